@@ -86,6 +86,7 @@ enum GromacsFileType
     efRND,
     efCSV,
     efQMI,
+    efJSON,
     efNR
 };
 
@@ -242,6 +242,33 @@ bool read_first_frame(const gmx_output_env_t*      oenv,
  * Returns true when succeeded, false otherwise.
  */
 
+/*! \brief Reads the first frame, only reading the atoms in \p atomIndices from H5MD files
+ *
+ * As read_first_frame() above. For H5MD trajectories only the data of the atoms
+ * in \p atomIndices is read from the file, also by subsequent calls to
+ * read_next_frame(), and the frames store these atoms in the order of
+ * \p atomIndices. Other formats can not read a subset of the atoms, so their
+ * frames contain all atoms, which callers can check with fr->natoms.
+ *
+ * \param[in]  oenv        Output environment.
+ * \param[out] status      Status of the opened trajectory.
+ * \param[in]  fn          Name of the trajectory file.
+ * \param[out] fr          The first frame.
+ * \param[in]  flags       Which data to read, see TRX_READ_X etc.
+ * \param[in]  atomIndices Strictly increasing indices of the atoms to read,
+ *                         or empty to read all atoms.
+ *
+ * \returns true when succeeded, false otherwise.
+ * \throws FileIOError for H5MD files when \p atomIndices are not strictly
+ *     increasing or are outside of the system.
+ */
+bool read_first_frame(const gmx_output_env_t*      oenv,
+                      t_trxstatus**                status,
+                      const std::filesystem::path& fn,
+                      struct t_trxframe*           fr,
+                      int                          flags,
+                      gmx::ArrayRef<const int>     atomIndices);
+
 /*! \brief Reads the next frame which is in accordance with fr->flags.
  *
  * \returns true when succeeded, false otherwise.
@@ -44,6 +44,7 @@
 
 #include "dlb.h"
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <vector>
@@ -71,6 +72,38 @@ float dd_pme_f_ratio(const gmx_domdec_t* dd)
     }
 }
 
+float DlbLoadPredictor::update(const float load, const int numAtoms)
+{
+    if (numAtoms <= 0 || load <= 0)
+    {
+        return load;
+    }
+
+    const float costPerAtom = load / numAtoms;
+    if (!haveLevel_)
+    {
+        level_     = costPerAtom;
+        trend_     = 0;
+        haveLevel_ = true;
+    }
+    else
+    {
+        const float previousLevel = level_;
+        level_ = c_levelSmoothing * costPerAtom + (1 - c_levelSmoothing) * (level_ + trend_);
+        trend_ = c_trendSmoothing * (level_ - previousLevel) + (1 - c_trendSmoothing) * trend_;
+    }
+
+    /* Do not let a steep downward trend predict (close to) zero cost */
+    return std::max(level_ + trend_, 0.5F * level_) * numAtoms;
+}
+
+void DlbLoadPredictor::reset()
+{
+    haveLevel_ = false;
+    level_     = 0;
+    trend_     = 0;
+}
+
 void set_dlb_limits(gmx_domdec_t* dd)
 
 {
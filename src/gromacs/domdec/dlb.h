@@ -63,6 +63,42 @@ constexpr int c_checkTurnDlbOnInterval = 100;
 constexpr int c_checkTurnDlbOffInterval = 20;
 
 
+/*! \internal \brief Exponentially smoothed model of the force cost per home atom
+ *
+ * With predictive DLB, the load balancing uses the load predicted by this
+ * model for the next balancing interval instead of the load measured over
+ * the last interval, which is noisy. The model uses double exponential
+ * smoothing of the cost per home atom, so it tracks both the level and
+ * the trend of the cost. As the cost is normalized by the number of atoms,
+ * changes of the load due to the DLB cell boundary changes themselves do
+ * not end up in the trend.
+ */
+class DlbLoadPredictor
+{
+public:
+    /*! \brief Adds a measurement and returns the predicted load for the next interval
+     *
+     * \param[in] load      The force load measured over the last interval
+     * \param[in] numAtoms  The number of home atoms during the last interval
+     */
+    float update(float load, int numAtoms);
+
+    //! Clears the model, to be called when the cell sizes change abruptly
+    void reset();
+
+private:
+    //! Weight of a new measurement for the level
+    static constexpr float c_levelSmoothing = 0.5F;
+    //! Weight of a new measurement for the trend
+    static constexpr float c_trendSmoothing = 0.25F;
+    //! Whether we have a measurement
+    bool haveLevel_ = false;
+    //! The smoothed cost per atom
+    float level_ = 0;
+    //! The smoothed change of the cost per atom per interval
+    float trend_ = 0;
+};
+
 /*! \brief Return the PME/PP force load ratio, or -1 if nothing was measured.
  *
  * Should only be called on the DD main node.
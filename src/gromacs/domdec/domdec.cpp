@@ -888,6 +888,11 @@ bool ddUsesUpdateGroups(const gmx_domdec_t& dd)
     return dd.comm->systemInfo.useUpdateGroups;
 }
 
+bool ddUsesHilbertOrder(const gmx_domdec_t& dd)
+{
+    return dd.comm->ddSettings.useHilbertOrder;
+}
+
 void dd_cycles_add(const gmx_domdec_t* dd, float cycles, int ddCycl)
 {
     /* Note that the cycles value can be incorrect, either 0 or some
@@ -2640,15 +2645,18 @@ static DDSettings getDDSettings(const gmx::MDLogger&     mdlog,
 {
     DDSettings ddSettings;
 
-    ddSettings.useSendRecv2        = (dd_getenv(mdlog, "GMX_DD_USE_SENDRECV2", 0) != 0);
-    ddSettings.dlb_scale_lim       = dd_getenv(mdlog, "GMX_DLB_MAX_BOX_SCALING", 10);
-    ddSettings.useDDOrderZYX       = bool(dd_getenv(mdlog, "GMX_DD_ORDER_ZYX", 0));
-    ddSettings.useCartesianReorder = bool(dd_getenv(mdlog, "GMX_NO_CART_REORDER", 1));
-    ddSettings.eFlop               = dd_getenv(mdlog, "GMX_DLB_BASED_ON_FLOPS", 0);
-    const int recload              = dd_getenv(mdlog, "GMX_DD_RECORD_LOAD", 1);
-    ddSettings.nstDDDump           = dd_getenv(mdlog, "GMX_DD_NST_DUMP", 0);
-    ddSettings.nstDDDumpGrid       = dd_getenv(mdlog, "GMX_DD_NST_DUMP_GRID", 0);
-    ddSettings.DD_debug            = dd_getenv(mdlog, "GMX_DD_DEBUG", 0);
+    ddSettings.useSendRecv2         = (dd_getenv(mdlog, "GMX_DD_USE_SENDRECV2", 0) != 0);
+    ddSettings.dlb_scale_lim        = dd_getenv(mdlog, "GMX_DLB_MAX_BOX_SCALING", 10);
+    ddSettings.useDDOrderZYX        = bool(dd_getenv(mdlog, "GMX_DD_ORDER_ZYX", 0));
+    ddSettings.useCartesianReorder  = bool(dd_getenv(mdlog, "GMX_NO_CART_REORDER", 1));
+    ddSettings.eFlop                = dd_getenv(mdlog, "GMX_DLB_BASED_ON_FLOPS", 0);
+    ddSettings.usePredictiveDlb     = bool(dd_getenv(mdlog, "GMX_DLB_PREDICTIVE", 0));
+    const int recload               = dd_getenv(mdlog, "GMX_DD_RECORD_LOAD", 1);
+    ddSettings.nstDDDump            = dd_getenv(mdlog, "GMX_DD_NST_DUMP", 0);
+    ddSettings.nstDDDumpGrid        = dd_getenv(mdlog, "GMX_DD_NST_DUMP_GRID", 0);
+    ddSettings.DD_debug             = dd_getenv(mdlog, "GMX_DD_DEBUG", 0);
+    ddSettings.compressHaloMessages = bool(dd_getenv(mdlog, "GMX_DD_COMPRESS_HALO", 0));
+    ddSettings.useHilbertOrder      = bool(dd_getenv(mdlog, "GMX_DD_HILBERT_ORDER", 0));
 
     if (ddSettings.useSendRecv2)
     {
@@ -2659,6 +2667,21 @@ static DDSettings getDDSettings(const gmx::MDLogger&     mdlog,
                         "communication");
     }
 
+    if (ddSettings.compressHaloMessages)
+    {
+        GMX_LOG(mdlog.info)
+                .appendTextFormatted("Will send halo coordinates as 21-bit fixed-point offsets%s",
+                                     GMX_DOUBLE ? " and halo forces in single precision" : "");
+    }
+
+    if (ddSettings.usePredictiveDlb)
+    {
+        GMX_LOG(mdlog.info)
+                .appendText(
+                        "Dynamic load balancing will use the load predicted by a smoothed model "
+                        "of the cost per atom");
+    }
+
     if (ddSettings.eFlop)
     {
         GMX_LOG(mdlog.info).appendText("Will load balance based on FLOP count");
@@ -2915,7 +2938,8 @@ DomainDecompositionBuilder::Impl::build(LocalAtomSetManager*       atomSets,
         // Use of direct halo exchange is coupled to having filler particles in the local state
         if (dd->nnodes > 1 && haveFillerParticlesInLocalState)
         {
-            dd->haloExchange = std::make_unique<gmx::HaloExchange>(ir_.pbcType);
+            dd->haloExchange = std::make_unique<gmx::HaloExchange>(ir_.pbcType,
+                                                                   ddSettings_.compressHaloMessages);
         }
     }
 
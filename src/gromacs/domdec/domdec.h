@@ -165,6 +165,9 @@ int dd_pme_maxshift_y(const gmx_domdec_t& dd);
 /*! \brief Return whether update groups are used */
 bool ddUsesUpdateGroups(const gmx_domdec_t& dd);
 
+/*! \brief Return whether the home atoms should be ordered along a Hilbert curve */
+bool ddUsesHilbertOrder(const gmx_domdec_t& dd);
+
 /*! \brief Returns whether molecules are always whole, i.e. not broken by PBC */
 bool dd_moleculesAreAlwaysWhole(const gmx_domdec_t& dd);
 
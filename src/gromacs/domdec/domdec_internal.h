@@ -44,6 +44,7 @@
 
 #include "config.h"
 
+#include "gromacs/domdec/dlb.h"
 #include "gromacs/domdec/dlbtiming.h"
 #include "gromacs/domdec/domdec.h"
 #include "gromacs/domdec/domdec_struct.h"
@@ -490,6 +491,15 @@ struct DDSettings
     //! Whether we should record the load
     bool recordLoad = false;
 
+    //! Whether the direct halo exchange sends compressed coordinates and forces
+    bool compressHaloMessages = false;
+
+    //! Whether DLB balances the predicted instead of the last measured load
+    bool usePredictiveDlb = false;
+
+    //! Whether to order the home atoms with the search grid columns along a Hilbert curve
+    bool useHilbertOrder = false;
+
     /* Debugging */
     //! Step interval for dumping the local+non-local atoms to pdb
     int nstDDDump = 0;
@@ -734,6 +744,8 @@ struct gmx_domdec_comm_t // NOLINT (clang-analyzer-optin.performance.Padding)
     float cyclesPerStepBeforeDLB = 0;
     /**< The running average of the cycles per step during DLB */
     float cyclesPerStepDlbExpAverage = 0;
+    /**< The model for predicting the force load with predictive DLB */
+    DlbLoadPredictor dlbLoadPredictor;
     /**< Have we turned off DLB (after turning DLB on)? */
     bool haveTurnedOffDlb = false;
     /**< The DD step at which we last measured that DLB off was faster than DLB on, 0 if there was no such step */
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+
+/*! \internal \file
+ *
+ * \brief Defines functions for compressing halo coordinate messages
+ *
+ * \ingroup module_domdec
+ */
+
+#include "gmxpre.h"
+
+#include "halocompression.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! The largest fixed-point value of a component
+constexpr uint64_t c_maxFixedPointValue = (uint64_t(1) << c_haloCompressionBitsPerComponent) - 1;
+
+//! Stores a double in a 64-bit word
+uint64_t doubleToWord(const double value)
+{
+    uint64_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    return word;
+}
+
+//! Extracts a double from a 64-bit word
+double wordToDouble(const uint64_t word)
+{
+    double value;
+    std::memcpy(&value, &word, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+void compressHaloCoordinates(ArrayRef<const RVec> x, ArrayRef<uint64_t> buffer)
+{
+    GMX_ASSERT(buffer.ssize() >= compressedHaloCoordinatesSize(x.ssize()),
+               "The buffer should be large enough");
+
+    DVec origin = { 0.0, 0.0, 0.0 };
+    DVec extent = { 0.0, 0.0, 0.0 };
+    if (!x.empty())
+    {
+        DVec upper;
+        for (int d = 0; d < DIM; d++)
+        {
+            origin[d] = std::numeric_limits<double>::max();
+            upper[d]  = std::numeric_limits<double>::lowest();
+        }
+        for (const RVec& v : x)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                origin[d] = std::min(origin[d], double(v[d]));
+                upper[d]  = std::max(upper[d], double(v[d]));
+            }
+        }
+        extent = upper - origin;
+    }
+
+    DVec spacing;
+    DVec invSpacing;
+    for (int d = 0; d < DIM; d++)
+    {
+        /* Avoid division by zero when all coordinates are equal */
+        spacing[d]    = std::max(extent[d], 1e-30) / c_maxFixedPointValue;
+        invSpacing[d] = 1.0 / spacing[d];
+
+        buffer[d]       = doubleToWord(origin[d]);
+        buffer[DIM + d] = doubleToWord(spacing[d]);
+    }
+
+    for (int i = 0; i < x.ssize(); i++)
+    {
+        uint64_t word = 0;
+        for (int d = 0; d < DIM; d++)
+        {
+            const double   scaled = (x[i][d] - origin[d]) * invSpacing[d];
+            const uint64_t value  = std::min(uint64_t(std::llround(scaled)), c_maxFixedPointValue);
+            word |= value << (d * c_haloCompressionBitsPerComponent);
+        }
+        buffer[c_compressedHaloHeaderSize + i] = word;
+    }
+}
+
+void decompressHaloCoordinates(ArrayRef<const uint64_t> buffer, ArrayRef<RVec> x)
+{
+    GMX_ASSERT(buffer.ssize() >= compressedHaloCoordinatesSize(x.ssize()),
+               "The buffer should be large enough");
+
+    DVec origin;
+    DVec spacing;
+    for (int d = 0; d < DIM; d++)
+    {
+        origin[d]  = wordToDouble(buffer[d]);
+        spacing[d] = wordToDouble(buffer[DIM + d]);
+    }
+
+    for (int i = 0; i < x.ssize(); i++)
+    {
+        const uint64_t word = buffer[c_compressedHaloHeaderSize + i];
+        for (int d = 0; d < DIM; d++)
+        {
+            const uint64_t value =
+                    (word >> (d * c_haloCompressionBitsPerComponent)) & c_maxFixedPointValue;
+            x[i][d] = origin[d] + value * spacing[d];
+        }
+    }
+}
+
+} // namespace gmx
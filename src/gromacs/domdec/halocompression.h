@@ -0,0 +1,90 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+
+/*! \internal \file
+ *
+ * \brief Declares functions for compressing halo coordinate messages
+ *
+ * Halo coordinates can optionally be sent as fixed-point offsets relative
+ * to the lower corner of the bounding box of the coordinates in a message.
+ * Each component is stored with c_haloCompressionBitsPerComponent bits and
+ * the three components of an atom are packed into one 64-bit word.
+ * The message starts with a header with the origin and the grid spacing.
+ *
+ * \ingroup module_domdec
+ */
+
+#ifndef GMX_DOMDEC_HALOCOMPRESSION_H
+#define GMX_DOMDEC_HALOCOMPRESSION_H
+
+#include <cstdint>
+
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/vectypes.h"
+
+namespace gmx
+{
+
+//! The number of bits used for each coordinate component in compressed halo messages
+static constexpr int c_haloCompressionBitsPerComponent = 21;
+
+//! The number of 64-bit words in the header of a compressed halo coordinate message
+static constexpr int c_compressedHaloHeaderSize = 2 * DIM;
+
+//! Returns the number of 64-bit words in a compressed message with \p numAtoms coordinates
+static inline int compressedHaloCoordinatesSize(const int numAtoms)
+{
+    return c_compressedHaloHeaderSize + numAtoms;
+}
+
+/*! \brief Compresses coordinates into a halo message buffer
+ *
+ * \param[in]  x       The coordinates to compress
+ * \param[out] buffer  The message buffer, size compressedHaloCoordinatesSize(x.size())
+ */
+void compressHaloCoordinates(ArrayRef<const RVec> x, ArrayRef<uint64_t> buffer);
+
+/*! \brief Decompresses coordinates from a halo message buffer
+ *
+ * The absolute error per component is at most half the grid spacing,
+ * which is the bounding box size divided by 2^c_haloCompressionBitsPerComponent - 1.
+ *
+ * \param[in]  buffer  The message buffer, size compressedHaloCoordinatesSize(x.size())
+ * \param[out] x       The decompressed coordinates
+ */
+void decompressHaloCoordinates(ArrayRef<const uint64_t> buffer, ArrayRef<RVec> x);
+
+} // namespace gmx
+
+#endif // GMX_DOMDEC_HALOCOMPRESSION_H
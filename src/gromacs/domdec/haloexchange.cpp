@@ -57,11 +57,17 @@
 
 #include "domainpaircomm.h"
 #include "domdec_internal.h"
+#include "halocompression.h"
 
 namespace gmx
 {
 
-HaloExchange::HaloExchange(const PbcType pbcType) : pbcType_(pbcType) {}
+HaloExchange::HaloExchange(const PbcType pbcType, const bool compressMessages) :
+    pbcType_(pbcType),
+    compressCoordinates_(compressMessages),
+    compressForces_(compressMessages && GMX_DOUBLE)
+{
+}
 
 HaloExchange::~HaloExchange() = default;
 
@@ -102,12 +108,14 @@ constexpr int numAtomsPerClusterToInt(const NumAtomsPerCluster numAtomsPerCluste
  *
  * \param[in] send         The domain pair communication setup
  * \param[in] sendBuffer   The data to send
+ * \param[in] numElements  The number of elements of \p sendBuffer to send
  * \param[in] tag          The MPI tag
  * \param[in] mpiRequests  List of requests where the send will be appended to
  */
 template<typename DomainPairComm, typename T>
 void ddIsendDomain(const DomainPairComm&     send,
                    ArrayRef<T>               sendBuffer,
+                   const int                 numElements,
                    const HaloMpiTag          tag,
                    std::vector<MPI_Request>* mpiRequests)
 {
@@ -117,7 +125,7 @@ void ddIsendDomain(const DomainPairComm&     send,
         mpiRequests->emplace_back();
 
         MPI_Isend(sendBuffer.data(),
-                  send.numAtoms() * sizeof(T),
+                  numElements * sizeof(T),
                   MPI_BYTE,
                   send.rank(),
                   static_cast<int>(tag),
@@ -127,6 +135,7 @@ void ddIsendDomain(const DomainPairComm&     send,
 #else
     GMX_UNUSED_VALUE(send);
     GMX_UNUSED_VALUE(sendBuffer);
+    GMX_UNUSED_VALUE(numElements);
     GMX_UNUSED_VALUE(tag);
     GMX_UNUSED_VALUE(mpiRequests);
 #endif
@@ -136,17 +145,18 @@ void ddIsendDomain(const DomainPairComm&     send,
  *
  * \param[in] receive        The domain pair communication setup
  * \param[in] receiveBuffer  Buffer to receive the data in
+ * \param[in] numElements    The number of elements to receive
  * \param[in] tag            The MPI tag
  * \param[in] mpiRequests    List of requests where the send will be appended to
  */
 template<typename DomainPairComm, typename T>
 void ddIreceiveDomain(const DomainPairComm&     receive,
                       ArrayRef<T>               receiveBuffer,
+                      const int                 numElements,
                       const HaloMpiTag          tag,
                       std::vector<MPI_Request>* mpiRequests)
 {
-    GMX_ASSERT(receiveBuffer.ssize() >= receive.numAtoms(),
-               "Receive buffer should be sufficiently large");
+    GMX_ASSERT(receiveBuffer.ssize() >= numElements, "Receive buffer should be sufficiently large");
 
 #if GMX_MPI
     if (receive.numAtoms() > 0)
@@ -154,7 +164,7 @@ void ddIreceiveDomain(const DomainPairComm&     receive,
         mpiRequests->emplace_back();
 
         MPI_Irecv(receiveBuffer.data(),
-                  receive.numAtoms() * sizeof(T),
+                  numElements * sizeof(T),
                   MPI_BYTE,
                   receive.rank(),
                   static_cast<int>(tag),
@@ -164,6 +174,7 @@ void ddIreceiveDomain(const DomainPairComm&     receive,
 #else
     GMX_UNUSED_VALUE(receive);
     GMX_UNUSED_VALUE(receiveBuffer);
+    GMX_UNUSED_VALUE(numElements);
     GMX_UNUSED_VALUE(tag);
     GMX_UNUSED_VALUE(mpiRequests);
 #endif
@@ -268,17 +279,30 @@ void HaloExchange::initiateReceiveX(ArrayRef<RVec> x)
 {
     auto& mpiRequests = mpiCoordinateRequests_.receive;
 
+    xReceive_ = x;
+    compressedXReceiveBuffers_.resize(domainPairComm_.size());
+
     /* Post all the non-blocking receives */
-    for (DomainPairComm& dpc : domainPairComm_)
+    for (size_t i = 0; i < domainPairComm_.size(); i++)
     {
-        DomainCommForward& receive = dpc.forward();
+        DomainCommForward& receive = domainPairComm_[i].forward();
 
         if (receive.numAtoms() > 0)
         {
-            ddIreceiveDomain(receive,
-                             x.subArray(*receive.atomRange().begin(), receive.atomRange().size()),
-                             HaloMpiTag::X,
-                             &mpiRequests);
+            if (compressCoordinates_)
+            {
+                std::vector<uint64_t>& buffer = compressedXReceiveBuffers_[i];
+                buffer.resize(compressedHaloCoordinatesSize(receive.numAtoms()));
+                ddIreceiveDomain(
+                        receive, makeArrayRef(buffer), buffer.size(), HaloMpiTag::X, &mpiRequests);
+            }
+            else
+            {
+                ArrayRef<RVec> receiveX =
+                        x.subArray(*receive.atomRange().begin(), receive.atomRange().size());
+                ddIreceiveDomain(
+                        receive, receiveX, receive.numAtoms(), HaloMpiTag::X, &mpiRequests);
+            }
         }
     }
 }
@@ -290,16 +314,30 @@ void HaloExchange::initiateSendX(const matrix box, ArrayRef<RVec> x)
     GMX_ASSERT(mpiRequests.empty(),
                "All MPI Requests should have been handled before initiating sendX");
 
-    for (DomainPairComm& dpc : domainPairComm_)
+    compressedXSendBuffers_.resize(domainPairComm_.size());
+
+    for (size_t i = 0; i < domainPairComm_.size(); i++)
     {
-        DomainCommBackward& send = dpc.backward();
+        DomainCommBackward& send = domainPairComm_[i].backward();
 
         if (send.numAtoms() > 0)
         {
             send.packCoordinateSendBuffer(box, x, send.rvecBuffer());
 
             // Post the non-blocking send
-            ddIsendDomain(send, send.rvecBuffer(), HaloMpiTag::X, &mpiRequests);
+            if (compressCoordinates_)
+            {
+                std::vector<uint64_t>& buffer = compressedXSendBuffers_[i];
+                buffer.resize(compressedHaloCoordinatesSize(send.numAtoms()));
+                compressHaloCoordinates(send.rvecBuffer().subArray(0, send.numAtoms()), buffer);
+                ddIsendDomain(
+                        send, makeArrayRef(buffer), buffer.size(), HaloMpiTag::X, &mpiRequests);
+            }
+            else
+            {
+                ddIsendDomain(
+                        send, send.rvecBuffer(), send.numAtoms(), HaloMpiTag::X, &mpiRequests);
+            }
         }
     }
 }
@@ -312,6 +350,21 @@ void HaloExchange::completeReceiveX()
     mpiWaitall(mpiRequests.receive, mpiStatus_);
 
     mpiRequests.receive.clear();
+
+    if (compressCoordinates_)
+    {
+        for (size_t i = 0; i < domainPairComm_.size(); i++)
+        {
+            const DomainCommForward& receive = domainPairComm_[i].forward();
+
+            if (receive.numAtoms() > 0)
+            {
+                decompressHaloCoordinates(compressedXReceiveBuffers_[i],
+                                          xReceive_.subArray(*receive.atomRange().begin(),
+                                                             receive.atomRange().size()));
+            }
+        }
+    }
 }
 
 void HaloExchange::completeSendX()
@@ -403,18 +456,37 @@ void HaloExchange::initiateReceiveF()
 {
     HaloMpiRequests& mpiRequests = mpiForceRequests_;
 
+    floatFReceiveBuffers_.resize(domainPairComm_.size());
+
     /* Post all the non-blocking receives */
-    for (DomainPairComm& dpc : domainPairComm_)
+    for (size_t i = 0; i < domainPairComm_.size(); i++)
     {
-        DomainCommBackward& receive = dpc.backward();
+        DomainCommBackward& receive = domainPairComm_[i].backward();
 
         if (receive.numAtoms() > 0)
         {
-            /* We can reuse the send x buffer as the receive buffer for f,
-             * since the received x need to be processed before f can be
-             * calculated and communicated.
-             */
-            ddIreceiveDomain(receive, receive.rvecBuffer(), HaloMpiTag::F, &mpiRequests.receive);
+            if (compressForces_)
+            {
+                std::vector<BasicVector<float>>& buffer = floatFReceiveBuffers_[i];
+                buffer.resize(receive.numAtoms());
+                ddIreceiveDomain(receive,
+                                 makeArrayRef(buffer),
+                                 receive.numAtoms(),
+                                 HaloMpiTag::F,
+                                 &mpiRequests.receive);
+            }
+            else
+            {
+                /* We can reuse the send x buffer as the receive buffer for f,
+                 * since the received x need to be processed before f can be
+                 * calculated and communicated.
+                 */
+                ddIreceiveDomain(receive,
+                                 receive.rvecBuffer(),
+                                 receive.numAtoms(),
+                                 HaloMpiTag::F,
+                                 &mpiRequests.receive);
+            }
         }
     }
 }
@@ -426,17 +498,37 @@ void HaloExchange::initiateSendF(ArrayRef<const RVec> f)
     GMX_ASSERT(mpiRequests.send.empty(),
                "All MPI Requests should have been handled before initiating sendF");
 
+    floatFSendBuffers_.resize(domainPairComm_.size());
+
     /* Non-blocking send using direct force buffer pointers */
-    for (DomainPairComm& dpc : domainPairComm_)
+    for (size_t i = 0; i < domainPairComm_.size(); i++)
     {
-        DomainCommForward& send = dpc.forward();
+        DomainCommForward& send = domainPairComm_[i].forward();
 
         if (send.numAtoms() > 0)
         {
-            ddIsendDomain(send,
-                          f.subArray(*send.atomRange().begin(), send.atomRange().size()),
-                          HaloMpiTag::F,
-                          &mpiRequests.send);
+            ArrayRef<const RVec> sendForces =
+                    f.subArray(*send.atomRange().begin(), send.atomRange().size());
+            if (compressForces_)
+            {
+                std::vector<BasicVector<float>>& buffer = floatFSendBuffers_[i];
+                buffer.resize(send.numAtoms());
+                for (int a = 0; a < send.numAtoms(); a++)
+                {
+                    buffer[a] = { static_cast<float>(sendForces[a][XX]),
+                                  static_cast<float>(sendForces[a][YY]),
+                                  static_cast<float>(sendForces[a][ZZ]) };
+                }
+                ddIsendDomain(send,
+                              makeArrayRef(buffer),
+                              send.numAtoms(),
+                              HaloMpiTag::F,
+                              &mpiRequests.send);
+            }
+            else
+            {
+                ddIsendDomain(send, sendForces, send.numAtoms(), HaloMpiTag::F, &mpiRequests.send);
+            }
         }
     }
 }
@@ -456,9 +548,21 @@ void HaloExchange::completeReceiveF(ArrayRef<RVec> forces, ArrayRef<RVec> shiftF
     mpiRequests.receive.clear();
 
     /* Reduce the received non-local forces with our local forces */
-    for (DomainPairComm& dpc : domainPairComm_)
+    for (size_t i = 0; i < domainPairComm_.size(); i++)
     {
-        dpc.backward().accumulateReceivedForces(forces, shiftForces);
+        DomainCommBackward& receive = domainPairComm_[i].backward();
+
+        if (compressForces_ && receive.numAtoms() > 0)
+        {
+            ArrayRef<RVec> receivedForces = receive.rvecBuffer();
+            for (int a = 0; a < receive.numAtoms(); a++)
+            {
+                const BasicVector<float>& receivedForce = floatFReceiveBuffers_[i][a];
+                receivedForces[a] = { receivedForce[XX], receivedForce[YY], receivedForce[ZZ] };
+            }
+        }
+
+        receive.accumulateReceivedForces(forces, shiftForces);
     }
 }
 
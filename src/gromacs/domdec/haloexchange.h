@@ -58,8 +58,11 @@
 #ifndef GMX_DOMDEC_HALOEXCHANGE_H
 #define GMX_DOMDEC_HALOEXCHANGE_H
 
+#include <cstdint>
+
 #include <vector>
 
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/gmxmpi.h"
 #include "gromacs/utility/range.h"
 #include "gromacs/utility/vectypes.h"
@@ -72,8 +75,6 @@ class t_state;
 
 namespace gmx
 {
-template<typename>
-class ArrayRef;
 class DomainPairComm;
 
 //! Storage for MPI request for halo MPI receive and send operations
@@ -89,7 +90,13 @@ struct HaloMpiRequests
 class HaloExchange
 {
 public:
-    HaloExchange(PbcType pbcType);
+    /*! \brief Constructor
+     *
+     * \param[in] pbcType           The type of PBC
+     * \param[in] compressMessages  Whether to send coordinates as fixed-point offsets
+     *                              and, in double precision, forces in single precision
+     */
+    HaloExchange(PbcType pbcType, bool compressMessages = false);
 
     ~HaloExchange();
 
@@ -157,6 +164,10 @@ private:
 
     //! The type of PBC
     PbcType pbcType_;
+    //! Whether we send compressed coordinates
+    bool compressCoordinates_;
+    //! Whether we send forces in single precision in a double precision build
+    bool compressForces_;
 
     //! List of objects for communicating between pairs of domains
     std::vector<DomainPairComm> domainPairComm_;
@@ -170,6 +181,17 @@ private:
 
     //! Buffer for storing the MPI status for MPI waits
     std::vector<MPI_Status> mpiStatus_;
+
+    //! The coordinate buffer the halo coordinates are received in
+    ArrayRef<RVec> xReceive_;
+    //! Per domain pair buffers for sending compressed coordinates
+    std::vector<std::vector<uint64_t>> compressedXSendBuffers_;
+    //! Per domain pair buffers for receiving compressed coordinates
+    std::vector<std::vector<uint64_t>> compressedXReceiveBuffers_;
+    //! Per domain pair buffers for sending single precision forces
+    std::vector<std::vector<BasicVector<float>>> floatFSendBuffers_;
+    //! Per domain pair buffers for receiving single precision forces
+    std::vector<std::vector<BasicVector<float>>> floatFReceiveBuffers_;
 };
 
 } // namespace gmx
@@ -683,19 +683,32 @@ static int make_bondeds_zone(const gmx_reverse_top_t&           rt,
 
         const AtomIndexSet atomIndexMol = { atomIndexLocal, atomIndexGlobal, aim.atomIndexInMolecule };
         const auto& ilistMol = rt.interactionListForMoleculeType(aim.moleculeType);
-        numBondedInteractions += assignInteractionsForAtom<haveSingleDomain>(atomIndexMol,
-                                                                             ilistMol,
-                                                                             ga2la,
-                                                                             zones,
-                                                                             checkDistanceMultiBody,
-                                                                             rcheck,
-                                                                             checkDistanceTwoBody,
-                                                                             cutoffSquared,
-                                                                             pbc_null,
-                                                                             coordinates,
-                                                                             idef,
-                                                                             izone,
-                                                                             ddBondedChecking);
+
+        /* The atoms of an update group are always in the same zone. As the home zone
+         * is the only zone that is paired with itself, interactions within an update group
+         * are only assigned in the home zone. With small domains most atoms are in
+         * the halo zones, so skipping these saves most of the lookups there.
+         */
+        const bool skipMoleculeInteractions =
+                (izone > 0 && !ilistMol.linksUpdateGroups.empty()
+                 && !ilistMol.linksUpdateGroups[aim.atomIndexInMolecule]);
+        if (!skipMoleculeInteractions)
+        {
+            numBondedInteractions +=
+                    assignInteractionsForAtom<haveSingleDomain>(atomIndexMol,
+                                                                ilistMol,
+                                                                ga2la,
+                                                                zones,
+                                                                checkDistanceMultiBody,
+                                                                rcheck,
+                                                                checkDistanceTwoBody,
+                                                                cutoffSquared,
+                                                                pbc_null,
+                                                                coordinates,
+                                                                idef,
+                                                                izone,
+                                                                ddBondedChecking);
+        }
 
         // Assign position restraints, when present, for the home zone
         if (izone == 0 && rt.hasPositionRestraints())
@@ -813,25 +826,25 @@ static void make_exclusions_zone(ArrayRef<const int>               globalAtomInd
             "The number of exclusion list should match the number of atoms in the range");
 }
 
-/*! \brief Generate and store all required local bonded interactions in \p idef and local exclusions in \p lexcls
- *
- * \returns Total count of bonded interactions in the local topology on this domain */
-static int make_local_bondeds_excls(const gmx_domdec_t&     dd,
-                                    const gmx::DomdecZones& zones,
-                                    const gmx_mtop_t&       mtop,
-                                    ArrayRef<const int32_t> atomInfo,
-                                    const bool              checkDistanceMultiBody,
-                                    const ivec              rcheck,
-                                    const gmx_bool          checkDistanceTwoBody,
-                                    const real              cutoff,
-                                    const t_pbc*            pbc_null,
-                                    ArrayRef<const RVec>    coordinates,
-                                    InteractionDefinitions* idef,
-                                    ListOfLists<int>*       lexcls)
+int make_local_bondeds_excls(const gmx_reverse_top_t& rt,
+                             ArrayRef<const int>      globalAtomIndices,
+                             const gmx_ga2la_t&       ga2la,
+                             const bool               haveExclusions,
+                             const gmx::DomdecZones&  zones,
+                             const gmx_mtop_t&        mtop,
+                             ArrayRef<const int32_t>  atomInfo,
+                             const bool               checkDistanceMultiBody,
+                             const ivec               rcheck,
+                             const bool               checkDistanceTwoBody,
+                             const real               cutoff,
+                             const t_pbc*             pbc_null,
+                             ArrayRef<const RVec>     coordinates,
+                             InteractionDefinitions*  idef,
+                             ListOfLists<int>*        lexcls)
 {
     int nzone_bondeds = 0;
 
-    if (dd.reverse_top->hasInterAtomicInteractions())
+    if (rt.hasInterAtomicInteractions())
     {
         nzone_bondeds = zones.numZones();
     }
@@ -844,9 +857,7 @@ static int make_local_bondeds_excls(const gmx_domdec_t&     dd,
     }
 
     /* We only use exclusions from i-zones to i- and j-zones */
-    const int numIZonesForExclusions = (dd.haveExclusions ? zones.numIZones() : 0);
-
-    const gmx_reverse_top_t& rt = *dd.reverse_top;
+    const int numIZonesForExclusions = (haveExclusions ? zones.numIZones() : 0);
 
     const real cutoffSquared = gmx::square(cutoff);
 
@@ -887,8 +898,8 @@ static int make_local_bondeds_excls(const gmx_domdec_t&     dd,
                         zones.numZones() == 1 ? make_bondeds_zone<true> : make_bondeds_zone<false>;
                 threadWorkObjects[thread].numBondedInteractions =
                         runMakeBondedsZone(rt,
-                                           dd.globalAtomIndices,
-                                           *dd.ga2la,
+                                           globalAtomIndices,
+                                           ga2la,
                                            zones,
                                            mtop.molblock,
                                            checkDistanceMultiBody,
@@ -920,8 +931,8 @@ static int make_local_bondeds_excls(const gmx_domdec_t&     dd,
                     /* No charge groups and no distance check required */
                     auto runMakeExclusionsZone = zones.numZones() == 1 ? make_exclusions_zone<true>
                                                                        : make_exclusions_zone<false>;
-                    runMakeExclusionsZone(dd.globalAtomIndices,
-                                          *dd.ga2la,
+                    runMakeExclusionsZone(globalAtomIndices,
+                                          ga2la,
                                           zones,
                                           rt.molblockIndices(),
                                           mtop.moltype,
@@ -1047,7 +1058,10 @@ int dd_make_local_top(const gmx_domdec_t&          dd,
         }
     }
 
-    int numBondedInteractionsToReduce = make_local_bondeds_excls(dd,
+    int numBondedInteractionsToReduce = make_local_bondeds_excls(*dd.reverse_top,
+                                                                 dd.globalAtomIndices,
+                                                                 *dd.ga2la,
+                                                                 dd.haveExclusions,
                                                                  zones,
                                                                  mtop,
                                                                  fr->atomInfo,
@@ -45,19 +45,26 @@
 
 #include <cstdint>
 
+#include "gromacs/utility/real.h"
 #include "gromacs/utility/vectypes.h"
 
 struct gmx_domdec_t;
+class gmx_ga2la_t;
 struct gmx_localtop_t;
 struct gmx_mtop_t;
+class gmx_reverse_top_t;
+class InteractionDefinitions;
 struct t_forcerec;
 struct t_mdatoms;
+struct t_pbc;
 
 namespace gmx
 {
 template<typename>
 class ArrayRef;
 class DomdecZones;
+template<typename>
+class ListOfLists;
 } // namespace gmx
 
 /*! \brief Generate the local topology and virtual site data
@@ -75,4 +82,26 @@ int dd_make_local_top(const gmx_domdec_t&            dd,
                       gmx::ArrayRef<const int32_t>   atomInfo,
                       gmx_localtop_t*                ltop);
 
+/*! \brief Generate and store all required local bonded interactions in \p idef and local exclusions in \p lexcls
+ *
+ * This is the part of dd_make_local_top() that only depends on the local atoms
+ * and zones, declared here for testing.
+ *
+ * \returns Total count of bonded interactions in the local topology on this domain */
+int make_local_bondeds_excls(const gmx_reverse_top_t&       rt,
+                             gmx::ArrayRef<const int>       globalAtomIndices,
+                             const gmx_ga2la_t&             ga2la,
+                             bool                           haveExclusions,
+                             const gmx::DomdecZones&        zones,
+                             const gmx_mtop_t&              mtop,
+                             gmx::ArrayRef<const int32_t>   atomInfo,
+                             bool                           checkDistanceMultiBody,
+                             const ivec                     rcheck,
+                             bool                           checkDistanceTwoBody,
+                             real                           cutoff,
+                             const t_pbc*                   pbc_null,
+                             gmx::ArrayRef<const gmx::RVec> coordinates,
+                             InteractionDefinitions*        idef,
+                             gmx::ListOfLists<int>*         lexcls);
+
 #endif
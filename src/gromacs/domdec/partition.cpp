@@ -782,6 +782,19 @@ static void comm_dd_ns_cell_sizes(gmx_domdec_t* dd, gmx_ddbox_t* ddbox, rvec cel
     }
 }
 
+//! Returns the force load on this rank for the next interval predicted from the measured \p load
+static float dd_predicted_force_load(gmx_domdec_t* dd, const float load)
+{
+    gmx_domdec_comm_t* comm = dd->comm.get();
+
+    /* The model works per step, so intervals of different length can be combined.
+     * Note that dd_force_load() subtracts the maximum count with multiple steps.
+     */
+    const int numSteps = (comm->cycl_n[ddCyclF] > 1 ? comm->cycl_n[ddCyclF] - 1 : 1);
+
+    return numSteps * comm->dlbLoadPredictor.update(load / numSteps, dd->numHomeAtoms);
+}
+
 //! Compute and communicate to determine the load distribution across PP ranks.
 static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle* wcycle)
 {
@@ -830,7 +843,9 @@ static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle* wcycle)
                 sbuf[pos++] = sbuf[0];
                 if (isDlbOn(dd->comm->dlbState))
                 {
-                    sbuf[pos++] = sbuf[0];
+                    sbuf[pos++] = comm->ddSettings.usePredictiveDlb
+                                          ? dd_predicted_force_load(dd, sbuf[0])
+                                          : sbuf[0];
                     sbuf[pos++] = cell_frac;
                     if (d > 0)
                     {
@@ -1279,6 +1294,7 @@ static void turn_on_dlb(const gmx::MDLogger& mdlog, gmx_domdec_t* dd, int64_t st
                     gmx::toString(step).c_str(),
                     dd_force_imb_perf_loss(dd) * 100);
     comm->dlbState = DlbState::onCanTurnOff;
+    comm->dlbLoadPredictor.reset();
 
     /* Store the non-DLB performance, so we can check if DLB actually
      * improves performance.
@@ -2386,7 +2402,11 @@ static void orderVector(gmx::ArrayRef<const gmx_cgsort_t> sort,
     orderVector<T>(sort, vectorToSort, fillerValue, *workVector);
 }
 
-//! Returns the sorting order for atoms based on the nbnxn grid order in sort
+/*! \brief Returns the sorting order for atoms based on the nbnxn grid order in sort
+ *
+ * With GMX_DD_HILBERT_ORDER, the grid columns are visited along a Hilbert curve,
+ * so the local topology, update and constraints also process the atoms in that order.
+ */
 static void dd_sort_order_nbnxn(const gmx::nonbonded_verlet_t& nbv, gmx::FastVector<gmx_cgsort_t>* sort)
 {
     gmx::ArrayRef<const int> atomOrder = nbv.getLocalAtomOrder();
@@ -61,6 +61,7 @@
 #include "gromacs/mdtypes/inputrec.h"
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/topology/atoms.h"
+#include "gromacs/topology/block.h"
 #include "gromacs/topology/ifunc.h"
 #include "gromacs/topology/mtop_util.h"
 #include "gromacs/topology/topology.h"
@@ -82,7 +83,10 @@ using gmx::RVec;
 struct gmx_reverse_top_t::Impl
 {
     //! Constructs a reverse topology from \p mtop
-    Impl(const gmx_mtop_t& mtop, bool useFreeEnergy, const ReverseTopOptions& reverseTopOptions);
+    Impl(const gmx_mtop_t&                           mtop,
+         bool                                        useFreeEnergy,
+         const ReverseTopOptions&                    reverseTopOptions,
+         gmx::ArrayRef<const gmx::RangePartitioning> updateGroupings);
 
     //! @cond Doxygen_Suppress
     //! Options for the setup of this reverse topology
@@ -294,10 +298,11 @@ void make_reverse_ilist(const InteractionLists&  ilist,
     ril_mt->numAtomsInMolecule = atoms->nr;
 }
 
-gmx_reverse_top_t::gmx_reverse_top_t(const gmx_mtop_t&        mtop,
-                                     bool                     useFreeEnergy,
-                                     const ReverseTopOptions& reverseTopOptions) :
-    impl_(std::make_unique<Impl>(mtop, useFreeEnergy, reverseTopOptions))
+gmx_reverse_top_t::gmx_reverse_top_t(const gmx_mtop_t&                           mtop,
+                                     bool                                        useFreeEnergy,
+                                     const ReverseTopOptions&                    reverseTopOptions,
+                                     gmx::ArrayRef<const gmx::RangePartitioning> updateGroupings) :
+    impl_(std::make_unique<Impl>(mtop, useFreeEnergy, reverseTopOptions, updateGroupings))
 {
 }
 
@@ -348,10 +353,49 @@ bool gmx_reverse_top_t::doListedForcesSorting() const
     return impl_->doListedForcesSorting;
 }
 
+/*! \brief Marks the atoms in \p ril with linked interactions that involve multiple update groups
+ *
+ * Virtual site constructions are not considered, as these are only assigned in the home zone.
+ */
+static void setLinksUpdateGroups(const gmx::RangePartitioning& updateGrouping, reverse_ilist_t* ril)
+{
+    std::vector<int> updateGroupIndex(ril->numAtomsInMolecule);
+    for (int group = 0; group < updateGrouping.numBlocks(); group++)
+    {
+        for (int a : updateGrouping.block(group))
+        {
+            updateGroupIndex[a] = group;
+        }
+    }
+
+    ril->linksUpdateGroups.assign(ril->numAtomsInMolecule, false);
+    for (int a = 0; a < ril->numAtomsInMolecule; a++)
+    {
+        int j = ril->index[a];
+        while (j < ril->index[a + 1])
+        {
+            const InteractionFunction ftype = static_cast<InteractionFunction>(ril->il[j]);
+            const int                 nral  = NRAL(ftype);
+            if (!(interaction_function[ftype].flags & IF_VSITE))
+            {
+                for (int k = 0; k < nral; k++)
+                {
+                    if (updateGroupIndex[ril->il[j + 2 + k]] != updateGroupIndex[a])
+                    {
+                        ril->linksUpdateGroups[a] = true;
+                    }
+                }
+            }
+            j += 2 + nral_rt(ftype);
+        }
+    }
+}
+
 /*! \brief Generate the reverse topology */
-gmx_reverse_top_t::Impl::Impl(const gmx_mtop_t&        mtop,
-                              const bool               useFreeEnergy,
-                              const ReverseTopOptions& reverseTopOptions) :
+gmx_reverse_top_t::Impl::Impl(const gmx_mtop_t&                           mtop,
+                              const bool                                  useFreeEnergy,
+                              const ReverseTopOptions&                    reverseTopOptions,
+                              gmx::ArrayRef<const gmx::RangePartitioning> updateGroupings) :
     options(reverseTopOptions),
     hasPositionRestraints(gmx_mtop_ftype_count(mtop, InteractionFunction::PositionRestraints)
                                   + gmx_mtop_ftype_count(mtop, InteractionFunction::FlatBottomedPositionRestraints)
@@ -372,6 +416,11 @@ gmx_reverse_top_t::Impl::Impl(const gmx_mtop_t&        mtop,
         /* Make the atom to interaction list for this molecule type */
         make_reverse_ilist(molt.ilist, &molt.atoms, options, AtomLinkRule::FirstAtom, &ril_mt[mt]);
 
+        if (!updateGroupings.empty())
+        {
+            setLinksUpdateGroups(updateGroupings[mt], &ril_mt[mt]);
+        }
+
         ril_mt_tot_size += ril_mt[mt].index[molt.atoms.nr];
     }
     if (debug)
@@ -442,8 +491,14 @@ void dd_make_reverse_top(FILE*                           fplog,
                                       !dd->comm->systemInfo.mayHaveSplitConstraints,
                                       !dd->comm->systemInfo.mayHaveSplitSettles);
 
+    gmx::ArrayRef<const gmx::RangePartitioning> updateGroupings;
+    if (dd->comm->systemInfo.useUpdateGroups)
+    {
+        updateGroupings = dd->comm->systemInfo.updateGroupingsPerMoleculeType;
+    }
+
     dd->reverse_top = std::make_unique<gmx_reverse_top_t>(
-            mtop, inputrec.efep != FreeEnergyPerturbationType::No, rtOptions);
+            mtop, inputrec.efep != FreeEnergyPerturbationType::No, rtOptions, updateGroupings);
 
     // we also need to check for intermolecular exclusions
     dd->haveExclusions = !mtop.intermolecularExclusionGroup.empty();
@@ -63,6 +63,7 @@ struct ReverseTopOptions;
 
 namespace gmx
 {
+class RangePartitioning;
 class VirtualSitesHandler;
 enum class DDBondedChecking : bool;
 } // namespace gmx
@@ -87,6 +88,10 @@ struct reverse_ilist_t
     std::vector<int> index;              /* Index for each atom into il          */
     std::vector<int> il;                 /* ftype|type|a0|...|an|ftype|...       */
     int              numAtomsInMolecule; /* The number of atoms in this molecule */
+    /* Per atom, whether an interaction linked to it involves multiple update groups,
+     * empty when update groups are not used.
+     */
+    std::vector<bool> linksUpdateGroups;
 };
 
 /*! \internal \brief Struct for thread local work data for local topology generation */
@@ -129,8 +134,15 @@ struct ReverseTopOptions
 class gmx_reverse_top_t
 {
 public:
-    //! Constructor
-    gmx_reverse_top_t(const gmx_mtop_t& mtop, bool useFreeEnergy, const ReverseTopOptions& reverseTopOptions);
+    /*! \brief Constructor
+     *
+     * When the update groupings per molecule type \p updateGroupings are passed,
+     * the atoms are marked that have linked interactions involving multiple update groups.
+     */
+    gmx_reverse_top_t(const gmx_mtop_t&                           mtop,
+                      bool                                        useFreeEnergy,
+                      const ReverseTopOptions&                    reverseTopOptions,
+                      gmx::ArrayRef<const gmx::RangePartitioning> updateGroupings = {});
     //! Destructor
     ~gmx_reverse_top_t();
 
@@ -0,0 +1,118 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the load prediction used with dynamic load balancing.
+ *
+ * \ingroup module_domdec
+ */
+#include "gmxpre.h"
+
+#include "gromacs/domdec/dlb.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+TEST(DlbLoadPredictor, FirstMeasurementIsReturned)
+{
+    DlbLoadPredictor predictor;
+
+    EXPECT_FLOAT_EQ(predictor.update(1000.0F, 100), 1000.0F);
+}
+
+TEST(DlbLoadPredictor, ScalesWithNumberOfAtoms)
+{
+    DlbLoadPredictor predictor;
+
+    predictor.update(1000.0F, 100);
+    // Same cost per atom, twice the atoms
+    EXPECT_FLOAT_EQ(predictor.update(2000.0F, 200), 2000.0F);
+}
+
+TEST(DlbLoadPredictor, SmoothesFluctuations)
+{
+    DlbLoadPredictor predictor;
+
+    const float averageLoad  = 1000.0F;
+    float       maxDeviation = 0;
+    for (int i = 0; i < 20; i++)
+    {
+        const float measuredLoad  = averageLoad * (i % 2 == 0 ? 1.2F : 0.8F);
+        const float predictedLoad = predictor.update(measuredLoad, 100);
+        if (i >= 10)
+        {
+            maxDeviation = std::max(maxDeviation, std::abs(predictedLoad - averageLoad));
+        }
+    }
+    EXPECT_LT(maxDeviation, 0.2F * averageLoad);
+}
+
+TEST(DlbLoadPredictor, FollowsTrend)
+{
+    DlbLoadPredictor predictor;
+
+    float predictedLoad = 0;
+    for (int i = 0; i < 30; i++)
+    {
+        predictedLoad = predictor.update(1000.0F + 10.0F * i, 100);
+    }
+    // The prediction for the next interval should be close to the extrapolated load
+    EXPECT_NEAR(predictedLoad, 1000.0F + 10.0F * 30, 5.0F);
+}
+
+TEST(DlbLoadPredictor, ResetDiscardsHistory)
+{
+    DlbLoadPredictor predictor;
+
+    predictor.update(1000.0F, 100);
+    predictor.update(1500.0F, 100);
+    predictor.reset();
+
+    EXPECT_FLOAT_EQ(predictor.update(500.0F, 100), 500.0F);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -0,0 +1,201 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the compression of halo coordinate messages.
+ *
+ * \ingroup module_domdec
+ */
+#include "gmxpre.h"
+
+#include "gromacs/domdec/halocompression.h"
+
+#include <cmath>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/utility/vec.h"
+#include "gromacs/random/threefry.h"
+#include "gromacs/random/uniformrealdistribution.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Returns random coordinates in a halo slab of a 6x6x1.2 nm domain
+std::vector<RVec> generateHaloCoordinates(const int numAtoms)
+{
+    ThreeFry2x64<64>              rng(123456, RandomDomain::Other);
+    UniformRealDistribution<real> dist;
+    const RVec                    size   = { 6.0, 6.0, 1.2 };
+    const RVec                    offset = { 2.5, -1.0, 3.0 };
+    std::vector<RVec>             x(numAtoms);
+    for (RVec& v : x)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            v[d] = offset[d] + size[d] * dist(rng);
+        }
+    }
+    return x;
+}
+
+//! Returns the compressed and decompressed coordinates
+std::vector<RVec> roundTrip(ArrayRef<const RVec> x)
+{
+    std::vector<uint64_t> buffer(compressedHaloCoordinatesSize(x.ssize()));
+    compressHaloCoordinates(x, buffer);
+    std::vector<RVec> xDecompressed(x.size());
+    decompressHaloCoordinates(buffer, xDecompressed);
+    return xDecompressed;
+}
+
+TEST(HaloCompression, RoundTripErrorIsBoundedByHalfTheSpacing)
+{
+    const std::vector<RVec> x = generateHaloCoordinates(1000);
+
+    RVec lower = x[0];
+    RVec upper = x[0];
+    for (const RVec& v : x)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            lower[d] = std::min(lower[d], v[d]);
+            upper[d] = std::max(upper[d], v[d]);
+        }
+    }
+
+    const std::vector<RVec> xDecompressed = roundTrip(x);
+
+    for (int d = 0; d < DIM; d++)
+    {
+        const real spacing = (upper[d] - lower[d]) / ((1 << c_haloCompressionBitsPerComponent) - 1);
+        // Allow for the rounding of the decompressed value to real
+        const real tolerance = 0.5 * spacing + 2 * GMX_REAL_EPS * std::fabs(upper[d]);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            EXPECT_LE(std::fabs(xDecompressed[i][d] - x[i][d]), tolerance)
+                    << "atom " << i << " dimension " << d;
+        }
+    }
+}
+
+TEST(HaloCompression, HandlesEmptyAndDegenerateMessages)
+{
+    EXPECT_TRUE(roundTrip({}).empty());
+
+    const std::vector<RVec> x(3, RVec({ 1.5, -2.0, 0.25 }));
+    const std::vector<RVec> xDecompressed = roundTrip(x);
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_EQ(xDecompressed[i][d], x[i][d]);
+        }
+    }
+}
+
+//! Returns the Lennard-Jones plus reaction-field force on \p xi due to \p xj
+RVec pairForce(const RVec& xi, const RVec& xj)
+{
+    const real c6     = 2.6e-3;
+    const real c12    = 2.6e-6;
+    const real qq     = 138.935 * 0.4 * -0.8;
+    const real krf    = 0.5;
+    const RVec dx     = xi - xj;
+    const real rInvSq = 1.0 / norm2(dx);
+    const real rInv   = std::sqrt(rInvSq);
+    const real rInv6  = rInvSq * rInvSq * rInvSq;
+    const real fScal  = (12 * c12 * rInv6 * rInv6 - 6 * c6 * rInv6) * rInvSq
+                       + qq * (rInv * rInvSq - 2 * krf);
+    return fScal * dx;
+}
+
+TEST(HaloCompression, PairForceErrorIsSmall)
+{
+    const std::vector<RVec> x             = generateHaloCoordinates(500);
+    const std::vector<RVec> xDecompressed = roundTrip(x);
+
+    // Compare the forces between local atoms just below the halo and the halo atoms
+    const real cutoffSq         = 1.0 * 1.0;
+    real       maxRelativeError = 0;
+    int        numPairs         = 0;
+    for (size_t i = 0; i < 100; i++)
+    {
+        const RVec xLocal = x[i] - RVec({ 0, 0, 0.3 });
+
+        RVec fExact      = { 0, 0, 0 };
+        RVec fCompressed = { 0, 0, 0 };
+        for (size_t j = 0; j < x.size(); j++)
+        {
+            const real rSq = distance2(xLocal, x[j]);
+            if (rSq < cutoffSq && rSq > 0.1)
+            {
+                fExact += pairForce(xLocal, x[j]);
+                fCompressed += pairForce(xLocal, xDecompressed[j]);
+                numPairs++;
+            }
+        }
+        const real fNorm = std::max(norm(fExact), real(1));
+        maxRelativeError = std::max(maxRelativeError, norm(fCompressed - fExact) / fNorm);
+    }
+
+    EXPECT_GT(numPairs, 0);
+    // 21 bits over a 6 nm extent gives a spacing of 3e-6 nm, so the relative
+    // force error is of the order of the position error relative to the distance
+    EXPECT_LT(maxRelativeError, 1e-4);
+}
+
+TEST(HaloCompression, ReducesMessageSize)
+{
+    const int numAtoms = 10000;
+
+    const size_t uncompressedBytes = numAtoms * sizeof(RVec);
+    const size_t compressedBytes   = compressedHaloCoordinatesSize(numAtoms) * sizeof(uint64_t);
+
+    EXPECT_EQ(compressedBytes, 8 * numAtoms + c_compressedHaloHeaderSize * sizeof(uint64_t));
+    // In mixed precision the coordinate messages shrink by a third, in double precision by two thirds
+    EXPECT_LT(compressedBytes, uncompressedBytes * (GMX_DOUBLE ? 0.34 : 0.68));
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
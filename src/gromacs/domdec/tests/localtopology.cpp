@@ -0,0 +1,261 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the assignment of bonded interactions in the local topology.
+ *
+ * \ingroup module_domdec
+ */
+#include "gmxpre.h"
+
+#include "gromacs/domdec/localtopology.h"
+
+#include <cstdint>
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/domdec/domdec_zones.h"
+#include "gromacs/domdec/ga2la.h"
+#include "gromacs/domdec/options.h"
+#include "gromacs/domdec/reversetopology.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
+#include "gromacs/topology/block.h"
+#include "gromacs/topology/idef.h"
+#include "gromacs/topology/ifunc.h"
+#include "gromacs/topology/topology.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/enumerationhelpers.h"
+#include "gromacs/utility/listoflists.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/vectypes.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! The number of atoms in the test molecule
+constexpr int c_numAtomsPerMolecule = 6;
+//! The number of atoms in each of the two update groups of the test molecule
+constexpr int c_numAtomsPerUpdateGroup = 3;
+//! The number of molecules in the test system
+constexpr int c_numMolecules = 40;
+
+/*! \brief Sets up \p mtop as a system of linear six-atom molecules with bonds and angles
+ *
+ * Each molecule consists of two update groups, the first and the last three atoms.
+ */
+void setupTopology(gmx_mtop_t* mtop)
+{
+    mtop->ffparams.functype = { InteractionFunction::Bonds, InteractionFunction::Angles };
+    mtop->ffparams.iparams.resize(mtop->ffparams.functype.size());
+
+    gmx_moltype_t moltype;
+    moltype.atoms.nr                                  = c_numAtomsPerMolecule;
+    moltype.ilist[InteractionFunction::Bonds].iatoms  = { 0, 0, 1, 0, 1, 2, 0, 2,
+                                                          3, 0, 3, 4, 0, 4, 5 };
+    moltype.ilist[InteractionFunction::Angles].iatoms = { 1, 0, 1, 2, 1, 1, 2, 3,
+                                                          1, 2, 3, 4, 1, 3, 4, 5 };
+    mtop->moltype.push_back(std::move(moltype));
+
+    gmx_molblock_t molblock;
+    molblock.type = 0;
+    molblock.nmol = c_numMolecules;
+    mtop->molblock.push_back(molblock);
+    mtop->natoms = c_numMolecules * c_numAtomsPerMolecule;
+}
+
+//! Returns the update grouping of the molecule set up by setupTopology()
+std::vector<RangePartitioning> makeUpdateGroupings()
+{
+    std::vector<RangePartitioning> updateGroupings(1);
+    for (int a = 0; a < c_numAtomsPerMolecule; a += c_numAtomsPerUpdateGroup)
+    {
+        updateGroupings[0].appendBlock(c_numAtomsPerUpdateGroup);
+    }
+    return updateGroupings;
+}
+
+//! Returns whether \p idef has an interaction assigned by an atom outside the home zone
+bool haveHaloInteractions(const InteractionDefinitions& idef, const DomdecZones& zones)
+{
+    const int homeAtomEnd = *zones.atomRange(0).end();
+    for (const auto ftype : EnumerationWrapper<InteractionFunction>{})
+    {
+        const auto& il   = idef.il[ftype];
+        const int   nral = NRAL(ftype);
+        for (int i = 0; i < il.size(); i += 1 + nral)
+        {
+            if (il.iatoms[i + 1] >= homeAtomEnd)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//! Test fixture, parametrized over the domain decomposition dimensions
+class LocalTopologyTest : public ::testing::TestWithParam<std::vector<int>>
+{
+public:
+    LocalTopologyTest() : previousNumThreads_(gmx_omp_nthreads_get(ModuleMultiThread::Domdec))
+    {
+        setupTopology(&mtop_);
+        // Use more than one thread, so we also check the reduction over threads
+        gmx_omp_nthreads_set(ModuleMultiThread::Domdec, 2);
+    }
+    ~LocalTopologyTest() override
+    {
+        gmx_omp_nthreads_set(ModuleMultiThread::Domdec, previousNumThreads_);
+    }
+
+    //! Returns the local bonded interactions for \p rt with the atom layout set up by the test
+    InteractionDefinitions makeLocalInteractions(const gmx_reverse_top_t& rt,
+                                                 const DomdecZones&       zones,
+                                                 ArrayRef<const int>      globalAtomIndices,
+                                                 const gmx_ga2la_t&       ga2la,
+                                                 int* numBondedInteractions) const
+    {
+        const std::vector<int32_t> atomInfo(globalAtomIndices.size(), 0);
+        const ivec                 rcheck = { FALSE, FALSE, FALSE };
+        InteractionDefinitions     idef(mtop_.ffparams);
+        ListOfLists<int>           excls;
+        *numBondedInteractions = make_local_bondeds_excls(rt,
+                                                          globalAtomIndices,
+                                                          ga2la,
+                                                          false,
+                                                          zones,
+                                                          mtop_,
+                                                          atomInfo,
+                                                          false,
+                                                          rcheck,
+                                                          false,
+                                                          0.0_real,
+                                                          nullptr,
+                                                          {},
+                                                          &idef,
+                                                          &excls);
+        return idef;
+    }
+
+    //! The number of threads for domdec at test setup
+    int previousNumThreads_;
+    //! The system topology
+    gmx_mtop_t mtop_;
+};
+
+TEST_P(LocalTopologyTest, UpdateGroupSkipGivesIdenticalInteractions)
+{
+    const std::vector<int>& ddDims = GetParam();
+    DomdecZones             zones(ddDims);
+
+    /* Distribute the update groups over the zones such that the two groups of
+     * the molecules are placed in all combinations of zones, including the same zone.
+     * With multiple zones, slot numZones() is used for groups not present on this domain.
+     */
+    const int        numSlots = (zones.numZones() == 1 ? 1 : zones.numZones() + 1);
+    std::vector<int> slotOfGroup;
+    for (int m = 0; m < c_numMolecules; m++)
+    {
+        slotOfGroup.push_back(m % numSlots);
+        slotOfGroup.push_back((m + m / numSlots) % numSlots);
+    }
+    std::vector<int> globalAtomIndices;
+    for (int zone = 0; zone < zones.numZones(); zone++)
+    {
+        for (int group = 0; group < gmx::ssize(slotOfGroup); group++)
+        {
+            if (slotOfGroup[group] == zone)
+            {
+                for (int a = 0; a < c_numAtomsPerUpdateGroup; a++)
+                {
+                    globalAtomIndices.push_back(group * c_numAtomsPerUpdateGroup + a);
+                }
+            }
+        }
+        zones.setAtomRangeEnd(zone, globalAtomIndices.size(), true);
+    }
+    gmx_ga2la_t ga2la(mtop_.natoms, globalAtomIndices.size());
+    for (int zone = 0; zone < zones.numZones(); zone++)
+    {
+        for (int a : zones.atomRange(zone))
+        {
+            ga2la.insert(globalAtomIndices[a], { a, zone });
+        }
+    }
+
+    const ReverseTopOptions              options(DDBondedChecking::All);
+    const std::vector<RangePartitioning> updateGroupings = makeUpdateGroupings();
+    const gmx_reverse_top_t              rtWithoutSkip(mtop_, false, options);
+    const gmx_reverse_top_t              rtWithSkip(mtop_, false, options, updateGroupings);
+    ASSERT_FALSE(rtWithSkip.interactionListForMoleculeType(0).linksUpdateGroups.empty())
+            << "The reverse topology should mark the atoms linking update groups";
+
+    int        numInteractionsWithoutSkip = 0;
+    int        numInteractionsWithSkip    = 0;
+    const auto idefWithoutSkip            = makeLocalInteractions(
+            rtWithoutSkip, zones, globalAtomIndices, ga2la, &numInteractionsWithoutSkip);
+    const auto idefWithSkip = makeLocalInteractions(
+            rtWithSkip, zones, globalAtomIndices, ga2la, &numInteractionsWithSkip);
+
+    EXPECT_GT(numInteractionsWithoutSkip, 0);
+    EXPECT_EQ(numInteractionsWithSkip, numInteractionsWithoutSkip);
+    if (zones.numZones() > 1)
+    {
+        EXPECT_TRUE(haveHaloInteractions(idefWithoutSkip, zones))
+                << "The test should cover interactions assigned in halo zones";
+    }
+    for (const auto ftype : EnumerationWrapper<InteractionFunction>{})
+    {
+        EXPECT_EQ(idefWithSkip.il[ftype].iatoms, idefWithoutSkip.il[ftype].iatoms)
+                << "Interaction lists differ for " << interaction_function[ftype].longname;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(WithZones,
+                         LocalTopologyTest,
+                         ::testing::Values(std::vector<int>{},
+                                           std::vector<int>{ XX },
+                                           std::vector<int>{ XX, YY },
+                                           std::vector<int>{ XX, YY, ZZ }));
+
+} // namespace
+} // namespace test
+} // namespace gmx
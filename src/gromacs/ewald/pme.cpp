@@ -792,6 +792,12 @@ gmx_pme_t* gmx_pme_init(const gmx_domdec_t*              dd,
     pme->ewaldcoeff_q  = ewaldcoeff_q;
     pme->ewaldcoeff_lj = ewaldcoeff_lj;
 
+    /* Slab-coloured spreading needs the complete FFT grid on this rank
+     * and at least two slabs of pme_order grid lines along x.
+     */
+    pme->useSlabColoredSpread = (pme->bUseThreads && pme->nnodes == 1 && pme->nkx >= 2 * pme->pme_order
+                                 && std::getenv("GMX_PME_SPREAD_COLORING") != nullptr);
+
     /* Always constant electrostatics coefficients */
     pme->epsilon_r = ir->epsilon_r;
 
@@ -1053,6 +1059,7 @@ void gmx_pme_reinit(struct gmx_pme_t**  pmedata,
                     struct gmx_pme_t*   pme_src,
                     const t_inputrec*   ir,
                     const ivec          grid_size,
+                    const int           pmeOrder,
                     real                ewaldcoeff_q,
                     real                ewaldcoeff_lj)
 {
@@ -1066,7 +1073,7 @@ void gmx_pme_reinit(struct gmx_pme_t**  pmedata,
     irc.coulombtype            = ir->coulombtype;
     irc.vdwtype                = ir->vdwtype;
     irc.efep                   = ir->efep;
-    irc.pme_order              = ir->pme_order;
+    irc.pme_order              = pmeOrder;
     irc.epsilon_r              = ir->epsilon_r;
     irc.ljpme_combination_rule = ir->ljpme_combination_rule;
     irc.nkx                    = grid_size[XX];
@@ -1137,7 +1144,7 @@ real gmx_pme_calc_energy(gmx_pme_t* pme, gmx::ArrayRef<const gmx::RVec> x, gmx::
     PmeAndFftGrids& grids = pme->gridsCoulomb[0];
 
     /* Only calculate the spline coefficients, don't actually spread */
-    spread_on_grid(pme, atc, &grids, true, false, false);
+    spread_on_grid(pme, atc, &grids, true, false, false, nullptr);
 
     return gather_energy_bsplines(*pme, grids.pmeGrids.grid.grid(), *atc);
 }
@@ -1286,7 +1293,7 @@ int gmx_pme_do(struct gmx_pme_t*              pme,
         wallcycle_start(wcycle, WallCycleCounter::PmeSpread);
 
         /* Spread the coefficients on a grid */
-        spread_on_grid(pme, &atc, &gridsRef.grids, bFirst, true, bDoSplines);
+        spread_on_grid(pme, &atc, &gridsRef.grids, bFirst, true, bDoSplines, wcycle);
 
         if (bFirst)
         {
@@ -1541,7 +1548,7 @@ int gmx_pme_do(struct gmx_pme_t*              pme,
 
                 wallcycle_start(wcycle, WallCycleCounter::PmeSpread);
                 /* Spread the c6 on a grid */
-                spread_on_grid(pme, &atc, &grids, bFirst, true, bDoSplines);
+                spread_on_grid(pme, &atc, &grids, bFirst, true, bDoSplines, wcycle);
 
                 if (bFirst)
                 {
@@ -1832,9 +1839,10 @@ void gmx_pme_reinit_atoms(gmx_pme_t*                pme,
     }
 }
 
-bool gmx_pme_grid_matches(const gmx_pme_t& pme, const ivec grid_size)
+bool gmx_pme_grid_matches(const gmx_pme_t& pme, const ivec grid_size, const int pmeOrder)
 {
-    return (pme.nkx == grid_size[XX] && pme.nky == grid_size[YY] && pme.nkz == grid_size[ZZ]);
+    return (pme.nkx == grid_size[XX] && pme.nky == grid_size[YY] && pme.nkz == grid_size[ZZ]
+            && pme.pme_order == pmeOrder);
 }
 
 void gmx::SeparatePmeRanksPermitted::disablePmeRanks(const std::string& reason)
@@ -152,8 +152,8 @@ int numGridLinesForExtendedHaloRegion(int pmeOrder, real haloExtentForAtomDispla
  */
 real getGridSpacingFromBox(const matrix box, const ivec gridDim);
 
-//! Return whether the grid of \c pme is identical to \c grid_size.
-bool gmx_pme_grid_matches(const gmx_pme_t& pme, const ivec grid_size);
+//! Return whether the grid of \c pme is identical to \c grid_size and uses order \c pmeOrder.
+bool gmx_pme_grid_matches(const gmx_pme_t& pme, const ivec grid_size, int pmeOrder);
 
 /*! \brief Check restrictions on pme_order and the PME grid nkx,nky,nkz.
  *
@@ -210,13 +210,14 @@ gmx_pme_t* gmx_pme_init(const gmx_domdec_t*              dd,
                         std::shared_ptr<PmeGridsStorage> pmeGridsStoragePtr);
 
 /*! \brief As gmx_pme_init, but takes most settings, except the grid/Ewald coefficients,
- * and the shared grid storage from pme_src.
+ * the interpolation order and the shared grid storage from pme_src.
  */
 void gmx_pme_reinit(gmx_pme_t**         pmedata,
                     const gmx_domdec_t* dd,
                     gmx_pme_t*          pme_src,
                     const t_inputrec*   ir,
                     const ivec          grid_size,
+                    int                 pmeOrder,
                     real                ewaldcoeff_q,
                     real                ewaldcoeff_lj);
 
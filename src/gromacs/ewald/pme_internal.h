@@ -53,6 +53,7 @@
 #include "config.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "gromacs/math/gmxcomplex.h"
@@ -275,6 +276,13 @@ public:
     FastVector<int>              thread_idx;
     std::vector<AtomToThreadMap> threadMap;
     std::vector<splinedata_t>    spline;
+
+    //! Atom counts per thread and x-slab, used with slab-coloured spreading
+    std::vector<int> slabAtomCount;
+    //! Start of the range in slabAtoms for each x-slab, used with slab-coloured spreading
+    std::vector<int> slabAtomStart;
+    //! The thread and index in the thread's spline data of atoms, sorted on x-slab
+    std::vector<std::pair<int, int>> slabAtoms;
 };
 
 /*! \brief Data structure for a single PME grid */
@@ -376,6 +384,10 @@ struct gmx_pme_t
 
     bool bUseThreads; /* Does any of the PME ranks have nthread>1 ?  */
     int  nthread;     /* The number of threads doing PME on our rank */
+    /* Spread directly on the FFT grid using alternating x-slabs, instead of
+     * spreading on thread-local grids and reducing their overlap afterwards
+     */
+    bool useSlabColoredSpread;
 
     bool simulationIsParallel; /* Whether more than one MPI rank is used for the simulation */
     bool haveDDAtomOrdering;   /* Whether atoms are ordered according to DD instead of global top */
@@ -44,8 +44,10 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 
 #include <algorithm>
+#include <optional>
 
 #include "gromacs/domdec/dlb.h"
 #include "gromacs/domdec/domdec.h"
@@ -80,27 +82,12 @@
 #include "gromacs/utility/vec.h"
 
 #include "pme_internal.h"
+#include "pme_load_balancing_setup.h"
 #include "pme_pp.h"
 
 namespace gmx
 {
 
-/*! \brief Parameters and settings for one PP-PME setup */
-struct pme_setup_t
-{
-    real rcut_coulomb;         /**< Coulomb cut-off                              */
-    real rlistOuter;           /**< cut-off for the outer pair-list              */
-    real rlistInner;           /**< cut-off for the inner pair-list              */
-    real spacing;              /**< (largest) PME grid spacing                   */
-    ivec grid;                 /**< the PME grid dimensions                      */
-    real grid_efficiency;      /**< ineffiency factor for non-uniform grids <= 1 */
-    real ewaldcoeff_q;         /**< Electrostatic Ewald coefficient            */
-    real ewaldcoeff_lj;        /**< LJ Ewald coefficient, only for the call to send_switchgrid */
-    struct gmx_pme_t* pmedata; /**< the data structure used in the PME code      */
-    int               count;   /**< number of times this setup has been timed    */
-    double            cycles;  /**< the fastest time for this setup in cycles    */
-};
-
 /*! \brief After 50 nstlist periods of not observing imbalance: never tune PME */
 const int PMETunePeriod = 50;
 /*! \brief Trigger PME load balancing at more than 5% PME overload */
@@ -140,6 +127,8 @@ const int c_numFirstTuningIntervalSkipWithSepPme = 3;
 const int c_numPostSwitchTuningIntervalSkip = 1;
 //! \brief Number of seconds to delay the tuning at startup to allow processors clocks to ramp up.
 const double c_startupTimeDelay = 5.0;
+//! \brief Number of timings of the higher PME interpolation order setup.
+const int c_numPmeOrderTimings = 2;
 
 /*! \brief Enumeration whose values describe the effect limiting the load balancing */
 enum class PmeLoadBalancingLimit : int
@@ -231,6 +220,16 @@ public:
     //! Attempts to increase the cutoff, returns true when a setup has been added to the list
     bool increaseCutoff();
 
+    /*! \brief Attempts to add a variant of the fastest setup with PME order + 1 and a coarser grid
+     *
+     * The Coulomb cut-off and Ewald coefficient are not changed. The grid spacing
+     * is increased such that the reciprocal space error stays roughly constant.
+     *
+     * \returns the index of the added setup, which is inserted in order of cut-off,
+     *          or std::nullopt when no setup was added
+     */
+    std::optional<int> addHigherPmeOrderSetup();
+
     /*! \brief Switch load balancing to stage 1
      *
      * In this stage, only sufficiently fast setups are run again.
@@ -258,6 +257,12 @@ public:
                  gmx_pme_t**          pmedata,
                  int64_t              step);
 
+    //! Applies the current setup to \p ic, \p nbv and \p pmedata
+    void applyCurrentSetup(FILE*                fp_err,
+                           interaction_const_t* ic,
+                           nonbonded_verlet_t*  nbv,
+                           gmx_pme_t**          pmedata);
+
     /*! \brief Prepare for another round of PME load balancing
      *
      * \param[in]     dlbWasUnlocked  Pass true when DLB was locked and is now unlocked
@@ -282,11 +287,13 @@ private:
     const bool haveSepPMERanks_;          /**< do we have separate PME ranks? */
     const bool useGpuForNonbondeds_;      /**< do we use a GPU for, at least, the non-bondes? */
     const bool useGpuPmePpCommunication_; /**< do we perform PME-PP communication on GPUs? */
+    const bool tunePmeOrder_;             /**< do we also try PME order 5 with a coarser grid? */
 
     bool    isActive_;        /**< is PME tuning active? */
     int64_t stepRelStop_;     /**< stop the tuning after this value of step_rel */
     bool    triggerOnDLB_;    /**< trigger balancing only on DD DLB */
     bool isInBalancingPhase_; /**< are we in the balancing phase, i.e. trying different setups? */
+    bool isTimingPmeOrder_;   /**< are we timing the higher PME order setup? */
     int  numStages_;          /**< the current maximum number of stages */
     bool startupTimeDelayElapsed_; /**< Has the c_startupTimeDelay elapsed indicating that the balancing can start. */
 
@@ -367,7 +374,14 @@ PmeLoadBalancing::Impl::Impl(gmx_domdec_t*              dd,
     haveSepPMERanks_(simulationWork.haveSeparatePmeRank),
     useGpuForNonbondeds_(simulationWork.useGpuNonbonded),
     useGpuPmePpCommunication_(simulationWork.useGpuPmePpCommunication),
+    /* Only PME orders 4 and 5 have SIMD acceleration and GPUs only support order 4.
+     * The accuracy estimate for the coarser grid only considers Coulomb.
+     */
+    tunePmeOrder_(ir.pme_order == 4 && ir.coulombtype == CoulombInteractionType::Pme
+                  && !usingLJPme(ir.vdwtype) && !simulationWork.useGpuPme
+                  && getenv("GMX_PME_TUNE_ORDER") != nullptr),
     isActive_(true),
+    isTimingPmeOrder_(false),
     cutoffs_(getCutoffs(ir, box, ic, nbv)),
     ir_(ir),
     dd_(*dd),
@@ -396,9 +410,12 @@ PmeLoadBalancing::Impl::Impl(gmx_domdec_t*              dd,
     setups_[0].grid[XX]      = ir.nkx;
     setups_[0].grid[YY]      = ir.nky;
     setups_[0].grid[ZZ]      = ir.nkz;
+    setups_[0].pmeOrder      = ir.pme_order;
     setups_[0].ewaldcoeff_q  = ic.coulomb.ewaldCoeff;
     setups_[0].ewaldcoeff_lj = ic.vdw.ewaldCoeff;
 
+    setups_[0].triedHigherPmeOrder = false;
+
     if (!haveSepPMERanks_)
     {
         GMX_RELEASE_ASSERT(pmedata, "On ranks doing both PP and PME we need a valid pmedata object");
@@ -548,7 +565,8 @@ bool PmeLoadBalancing::Impl::increaseCutoff()
     set.rlistInner = std::max(set.rcut_coulomb + cutoffs_.rbufInner_coulomb,
                               cutoffs_.rcut_vdw + cutoffs_.rbufInner_vdw);
 
-    set.spacing = sp;
+    set.spacing  = sp;
+    set.pmeOrder = ir_.pme_order;
     /* The grid efficiency is the size wrt a grid with uniform x/y/z spacing */
     set.grid_efficiency = 1;
     for (int d = 0; d < DIM; d++)
@@ -563,6 +581,8 @@ bool PmeLoadBalancing::Impl::increaseCutoff()
     set.count  = 0;
     set.cycles = 0;
 
+    set.triedHigherPmeOrder = false;
+
     if (debug)
     {
         fprintf(debug,
@@ -578,6 +598,107 @@ bool PmeLoadBalancing::Impl::increaseCutoff()
     return true;
 }
 
+int insertSetupOrderedOnCutoff(std::vector<pme_setup_t>* setups, const pme_setup_t& setup)
+{
+    const auto position = std::upper_bound(
+            setups->begin(), setups->end(), setup, [](const pme_setup_t& a, const pme_setup_t& b) {
+                return a.rcut_coulomb < b.rcut_coulomb;
+            });
+
+    return std::distance(setups->begin(), setups->insert(position, setup));
+}
+
+std::optional<int> PmeLoadBalancing::Impl::addHigherPmeOrderSetup()
+{
+    pme_setup_t& baseSetup = setups_[fastestSetup_];
+
+    if (!tunePmeOrder_ || baseSetup.pmeOrder != ir_.pme_order || baseSetup.triedHigherPmeOrder)
+    {
+        return std::nullopt;
+    }
+    baseSetup.triedHigherPmeOrder = true;
+
+    pme_setup_t set = baseSetup;
+
+    set.pmedata  = nullptr;
+    set.pmeOrder = baseSetup.pmeOrder + 1;
+
+    /* The B-spline interpolation error scales roughly as (beta h)^order,
+     * with beta the Ewald coefficient and h the grid spacing. Requiring
+     * (beta h')^(order + 1) = (beta h)^order gives the spacing scaling below,
+     * which is about 1.2 for common settings.
+     */
+    const real spacingScaling = std::pow(baseSetup.ewaldcoeff_q * baseSetup.spacing,
+                                         static_cast<real>(-1) / set.pmeOrder);
+
+    clear_ivec(set.grid);
+    set.spacing = calcFftGrid(nullptr,
+                              cutoffs_.startBox,
+                              spacingScaling * baseSetup.spacing,
+                              minimalPmeGridSize(set.pmeOrder),
+                              &set.grid[XX],
+                              &set.grid[YY],
+                              &set.grid[ZZ]);
+
+    /* The higher order only pays off with a grid with fewer points */
+    if (numPmeGridPoints(set) >= numPmeGridPoints(baseSetup))
+    {
+        return std::nullopt;
+    }
+
+    /* Same conservative check as in increaseCutoff() */
+    const NumPmeDomains numPmeDomains = getNumPmeDomains(&dd_);
+    if (!gmx_pme_check_restrictions(set.pmeOrder,
+                                    set.grid[XX],
+                                    set.grid[YY],
+                                    set.grid[ZZ],
+                                    numPmeDomains.x,
+                                    numPmeDomains.y,
+                                    0,
+                                    false,
+                                    true,
+                                    false))
+    {
+        return std::nullopt;
+    }
+
+    set.grid_efficiency = 1;
+    for (int d = 0; d < DIM; d++)
+    {
+        set.grid_efficiency *= (set.grid[d] * set.spacing) / norm(cutoffs_.startBox[d]);
+    }
+
+    set.count  = 0;
+    set.cycles = 0;
+
+    if (debug)
+    {
+        fprintf(debug,
+                "PME loadbal: grid %d %d %d, pme order %d, coulomb cutoff %f\n",
+                set.grid[XX],
+                set.grid[YY],
+                set.grid[ZZ],
+                set.pmeOrder,
+                set.rcut_coulomb);
+    }
+
+    /* Keep the list ordered on cut-off, as the setup ranges and limits assume that */
+    const int index = insertSetupOrderedOnCutoff(&setups_, set);
+    for (int* setupIndex : { &currentSetup_, &fastestSetup_, &lowerLimit_, &startSetup_ })
+    {
+        if (*setupIndex >= index)
+        {
+            (*setupIndex)++;
+        }
+    }
+    if (endSetup_ >= index)
+    {
+        endSetup_++;
+    }
+
+    return index;
+}
+
 /*! \brief Print the PME grid */
 static void printGrid(FILE*              fp_err,
                       const MDLogger&    mdlog,
@@ -586,12 +707,13 @@ static void printGrid(FILE*              fp_err,
                       const pme_setup_t& set,
                       double             cycles)
 {
-    auto buf = formatString("%-11s%10s pme grid %d %d %d, coulomb cutoff %.3f",
+    auto buf = formatString("%-11s%10s pme grid %d %d %d, order %d, coulomb cutoff %.3f",
                             pre,
                             desc,
                             set.grid[XX],
                             set.grid[YY],
                             set.grid[ZZ],
+                            set.pmeOrder,
                             set.rcut_coulomb);
     if (cycles >= 0)
     {
@@ -714,8 +836,14 @@ static void applySetup(pme_setup_t*         setup,
         {
             gmx_pme_t* newPmeData;
             // Generate a new PME data structure, copying part of the old pointers.
-            gmx_pme_reinit(
-                    &newPmeData, dd, pmedataOfSetup0, &ir, setup->grid, setup->ewaldcoeff_q, setup->ewaldcoeff_lj);
+            gmx_pme_reinit(&newPmeData,
+                           dd,
+                           pmedataOfSetup0,
+                           &ir,
+                           setup->grid,
+                           setup->pmeOrder,
+                           setup->ewaldcoeff_q,
+                           setup->ewaldcoeff_lj);
             // Destroy the old structure. Must be done after gmx_pme_reinit in case currenSetup_==0.
             if (setup->pmedata != nullptr)
             {
@@ -727,7 +855,8 @@ static void applySetup(pme_setup_t*         setup,
     else
     {
         /* Tell our PME-only rank to switch grid */
-        gmx_pme_send_switchgrid(*dd, setup->grid, setup->ewaldcoeff_q, setup->ewaldcoeff_lj);
+        gmx_pme_send_switchgrid(
+                *dd, setup->grid, setup->pmeOrder, setup->ewaldcoeff_q, setup->ewaldcoeff_lj);
     }
 }
 
@@ -820,8 +949,12 @@ void PmeLoadBalancing::Impl::balance(FILE*                fp_err,
         return;
     }
 
-    const bool increaseNumStages = processCycles(
-            fp_err, mdlog_, cycles, step, stage_ == numStages_ - 1, &setups_[currentSetup_]);
+    const bool increaseNumStages = processCycles(fp_err,
+                                                 mdlog_,
+                                                 cycles,
+                                                 step,
+                                                 stage_ == numStages_ - 1 && !isTimingPmeOrder_,
+                                                 &setups_[currentSetup_]);
 
     if (increaseNumStages)
     {
@@ -851,6 +984,22 @@ void PmeLoadBalancing::Impl::balance(FILE*                fp_err,
     }
     const double cyclesFastest = setups_[fastestSetup_].cycles;
 
+    if (isTimingPmeOrder_)
+    {
+        const int numIntervals = c_numPmeOrderTimings * (c_numPostSwitchTuningIntervalSkip + 1);
+        if (setups_[currentSetup_].count >= numIntervals)
+        {
+            /* We are done timing the higher order, use the fastest setup we found */
+            isTimingPmeOrder_ = false;
+            stage_            = numStages_;
+            currentSetup_     = fastestSetup_;
+        }
+
+        applyCurrentSetup(fp_err, ic, nbv, pmedata);
+
+        return;
+    }
+
     /* Check in stage 0 if we should stop scanning grids.
      * Stop when the time is more than maxRelativeSlowDownAccepted longer than the fastest.
      */
@@ -1001,7 +1150,7 @@ void PmeLoadBalancing::Impl::balance(FILE*                fp_err,
                  */
                 stage_--;
             }
-            if (currentSetup_ <= fastestSetup_)
+            if (setups_[currentSetup_].rlistOuter <= setups_[fastestSetup_].rlistOuter)
             {
                 /* This should not happen, as we set limits on the DLB bounds.
                  * But we implement a complete failsafe solution anyhow.
@@ -1023,9 +1172,30 @@ void PmeLoadBalancing::Impl::balance(FILE*                fp_err,
         }
     }
 
+    if (stage_ == numStages_)
+    {
+        if (const std::optional<int> higherPmeOrderSetup = addHigherPmeOrderSetup())
+        {
+            /* Time the fastest setup with a higher PME order and a coarser grid.
+             * Its cut-off is identical, so there are no DD limitations to check.
+             */
+            isTimingPmeOrder_ = true;
+            stage_            = numStages_ - 1;
+            currentSetup_     = higherPmeOrderSetup.value();
+        }
+    }
+
+    applyCurrentSetup(fp_err, ic, nbv, pmedata);
+}
+
+void PmeLoadBalancing::Impl::applyCurrentSetup(FILE*                fp_err,
+                                               interaction_const_t* ic,
+                                               nonbonded_verlet_t*  nbv,
+                                               gmx_pme_t**          pmedata)
+{
     pme_setup_t& setup = setups_[currentSetup_];
 
-    /* Change the Coulomb cut-off and the PME grid */
+    /* Change the Coulomb cut-off, the PME grid and the PME order */
     applySetup(&setup, setups_[0].pmedata, ir_, ic, nbv, &dd_);
 
     if (!haveSepPMERanks_)
@@ -1212,13 +1382,14 @@ void PmeLoadBalancing::Impl::addCycles(FILE*                fp_err,
 static void printLoadBalSetup(const MDLogger& mdlog, const char* name, const pme_setup_t& setup)
 {
     GMX_LOG(mdlog.info)
-            .appendTextFormatted("   %-7s %6.3f nm %6.3f nm     %3d %3d %3d   %5.3f nm  %5.3f nm",
+            .appendTextFormatted("   %-7s %6.3f nm %6.3f nm     %3d %3d %3d  %2d   %5.3f nm  %5.3f nm",
                                  name,
                                  setup.rcut_coulomb,
                                  setup.rlistInner,
                                  setup.grid[XX],
                                  setup.grid[YY],
                                  setup.grid[ZZ],
+                                 setup.pmeOrder,
                                  setup.spacing,
                                  1 / setup.ewaldcoeff_q);
 }
@@ -1264,7 +1435,7 @@ static void printLoadBalSettings(const PmeLoadBalancingLimit limited,
                     " PP/PME load balancing changed the cut-off and PME settings:\n"
                     "           particle-particle                    PME\n"
 
-                    "            rcoulomb  rlist            grid      spacing   1/beta");
+                    "            rcoulomb  rlist            grid order   spacing   1/beta");
     printLoadBalSetup(mdlog, "initial", originalSetup);
     printLoadBalSetup(mdlog, "final", currentSetup);
     GMX_LOG(mdlog.info).appendTextFormatted(" cost-ratio           %4.2f             %4.2f", pp_ratio, grid_ratio);
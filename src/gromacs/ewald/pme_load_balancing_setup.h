@@ -0,0 +1,83 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ *
+ * \brief This file declares the setups that PME load balancing switches between
+ *
+ * \ingroup module_ewald
+ */
+#ifndef GMX_EWALD_PME_LOAD_BALANCING_SETUP_H
+#define GMX_EWALD_PME_LOAD_BALANCING_SETUP_H
+
+#include <vector>
+
+#include "gromacs/utility/vectypes.h"
+#include "gromacs/utility/real.h"
+
+struct gmx_pme_t;
+
+namespace gmx
+{
+
+/*! \internal \brief Parameters and settings for one PP-PME setup */
+struct pme_setup_t
+{
+    real rcut_coulomb;         /**< Coulomb cut-off                              */
+    real rlistOuter;           /**< cut-off for the outer pair-list              */
+    real rlistInner;           /**< cut-off for the inner pair-list              */
+    real spacing;              /**< (largest) PME grid spacing                   */
+    ivec grid;                 /**< the PME grid dimensions                      */
+    int  pmeOrder;             /**< the PME interpolation order                  */
+    real grid_efficiency;      /**< ineffiency factor for non-uniform grids <= 1 */
+    real ewaldcoeff_q;         /**< Electrostatic Ewald coefficient            */
+    real ewaldcoeff_lj;        /**< LJ Ewald coefficient, only for the call to send_switchgrid */
+    struct gmx_pme_t* pmedata; /**< the data structure used in the PME code      */
+    int               count;   /**< number of times this setup has been timed    */
+    double            cycles;  /**< the fastest time for this setup in cycles    */
+    bool triedHigherPmeOrder;  /**< whether a higher order setup has been added  */
+};
+
+/*! \brief Inserts \p setup into \p setups, which is ordered on Coulomb cut-off
+ *
+ * The setup is inserted after all setups with a cut-off shorter than or equal to
+ * that of \p setup. Thus the setup range and limit logic of the load balancing,
+ * which assumes that the cut-off increases with the index, remains valid.
+ *
+ * \returns the index of the inserted setup
+ */
+int insertSetupOrderedOnCutoff(std::vector<pme_setup_t>* setups, const pme_setup_t& setup);
+
+} // namespace gmx
+
+#endif
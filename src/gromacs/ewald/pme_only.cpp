@@ -194,6 +194,7 @@ static void reset_pmeonly_counters(gmx_wallcycle*            wcycle,
 
 static gmx_pme_t* gmx_pmeonly_switch(std::vector<gmx_pme_t*>* pmedata,
                                      const ivec               grid_size,
+                                     const int                pmeOrder,
                                      real                     ewaldcoeff_q,
                                      real                     ewaldcoeff_lj,
                                      const gmx_domdec_t&      dd,
@@ -203,7 +204,7 @@ static gmx_pme_t* gmx_pmeonly_switch(std::vector<gmx_pme_t*>* pmedata,
     for (auto& pme : *pmedata)
     {
         GMX_ASSERT(pme, "Bad PME tuning list element pointer");
-        if (gmx_pme_grid_matches(*pme, grid_size))
+        if (gmx_pme_grid_matches(*pme, grid_size, pmeOrder))
         {
             /* Here we have found an existing PME data structure that suits us.
              * However, in the GPU case, we have to reinitialize it - there's only one GPU structure.
@@ -212,7 +213,7 @@ static gmx_pme_t* gmx_pmeonly_switch(std::vector<gmx_pme_t*>* pmedata,
              * TODO: this should be something like gmx_pme_update_split_params()
              */
             gmx_pme_t* pmeNew;
-            gmx_pme_reinit(&pmeNew, &dd, pme, ir, grid_size, ewaldcoeff_q, ewaldcoeff_lj);
+            gmx_pme_reinit(&pmeNew, &dd, pme, ir, grid_size, pmeOrder, ewaldcoeff_q, ewaldcoeff_lj);
             gmx_pme_destroy(pme, false);
             pme = pmeNew;
             return pmeNew;
@@ -222,7 +223,7 @@ static gmx_pme_t* gmx_pmeonly_switch(std::vector<gmx_pme_t*>* pmedata,
     const auto& pme          = pmedata->back();
     gmx_pme_t*  newStructure = nullptr;
     // Copy last structure with new grid params
-    gmx_pme_reinit(&newStructure, &dd, pme, ir, grid_size, ewaldcoeff_q, ewaldcoeff_lj);
+    gmx_pme_reinit(&newStructure, &dd, pme, ir, grid_size, pmeOrder, ewaldcoeff_q, ewaldcoeff_lj);
     pmedata->push_back(newStructure);
     return newStructure;
 }
@@ -243,6 +244,7 @@ static gmx_pme_t* gmx_pmeonly_switch(std::vector<gmx_pme_t*>* pmedata,
  * \param[out] stepWork               The workload of this simulation step
  * \param[out] step                   MD integration step number.
  * \param[out] grid_size              PME grid size, if received.
+ * \param[out] pmeOrder               PME interpolation order, if received.
  * \param[out] ewaldcoeff_q           Ewald cut-off parameter for electrostatics, if received.
  * \param[out] ewaldcoeff_lj          Ewald cut-off parameter for Lennard-Jones, if received.
  * \param[in]  useGpuForPme           Flag on whether PME is on GPU.
@@ -254,7 +256,7 @@ static gmx_pme_t* gmx_pmeonly_switch(std::vector<gmx_pme_t*>* pmedata,
  *
  * \retval pmerecvqxX                 All parameters were set, chargeA and chargeB can be NULL.
  * \retval pmerecvqxFINISH            No parameters were set.
- * \retval pmerecvqxSWITCHGRID        Only grid_size and *ewaldcoeff were set.
+ * \retval pmerecvqxSWITCHGRID        Only grid_size, pmeOrder and *ewaldcoeff were set.
  * \retval pmerecvqxRESETCOUNTERS     *step was set.
  */
 static int gmx_pme_recv_coeffs_coords(struct gmx_pme_t*            pme,
@@ -268,6 +270,7 @@ static int gmx_pme_recv_coeffs_coords(struct gmx_pme_t*            pme,
                                       gmx::StepWorkload*           stepWork,
                                       int64_t*                     step,
                                       ivec*                        grid_size,
+                                      int*                         pmeOrder,
                                       real*                        ewaldcoeff_q,
                                       real*                        ewaldcoeff_lj,
                                       bool                         useGpuForPme,
@@ -321,6 +324,7 @@ static int gmx_pme_recv_coeffs_coords(struct gmx_pme_t*            pme,
         {
             /* Special case, receive the new parameters and return */
             copy_ivec(cnb.grid_size, *grid_size);
+            *pmeOrder      = cnb.pmeOrder;
             *ewaldcoeff_q  = cnb.ewaldcoeff_q;
             *ewaldcoeff_lj = cnb.ewaldcoeff_lj;
 
@@ -559,6 +563,7 @@ static int gmx_pme_recv_coeffs_coords(struct gmx_pme_t*            pme,
     GMX_UNUSED_VALUE(stepWork);
     GMX_UNUSED_VALUE(step);
     GMX_UNUSED_VALUE(grid_size);
+    GMX_UNUSED_VALUE(pmeOrder);
     GMX_UNUSED_VALUE(ewaldcoeff_q);
     GMX_UNUSED_VALUE(ewaldcoeff_lj);
     GMX_UNUSED_VALUE(useGpuForPme);
@@ -783,6 +788,7 @@ int gmx_pmeonly(struct gmx_pme_t**              pmeFromRunnerPtr,
         {
             /* Domain decomposition */
             ivec newGridSize;
+            int  newPmeOrder  = 0;
             real ewaldcoeff_q = 0, ewaldcoeff_lj = 0;
             ret = gmx_pme_recv_coeffs_coords(pme,
                                              pme_pp.get(),
@@ -795,6 +801,7 @@ int gmx_pmeonly(struct gmx_pme_t**              pmeFromRunnerPtr,
                                              &stepWork,
                                              &step,
                                              &newGridSize,
+                                             &newPmeOrder,
                                              &ewaldcoeff_q,
                                              &ewaldcoeff_lj,
                                              useGpuForPme,
@@ -805,8 +812,9 @@ int gmx_pmeonly(struct gmx_pme_t**              pmeFromRunnerPtr,
 
             if (ret == pmerecvqxSWITCHGRID)
             {
-                /* Switch the PME grid to newGridSize */
-                pme = gmx_pmeonly_switch(&pmedata, newGridSize, ewaldcoeff_q, ewaldcoeff_lj, dd, ir);
+                /* Switch the PME grid to newGridSize and the order to newPmeOrder */
+                pme = gmx_pmeonly_switch(
+                        &pmedata, newGridSize, newPmeOrder, ewaldcoeff_q, ewaldcoeff_lj, dd, ir);
             }
 
             if (ret == pmerecvqxRESETCOUNTERS)
@@ -447,7 +447,11 @@ void gmx_pme_send_finish(gmx_domdec_t* dd)
                                nullptr);
 }
 
-void gmx_pme_send_switchgrid(const gmx_domdec_t& dd, ivec grid_size, real ewaldcoeff_q, real ewaldcoeff_lj)
+void gmx_pme_send_switchgrid(const gmx_domdec_t& dd,
+                             ivec                grid_size,
+                             int                 pmeOrder,
+                             real                ewaldcoeff_q,
+                             real                ewaldcoeff_lj)
 {
 #if GMX_MPI
     gmx_pme_comm_n_box_t cnb;
@@ -457,6 +461,7 @@ void gmx_pme_send_switchgrid(const gmx_domdec_t& dd, ivec grid_size, real ewaldc
     {
         cnb.flags = PP_PME_SWITCHGRID;
         copy_ivec(grid_size, cnb.grid_size);
+        cnb.pmeOrder      = pmeOrder;
         cnb.ewaldcoeff_q  = ewaldcoeff_q;
         cnb.ewaldcoeff_lj = ewaldcoeff_lj;
 
@@ -466,6 +471,7 @@ void gmx_pme_send_switchgrid(const gmx_domdec_t& dd, ivec grid_size, real ewaldc
 #else
     GMX_UNUSED_VALUE(dd);
     GMX_UNUSED_VALUE(grid_size);
+    GMX_UNUSED_VALUE(pmeOrder);
     GMX_UNUSED_VALUE(ewaldcoeff_q);
     GMX_UNUSED_VALUE(ewaldcoeff_lj);
 #endif
@@ -114,7 +114,11 @@ void gmx_pme_receive_f(gmx::PmePpCommGpu*    pmePpCommGpu,
                        bool                  receivePmeForceToGpu,
                        float*                pme_cycles);
 
-/*! \brief Tell our PME-only node to switch to a new grid size */
-void gmx_pme_send_switchgrid(const gmx_domdec_t& dd, ivec grid_size, real ewaldcoeff_q, real ewaldcoeff_lj);
+/*! \brief Tell our PME-only node to switch to a new grid size and interpolation order */
+void gmx_pme_send_switchgrid(const gmx_domdec_t& dd,
+                             ivec                grid_size,
+                             int                 pmeOrder,
+                             real                ewaldcoeff_q,
+                             real                ewaldcoeff_lj);
 
 #endif
@@ -126,6 +126,7 @@ struct gmx_pme_comm_n_box_t
     //@{
     /*! \brief Used in PME grid tuning */
     ivec grid_size;
+    int  pmeOrder;
     real ewaldcoeff_q;
     real ewaldcoeff_lj;
     //@}
@@ -40,14 +40,18 @@
 #include <cassert>
 
 #include <algorithm>
+#include <array>
+#include <vector>
 
 #include "gromacs/ewald/pme.h"
 #include "gromacs/fft/parallel_3dfft.h"
 #include "gromacs/simd/simd.h"
+#include "gromacs/timing/wallcycle.h"
 #include "gromacs/utility/basedefinitions.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/gmxomp.h"
 
 #include "pme_grid.h"
 #include "pme_internal.h"
@@ -264,6 +268,79 @@ static void make_thread_local_ind(const PmeAtomComm* atc, int thread, splinedata
         }                                                                                        \
     }
 
+#ifdef PME_SIMD4_SPREAD_GATHER
+/*! \brief Computes the B-spline coefficients and derivatives for one atom using SIMD4
+ *
+ * The recursion is identical for the three dimensions, so these are computed
+ * simultaneously in the first three elements of 4-wide SIMD registers.
+ */
+template<int order>
+static inline void calcSplineSimd4(gmx::ArrayRef<real*> theta,
+                                   gmx::ArrayRef<real*> dtheta,
+                                   const real*          xptr,
+                                   const int            i)
+{
+    using namespace gmx;
+
+    alignas(GMX_SIMD_ALIGNMENT) real drBuffer[GMX_SIMD4_WIDTH] = { xptr[XX], xptr[YY], xptr[ZZ], 0 };
+    alignas(GMX_SIMD_ALIGNMENT) real thetaBuffer[order * GMX_SIMD4_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real dthetaBuffer[order * GMX_SIMD4_WIDTH];
+
+    const Simd4Real one(1.0_real);
+    const Simd4Real dr = load4(drBuffer);
+
+    std::array<Simd4Real, order> data;
+
+    /* dr is relative offset from lower cell limit */
+    data[order - 1] = setZero();
+    data[1]         = dr;
+    data[0]         = one - dr;
+
+    for (int k = 3; k < order; k++)
+    {
+        const Simd4Real div(1.0_real / (k - 1.0_real));
+        data[k - 1] = div * dr * data[k - 2];
+        for (int l = 1; l < (k - 1); l++)
+        {
+            data[k - l - 1] = div
+                              * ((dr + Simd4Real(l)) * data[k - l - 2]
+                                 + (Simd4Real(k - l) - dr) * data[k - l - 1]);
+        }
+        data[0] = div * (one - dr) * data[0];
+    }
+    /* differentiate */
+    store4(dthetaBuffer, -data[0]);
+    for (int k = 1; k < order; k++)
+    {
+        store4(dthetaBuffer + k * GMX_SIMD4_WIDTH, data[k - 1] - data[k]);
+    }
+
+    const Simd4Real div(1.0_real / (order - 1));
+    data[order - 1] = div * dr * data[order - 2];
+    for (int l = 1; l < (order - 1); l++)
+    {
+        data[order - l - 1] =
+                div
+                * ((dr + Simd4Real(l)) * data[order - l - 2] + (Simd4Real(order - l) - dr) * data[order - l - 1]);
+    }
+    data[0] = div * (one - dr) * data[0];
+
+    for (int k = 0; k < order; k++)
+    {
+        store4(thetaBuffer + k * GMX_SIMD4_WIDTH, data[k]);
+    }
+
+    for (int j = 0; j < DIM; j++)
+    {
+        for (int k = 0; k < order; k++)
+        {
+            theta[j][i * order + k]  = thetaBuffer[k * GMX_SIMD4_WIDTH + j];
+            dtheta[j][i * order + k] = dthetaBuffer[k * GMX_SIMD4_WIDTH + j];
+        }
+    }
+}
+#endif
+
 static void make_bsplines(gmx::ArrayRef<real*> theta,
                           gmx::ArrayRef<real*> dtheta,
                           int                  order,
@@ -290,8 +367,13 @@ static void make_bsplines(gmx::ArrayRef<real*> theta,
             assert(order >= 3 && order <= PME_ORDER_MAX);
             switch (order)
             {
+#ifdef PME_SIMD4_SPREAD_GATHER
+                case 4: calcSplineSimd4<4>(theta, dtheta, xptr, i); break;
+                case 5: calcSplineSimd4<5>(theta, dtheta, xptr, i); break;
+#else
                 case 4: CALC_SPLINE(4) break;
                 case 5: CALC_SPLINE(5) break;
+#endif
                 default: CALC_SPLINE(order) break;
             }
         }
@@ -890,12 +972,225 @@ static void sum_fftgrid_dd(const gmx_pme_t* pme, PmeAndFftGrids* grids)
     }
 }
 
+/*! \brief Spreads the coefficient of one atom on a periodic grid
+ *
+ * The grid index wrapping is done through lookup tables for the indices
+ * i0 + ithx etc., which extend beyond the grid size by order - 1.
+ * This function is always inlined, so when called with a constant value
+ * for \p order all loops can be unrolled.
+ */
+static inline void spreadCoefficientOnWrappedGrid(real* gmx_restrict grid,
+                                                  const int          gridSizeY,
+                                                  const int          gridSizeZ,
+                                                  const int*         wrapX,
+                                                  const int*         wrapY,
+                                                  const int*         wrapZ,
+                                                  const int*         idxptr,
+                                                  const real         coefficient,
+                                                  const real*        thx,
+                                                  const real*        thy,
+                                                  const real*        thz,
+                                                  const int          order)
+{
+    for (int ithx = 0; ithx < order; ithx++)
+    {
+        const int  indexX = wrapX[idxptr[XX] + ithx] * gridSizeY;
+        const real valx   = coefficient * thx[ithx];
+
+        for (int ithy = 0; ithy < order; ithy++)
+        {
+            const int  indexXY = (indexX + wrapY[idxptr[YY] + ithy]) * gridSizeZ;
+            const real valxy   = valx * thy[ithy];
+
+            for (int ithz = 0; ithz < order; ithz++)
+            {
+                grid[indexXY + wrapZ[idxptr[ZZ] + ithz]] += valxy * thz[ithz];
+            }
+        }
+    }
+}
+
+/*! \brief Spreads all coefficients directly on the FFT grid, using slabs along x colored by parity
+ *
+ * The grid is divided along x in an even number of slabs with at least pme_order
+ * grid lines each. Each atom is assigned to the slab containing its first spline
+ * grid line. The spreading stencil of an atom then only overlaps with the slab
+ * after its own, also over the periodic boundary. So all even slabs can be spread
+ * simultaneously by different threads, followed by all odd slabs. This avoids
+ * thread-local grids and the reduction of their overlap, which does not scale
+ * to large numbers of threads.
+ *
+ * Requires that the spline coefficients have been computed in atc->spline
+ * and that the complete FFT grid is present on this rank.
+ */
+static void spreadOnFftGridSlabColored(const gmx_pme_t* pme, PmeAtomComm* atc, PmeAndFftGrids* grids)
+{
+    const int nthread = pme->nthread;
+    const int order   = pme->pme_order;
+    const int nx      = pme->nkx;
+    const int ny      = pme->nky;
+    const int nz      = pme->nkz;
+
+    ivec localFftNData, localFftOffset, localFftSize;
+    gmx_parallel_3dfft_real_limits(grids->pfft_setup.get(), localFftNData, localFftOffset, localFftSize);
+    GMX_RELEASE_ASSERT(localFftNData[XX] == nx && localFftNData[YY] == ny && localFftNData[ZZ] == nz,
+                       "Slab-colored spreading requires the complete FFT grid");
+
+    const int numSlabs = 2 * (nx / (2 * order));
+    GMX_RELEASE_ASSERT(numSlabs >= 2, "We need at least two slabs for colored spreading");
+
+    /* Lookup tables for the periodic wrapping of the grid indices */
+    std::array<std::vector<int>, DIM> wrap;
+    for (int d = 0; d < DIM; d++)
+    {
+        const int n = localFftNData[d];
+        wrap[d].resize(n + order - 1);
+        for (int i = 0; i < n + order - 1; i++)
+        {
+            wrap[d][i] = (i < n ? i : i - n);
+        }
+    }
+
+    atc->slabAtomCount.resize(nthread * numSlabs);
+    atc->slabAtomStart.resize(numSlabs + 1);
+
+    real* gmx_restrict fftgrid = grids->fftgrid;
+
+#pragma omp parallel num_threads(nthread)
+    {
+        try
+        {
+            const int           thread = gmx_omp_get_thread_num();
+            const splinedata_t& spline = atc->spline[thread];
+
+            /* The slab index of grid line x, the slab boundaries are at s*nx/numSlabs */
+            const auto slabIndex = [nx, numSlabs](int x) { return ((x + 1) * numSlabs - 1) / nx; };
+
+            /* Count the atoms with non-zero coefficient per slab in our spline data */
+            int* slabCount = atc->slabAtomCount.data() + thread * numSlabs;
+            std::fill(slabCount, slabCount + numSlabs, 0);
+            for (int nn = 0; nn < spline.n; nn++)
+            {
+                const int n = spline.ind[nn];
+                if (atc->coefficient[n] != 0)
+                {
+                    slabCount[slabIndex(atc->idx[n][XX])]++;
+                }
+            }
+
+#pragma omp barrier
+#pragma omp single
+            {
+                /* Convert the counts into start indices, ordered on slab and then thread */
+                int numAtoms = 0;
+                for (int slab = 0; slab < numSlabs; slab++)
+                {
+                    atc->slabAtomStart[slab] = numAtoms;
+                    for (int t = 0; t < nthread; t++)
+                    {
+                        const int count                         = atc->slabAtomCount[t * numSlabs + slab];
+                        atc->slabAtomCount[t * numSlabs + slab] = numAtoms;
+                        numAtoms += count;
+                    }
+                }
+                atc->slabAtomStart[numSlabs] = numAtoms;
+                atc->slabAtoms.resize(numAtoms);
+            }
+
+            for (int nn = 0; nn < spline.n; nn++)
+            {
+                const int n = spline.ind[nn];
+                if (atc->coefficient[n] != 0)
+                {
+                    atc->slabAtoms[slabCount[slabIndex(atc->idx[n][XX])]++] = { thread, nn };
+                }
+            }
+
+#pragma omp for schedule(static)
+            for (int x = 0; x < nx; x++)
+            {
+                for (int y = 0; y < ny; y++)
+                {
+                    real* gridRow = fftgrid + (x * localFftSize[YY] + y) * localFftSize[ZZ];
+                    std::fill(gridRow, gridRow + nz, 0.0_real);
+                }
+            }
+            /* The implicit barrier above ensures the slab lists are complete */
+
+            for (int color = 0; color < 2; color++)
+            {
+#pragma omp for schedule(dynamic)
+                for (int slab = color; slab < numSlabs; slab += 2)
+                {
+                    for (int a = atc->slabAtomStart[slab]; a < atc->slabAtomStart[slab + 1]; a++)
+                    {
+                        const auto [splineThread, nn] = atc->slabAtoms[a];
+                        const splinedata_t& atomSpline = atc->spline[splineThread];
+                        const int           n          = atomSpline.ind[nn];
+                        const real*         thx = atomSpline.theta.coefficients[XX] + nn * order;
+                        const real*         thy = atomSpline.theta.coefficients[YY] + nn * order;
+                        const real*         thz = atomSpline.theta.coefficients[ZZ] + nn * order;
+
+                        switch (order)
+                        {
+                            case 4:
+                                spreadCoefficientOnWrappedGrid(fftgrid,
+                                                               localFftSize[YY],
+                                                               localFftSize[ZZ],
+                                                               wrap[XX].data(),
+                                                               wrap[YY].data(),
+                                                               wrap[ZZ].data(),
+                                                               atc->idx[n],
+                                                               atc->coefficient[n],
+                                                               thx,
+                                                               thy,
+                                                               thz,
+                                                               4);
+                                break;
+                            case 5:
+                                spreadCoefficientOnWrappedGrid(fftgrid,
+                                                               localFftSize[YY],
+                                                               localFftSize[ZZ],
+                                                               wrap[XX].data(),
+                                                               wrap[YY].data(),
+                                                               wrap[ZZ].data(),
+                                                               atc->idx[n],
+                                                               atc->coefficient[n],
+                                                               thx,
+                                                               thy,
+                                                               thz,
+                                                               5);
+                                break;
+                            default:
+                                spreadCoefficientOnWrappedGrid(fftgrid,
+                                                               localFftSize[YY],
+                                                               localFftSize[ZZ],
+                                                               wrap[XX].data(),
+                                                               wrap[YY].data(),
+                                                               wrap[ZZ].data(),
+                                                               atc->idx[n],
+                                                               atc->coefficient[n],
+                                                               thx,
+                                                               thy,
+                                                               thz,
+                                                               order);
+                                break;
+                        }
+                    }
+                }
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
+}
+
 void spread_on_grid(const gmx_pme_t* pme,
                     PmeAtomComm*     atc,
                     PmeAndFftGrids*  grids,
                     const bool       calculateSplines,
                     const bool       doSpreading,
-                    const bool       computeAllSplineCoefficients)
+                    const bool       computeAllSplineCoefficients,
+                    gmx_wallcycle*   wcycle)
 {
 #ifdef PME_TIME_THREADS
     gmx_cycles_t  c1, c2, c3, ct1a, ct1b, ct1c;
@@ -908,9 +1203,13 @@ void spread_on_grid(const gmx_pme_t* pme,
     assert(nthread > 0);
     GMX_ASSERT(grids != nullptr || !doSpreading, "If there's no grid, we cannot be spreading");
 
+    /* With slab-colored spreading we spread after computing all splines */
+    const bool spreadSlabColored = (doSpreading && pme->useSlabColoredSpread);
+
 #ifdef PME_TIME_THREADS
     c1 = omp_cyc_start();
 #endif
+    wallcycle_sub_start(wcycle, WallCycleSubCounter::PmeSplines);
     if (calculateSplines)
     {
 #pragma omp parallel for num_threads(nthread) schedule(static)
@@ -939,6 +1238,11 @@ void spread_on_grid(const gmx_pme_t* pme,
 #ifdef PME_TIME_THREADS
     c2 = omp_cyc_start();
 #endif
+    if (doSpreading && !spreadSlabColored)
+    {
+        wallcycle_sub_stop(wcycle, WallCycleSubCounter::PmeSplines);
+        wallcycle_sub_start(wcycle, WallCycleSubCounter::PmeSpreadGrid);
+    }
 #pragma omp parallel for num_threads(nthread) schedule(static)
     for (int thread = 0; thread < nthread; thread++)
     {
@@ -981,7 +1285,7 @@ void spread_on_grid(const gmx_pme_t* pme,
                               computeAllSplineCoefficients);
             }
 
-            if (doSpreading)
+            if (doSpreading && !spreadSlabColored)
             {
                 /* put local atoms on grid. */
                 pmegrid_t& grid =
@@ -1008,9 +1312,24 @@ void spread_on_grid(const gmx_pme_t* pme,
     c2 = omp_cyc_end(c2);
     cs2 += (double)c2;
 #endif
+    if (doSpreading && !spreadSlabColored)
+    {
+        wallcycle_sub_stop(wcycle, WallCycleSubCounter::PmeSpreadGrid);
+    }
+    else
+    {
+        wallcycle_sub_stop(wcycle, WallCycleSubCounter::PmeSplines);
+    }
 
-    if (doSpreading && pme->bUseThreads)
+    if (spreadSlabColored)
+    {
+        wallcycle_sub_start(wcycle, WallCycleSubCounter::PmeSpreadGrid);
+        spreadOnFftGridSlabColored(pme, atc, grids);
+        wallcycle_sub_stop(wcycle, WallCycleSubCounter::PmeSpreadGrid);
+    }
+    else if (doSpreading && pme->bUseThreads)
     {
+        wallcycle_sub_start(wcycle, WallCycleSubCounter::PmeSpreadReduce);
 #ifdef PME_TIME_THREADS
         c3 = omp_cyc_start();
 #endif
@@ -1040,6 +1359,7 @@ void spread_on_grid(const gmx_pme_t* pme,
              */
             sum_fftgrid_dd(pme, grids);
         }
+        wallcycle_sub_stop(wcycle, WallCycleSubCounter::PmeSpreadReduce);
     }
 
 #ifdef PME_TIME_THREADS
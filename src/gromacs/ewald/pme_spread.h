@@ -38,6 +38,7 @@
 
 struct gmx_pme_t;
 struct PmeAndFftGrids;
+struct gmx_wallcycle;
 class PmeAtomComm;
 
 /*! \brief Spread coefficients on the grid
@@ -48,12 +49,17 @@ class PmeAtomComm;
  * \param[in]     calculateSplines  Whether to calculate the splines
  * \param[in]     doSpreading       Whether to spead on the grid
  * \param[in]     computeAllSplineCoefficients  When false, only compute spline coefficients for atoms with non-zero coefficient
+ * \param[in,out] wcycle  Wall-cycle accounting for the spline, spread and reduction sub-counters, can be nullptr
+ *
+ * Note that with thread-local spreading grids, the B-spline coefficients are computed in
+ * the same thread-parallel loop as the spreading and are counted as spreading.
  */
 void spread_on_grid(const gmx_pme_t* pme,
                     PmeAtomComm*     atc,
                     PmeAndFftGrids*  grids,
                     bool             calculateSplines,
                     bool             doSpreading,
-                    bool             computeAllSplineCoefficients);
+                    bool             computeAllSplineCoefficients,
+                    gmx_wallcycle*   wcycle);
 
 #endif
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the ordering of the PME load balancing setups.
+ *
+ * \ingroup module_ewald
+ */
+#include "gmxpre.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/ewald/pme_load_balancing_setup.h"
+#include "gromacs/utility/real.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Returns a setup with \p cutoff and \p pmeOrder, other fields are not used
+pme_setup_t makeSetup(real cutoff, int pmeOrder)
+{
+    pme_setup_t setup  = {};
+    setup.rcut_coulomb = cutoff;
+    setup.pmeOrder     = pmeOrder;
+    return setup;
+}
+
+//! Returns setups with increasing cut-off, as generated during the cut-off scan
+std::vector<pme_setup_t> makeScannedSetups()
+{
+    return { makeSetup(0.9, 4), makeSetup(1.0, 4), makeSetup(1.1, 4), makeSetup(1.2, 4) };
+}
+
+TEST(PmeLoadBalancingSetupTest, HigherOrderSetupIsInsertedAfterItsBase)
+{
+    std::vector<pme_setup_t> setups = makeScannedSetups();
+
+    const int fastestSetup = 1;
+    const int index =
+            insertSetupOrderedOnCutoff(&setups, makeSetup(setups[fastestSetup].rcut_coulomb, 5));
+
+    ASSERT_EQ(setups.size(), 5);
+    EXPECT_EQ(index, fastestSetup + 1);
+    EXPECT_EQ(setups[fastestSetup].pmeOrder, 4);
+    EXPECT_EQ(setups[index].pmeOrder, 5);
+    for (size_t i = 1; i < setups.size(); i++)
+    {
+        EXPECT_LE(setups[i - 1].rcut_coulomb, setups[i].rcut_coulomb) << "setup " << i;
+    }
+}
+
+TEST(PmeLoadBalancingSetupTest, HigherOrderSetupAtLongestCutoffIsInsertedAtTheEnd)
+{
+    std::vector<pme_setup_t> setups = makeScannedSetups();
+
+    const int index = insertSetupOrderedOnCutoff(&setups, makeSetup(setups.back().rcut_coulomb, 5));
+
+    ASSERT_EQ(setups.size(), 5);
+    EXPECT_EQ(index, 4);
+    EXPECT_EQ(setups[3].pmeOrder, 4);
+    EXPECT_EQ(setups[4].pmeOrder, 5);
+}
+
+/* After the higher order setup has been tried and turned out fastest,
+ * DD limits the cut-off to below that of the next setup. The range of
+ * setups that is then considered should still contain the fastest setup
+ * and end with the longest allowed cut-off.
+ */
+TEST(PmeLoadBalancingSetupTest, HigherOrderSetupIsKeptWhenLimited)
+{
+    std::vector<pme_setup_t> setups = makeScannedSetups();
+
+    const int baseSetup    = 1;
+    const int fastestSetup = insertSetupOrderedOnCutoff(
+            &setups, makeSetup(setups[baseSetup].rcut_coulomb, 5));
+
+    /* DD does not allow the first setup with a longer cut-off than the fastest */
+    int limitedSetup = fastestSetup;
+    while (setups[limitedSetup].rcut_coulomb <= setups[fastestSetup].rcut_coulomb)
+    {
+        limitedSetup++;
+    }
+    const int endSetup = limitedSetup;
+
+    EXPECT_LT(fastestSetup, endSetup);
+    EXPECT_EQ(setups[endSetup - 1].pmeOrder, 5);
+    EXPECT_EQ(setups[endSetup - 1].rcut_coulomb, setups[baseSetup].rcut_coulomb);
+    for (int i = 0; i < endSetup; i++)
+    {
+        EXPECT_LT(setups[i].rcut_coulomb, setups[limitedSetup].rcut_coulomb) << "setup " << i;
+    }
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -48,6 +48,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <random>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -58,6 +59,7 @@
 
 #include "gromacs/ewald/pme.h"
 #include "gromacs/ewald/pme_gpu_internal.h"
+#include "gromacs/ewald/pme_internal.h"
 #include "gromacs/mdtypes/inputrec.h"
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/state_propagator_data_gpu.h"
@@ -70,6 +72,7 @@
 #include "gromacs/utility/vectypes.h"
 
 #include "testutils/refdata.h"
+#include "testutils/setenv.h"
 #include "testutils/test_hardware_environment.h"
 #include "testutils/testasserts.h"
 #include "testutils/testinit.h"
@@ -422,6 +425,100 @@ const auto c_inputGridNames = ::testing::Values("first", "second");
 //! Moved out from instantiations for readability
 const auto c_inputTestSystemNames = ::testing::Values("1 atom", "2 atoms", "13 atoms");
 
+/*! \brief Convenience typedef of input parameters for the threaded spreading test
+ *
+ * Parameters:
+ * - unit cell box
+ * - PME interpolation order
+ * - grid dimensions
+ */
+typedef std::tuple<std::string, int, IVec> ThreadedSpreadInputParameters;
+
+//! Test fixture for comparing threaded spreading algorithms
+class ThreadedSpreadTest : public ::testing::TestWithParam<ThreadedSpreadInputParameters>
+{
+};
+
+//! Returns the real grid after spreading \p charges with \p numThreads threads
+SparseRealGridValuesOutput spreadWithThreads(const t_inputrec&        inputRec,
+                                             const Matrix3x3&         box,
+                                             const CoordinatesVector& coordinates,
+                                             const ChargesVector&     charges,
+                                             int                      numThreads,
+                                             bool                     useSlabColoring)
+{
+    if (useSlabColoring)
+    {
+        gmxSetenv("GMX_PME_SPREAD_COLORING", "1", true);
+    }
+    PmeSafePointer pmeSafe = pmeInitWrapper(
+            &inputRec, CodePath::CPU, nullptr, nullptr, nullptr, box, 1.0F, 1.0F, numThreads);
+    if (useSlabColoring)
+    {
+        gmxUnsetenv("GMX_PME_SPREAD_COLORING");
+    }
+    EXPECT_EQ(useSlabColoring, pmeSafe->useSlabColoredSpread);
+
+    pmeInitAtoms(pmeSafe.get(), nullptr, CodePath::CPU, coordinates, charges);
+    pmePerformSplineAndSpread(pmeSafe.get(), CodePath::CPU, true, true);
+    pmeFinalizeTest(pmeSafe.get(), CodePath::CPU);
+
+    return pmeGetRealGrid(pmeSafe.get(), CodePath::CPU);
+}
+
+/* Spreading directly on the FFT grid in slabs of alternating color should
+ * give the same grid as spreading on thread-local grids and reducing them.
+ */
+TEST_P(ThreadedSpreadTest, SlabColoredMatchesThreadLocalGrids)
+{
+    const auto [boxName, pmeOrder, gridSize] = GetParam();
+    const Matrix3x3& box                     = c_inputBoxes.at(boxName);
+
+    t_inputrec inputRec;
+    inputRec.nkx         = gridSize[XX];
+    inputRec.nky         = gridSize[YY];
+    inputRec.nkz         = gridSize[ZZ];
+    inputRec.pme_order   = pmeOrder;
+    inputRec.coulombtype = CoulombInteractionType::Pme;
+    inputRec.epsilon_r   = 1.0;
+
+    /* Enough atoms to have several per slab, partly outside the unit cell */
+    const int                        numAtoms = 300;
+    std::mt19937                     generator(pmeOrder);
+    std::uniform_real_distribution<> distribution(-0.5, 1.5);
+    CoordinatesVector                coordinates(numAtoms);
+    ChargesVector                    charges(numAtoms);
+    for (int i = 0; i < numAtoms; i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            coordinates[i][d] = distribution(generator) * box[d * DIM + d];
+        }
+        charges[i] = distribution(generator) - 0.5;
+    }
+
+    const int numThreads = 4;
+    const auto reference = spreadWithThreads(inputRec, box, coordinates, charges, numThreads, false);
+    const auto slabColored = spreadWithThreads(inputRec, box, coordinates, charges, numThreads, true);
+
+    ASSERT_FALSE(reference.empty());
+    EXPECT_EQ(reference.size(), slabColored.size());
+    /* The contributions are summed in a different order */
+    const auto tolerance = relativeToleranceAsPrecisionDependentUlp(10.0, 64, 512);
+    for (const auto& [cell, value] : reference)
+    {
+        const auto it = slabColored.find(cell);
+        ASSERT_NE(it, slabColored.end()) << cell;
+        EXPECT_REAL_EQ_TOL(value, it->second, tolerance) << cell;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(WithVariousInputs,
+                         ThreadedSpreadTest,
+                         ::testing::Combine(c_inputBoxNames,
+                                            ::testing::ValuesIn(c_inputPmeOrders),
+                                            ::testing::ValuesIn(c_inputGridSizes)));
+
 } // namespace
 
 void registerDynamicalPmeSplineSpreadTests(const Range<int> hardwareContextIndexRange)
@@ -142,7 +142,8 @@ PmeSafePointer pmeInitWrapper(const t_inputrec*    inputRec,
                               const PmeGpuProgram* pmeGpuProgram,
                               const Matrix3x3&     box,
                               const real           ewaldCoeff_q,
-                              const real           ewaldCoeff_lj)
+                              const real           ewaldCoeff_lj,
+                              const int            numThreads)
 {
     const MDLogger dummyLogger;
     const auto     runMode       = (mode == CodePath::CPU) ? PmeRunMode::CPU : PmeRunMode::Mixed;
@@ -172,7 +173,7 @@ PmeSafePointer pmeInitWrapper(const t_inputrec*    inputRec,
                                          true,
                                          ewaldCoeff_q,
                                          ewaldCoeff_lj,
-                                         1,
+                                         numThreads,
                                          runMode,
                                          nullptr,
                                          deviceContext,
@@ -345,7 +346,8 @@ void pmePerformSplineAndSpread(gmx_pme_t* pme,
     switch (mode)
     {
         case CodePath::CPU:
-            spread_on_grid(pme, atc, &grids, computeSplines, spreadCharges, computeSplinesForZeroCharges);
+            spread_on_grid(
+                    pme, atc, &grids, computeSplines, spreadCharges, computeSplinesForZeroCharges, nullptr);
             if (spreadCharges && !pme->bUseThreads)
             {
                 wrap_periodic_pmegrid(pme, grids.pmeGrids.grid.grid());
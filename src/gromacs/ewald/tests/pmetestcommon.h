@@ -159,7 +159,8 @@ PmeSafePointer pmeInitWrapper(const t_inputrec*    inputRec,
                               const PmeGpuProgram* pmeGpuProgram,
                               const Matrix3x3&     box,
                               real                 ewaldCoeff_q  = 1.0F,
-                              real                 ewaldCoeff_lj = 1.0F);
+                              real                 ewaldCoeff_lj = 1.0F,
+                              int                  numThreads    = 1);
 
 //! Simple PME initialization based on inputrec only
 PmeSafePointer pmeInitEmpty(const t_inputrec* inputRec);
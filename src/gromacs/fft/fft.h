@@ -352,6 +352,27 @@ void gmx_many_fft_destroy(gmx_fft_t setup);
  */
 int gmx_fft_transpose_2d(t_complex* in_data, t_complex* out_data, int nx, int ny);
 
+/*! \brief Imports planning results of earlier runs, when supported by the FFT library
+ *
+ *  With FFTW and the environment variable GMX_FFTW_WISDOM_FILE set, the FFTW
+ *  wisdom in that file is imported, so measured plans for transforms planned
+ *  in earlier runs are created without repeating the measurements. FFTW keys
+ *  its wisdom on the complete transform setup, i.e. sizes, strides and threads.
+ *  Only the first call has an effect. The FFTW plan initialization functions
+ *  call this when measuring plans, so this is only needed for planning done
+ *  outside this module. Note that after the import, FFTW also uses the wisdom
+ *  for plans created with FFTW_ESTIMATE.
+ */
+void gmx_fft_import_wisdom();
+
+/*! \brief Stores new planning results for use in later runs, when supported by the FFT library
+ *
+ *  With FFTW, rewrites the wisdom file after new plans have been measured.
+ *  The file is replaced atomically, so concurrent processes can share the
+ *  same file, but the last writer determines its contents.
+ */
+void gmx_fft_export_wisdom();
+
 /*! \brief Cleanup global data of FFT
  *
  *  Any plans are invalid after this function. Should be called
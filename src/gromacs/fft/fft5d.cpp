@@ -83,27 +83,7 @@ FILE* debug = 0;
 #endif
 
 #if GMX_FFT_FFTW3
-
-#    include <mutex>
-
-#    include "gromacs/utility/exceptions.h"
-
-/* none of the fftw3 calls, except execute(), are thread-safe, so
-   we need to serialize them with this mutex. */
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-static std::mutex big_fftw_mutex;
-#    define FFTW_LOCK              \
-        try                        \
-        {                          \
-            big_fftw_mutex.lock(); \
-        }                          \
-        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
-#    define FFTW_UNLOCK              \
-        try                          \
-        {                            \
-            big_fftw_mutex.unlock(); \
-        }                            \
-        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+#    include "gromacs/fft/fftw_lock.h"
 #endif /* GMX_FFT_FFTW3 */
 
 #if !GMX_MPI
@@ -139,6 +119,22 @@ static int vmax(const int* a, int s)
 static constexpr bool allocatePmeGpuMixedMode = (GMX_GPU && !GMX_GPU_OPENCL);
 
 
+/*! \brief Returns the local line range [lineStart, lineEnd) of \p thread for \p chunk
+ *
+ * Chunks are slabs of planes along the major dimension, of which there are pK
+ * local and K in the transpose blocks. Thus each chunk of the transpose is a
+ * contiguous part of the block for each rank.
+ */
+static void chunkLineRange(int pM, int pK, int K, int numChunks, int chunk, int thread, int nthreads, int* lineStart, int* lineEnd)
+{
+    const int planeStart = std::min(chunk * K / numChunks, pK);
+    const int planeEnd   = std::min((chunk + 1) * K / numChunks, pK);
+    const int numLines   = (planeEnd - planeStart) * pM;
+
+    *lineStart = planeStart * pM + thread * numLines / nthreads;
+    *lineEnd   = planeStart * pM + (thread + 1) * numLines / nthreads;
+}
+
 /* NxMxK the size of the data
  * comm communicator to use for fft5d
  * P0 number of processor in 1st axes (can be null for automatic)
@@ -155,7 +151,8 @@ fft5d_plan fft5d_plan_3d(int                NG,
                          t_complex**        rlout2,
                          t_complex**        rlout3,
                          int                nthreads,
-                         gmx::PinningPolicy realGridAllocationPinningPolicy)
+                         gmx::PinningPolicy realGridAllocationPinningPolicy,
+                         int                numCommChunks)
 {
 
     int  P[2], prank[2], i;
@@ -169,6 +166,8 @@ fft5d_plan fft5d_plan_3d(int                NG,
     int        C[3], rC[3], nP[2];
     int        lsize;
     t_complex *lin = nullptr, *lout = nullptr, *lout2 = nullptr, *lout3 = nullptr;
+    /* Chunked transposes read and write while the next chunk is transformed */
+    const bool useSeparateTransposeBuffers = (nthreads > 1 || numCommChunks > 1);
     fft5d_plan plan;
     int        s;
 
@@ -438,7 +437,7 @@ fft5d_plan fft5d_plan_3d(int                NG,
             snew_aligned(lin, lsize, 32);
         }
         snew_aligned(lout, lsize, 32);
-        if (nthreads > 1)
+        if (useSeparateTransposeBuffers)
         {
             /* We need extra transpose buffers to avoid OpenMP barriers */
             snew_aligned(lout2, lsize, 32);
@@ -455,7 +454,7 @@ fft5d_plan fft5d_plan_3d(int                NG,
     {
         lin  = *rlin;
         lout = *rlout;
-        if (nthreads > 1)
+        if (useSeparateTransposeBuffers)
         {
             lout2 = *rlout2;
             lout3 = *rlout3;
@@ -495,6 +494,11 @@ fft5d_plan fft5d_plan_3d(int                NG,
         FFTW(iodim) dims[3];
         int inNG = NG, outMG = MG, outKG = KG;
 
+        if (!(flags & FFT5D_NOMEASURE))
+        {
+            gmx_fft_import_wisdom();
+        }
+
         FFTW_LOCK
 
         fftwflags |= (flags & FFT5D_NOMEASURE) ? FFTW_ESTIMATE : FFTW_MEASURE;
@@ -614,6 +618,11 @@ fft5d_plan fft5d_plan_3d(int                NG,
 #        endif
 #    endif
         FFTW_UNLOCK
+
+        if (!(flags & FFT5D_NOMEASURE))
+        {
+            gmx_fft_export_wisdom();
+        }
     }
     if (!plan->p3d) /* for decomposition and if 3d plan did not work */
     {
@@ -661,6 +670,50 @@ fft5d_plan fft5d_plan_3d(int                NG,
             }
         }
 
+        /* Plans for the chunks of the first two steps, when their transposes are overlapped */
+        for (s = 0; s < 2; s++)
+        {
+            plan->numCommChunks[s] = (nP[s] > 1) ? std::min(numCommChunks, K[s]) : 1;
+            if (plan->numCommChunks[s] > 1)
+            {
+                plan->p1dChunk[s] = static_cast<gmx_fft_t*>(
+                        std::malloc(sizeof(gmx_fft_t) * plan->numCommChunks[s] * nthreads));
+                for (int c = 0; c < plan->numCommChunks[s]; c++)
+                {
+                    for (int t = 0; t < nthreads; t++)
+                    {
+                        int lineStart, lineEnd;
+                        chunkLineRange(pM[s], pK[s], K[s], plan->numCommChunks[s], c, t, nthreads, &lineStart, &lineEnd);
+                        gmx_fft_t* fft = &plan->p1dChunk[s][c * nthreads + t];
+                        if (lineEnd == lineStart)
+                        {
+                            *fft = nullptr;
+                        }
+                        else if ((flags & FFT5D_REALCOMPLEX) && !(flags & FFT5D_BACKWARD) && s == 0)
+                        {
+                            gmx_fft_init_many_1d_real(fft,
+                                                      rC[s],
+                                                      lineEnd - lineStart,
+                                                      (flags & FFT5D_NOMEASURE) ? GMX_FFT_FLAG_CONSERVATIVE : 0);
+                        }
+                        else
+                        {
+                            gmx_fft_init_many_1d(fft,
+                                                 C[s],
+                                                 lineEnd - lineStart,
+                                                 (flags & FFT5D_NOMEASURE) ? GMX_FFT_FLAG_CONSERVATIVE : 0);
+                        }
+                    }
+                }
+            }
+        }
+        if (plan->numCommChunks[0] > 1 || plan->numCommChunks[1] > 1)
+        {
+            plan->commRequests = static_cast<MPI_Request*>(
+                    std::malloc(sizeof(MPI_Request) * 2 * std::max(nP[0], nP[1])
+                                * std::max(plan->numCommChunks[0], plan->numCommChunks[1])));
+        }
+
 #if GMX_FFT_FFTW3
     }
 #endif
@@ -711,9 +764,10 @@ fft5d_plan fft5d_plan_3d(int                NG,
         plan->direction=direction;
         plan->realcomplex=realcomplex;
      */
-    plan->flags         = flags;
-    plan->nthreads      = nthreads;
-    plan->pinningPolicy = realGridAllocationPinningPolicy;
+    plan->flags                  = flags;
+    plan->nthreads               = nthreads;
+    plan->pinningPolicy          = realGridAllocationPinningPolicy;
+    plan->numCommChunksRequested = numCommChunks;
     *rlin               = lin;
     *rlout              = lout;
     *rlout2             = lout2;
@@ -1084,6 +1138,196 @@ static void print_localdata(const t_complex* lin, const char* txt, int s, fft5d_
     }
 }
 
+#if GMX_MPI
+/*! \brief Returns whether all \p numRequests requests have completed
+ *
+ * Also lets MPI progress the outstanding messages. Completed requests
+ * are set to MPI_REQUEST_NULL.
+ */
+static bool requestsAreComplete(MPI_Request* requests, int numRequests)
+{
+    bool allComplete = true;
+    for (int i = 0; i < numRequests; i++)
+    {
+        if (requests[i] != MPI_REQUEST_NULL)
+        {
+            int isComplete = 0;
+            MPI_Test(&requests[i], &isComplete, MPI_STATUS_IGNORE);
+            allComplete = allComplete && (isComplete != 0);
+        }
+    }
+    return allComplete;
+}
+#endif
+
+/*! \brief FFT, split and transpose of step \p s in chunks, overlapping communication with the FFTs
+ *
+ * The data is transposed with non-blocking point-to-point messages per chunk,
+ * so each transpose chunk is in flight while the next chunks are transformed
+ * and split. The resulting layout of lout3 is identical to that produced by
+ * the MPI_Alltoall in fft5d_execute(), so the join step is unchanged.
+ * The time spent in MPI calls, including the final wait, is accounted in
+ * PmeFftComm. The time that transpose chunks are in flight while thread 0
+ * computes FFTs, i.e. the hidden communication time, is accounted in
+ * PmeFftCommOverlap. As completion is only checked between chunks, the
+ * latter is an upper bound.
+ */
+static void fftAndTransposeInChunks(fft5d_plan plan, int s, int thread, fft5d_time times)
+{
+#if GMX_MPI
+    const int numChunks = plan->numCommChunks[s];
+    const int nthreads  = plan->nthreads;
+    const int P         = plan->P[s];
+    /* Size of the transpose block for each rank and of one plane, in complex numbers */
+    const int blockSize = plan->N[s] * plan->M[s] * plan->K[s];
+    const int planeSize = plan->N[s] * plan->M[s];
+    /* MPI counts are in units of real */
+    const int realsPerComplex = sizeof(t_complex) / sizeof(real);
+
+    /* The requests of chunk c are stored at c*numPeers for receives and sends */
+    const int    numPeers     = P - 1;
+    MPI_Request* recvRequests = plan->commRequests;
+    MPI_Request* sendRequests = plan->commRequests + numChunks * numPeers;
+    int          rank         = 0;
+    /* The first chunk of which not all messages are known to have completed */
+    int firstIncompleteChunk = 0;
+
+    /* All threads should be done with the previous join, which partitions lines differently */
+#    pragma omp barrier
+    if (thread == 0)
+    {
+#    ifndef NOGMX
+        wallcycle_start(times, WallCycleCounter::PmeFftComm);
+#    endif
+        MPI_Comm_rank(plan->cart[s], &rank);
+        for (int c = 0; c < numChunks; c++)
+        {
+            const int planeStart = c * plan->K[s] / numChunks;
+            const int planeEnd   = (c + 1) * plan->K[s] / numChunks;
+            int       peer       = 0;
+            for (int i = 0; i < P; i++)
+            {
+                if (i != rank)
+                {
+                    MPI_Irecv(reinterpret_cast<real*>(plan->lout3 + i * blockSize + planeStart * planeSize),
+                              (planeEnd - planeStart) * planeSize * realsPerComplex,
+                              GMX_MPI_REAL,
+                              i,
+                              c,
+                              plan->cart[s],
+                              &recvRequests[c * numPeers + peer++]);
+                }
+            }
+        }
+#    ifndef NOGMX
+        wallcycle_stop(times, WallCycleCounter::PmeFftComm);
+#    endif
+    }
+
+    for (int c = 0; c < numChunks; c++)
+    {
+        int lineStart, lineEnd;
+        chunkLineRange(plan->pM[s], plan->pK[s], plan->K[s], numChunks, c, thread, nthreads, &lineStart, &lineEnd);
+        if (lineEnd > lineStart)
+        {
+            gmx_fft_t fft = plan->p1dChunk[s][c * nthreads + thread];
+            if ((plan->flags & FFT5D_REALCOMPLEX) && !(plan->flags & FFT5D_BACKWARD) && s == 0)
+            {
+                gmx_fft_many_1d_real(fft,
+                                     GMX_FFT_REAL_TO_COMPLEX,
+                                     plan->lin + lineStart * plan->C[s],
+                                     plan->lout + lineStart * plan->C[s]);
+            }
+            else
+            {
+                gmx_fft_many_1d(fft,
+                                (plan->flags & FFT5D_BACKWARD) ? GMX_FFT_BACKWARD : GMX_FFT_FORWARD,
+                                plan->lin + lineStart * plan->C[s],
+                                plan->lout + lineStart * plan->C[s]);
+            }
+            splitaxes(plan->lout2,
+                      plan->lout,
+                      plan->N[s],
+                      plan->M[s],
+                      plan->K[s],
+                      plan->pM[s],
+                      P,
+                      plan->C[s],
+                      plan->iNout[s],
+                      plan->oNout[s],
+                      lineStart % plan->pM[s],
+                      lineStart / plan->pM[s],
+                      lineEnd % plan->pM[s],
+                      lineEnd / plan->pM[s]);
+        }
+        /* The whole chunk should be split before it is sent */
+#    pragma omp barrier
+        if (thread == 0)
+        {
+#    ifndef NOGMX
+            if (c > 0)
+            {
+                wallcycle_stop(times, WallCycleCounter::PmeFftCommOverlap);
+            }
+            wallcycle_start(times, WallCycleCounter::PmeFftComm);
+#    endif
+            while (firstIncompleteChunk < c
+                   && requestsAreComplete(recvRequests + firstIncompleteChunk * numPeers, numPeers)
+                   && requestsAreComplete(sendRequests + firstIncompleteChunk * numPeers, numPeers))
+            {
+                firstIncompleteChunk++;
+            }
+
+            const int planeStart = c * plan->K[s] / numChunks;
+            const int planeEnd   = (c + 1) * plan->K[s] / numChunks;
+            int       peer       = 0;
+            for (int i = 0; i < P; i++)
+            {
+                const int offset = i * blockSize + planeStart * planeSize;
+                const int size   = (planeEnd - planeStart) * planeSize;
+                if (i != rank)
+                {
+                    MPI_Isend(reinterpret_cast<real*>(plan->lout2 + offset),
+                              size * realsPerComplex,
+                              GMX_MPI_REAL,
+                              i,
+                              c,
+                              plan->cart[s],
+                              &sendRequests[c * numPeers + peer++]);
+                }
+                else
+                {
+                    std::memcpy(plan->lout3 + offset, plan->lout2 + offset, size * sizeof(t_complex));
+                }
+            }
+#    ifndef NOGMX
+            wallcycle_stop(times, WallCycleCounter::PmeFftComm);
+            /* Chunk c, and possibly earlier chunks, are now in flight while we compute */
+            wallcycle_start(times, WallCycleCounter::PmeFftCommOverlap);
+#    endif
+        }
+    }
+
+    if (thread == 0)
+    {
+#    ifndef NOGMX
+        wallcycle_stop(times, WallCycleCounter::PmeFftCommOverlap);
+        wallcycle_start(times, WallCycleCounter::PmeFftComm);
+#    endif
+        MPI_Waitall(2 * numChunks * numPeers, plan->commRequests, MPI_STATUSES_IGNORE);
+#    ifndef NOGMX
+        wallcycle_stop(times, WallCycleCounter::PmeFftComm);
+#    endif
+    }
+#else
+    GMX_UNUSED_VALUE(plan);
+    GMX_UNUSED_VALUE(s);
+    GMX_UNUSED_VALUE(thread);
+    GMX_UNUSED_VALUE(times);
+    GMX_RELEASE_ASSERT(false, "Invalid call to fftAndTransposeInChunks");
+#endif /*GMX_MPI*/
+}
+
 void fft5d_execute(fft5d_plan plan, int thread, fft5d_time times)
 {
     t_complex* lin   = plan->lin;
@@ -1150,61 +1394,70 @@ void fft5d_execute(fft5d_plan plan, int thread, fft5d_time times)
             bParallelDim = 0;
         }
 
-        /* ---------- START FFT ------------ */
-#ifdef NOGMX
-        if (times != 0 && thread == 0)
-        {
-            time = MPI_Wtime();
-        }
-#endif
+        const bool transposeInChunks = (bParallelDim && plan->numCommChunks[s] > 1);
 
-        if (bParallelDim || plan->nthreads == 1)
+        if (transposeInChunks)
         {
-            fftout = lout;
+            fftAndTransposeInChunks(plan, s, thread, times);
         }
         else
         {
-            if (s == 0)
+            /* ---------- START FFT ------------ */
+#ifdef NOGMX
+            if (times != 0 && thread == 0)
+            {
+                time = MPI_Wtime();
+            }
+#endif
+
+            if (bParallelDim || plan->nthreads == 1)
             {
-                fftout = lout3;
+                fftout = lout;
             }
             else
             {
-                fftout = lout2;
+                if (s == 0)
+                {
+                    fftout = lout3;
+                }
+                else
+                {
+                    fftout = lout2;
+                }
             }
-        }
 
-        tstart = (thread * pM[s] * pK[s] / plan->nthreads) * C[s];
-        if ((plan->flags & FFT5D_REALCOMPLEX) && !(plan->flags & FFT5D_BACKWARD) && s == 0)
-        {
-            gmx_fft_many_1d_real(p1d[s][thread],
-                                 (plan->flags & FFT5D_BACKWARD) ? GMX_FFT_COMPLEX_TO_REAL
-                                                                : GMX_FFT_REAL_TO_COMPLEX,
-                                 lin + tstart,
-                                 fftout + tstart);
-        }
-        else
-        {
-            gmx_fft_many_1d(p1d[s][thread],
-                            (plan->flags & FFT5D_BACKWARD) ? GMX_FFT_BACKWARD : GMX_FFT_FORWARD,
-                            lin + tstart,
-                            fftout + tstart);
-        }
+            tstart = (thread * pM[s] * pK[s] / plan->nthreads) * C[s];
+            if ((plan->flags & FFT5D_REALCOMPLEX) && !(plan->flags & FFT5D_BACKWARD) && s == 0)
+            {
+                gmx_fft_many_1d_real(p1d[s][thread],
+                                     (plan->flags & FFT5D_BACKWARD) ? GMX_FFT_COMPLEX_TO_REAL
+                                                                    : GMX_FFT_REAL_TO_COMPLEX,
+                                     lin + tstart,
+                                     fftout + tstart);
+            }
+            else
+            {
+                gmx_fft_many_1d(p1d[s][thread],
+                                (plan->flags & FFT5D_BACKWARD) ? GMX_FFT_BACKWARD : GMX_FFT_FORWARD,
+                                lin + tstart,
+                                fftout + tstart);
+            }
 
 #ifdef NOGMX
-        if (times != NULL && thread == 0)
-        {
-            time_fft += MPI_Wtime() - time;
-        }
+            if (times != NULL && thread == 0)
+            {
+                time_fft += MPI_Wtime() - time;
+            }
 #endif
-        if ((plan->flags & FFT5D_DEBUG) && thread == 0)
-        {
-            print_localdata(lout, "%d %d: FFT\n", s, plan);
+            if ((plan->flags & FFT5D_DEBUG) && thread == 0)
+            {
+                print_localdata(lout, "%d %d: FFT\n", s, plan);
+            }
+            /* ---------- END FFT ------------ */
         }
-        /* ---------- END FFT ------------ */
 
         /* ---------- START SPLIT + TRANSPOSE------------ (if parallel in in this dimension)*/
-        if (bParallelDim)
+        if (bParallelDim && !transposeInChunks)
         {
 #ifdef NOGMX
             if (times != NULL && thread == 0)
@@ -1434,6 +1687,17 @@ void fft5d_destroy(fft5d_plan plan)
             }
             std::free(plan->p1d[s]);
         }
+        if (s < 2 && plan->p1dChunk[s])
+        {
+            for (t = 0; t < plan->numCommChunks[s] * plan->nthreads; t++)
+            {
+                if (plan->p1dChunk[s][t])
+                {
+                    gmx_many_fft_destroy(plan->p1dChunk[s][t]);
+                }
+            }
+            std::free(plan->p1dChunk[s]);
+        }
         if (plan->iNin[s])
         {
             std::free(plan->iNin[s]);
@@ -1482,13 +1746,15 @@ void fft5d_destroy(fft5d_plan plan)
             sfree_aligned(plan->lin);
         }
         sfree_aligned(plan->lout);
-        if (plan->nthreads > 1)
+        if (plan->nthreads > 1 || plan->numCommChunksRequested > 1)
         {
             sfree_aligned(plan->lout2);
             sfree_aligned(plan->lout3);
         }
     }
 
+    std::free(plan->commRequests);
+
 #ifdef FFT5D_THREADS
 #    ifdef FFT5D_FFTW_THREADS
     /*FFTW(cleanup_threads)();*/
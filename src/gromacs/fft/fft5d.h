@@ -119,6 +119,11 @@ struct fft5d_plan_t
     int                coor[2];
     int                nthreads;
     gmx::PinningPolicy pinningPolicy;
+    /* Overlap of the transposes with the FFTs of the first two steps (when numCommChunks[s]>1) */
+    int          numCommChunksRequested; /*number of chunks requested at plan creation*/
+    int          numCommChunks[2];       /*number of chunks for each transpose*/
+    gmx_fft_t*   p1dChunk[2];            /*1D plans for each chunk and thread*/
+    MPI_Request* commRequests;           /*requests for the chunked transposes*/
 };
 
 typedef struct fft5d_plan_t* fft5d_plan;
@@ -134,7 +139,8 @@ fft5d_plan fft5d_plan_3d(int         N,
                          t_complex** lout2,
                          t_complex** lout3,
                          int         nthreads,
-                         gmx::PinningPolicy realGridAllocationPinningPolicy = gmx::PinningPolicy::CannotBePinned);
+                         gmx::PinningPolicy realGridAllocationPinningPolicy = gmx::PinningPolicy::CannotBePinned,
+                         int                numCommChunks                   = 1);
 void       fft5d_destroy(fft5d_plan plan);
 
 #endif
@@ -38,15 +38,20 @@
 #include <fftw3.h>
 
 #include <cerrno>
+#include <cstdio>
 #include <cstdlib>
 
 #include <filesystem>
 #include <mutex>
+#include <string>
+#include <utility>
 
 #include "gromacs/fft/fft.h"
+#include "gromacs/fft/fftw_lock.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/real.h"
+#include "gromacs/utility/sysinfo.h"
 
 #if GMX_DOUBLE
 #    define FFTWPREFIX(name) fftw_##name
@@ -54,22 +59,17 @@
 #    define FFTWPREFIX(name) fftwf_##name
 #endif
 
-/* none of the fftw3 calls, except execute(), are thread-safe, so
-   we need to serialize them with this mutex. */
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-static std::mutex big_fftw_mutex;
-#define FFTW_LOCK              \
-    try                        \
-    {                          \
-        big_fftw_mutex.lock(); \
-    }                          \
-    GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
-#define FFTW_UNLOCK              \
-    try                          \
-    {                            \
-        big_fftw_mutex.unlock(); \
-    }                            \
-    GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+namespace gmx
+{
+
+std::mutex& fftwMutex()
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace gmx
 
 /* We assume here that aligned memory starts at multiple of 16 bytes and unaligned memory starts at multiple of 8 bytes. The later is guranteed for all malloc implementation.
    Consequesences:
@@ -105,6 +105,119 @@ struct gmx_fft
     int ndim;
 };
 
+//! Whether an import of the FFTW wisdom file has been attempted, protected by the FFTW mutex
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static bool g_wisdomImportAttempted = false;
+//! Whether we may write the FFTW wisdom file, protected by the FFTW mutex
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static bool g_wisdomExportAllowed = false;
+//! The wisdom last read from or written to the wisdom file, protected by the FFTW mutex
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::string g_lastWisdom;
+
+//! Returns the name of the FFTW wisdom file, or nullptr when not set
+static const char* wisdomFileName()
+{
+    return std::getenv("GMX_FFTW_WISDOM_FILE");
+}
+
+//! Returns the current FFTW wisdom as a string, should be called with the FFTW mutex locked
+static std::string currentWisdomLocked()
+{
+    char*             wisdomChars = FFTWPREFIX(export_wisdom_to_string)();
+    const std::string wisdom      = (wisdomChars != nullptr ? wisdomChars : "");
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+    free(wisdomChars);
+
+    return wisdom;
+}
+
+/*! \brief Imports the wisdom file on the first call, should be called with the FFTW mutex locked
+ *
+ * When the file exists but cannot be read, e.g. because it was written
+ * by a build with different precision, we will not overwrite it.
+ */
+static void importWisdomLocked()
+{
+    if (g_wisdomImportAttempted)
+    {
+        return;
+    }
+    g_wisdomImportAttempted = true;
+
+    const char* fileName = wisdomFileName();
+    if (fileName == nullptr)
+    {
+        return;
+    }
+
+    if (std::FILE* fp = std::fopen(fileName, "r"))
+    {
+        const int success = FFTWPREFIX(import_wisdom_from_file)(fp);
+        std::fclose(fp);
+        if (!success)
+        {
+            fprintf(stderr,
+                    "\nNOTE: Could not import FFTW wisdom from file '%s', the file will not be "
+                    "updated\n",
+                    fileName);
+            return;
+        }
+    }
+    g_wisdomExportAllowed = true;
+    g_lastWisdom          = currentWisdomLocked();
+}
+
+/*! \brief Writes the wisdom file when we have new wisdom, should be called with the FFTW mutex locked
+ *
+ * The file is written under a temporary name and then renamed, so other processes
+ * never read a partially written file.
+ */
+static void exportWisdomLocked()
+{
+    if (!g_wisdomExportAllowed)
+    {
+        return;
+    }
+
+    std::string wisdom = currentWisdomLocked();
+    if (wisdom == g_lastWisdom)
+    {
+        return;
+    }
+
+    const std::string fileName     = wisdomFileName();
+    const std::string tempFileName = fileName + ".tmp" + std::to_string(gmx_getpid());
+    std::FILE*        fp           = std::fopen(tempFileName.c_str(), "w");
+    if (fp == nullptr)
+    {
+        return;
+    }
+    const bool writeSucceeded = (std::fputs(wisdom.c_str(), fp) >= 0);
+    if (std::fclose(fp) == 0 && writeSucceeded && std::rename(tempFileName.c_str(), fileName.c_str()) == 0)
+    {
+        g_lastWisdom = std::move(wisdom);
+    }
+    else
+    {
+        std::remove(tempFileName.c_str());
+    }
+}
+
+void gmx_fft_import_wisdom()
+{
+    FFTW_LOCK
+    importWisdomLocked();
+    FFTW_UNLOCK
+}
+
+void gmx_fft_export_wisdom()
+{
+    FFTW_LOCK
+    exportWisdomLocked();
+    FFTW_UNLOCK
+}
+
 int gmx_fft_init_1d(gmx_fft_t* pfft, int nx, gmx_fft_flag flags)
 {
     return gmx_fft_init_many_1d(pfft, nx, 1, flags);
@@ -133,6 +246,10 @@ int gmx_fft_init_many_1d(gmx_fft_t* pfft, int nx, int howmany, gmx_fft_flag flag
     *pfft = nullptr;
 
     FFTW_LOCK
+    if (fftw_flags == FFTW_MEASURE)
+    {
+        importWisdomLocked();
+    }
     if ((fft = static_cast<gmx_fft_t>(FFTWPREFIX(malloc)(sizeof(struct gmx_fft)))) == nullptr)
     {
         FFTW_UNLOCK
@@ -222,6 +339,10 @@ int gmx_fft_init_many_1d(gmx_fft_t* pfft, int nx, int howmany, gmx_fft_flag flag
     fft->ndim           = 1;
 
     *pfft = fft;
+    if (fftw_flags == FFTW_MEASURE)
+    {
+        exportWisdomLocked();
+    }
     FFTW_UNLOCK
     return 0;
 }
@@ -253,6 +374,10 @@ int gmx_fft_init_many_1d_real(gmx_fft_t* pfft, int nx, int howmany, gmx_fft_flag
     *pfft = nullptr;
 
     FFTW_LOCK
+    if (fftw_flags == FFTW_MEASURE)
+    {
+        importWisdomLocked();
+    }
     if ((fft = static_cast<gmx_fft_t>(FFTWPREFIX(malloc)(sizeof(struct gmx_fft)))) == nullptr)
     {
         FFTW_UNLOCK
@@ -421,6 +546,10 @@ int gmx_fft_init_many_1d_real(gmx_fft_t* pfft, int nx, int howmany, gmx_fft_flag
     fft->ndim           = 1;
 
     *pfft = fft;
+    if (fftw_flags == FFTW_MEASURE)
+    {
+        exportWisdomLocked();
+    }
     FFTW_UNLOCK
     return 0;
 }
@@ -448,6 +577,10 @@ int gmx_fft_init_2d_real(gmx_fft_t* pfft, int nx, int ny, gmx_fft_flag flags)
     *pfft = nullptr;
 
     FFTW_LOCK
+    if (fftw_flags == FFTW_MEASURE)
+    {
+        importWisdomLocked();
+    }
     if ((fft = static_cast<gmx_fft_t>(FFTWPREFIX(malloc)(sizeof(struct gmx_fft)))) == nullptr)
     {
         FFTW_UNLOCK
@@ -532,6 +665,10 @@ int gmx_fft_init_2d_real(gmx_fft_t* pfft, int nx, int ny, gmx_fft_flag flags)
     fft->ndim           = 2;
 
     *pfft = fft;
+    if (fftw_flags == FFTW_MEASURE)
+    {
+        exportWisdomLocked();
+    }
     FFTW_UNLOCK
     return 0;
 }
@@ -39,6 +39,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
 #include <filesystem>
 
 #include "gromacs/fft/fft.h"
@@ -67,12 +68,20 @@ int gmx_parallel_3dfft_init(gmx_parallel_3dfft_t* pfft_setup,
     MPI_Comm   rcomm[] = { comm[1], comm[0] };
     int        Nb, Mb, Kb;  /* dimension for backtransform (in starting order) */
     t_complex *buf1, *buf2; /*intermediate buffers - used internally.*/
+    int        numCommChunks = 1;
 
     snew(*pfft_setup, 1);
     if (bReproducible)
     {
         flags |= FFT5D_NOMEASURE;
     }
+    else if (const char* env = getenv("GMX_PME_FFT_COMM_CHUNKS"))
+    {
+        /* Split the transposes in chunks that overlap with the 1D FFTs.
+         * Not with reproducibility, as the chunk plans could use different code paths.
+         */
+        numCommChunks = std::max(1, std::atoi(env));
+    }
 
     if (!(flags & FFT5D_ORDER_YZ))
     {
@@ -87,8 +96,18 @@ int gmx_parallel_3dfft_init(gmx_parallel_3dfft_t* pfft_setup,
         Kb = M; /* currently always true because ORDER_YZ always set */
     }
 
-    (*pfft_setup)->p1 = fft5d_plan_3d(
-            rN, M, K, rcomm, flags, reinterpret_cast<t_complex**>(real_data), complex_data, &buf1, &buf2, nthreads, realGridAllocation);
+    (*pfft_setup)->p1 = fft5d_plan_3d(rN,
+                                      M,
+                                      K,
+                                      rcomm,
+                                      flags,
+                                      reinterpret_cast<t_complex**>(real_data),
+                                      complex_data,
+                                      &buf1,
+                                      &buf2,
+                                      nthreads,
+                                      realGridAllocation,
+                                      numCommChunks);
 
     (*pfft_setup)->p2 = fft5d_plan_3d(Nb,
                                       Mb,
@@ -99,7 +118,9 @@ int gmx_parallel_3dfft_init(gmx_parallel_3dfft_t* pfft_setup,
                                       reinterpret_cast<t_complex**>(real_data),
                                       &buf1,
                                       &buf2,
-                                      nthreads);
+                                      nthreads,
+                                      gmx::PinningPolicy::CannotBePinned,
+                                      numCommChunks);
 
     return static_cast<int>((*pfft_setup)->p1 != nullptr && (*pfft_setup)->p2 != nullptr);
 }
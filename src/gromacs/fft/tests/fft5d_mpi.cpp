@@ -0,0 +1,247 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests the chunked transposes of the parallel 3D FFT in fft5d.
+ *
+ * The chunked transposes, which overlap communication with the 1D FFTs,
+ * should give the same results as the unchunked transposes.
+ *
+ * \ingroup module_fft
+ */
+#include "gmxpre.h"
+
+#include "config.h"
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "gromacs/fft/fft5d.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/gmxmpi.h"
+#include "gromacs/utility/gmxomp.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/stringutil.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/mpitest.h"
+#include "testutils/testasserts.h"
+#include "testutils/testmatchers.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! A forward and backward real-complex 3D FFT plan pair, set up as in gmx_parallel_3dfft_init()
+class Fft5dPlanPair
+{
+public:
+    /*! \brief Constructor
+     *
+     * \param[in] gridSize       The size of the real grid
+     * \param[in] comm           The communicators along the major and minor dimension
+     * \param[in] numThreads     The number of OpenMP threads
+     * \param[in] numCommChunks  The number of chunks for the transposes
+     */
+    Fft5dPlanPair(const IVec& gridSize, MPI_Comm comm[2], int numThreads, int numCommChunks)
+    {
+        const int flags   = FFT5D_REALCOMPLEX | FFT5D_ORDER_YZ | FFT5D_NOMEASURE;
+        MPI_Comm  rcomm[] = { comm[1], comm[0] };
+        t_complex* buf1   = nullptr;
+        t_complex* buf2   = nullptr;
+
+        forward_ = fft5d_plan_3d(gridSize[ZZ],
+                                 gridSize[YY],
+                                 gridSize[XX],
+                                 rcomm,
+                                 flags,
+                                 reinterpret_cast<t_complex**>(&realData_),
+                                 &complexData_,
+                                 &buf1,
+                                 &buf2,
+                                 numThreads,
+                                 PinningPolicy::CannotBePinned,
+                                 numCommChunks);
+        backward_ = fft5d_plan_3d(gridSize[XX],
+                                  gridSize[ZZ],
+                                  gridSize[YY],
+                                  rcomm,
+                                  (flags | FFT5D_BACKWARD | FFT5D_NOMALLOC) ^ FFT5D_ORDER_YZ,
+                                  &complexData_,
+                                  reinterpret_cast<t_complex**>(&realData_),
+                                  &buf1,
+                                  &buf2,
+                                  numThreads,
+                                  PinningPolicy::CannotBePinned,
+                                  numCommChunks);
+    }
+
+    ~Fft5dPlanPair()
+    {
+        fft5d_destroy(backward_);
+        fft5d_destroy(forward_);
+    }
+
+    //! Executes the forward transform when \p forward is true, otherwise the backward one
+    void execute(bool forward)
+    {
+        fft5d_plan plan       = forward ? forward_ : backward_;
+        const int  numThreads = plan->nthreads;
+#pragma omp parallel num_threads(numThreads)
+        {
+            fft5d_execute(plan, gmx_omp_get_thread_num(), nullptr);
+        }
+    }
+
+    //! Returns the local real grid, lines along z have a padded length
+    ArrayRef<real> realGrid()
+    {
+        return { realData_, realData_ + forward_->pM[0] * forward_->pK[0] * 2 * forward_->C[0] };
+    }
+
+    //! Returns the length of the z-lines of the real grid, including padding
+    int realLineStride() const { return 2 * forward_->C[0]; }
+
+    //! Returns the local complex grid as reals
+    ArrayRef<real> complexGrid()
+    {
+        real* data = reinterpret_cast<real*>(complexData_);
+        return { data, data + 2 * backward_->pM[0] * backward_->pK[0] * backward_->C[0] };
+    }
+
+private:
+    //! The forward real to complex plan
+    fft5d_plan forward_ = nullptr;
+    //! The backward complex to real plan
+    fft5d_plan backward_ = nullptr;
+    //! The real grid, owned by forward_
+    real* realData_ = nullptr;
+    //! The complex grid, owned by forward_
+    t_complex* complexData_ = nullptr;
+};
+
+//! Parameters: grid size, number of ranks along the major dimension, threads, transpose chunks
+using Fft5dChunkedTestParameters = std::tuple<IVec, int, int, int>;
+
+class Fft5dChunkedTest : public ::testing::TestWithParam<Fft5dChunkedTestParameters>
+{
+};
+
+TEST_P(Fft5dChunkedTest, MatchesUnchunkedTransposes)
+{
+    GMX_MPI_TEST(RequireRankCount<4>);
+
+    const auto [gridSize, numRanksMajor, numThreads, numCommChunks] = GetParam();
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    const int numRanksMinor = getNumberOfTestMpiRanks() / numRanksMajor;
+
+    /* Set up the communicators as done for PME */
+    MPI_Comm comm[2] = { MPI_COMM_NULL, MPI_COMM_NULL };
+    if (numRanksMinor == 1)
+    {
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm[0]);
+    }
+    else
+    {
+        MPI_Comm_split(MPI_COMM_WORLD, rank % numRanksMinor, rank, &comm[0]);
+        MPI_Comm_split(MPI_COMM_WORLD, rank / numRanksMinor, rank, &comm[1]);
+    }
+
+    {
+        Fft5dPlanPair reference(gridSize, comm, numThreads, 1);
+        Fft5dPlanPair chunked(gridSize, comm, numThreads, numCommChunks);
+
+        /* Fill the local real grid with the same data for both plans, padding included */
+        std::mt19937                     generator(rank);
+        std::uniform_real_distribution<> distribution(-1.0, 1.0);
+        std::vector<real>                input(reference.realGrid().size());
+        for (real& value : input)
+        {
+            value = distribution(generator);
+        }
+        ASSERT_EQ(input.size(), chunked.realGrid().size());
+        std::copy(input.begin(), input.end(), reference.realGrid().begin());
+        std::copy(input.begin(), input.end(), chunked.realGrid().begin());
+
+        const auto tolerance = relativeToleranceAsPrecisionDependentUlp(10.0, 64, 512);
+
+        reference.execute(true);
+        chunked.execute(true);
+        ASSERT_EQ(reference.complexGrid().size(), chunked.complexGrid().size());
+        EXPECT_THAT(chunked.complexGrid(), Pointwise(RealEq(tolerance), reference.complexGrid()))
+                << "complex grid after the forward transform";
+
+        reference.execute(false);
+        chunked.execute(false);
+        /* Only compare the real grid values, the padding is not used in the backward transform */
+        const int lineStride = reference.realLineStride();
+        for (size_t start = 0; start < input.size(); start += lineStride)
+        {
+            const size_t lineLength = gridSize[ZZ];
+            EXPECT_THAT(chunked.realGrid().subArray(start, lineLength),
+                        Pointwise(RealEq(tolerance), reference.realGrid().subArray(start, lineLength)))
+                    << formatString("real grid line %zu after the backward transform", start / lineStride);
+        }
+    }
+
+    for (MPI_Comm& c : comm)
+    {
+        if (c != MPI_COMM_NULL)
+        {
+            MPI_Comm_free(&c);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(WithVariousDecompositions,
+                         Fft5dChunkedTest,
+                         ::testing::Combine(::testing::Values(IVec{ 16, 12, 10 }, IVec{ 15, 11, 9 }),
+                                            ::testing::Values(4, 2),
+                                            ::testing::Values(1, 2),
+                                            ::testing::Values(2, 3, 16)));
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -45,6 +45,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -574,7 +575,7 @@ bool H5md::readNextFrame(t_trxframe* frame, const std::string& selectionName)
         ArrayRef<RVec> velocities{};
         ArrayRef<RVec> forces{};
 
-        frame->natoms = readCursor.block().numParticles();
+        frame->natoms = readCursor.numParticlesToRead();
         if (frame->bX)
         {
             srenew(frame->x, frame->natoms);
@@ -610,6 +611,43 @@ bool H5md::readNextFrame(t_trxframe* frame, const std::string& selectionName)
 #endif
 }
 
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+void H5md::setParticlesToRead(ArrayRef<const int> particleIndices, const std::string& selectionName)
+{
+#if GMX_USE_HDF5
+    particleBlocks_.at(selectionName).setSelection(particleIndices);
+#else
+    throw gmx::NotImplementedError(
+            "GROMACS was compiled without HDF5 support, cannot handle this file type");
+    GMX_UNUSED_VALUE(particleIndices);
+    GMX_UNUSED_VALUE(selectionName);
+#endif
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+bool H5md::seekToTime(const double time, const std::string& selectionName)
+{
+#if GMX_USE_HDF5
+    return particleBlocks_.at(selectionName).seekToTime(time);
+#else
+    throw gmx::NotImplementedError(
+            "GROMACS was compiled without HDF5 support, cannot handle this file type");
+    GMX_UNUSED_VALUE(time);
+    GMX_UNUSED_VALUE(selectionName);
+#endif
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+void H5md::rewind()
+{
+#if GMX_USE_HDF5
+    for (auto& [name, readCursor] : particleBlocks_)
+    {
+        readCursor.rewind();
+    }
+#endif
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 void H5md::writeNextFrame(ArrayRef<const RVec> positions,
                           ArrayRef<const RVec> velocities,
@@ -663,6 +701,63 @@ void H5md::writeNextFrame(ArrayRef<const RVec> positions,
 }
 
 #if GMX_USE_HDF5
+void H5md::TrajectoryReadCursor::setSelection(ArrayRef<const int> selection)
+{
+    for (auto it = selection.begin(); it != selection.end(); ++it)
+    {
+        GMX_H5MD_THROW_UPON_ERROR(
+                *it < 0 || *it >= block_.numParticles(),
+                formatString("Cannot read particle %d: particle block has %lld particles",
+                             *it,
+                             static_cast<long long>(block_.numParticles())));
+        GMX_H5MD_THROW_UPON_ERROR(
+                it != selection.begin() && *it <= *(it - 1),
+                "Cannot read particles with indices that are not strictly increasing");
+    }
+    selection_.assign(selection.begin(), selection.end());
+}
+
+bool H5md::TrajectoryReadCursor::seekToTime(const double time)
+{
+    // Frames of different data blocks may be stored at different times, so we find
+    // the first frame in each block separately. Without time data we can not seek.
+    const auto findFrameIndex = [time](H5mdTimeDataBlock<RVec>& dataBlock,
+                                       const int64_t nextFrameToRead) -> std::optional<int64_t>
+    {
+        const std::optional<int64_t> frameIndex = dataBlock.firstFrameIndexAtOrAfterTime(time);
+        if (!frameIndex.has_value())
+        {
+            return std::nullopt;
+        }
+        return std::max(frameIndex.value(), nextFrameToRead);
+    };
+
+    std::optional<int64_t> positionFrame = nextPositionFrameToRead_;
+    std::optional<int64_t> velocityFrame = nextVelocityFrameToRead_;
+    std::optional<int64_t> forceFrame    = nextForceFrameToRead_;
+    if (block_.hasPosition())
+    {
+        positionFrame = findFrameIndex(*block_.position(), nextPositionFrameToRead_);
+    }
+    if (block_.hasVelocity())
+    {
+        velocityFrame = findFrameIndex(*block_.velocity(), nextVelocityFrameToRead_);
+    }
+    if (block_.hasForce())
+    {
+        forceFrame = findFrameIndex(*block_.force(), nextForceFrameToRead_);
+    }
+    if (!positionFrame.has_value() || !velocityFrame.has_value() || !forceFrame.has_value())
+    {
+        return false;
+    }
+
+    nextPositionFrameToRead_ = positionFrame.value();
+    nextVelocityFrameToRead_ = velocityFrame.value();
+    nextForceFrameToRead_    = forceFrame.value();
+    return true;
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 bool H5md::TrajectoryReadCursor::nextFrameContents(bool* hasPosition,
                                                    bool* hasVelocity,
@@ -729,13 +824,20 @@ bool H5md::TrajectoryReadCursor::readNextFrame(ArrayRef<RVec> positions,
                 "Cannot read %s for group '%s': no data set exists", blockType, c_fullSystemGroupName);
     };
 
+    // Read either all particles, or only the selected particles of the frame
+    const auto readFrame =
+            [&](H5mdTimeDataBlock<RVec>& dataBlock, const int64_t frameIndex, ArrayRef<RVec> values)
+    {
+        return selection_.empty() ? dataBlock.readFrame(frameIndex, values, step, time)
+                                  : dataBlock.readFrame(frameIndex, selection_, values, step, time);
+    };
+
     bool                   frameWasRead    = false;
     std::optional<int64_t> stepThatWasRead = std::nullopt;
     if (!positions.empty())
     {
         GMX_H5MD_THROW_UPON_ERROR(!block_.hasPosition(), blockNotFoundError("positions"));
-        frameWasRead = block_.position()->readFrame(nextPositionFrameToRead_, positions, step, time)
-                       || frameWasRead;
+        frameWasRead = readFrame(*block_.position(), nextPositionFrameToRead_, positions) || frameWasRead;
         // TODO: For a constant box we must also read it!
         GMX_H5MD_THROW_UPON_ERROR(!block_.hasBox(), blockNotFoundError("box"));
         block_.box()->readFrame(nextPositionFrameToRead_,
@@ -750,8 +852,7 @@ bool H5md::TrajectoryReadCursor::readNextFrame(ArrayRef<RVec> positions,
     if (!velocities.empty())
     {
         GMX_H5MD_THROW_UPON_ERROR(!block_.hasVelocity(), blockNotFoundError("velocities"));
-        frameWasRead = block_.velocity()->readFrame(nextVelocityFrameToRead_, velocities, step, time)
-                       || frameWasRead;
+        frameWasRead = readFrame(*block_.velocity(), nextVelocityFrameToRead_, velocities) || frameWasRead;
 
         GMX_H5MD_THROW_UPON_ERROR(
                 stepThatWasRead.has_value() && *step != stepThatWasRead.value(),
@@ -762,7 +863,7 @@ bool H5md::TrajectoryReadCursor::readNextFrame(ArrayRef<RVec> positions,
     if (!forces.empty())
     {
         GMX_H5MD_THROW_UPON_ERROR(!block_.hasForce(), blockNotFoundError("forces"));
-        frameWasRead = block_.force()->readFrame(nextForceFrameToRead_, forces, step, time) || frameWasRead;
+        frameWasRead = readFrame(*block_.force(), nextForceFrameToRead_, forces) || frameWasRead;
 
         GMX_H5MD_THROW_UPON_ERROR(
                 stepThatWasRead.has_value() && *step != stepThatWasRead.value(),
@@ -54,6 +54,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "gromacs/utility/vectypes.h"
 
@@ -102,10 +103,11 @@ private:
      *
      * Writing trajectory data always appends frames to the respective data sets. When reading
      * we want more up front control over the index to facilitate things like seeking. This
-     * cursor will faciliate this behavior.
+     * cursor keeps the index of the next frame to read for each data block, which can be
+     * moved to a given time with \c seekToTime or back to the first frame with \c rewind.
      *
-     * TODO: This class is only sketched out for now. Expand functionality as needed
-     * when implementing reading.
+     * The cursor can also be restricted to read a subset of the particles with
+     * \c setSelection. Only the data of the selected particles is then read from the file.
      */
     class TrajectoryReadCursor
     {
@@ -122,6 +124,41 @@ private:
         //! \brief Return the particle block.
         H5mdParticleBlock& block() { return block_; }
 
+        //! \brief Return the number of particles which are read for each frame.
+        int64_t numParticlesToRead() const
+        {
+            return selection_.empty() ? block_.numParticles()
+                                      : static_cast<int64_t>(selection_.size());
+        }
+
+        /*! \brief Set the \p selection of particles to read for each frame.
+         *
+         * \param[in] selection Strictly increasing particle indices, or empty for all particles.
+         *
+         * \throws gmx::FileIOError if \p selection is not strictly increasing or has indices
+         *     outside of the particle block.
+         */
+        void setSelection(ArrayRef<const int> selection);
+
+        /*! \brief Move the cursor to the first frame of each data block not before \p time.
+         *
+         * The cursor is never moved backwards. It is not moved at all if any data block
+         * has no time data set.
+         *
+         * \param[in] time Time to move the cursor to.
+         *
+         * \returns True if the cursor was moved, otherwise false.
+         */
+        bool seekToTime(double time);
+
+        //! \brief Move the cursor back to the first frame of every data block.
+        void rewind()
+        {
+            nextPositionFrameToRead_ = 0;
+            nextVelocityFrameToRead_ = 0;
+            nextForceFrameToRead_    = 0;
+        }
+
         /*! \brief Check which data blocks are available for the next frame and return whether a next frame exists.
          *
          * \param[out] hasPosition Whether or not position data exist for the next frame.
@@ -160,7 +197,7 @@ private:
          *
          * \throws gmx::FileIOError if \p position, \p velocity or \p force data is given
          *     but the corresponding data set has not been created, or if the size of
-         *     the data buffers do not match the number of atoms of the system.
+         *     the data buffers do not match the number of particles to read.
          */
         bool readNextFrame(ArrayRef<RVec> position,
                            ArrayRef<RVec> velocity,
@@ -176,6 +213,9 @@ private:
         int64_t nextPositionFrameToRead_;
         int64_t nextVelocityFrameToRead_;
         int64_t nextForceFrameToRead_;
+
+        //! \brief Indices of the particles to read, or empty to read all particles.
+        std::vector<int> selection_;
     };
 
     //! \brief List of particle blocks in /particles/, with the key being the block name
@@ -240,6 +280,35 @@ public:
      */
     bool readNextFrame(t_trxframe* frame, const std::string& selectionName = "system");
 
+    /*! \brief Read only the particles at \p particleIndices in subsequent frames.
+     *
+     * Only the data of the selected particles is read from the file, and the frames
+     * returned by readNextFrame() store the particles in the order of \p particleIndices.
+     *
+     * \param[in] particleIndices Strictly increasing indices of particles to read,
+     *                            or empty to read all particles.
+     * \param[in] selectionName   Name of group to read the particles from.
+     *
+     * \throws FileIOError if \p particleIndices are not strictly increasing or
+     *     are outside of the group.
+     */
+    void setParticlesToRead(ArrayRef<const int> particleIndices,
+                            const std::string&  selectionName = "system");
+
+    /*! \brief Skip to the first frame which is not before \p time.
+     *
+     * Frames are never skipped backwards.
+     *
+     * \param[in] time          Time of the frame to skip to.
+     * \param[in] selectionName Name of group to skip frames for.
+     *
+     * \returns True if frames could be skipped, false if the time of the frames is not stored.
+     */
+    bool seekToTime(double time, const std::string& selectionName = "system");
+
+    //! \brief Return to reading the first frame of the trajectory.
+    void rewind();
+
     /*! \brief Write input data as the next frame of the trajectory.
      *
      * \param[in] positions     Position data to write (or empty if not to write).
@@ -41,6 +41,8 @@
 
 #include "h5md_datasetbase.h"
 
+#include <optional>
+
 #include "gromacs/utility/basedefinitions.h"
 #include "gromacs/utility/stringutil.h"
 #include "gromacs/utility/vectypes.h"
@@ -48,6 +50,7 @@
 #include "h5md_error.h"
 #include "h5md_guard.h"
 #include "h5md_type.h"
+#include "h5md_util.h"
 
 // HDF5 constants use old style casts.
 CLANG_DIAGNOSTIC_IGNORE("-Wold-style-cast")
@@ -61,6 +64,94 @@ static hsize_t getNumDims(const hid_t dataSetHandle)
     return H5Sget_simple_extent_ndims(dataSpace);
 }
 
+/*! \brief Return the chunk cache size to use when reading the data set, if it should be changed.
+ *
+ * The size is matched to the chunk layout which was chosen when the data set was created.
+ * Compressed chunks, and chunks which span several frames along the major axis, are accessed
+ * by several reads. The cache must hold a full chunk to not read and decompress them repeatedly.
+ * Uncompressed chunks of a single frame are only read once. For these the cache is disabled,
+ * which lets HDF5 read only the selected values of a frame directly from the file instead of
+ * reading the full chunk into the cache.
+ *
+ * \returns The cache size in bytes, or std::nullopt if the data set is not chunked or if
+ *          the current chunk cache already fits the layout.
+ */
+static std::optional<size_t> chunkCacheSizeForLayout(const hid_t dataSetHandle)
+{
+    const auto [creationPropertyList, creationPropertyListGuard] =
+            makeH5mdPropertyListGuard(H5Dget_create_plist(dataSetHandle));
+    if (!handleIsValid(creationPropertyList) || H5Pget_layout(creationPropertyList) != H5D_CHUNKED)
+    {
+        return std::nullopt;
+    }
+
+    DataSetDims chunkDims(getNumDims(dataSetHandle), 0);
+    if (chunkDims.empty()
+        || H5Pget_chunk(creationPropertyList, chunkDims.size(), chunkDims.data()) < 0)
+    {
+        return std::nullopt;
+    }
+    const auto [dataType, dataTypeGuard] = makeH5mdTypeGuard(H5Dget_type(dataSetHandle));
+    size_t chunkSize = H5Tget_size(dataType);
+    for (const hsize_t d : chunkDims)
+    {
+        chunkSize *= d;
+    }
+
+    const auto [accessPropertyList, accessPropertyListGuard] =
+            makeH5mdPropertyListGuard(H5Dget_access_plist(dataSetHandle));
+    size_t numSlots, currentCacheSize;
+    double preemptionPolicy;
+    if (H5Pget_chunk_cache(accessPropertyList, &numSlots, &currentCacheSize, &preemptionPolicy) < 0)
+    {
+        return std::nullopt;
+    }
+
+    const bool isCompressed = H5Pget_nfilters(creationPropertyList) > 0;
+    if (!isCompressed && chunkDims[0] == 1)
+    {
+        return (currentCacheSize > 0) ? std::make_optional<size_t>(0) : std::nullopt;
+    }
+    return (currentCacheSize < chunkSize) ? std::make_optional(chunkSize) : std::nullopt;
+}
+
+/*! \brief Open the data set (called \p name, in \p container) with a chunk cache fit for its layout.
+ *
+ * Tuning the cache is an optimization: if it fails the data set is kept open with the
+ * default cache.
+ *
+ * \returns The handle to the data set, which is invalid if it could not be opened.
+ */
+static hid_t openDataSetWithChunkCache(const hid_t container, const char* name)
+{
+    const hid_t dataSetHandle = H5Dopen(container, name, H5P_DEFAULT);
+    if (!handleIsValid(dataSetHandle))
+    {
+        return dataSetHandle;
+    }
+
+    const std::optional<size_t> cacheSize = chunkCacheSizeForLayout(dataSetHandle);
+    if (!cacheSize.has_value())
+    {
+        return dataSetHandle;
+    }
+    const auto [accessPropertyList, accessPropertyListGuard] =
+            makeH5mdPropertyListGuard(H5Pcreate(H5P_DATASET_ACCESS));
+    if (!handleIsValid(accessPropertyList)
+        || H5Pset_chunk_cache(accessPropertyList,
+                              H5D_CHUNK_CACHE_NSLOTS_DEFAULT,
+                              cacheSize.value(),
+                              H5D_CHUNK_CACHE_W0_DEFAULT)
+                   < 0)
+    {
+        return dataSetHandle;
+    }
+
+    // The chunk cache can only be set when opening the data set, so we reopen it
+    H5Dclose(dataSetHandle);
+    return H5Dopen(container, name, accessPropertyList);
+}
+
 template<typename ValueType>
 class H5mdDataSetBase<ValueType>::Impl
 {
@@ -176,7 +267,7 @@ H5mdDataSetBase<ValueType>::H5mdDataSetBase(const hid_t dataSetHandle)
 template<typename ValueType>
 H5mdDataSetBase<ValueType>::H5mdDataSetBase(const hid_t container, const char* name)
 {
-    const hid_t dataSetHandle = H5Dopen(container, name, H5P_DEFAULT);
+    const hid_t dataSetHandle = openDataSetWithChunkCache(container, name);
     GMX_H5MD_THROW_UPON_INVALID_HID(dataSetHandle,
                                     gmx::formatString("Cannot open data set with name %s.", name));
     impl_ = std::make_unique<Impl>(dataSetHandle);
@@ -135,6 +135,41 @@ hid_t H5mdFrameDataSet<ValueType>::FrameDescription::fileDataSpaceForFrame(const
     return fileDataSpace;
 }
 
+template<typename ValueType>
+hid_t H5mdFrameDataSet<ValueType>::FrameDescription::fileDataSpaceForSelection(
+        const hsize_t       frameIndex,
+        ArrayRef<const int> selection,
+        const hid_t         dataSetHandle) noexcept
+{
+    // The hyperslab is a union of blocks in the frame at frameIndex, one for each run
+    // of consecutive indices along the first frame dimension. Every block spans the full
+    // extent of the remaining dimensions.
+    DataSetDims blockOffset(frameDimsPrimitive_.size(), 0);
+    DataSetDims blockDims = frameDimsPrimitive_;
+    blockOffset[0]        = frameIndex;
+
+    const hid_t fileDataSpace = H5Dget_space(dataSetHandle);
+    // As in fileDataSpaceForFrame() errors are left to the caller, but checked in debug mode
+    bool gmx_used_in_debug selectionFailed = (H5Sselect_none(fileDataSpace) < 0);
+    for (auto runBegin = selection.begin(); runBegin != selection.end();)
+    {
+        auto runEnd = runBegin + 1;
+        while (runEnd != selection.end() && *runEnd == *(runEnd - 1) + 1)
+        {
+            ++runEnd;
+        }
+        blockOffset[1] = *runBegin;
+        blockDims[1]   = runEnd - runBegin;
+        selectionFailed |= (H5Sselect_hyperslab(
+                                    fileDataSpace, H5S_SELECT_OR, blockOffset.data(), nullptr, blockDims.data(), nullptr)
+                            < 0);
+        runBegin = runEnd;
+    }
+    GMX_ASSERT(!selectionFailed, "Could not select hyperslab for given selection within file");
+
+    return fileDataSpace;
+}
+
 template<typename ValueType>
 H5mdFrameDataSet<ValueType>::H5mdFrameDataSet(H5mdDataSetBase<ValueType>&& dataSet) :
     Base(std::move(dataSet)),
@@ -204,6 +239,56 @@ void H5mdFrameDataSet<ValueType>::readFrame(hsize_t index, ArrayRef<ValueType> v
                               "Error reading frame data.");
 }
 
+template<typename ValueType>
+void H5mdFrameDataSet<ValueType>::readFrame(hsize_t             index,
+                                            ArrayRef<const int> selection,
+                                            ArrayRef<ValueType> values)
+{
+    GMX_H5MD_THROW_UPON_ERROR(index >= numFrames_, "Cannot read frame with index >= numFrames");
+    const DataSetDims& frameDims = frameDescription_.dims();
+    GMX_H5MD_THROW_UPON_ERROR(frameDims.empty(),
+                              "Cannot read selection from frame without frame dimensions");
+    for (auto it = selection.begin(); it != selection.end(); ++it)
+    {
+        GMX_H5MD_THROW_UPON_ERROR(
+                *it < 0 || static_cast<hsize_t>(*it) >= frameDims[0],
+                formatString("Cannot read selection with index %d outside of frame dimension %llu",
+                             *it,
+                             static_cast<unsigned long long>(frameDims[0])));
+        GMX_H5MD_THROW_UPON_ERROR(it != selection.begin() && *it <= *(it - 1),
+                                  "Cannot read selection with indices that are not strictly "
+                                  "increasing");
+    }
+    // Any selected index is within frameDims[0], so we never divide by zero here
+    const hsize_t numSelectedValues =
+            selection.empty() ? 0 : selection.size() * (frameDescription_.numValues() / frameDims[0]);
+    GMX_H5MD_THROW_UPON_ERROR(
+            values.size() != numSelectedValues,
+            formatString("Cannot read selection into buffer of incorrect size: "
+                         "size of selection is %llu values but size of buffer is %lu",
+                         static_cast<unsigned long long>(numSelectedValues),
+                         values.size()));
+    if (selection.empty())
+    {
+        return;
+    }
+
+    DataSetDims memoryDims = frameDescription_.frameDimsPrimitive();
+    memoryDims[1]          = selection.size();
+    const auto [memoryDataSpace, memoryDataSpaceGuard] =
+            makeH5mdDataSpaceGuard(H5Screate_simple(memoryDims.size(), memoryDims.data(), nullptr));
+    GMX_H5MD_THROW_UPON_INVALID_HID(memoryDataSpace,
+                                    "Could not create memory data space for selection");
+
+    const auto [fileDataSpace, fileDataSpaceGuard] = makeH5mdDataSpaceGuard(
+            frameDescription_.fileDataSpaceForSelection(index, selection, Base::id()));
+
+    GMX_H5MD_THROW_UPON_ERROR(
+            H5Dread(Base::id(), Base::nativeDataType(), memoryDataSpace, fileDataSpace, H5P_DEFAULT, values.data())
+                    < 0,
+            "Error reading selection of frame data.");
+}
+
 template<typename ValueType>
 void H5mdFrameDataSet<ValueType>::writeNextFrame(ArrayRef<const ValueType> values)
 {
@@ -154,6 +154,26 @@ public:
      */
     void readFrame(hsize_t index, ArrayRef<ValueType> values);
 
+    /*! \brief Read data at the \p selection of indices from frame at \p index into \p values.
+     *
+     * The \p selection indexes the first dimension of the frame, e.g. the atoms of a data set
+     * of size [30, 50, 3]. Only the selected data is read from the file, by selecting it as
+     * a hyperslab of the frame in which consecutive indices are merged into single blocks.
+     *
+     * The output buffer \p values must store the data of all selected indices: for a data set
+     * of BasicVector<float> with frame dimension [50] it must store exactly one value per index,
+     * for a data set of floats with frame dimension [50, 3] it must store three values per index.
+     *
+     * \param[in]  index     Frame index to read data from.
+     * \param[in]  selection Strictly increasing indices along the first frame dimension.
+     * \param[out] values    Container of values to read data into.
+     *
+     * \throws gmx::FileIOError if the frame dimension is empty, if \p selection is not strictly
+     *     increasing or has indices outside of the first frame dimension, if the size of
+     *     \p values does not match the selection or if an error occurred when reading the data.
+     */
+    void readFrame(hsize_t index, ArrayRef<const int> selection, ArrayRef<ValueType> values);
+
     /*! \brief Write data from \p values into the next frame.
      *
      * The input buffer \p values must have a size which is identical to the size
@@ -212,6 +232,20 @@ private:
          */
         hid_t fileDataSpaceForFrame(hsize_t frameIndex, hid_t dataSetHandle) noexcept;
 
+        /*! \brief Construct and return a data space for reading the \p selection of a frame.
+         *
+         * The \p selection of indices along the first frame dimension must be strictly
+         * increasing and within bounds. Consecutive indices are selected as single blocks.
+         *
+         * \note The returned handle must be closed by the caller to avoid leaking resources.
+         *
+         * \warning As for fileDataSpaceForFrame() this does not throw if the file data space
+         * cannot be selected.
+         */
+        hid_t fileDataSpaceForSelection(hsize_t             frameIndex,
+                                        ArrayRef<const int> selection,
+                                        hid_t               dataSetHandle) noexcept;
+
         //! \brief Return the frame dimensions.
         const DataSetDims& dims() const { return dims_; }
 
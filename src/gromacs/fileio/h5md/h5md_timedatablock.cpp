@@ -167,6 +167,59 @@ bool H5mdTimeDataBlock<ValueType>::readFrame(const int64_t       frameIndex,
     }
 }
 
+template<typename ValueType>
+bool H5mdTimeDataBlock<ValueType>::readFrame(const int64_t       frameIndex,
+                                             ArrayRef<const int> selection,
+                                             ArrayRef<ValueType> values,
+                                             int64_t*            step,
+                                             double*             time)
+{
+    if (frameIndex < numFrames_)
+    {
+        valueDataSet_.readFrame(frameIndex, selection, values);
+        if (step != nullptr)
+        {
+            stepDataSet_.readFrame(frameIndex, step);
+        }
+        if (timeDataSet_.has_value() && time != nullptr)
+        {
+            timeDataSet_->readFrame(frameIndex, time);
+        }
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template<typename ValueType>
+std::optional<int64_t> H5mdTimeDataBlock<ValueType>::firstFrameIndexAtOrAfterTime(const double time)
+{
+    if (!timeDataSet_.has_value())
+    {
+        return std::nullopt;
+    }
+
+    int64_t first = 0;
+    int64_t last  = numFrames_;
+    while (first < last)
+    {
+        const int64_t middle = first + (last - first) / 2;
+        double        middleTime;
+        timeDataSet_->readFrame(middle, &middleTime);
+        if (middleTime < time)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return first;
+}
+
 template<typename ValueType>
 void H5mdTimeDataBlock<ValueType>::writeNextFrame(ArrayRef<const ValueType> values, const int64_t step)
 {
@@ -165,6 +165,41 @@ public:
      */
     bool readFrame(int64_t frameIndex, ArrayRef<ValueType> values, int64_t* step, double* time);
 
+    /*! \brief Read the \p selection of the frame at \p frameIndex into the given buffers if the index exists.
+     *
+     * Only the values at the selected indices along the first frame dimension are read,
+     * see \c H5mdFrameDataSet::readFrame() for the requirements on \p selection and \p values.
+     * If \p step or \p time are nullptr their values are not read. If a time data set is
+     * not managed \p time is never read.
+     *
+     * \param[in]  frameIndex Index of frame to read.
+     * \param[in]  selection  Strictly increasing indices along the first frame dimension.
+     * \param[out] values     Buffer to read values into.
+     * \param[out] step       Buffer to read step into, or nullptr if not to read.
+     * \param[out] time       Buffer to read time into, or nullptr if not to read.
+     *
+     * \returns Whether the index is within [0,  numFrames) and thus if the frame was read.
+     * \throws  FileIOError if the selection is invalid or if there was an error reading any value.
+     */
+    bool readFrame(int64_t             frameIndex,
+                   ArrayRef<const int> selection,
+                   ArrayRef<ValueType> values,
+                   int64_t*            step,
+                   double*             time);
+
+    /*! \brief Return the index of the first frame with a time that is not before \p time.
+     *
+     * Times are stored in increasing order, so the frame is found by a binary search
+     * which only reads a few of the time values.
+     *
+     * \param[in] time Time to find the frame for.
+     *
+     * \returns The frame index, which is numFrames() if all frames are before \p time,
+     *          or std::nullopt if the time data set is not managed.
+     * \throws  FileIOError if there was an error reading a time value.
+     */
+    std::optional<int64_t> firstFrameIndexAtOrAfterTime(double time);
+
     /*! \brief Write given values and step to their data sets as the next frame.
      *
      * \note This overload throws if a time data set is managed, and is designed
@@ -58,6 +58,7 @@
 #include "gromacs/topology/mtop_util.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/baseversion.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/stringutil.h"
@@ -1288,6 +1289,109 @@ TEST_F(H5mdReadNextFrame, NonTrajectoryFrameBoolsInTrxFrameAreFalse)
     done_frame(frame);
 }
 
+TEST_F(H5mdReadNextFrame, ReadsOnlySelectedParticles)
+{
+    t_inputrec inputRecord;
+    inputRecord.nstxout = 1;
+    inputRecord.nstvout = 1;
+
+    const int  numAtoms = 6;
+    gmx_mtop_t mtop;
+    mtop.natoms = numAtoms;
+    file().setupFileFromInput(mtop, inputRecord);
+
+    std::vector<RVec> positions(numAtoms);
+    std::vector<RVec> velocities(numAtoms);
+    for (int atomIndex = 0; atomIndex < numAtoms; ++atomIndex)
+    {
+        positions[atomIndex]  = { static_cast<real>(atomIndex), 0.1, 0.01 };
+        velocities[atomIndex] = static_cast<real>(-10.0) * positions[atomIndex];
+    }
+    file().writeNextFrame(positions, velocities, {}, c_unusedBox, 0, 0.0);
+
+    const std::vector<int> selection = { 1, 2, 5 };
+    file().setParticlesToRead(selection);
+
+    t_trxframe* frame;
+    snew(frame, 1);
+    ASSERT_TRUE(file().readNextFrame(frame));
+    ASSERT_EQ(frame->natoms, gmx::ssize(selection)) << "Only the selected particles must be read";
+    for (int i = 0; i < frame->natoms; ++i)
+    {
+        EXPECT_EQ(RVec(frame->x[i]), positions[selection[i]]);
+        EXPECT_EQ(RVec(frame->v[i]), velocities[selection[i]]);
+    }
+    done_frame(frame);
+}
+
+TEST_F(H5mdReadNextFrame, SetParticlesToReadThrowsForInvalidIndices)
+{
+    t_inputrec inputRecord;
+    inputRecord.nstxout = 1;
+
+    const int  numAtoms = 6;
+    gmx_mtop_t mtop;
+    mtop.natoms = numAtoms;
+    file().setupFileFromInput(mtop, inputRecord);
+
+    EXPECT_THROW(file().setParticlesToRead(std::vector<int>{ 0, numAtoms }), gmx::FileIOError)
+            << "Must throw for indices outside of the group";
+    EXPECT_THROW(file().setParticlesToRead(std::vector<int>{ -1 }), gmx::FileIOError)
+            << "Must throw for negative indices";
+    EXPECT_THROW(file().setParticlesToRead(std::vector<int>{ 3, 2 }), gmx::FileIOError)
+            << "Must throw for indices which are not increasing";
+    EXPECT_NO_THROW(file().setParticlesToRead({})) << "Empty selection reads all particles";
+}
+
+TEST_F(H5mdReadNextFrame, SeekToTimeAndRewindWork)
+{
+    t_inputrec inputRecord;
+    inputRecord.nstxout = 1;
+    inputRecord.nstvout = 1;
+
+    const int  numAtoms = 2;
+    gmx_mtop_t mtop;
+    mtop.natoms = numAtoms;
+    file().setupFileFromInput(mtop, inputRecord);
+
+    // Write frames at times 0, 1, 2, 3
+    constexpr int     numFrames = 4;
+    std::vector<RVec> values(numAtoms);
+    for (int frameIndex = 0; frameIndex < numFrames; ++frameIndex)
+    {
+        file().writeNextFrame(values, values, {}, c_unusedBox, 10 * frameIndex, frameIndex);
+    }
+
+    t_trxframe* frame;
+    snew(frame, 1);
+    {
+        SCOPED_TRACE("Seek to time between frames");
+        EXPECT_TRUE(file().seekToTime(1.5));
+        ASSERT_TRUE(file().readNextFrame(frame));
+        EXPECT_EQ(frame->step, 20);
+        EXPECT_FLOAT_EQ(frame->time, 2.0);
+    }
+    {
+        SCOPED_TRACE("Seeking never moves backwards");
+        EXPECT_TRUE(file().seekToTime(0.0));
+        ASSERT_TRUE(file().readNextFrame(frame));
+        EXPECT_EQ(frame->step, 30);
+        EXPECT_FALSE(file().readNextFrame(frame));
+    }
+    {
+        SCOPED_TRACE("Rewind to the first frame");
+        file().rewind();
+        ASSERT_TRUE(file().readNextFrame(frame));
+        EXPECT_EQ(frame->step, 0);
+    }
+    {
+        SCOPED_TRACE("Seek past the last frame");
+        EXPECT_TRUE(file().seekToTime(10.0));
+        EXPECT_FALSE(file().readNextFrame(frame));
+    }
+    done_frame(frame);
+}
+
 } // namespace
 } // namespace test
 } // namespace gmx
@@ -47,6 +47,7 @@
 
 #include "gromacs/fileio/h5md/h5md.h"
 #include "gromacs/fileio/h5md/h5md_framedatasetbuilder.h"
+#include "gromacs/fileio/h5md/h5md_guard.h"
 #include "gromacs/fileio/h5md/h5md_type.h"
 #include "gromacs/fileio/h5md/h5md_util.h"
 #include "gromacs/fileio/h5md/tests/h5mdtestbase.h"
@@ -266,6 +267,42 @@ TYPED_TEST(H5mdDataSetBaseTest, DimsReturnsDataSetDimensions)
     EXPECT_EQ(dataSet.dims(), expectedDims) << "dims() does not return the data set dimensions";
 }
 
+//! \brief Return the chunk cache size of the opened \p dataSet.
+template<typename ValueType>
+size_t chunkCacheSize(const H5mdDataSetBase<ValueType>& dataSet)
+{
+    const auto [accessPropertyList, accessPropertyListGuard] =
+            makeH5mdPropertyListGuard(H5Dget_access_plist(dataSet.id()));
+    size_t numSlots, cacheSize;
+    double preemptionPolicy;
+    H5Pget_chunk_cache(accessPropertyList, &numSlots, &cacheSize, &preemptionPolicy);
+    return cacheSize;
+}
+
+//! \brief Test fixture for chunk cache tests.
+using H5mdDataSetBaseChunkCacheTest = H5mdTestBase;
+
+TEST_F(H5mdDataSetBaseChunkCacheTest, OpenDataSetMatchesChunkCacheToLayout)
+{
+    // Frames of 100000 BasicVector<float> are larger than the default chunk cache
+    using ValueType                      = gmx::BasicVector<float>;
+    const std::vector<hsize_t> frameDims = { 100000 };
+    const size_t               frameSize = frameDims[0] * sizeof(ValueType);
+
+    H5mdFrameDataSetBuilder<ValueType>(fileid(), "compressed")
+            .withFrameDimension(frameDims)
+            .withCompression(H5mdCompression::LosslessShuffle)
+            .build();
+    H5mdFrameDataSetBuilder<ValueType>(fileid(), "uncompressed")
+            .withFrameDimension(frameDims)
+            .build();
+
+    EXPECT_GE(chunkCacheSize(H5mdDataSetBase<ValueType>(fileid(), "compressed")), frameSize)
+            << "Chunk cache must hold a full compressed chunk";
+    EXPECT_EQ(chunkCacheSize(H5mdDataSetBase<ValueType>(fileid(), "uncompressed")), size_t{ 0 })
+            << "Chunk cache must be disabled for uncompressed chunks of a single frame";
+}
+
 //! \brief Helper struct to parametrize tests for combinations of dimensions, max dimensions and chunk dimensions.
 struct TestDimensions
 {
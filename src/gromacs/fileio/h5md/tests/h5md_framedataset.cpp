@@ -724,6 +724,103 @@ TEST_F(H5mdFrameDataSetTest, WriteAfterMaxNumFramesThrowsAfterReopen)
     }
 }
 
+TEST_F(H5mdFrameDataSetTest, ReadFrameSelectionWorksForVectorDataSets)
+{
+    using ValueType                  = gmx::BasicVector<float>;
+    constexpr int          numValues = 10;
+    const std::vector<int> selection = { 1, 2, 3, 7, 9 };
+
+    for (const auto compression :
+         { H5mdCompression::Uncompressed, H5mdCompression::LosslessShuffle })
+    {
+        const std::string name = formatString("testDataSet%d", static_cast<int>(compression));
+        H5mdFrameDataSet<ValueType> dataSet = H5mdFrameDataSetBuilder<ValueType>(fileid(), name)
+                                                      .withFrameDimension({ numValues })
+                                                      .withCompression(compression)
+                                                      .build();
+
+        std::vector<std::vector<ValueType>> valuesPerFrame;
+        for (int frameIndex = 0; frameIndex < 2; ++frameIndex)
+        {
+            std::vector<ValueType> values;
+            for (int i = 0; i < numValues; ++i)
+            {
+                values.push_back({ static_cast<float>(100 * frameIndex + i),
+                                   static_cast<float>(-i),
+                                   static_cast<float>(10 * i) });
+            }
+            dataSet.writeNextFrame(values);
+            valuesPerFrame.push_back(values);
+        }
+
+        std::vector<ValueType> readBuffer(selection.size());
+        for (int frameIndex = 0; frameIndex < 2; ++frameIndex)
+        {
+            dataSet.readFrame(frameIndex, selection, readBuffer);
+            for (size_t i = 0; i < selection.size(); ++i)
+            {
+                EXPECT_EQ(readBuffer[i], valuesPerFrame[frameIndex][selection[i]])
+                        << formatString("Incorrect value for selection index %lu of frame %d",
+                                        i,
+                                        frameIndex);
+            }
+        }
+    }
+}
+
+TEST_F(H5mdFrameDataSetTest, ReadFrameSelectionWorksForMultiDimensionalFrames)
+{
+    using ValueType = int32_t;
+
+    H5mdFrameDataSet<ValueType> dataSet = H5mdFrameDataSetBuilder<ValueType>(fileid(), "testDataSet")
+                                                  .withFrameDimension({ 5, 3 })
+                                                  .build();
+    std::vector<ValueType> values(15);
+    std::iota(values.begin(), values.end(), 0);
+    dataSet.writeNextFrame(values);
+
+    // Each selected index along the first frame dimension selects 3 values
+    std::vector<ValueType> readBuffer(9);
+    dataSet.readFrame(0, std::vector<int>{ 0, 2, 3 }, readBuffer);
+    EXPECT_EQ(readBuffer, (std::vector<ValueType>{ 0, 1, 2, 6, 7, 8, 9, 10, 11 }));
+}
+
+TEST_F(H5mdFrameDataSetTest, ReadFrameSelectionThrowsForInvalidInput)
+{
+    using ValueType = int32_t;
+
+    H5mdFrameDataSet<ValueType> dataSet = H5mdFrameDataSetBuilder<ValueType>(fileid(), "testDataSet")
+                                                  .withFrameDimension({ 5 })
+                                                  .build();
+    std::vector<ValueType> values(5, 0);
+    dataSet.writeNextFrame(values);
+
+    std::vector<ValueType> readBuffer(2);
+    EXPECT_NO_THROW(dataSet.readFrame(0, std::vector<int>{ 0, 4 }, readBuffer))
+            << "Sanity check failed: valid selection must be read";
+    EXPECT_THROW(dataSet.readFrame(1, std::vector<int>{ 0, 4 }, readBuffer), gmx::FileIOError)
+            << "Must throw for frame index >= numFrames";
+    EXPECT_THROW(dataSet.readFrame(0, std::vector<int>{ 0, 5 }, readBuffer), gmx::FileIOError)
+            << "Must throw for selection outside of frame";
+    EXPECT_THROW(dataSet.readFrame(0, std::vector<int>{ -1, 2 }, readBuffer), gmx::FileIOError)
+            << "Must throw for negative selection index";
+    EXPECT_THROW(dataSet.readFrame(0, std::vector<int>{ 4, 0 }, readBuffer), gmx::FileIOError)
+            << "Must throw for selection which is not increasing";
+    EXPECT_THROW(dataSet.readFrame(0, std::vector<int>{ 2, 2 }, readBuffer), gmx::FileIOError)
+            << "Must throw for selection with duplicate indices";
+    EXPECT_THROW(dataSet.readFrame(0, std::vector<int>{ 0, 1, 2 }, readBuffer), gmx::FileIOError)
+            << "Must throw for buffer which does not match the selection";
+
+    H5mdFrameDataSet<ValueType> scalarDataSet =
+            H5mdFrameDataSetBuilder<ValueType>(fileid(), "scalarDataSet").build();
+    scalarDataSet.writeNextFrame(constArrayRefFromArray(values.data(), 1));
+    ValueType scalarReadBuffer;
+    EXPECT_THROW(scalarDataSet.readFrame(
+                         0, std::vector<int>{ 0 }, arrayRefFromArray(&scalarReadBuffer, 1)),
+                 gmx::FileIOError)
+            << "Must throw for data set without frame dimensions";
+}
+
 } // namespace
 } // namespace test
 } // namespace gmx
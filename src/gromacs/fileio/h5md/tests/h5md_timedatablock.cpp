@@ -685,6 +685,77 @@ TEST_F(H5mdTimeDataBlockTest, ReadFrameDoesNotReadIntoNullPtrInput)
     EXPECT_EQ(readValueBuffer, valueFrame1);
 }
 
+TEST_F(H5mdTimeDataBlockTest, ReadFrameWithSelectionWorks)
+{
+    using ValueType                        = float;
+    constexpr int                numValues = 5;
+    H5mdTimeDataBlock<ValueType> dataBlock =
+            H5mdTimeDataBlockBuilder<ValueType>(fileid(), "testBlockName")
+                    .withFrameDimension({ numValues })
+                    .build();
+
+    std::vector<ValueType> values(numValues, 0.0);
+    std::iota(values.begin(), values.end(), 0);
+    constexpr int64_t stepToWrite = 5050;
+    constexpr double  timeToWrite = -5.0;
+    dataBlock.writeNextFrame(values, stepToWrite, timeToWrite);
+
+    const std::vector<int> selection = { 1, 3, 4 };
+    std::vector<ValueType> readValuesBuffer(selection.size());
+    int64_t                readStepBuffer;
+    double                 readTimeBuffer;
+
+    EXPECT_TRUE(dataBlock.readFrame(
+            0, selection, readValuesBuffer, &readStepBuffer, &readTimeBuffer))
+            << "readFrame should return true if a frame is read";
+    EXPECT_EQ(readValuesBuffer, (std::vector<ValueType>{ 1.0, 3.0, 4.0 }));
+    EXPECT_EQ(readStepBuffer, stepToWrite);
+    EXPECT_EQ(readTimeBuffer, timeToWrite);
+    EXPECT_FALSE(dataBlock.readFrame(
+            1, selection, readValuesBuffer, &readStepBuffer, &readTimeBuffer))
+            << "readFrame should return false if a frame index is invalid";
+}
+
+TEST_F(H5mdTimeDataBlockTest, FirstFrameIndexAtOrAfterTimeWorks)
+{
+    using ValueType = float;
+
+    H5mdTimeDataBlock<ValueType> dataBlock =
+            H5mdTimeDataBlockBuilder<ValueType>(fileid(), "block").build();
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(0.0), 0) << "Empty block has no frames";
+
+    // Write frames at times 0, 2, 4, ..., 18
+    constexpr int numFrames = 10;
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const ValueType value = i;
+        dataBlock.writeNextFrame(constArrayRefFromArray(&value, 1), i, 2.0 * i);
+    }
+
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(-1.0), 0);
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(0.0), 0);
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(5.0), 3);
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(6.0), 3);
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(18.0), numFrames - 1);
+    EXPECT_EQ(dataBlock.firstFrameIndexAtOrAfterTime(18.5), numFrames)
+            << "Must return numFrames if all frames are before the time";
+}
+
+TEST_F(H5mdTimeDataBlockTest, FirstFrameIndexAtOrAfterTimeReturnsNulloptWithoutTimeDataSet)
+{
+    using ValueType                = float;
+    const auto [group, groupGuard] = makeH5mdGroupGuard(createGroup(fileid(), "block"));
+
+    {
+        SCOPED_TRACE("Create value and step data sets and close them at the end of scope");
+        H5mdFrameDataSetBuilder<ValueType>(group, "value").build();
+        H5mdFrameDataSetBuilder<int64_t>(group, "step").build();
+    }
+
+    H5mdTimeDataBlock<ValueType> dataBlock(fileid(), "block");
+    EXPECT_FALSE(dataBlock.firstFrameIndexAtOrAfterTime(0.0).has_value());
+}
+
 TEST_F(H5mdTimeDataBlockTest, DefaultCompression)
 {
     using ValueType = double;
@@ -96,14 +96,29 @@ static const int magicints[] = {
 #define LASTIDX static_cast<int>((sizeof(magicints) / sizeof(*magicints)))
 
 
+/*! \brief Buffer for bit-wise reading or writing of compressed data
+ *
+ * Bits are cached in a 64-bit integer, so the data array is accessed
+ * per 4 bytes instead of per bit or per byte.
+ */
 struct DataBuffer
 {
-    std::size_t    index;
-    int            lastbits;
-    unsigned int   lastbyte;
+    std::size_t    index;         // The number of bytes written or read
+    std::size_t    size;          // The number of bytes in data, only used for reading
+    int            numCachedBits; // The number of valid bits in bitCache
+    uint64_t       bitCache;      // The cached bits, the valid bits are the lowest ones
     unsigned char* data;
 };
 
+//! Initializes the buffer for writing or for reading \p size bytes
+static void initDataBuffer(struct DataBuffer* buffer, std::size_t size)
+{
+    buffer->index         = 0;
+    buffer->size          = size;
+    buffer->numCachedBits = 0;
+    buffer->bitCache      = 0;
+}
+
 /*____________________________________________________________________________
  |
  | sendbits - encode num into buf using the specified number of bits
@@ -111,39 +126,46 @@ struct DataBuffer
  | This routines appends the value of num to the bits already present in
  | the databuffer. You need to give it the number of bits to use and you
  | better make sure that this number of bits is enough to hold the value
- | Also num must be positive.
+ | Also num must be positive. At most 32 bits can be sent per call.
+ | After the last call, flushbits() should be called.
  |
  */
 
-static void sendbits(struct DataBuffer* buffer, int num_of_bits, int num)
+static inline void sendbits(struct DataBuffer* buffer, int num_of_bits, unsigned int num)
 {
-
-    unsigned int lastbyte;
-    int          lastbits;
-
-    lastbits = buffer->lastbits;
-    lastbyte = buffer->lastbyte;
-    while (num_of_bits >= CHAR_BIT)
-    {
-        lastbyte = (lastbyte << CHAR_BIT) | ((num >> (num_of_bits - CHAR_BIT)) /* & 0xff*/);
-        buffer->data[buffer->index++] = lastbyte >> lastbits;
-        num_of_bits -= CHAR_BIT;
+    const uint64_t mask = (uint64_t(1) << num_of_bits) - 1;
+
+    buffer->bitCache = (buffer->bitCache << num_of_bits) | (num & mask);
+    buffer->numCachedBits += num_of_bits;
+    if (buffer->numCachedBits >= 4 * CHAR_BIT)
+    {
+        /* Write out 4 bytes at once, leaving less than 32 bits in the cache */
+        buffer->numCachedBits -= 4 * CHAR_BIT;
+        const auto bits = static_cast<uint32_t>(buffer->bitCache >> buffer->numCachedBits);
+
+        unsigned char* dest = buffer->data + buffer->index;
+        dest[0]             = static_cast<unsigned char>(bits >> (3 * CHAR_BIT));
+        dest[1]             = static_cast<unsigned char>(bits >> (2 * CHAR_BIT));
+        dest[2]             = static_cast<unsigned char>(bits >> CHAR_BIT);
+        dest[3]             = static_cast<unsigned char>(bits);
+        buffer->index += 4;
     }
-    if (num_of_bits > 0)
+}
+
+//! Writes the cached bits to the data array, the last byte is padded with zero bits
+static void flushbits(struct DataBuffer* buffer)
+{
+    while (buffer->numCachedBits >= CHAR_BIT)
     {
-        lastbyte = (lastbyte << num_of_bits) | num;
-        lastbits += num_of_bits;
-        if (lastbits >= CHAR_BIT)
-        {
-            lastbits -= CHAR_BIT;
-            buffer->data[buffer->index++] = lastbyte >> lastbits;
-        }
+        buffer->numCachedBits -= CHAR_BIT;
+        buffer->data[buffer->index++] =
+                static_cast<unsigned char>(buffer->bitCache >> buffer->numCachedBits);
     }
-    buffer->lastbits = lastbits;
-    buffer->lastbyte = lastbyte;
-    if (lastbits > 0)
+    if (buffer->numCachedBits > 0)
     {
-        buffer->data[buffer->index] = lastbyte << (CHAR_BIT - lastbits);
+        buffer->data[buffer->index++] = static_cast<unsigned char>(
+                buffer->bitCache << (CHAR_BIT - buffer->numCachedBits));
+        buffer->numCachedBits = 0;
     }
 }
 
@@ -239,6 +261,45 @@ static void sendints(struct DataBuffer* buffer,
     int          i, num_of_bytes, bytecnt;
     unsigned int bytes[32], tmp;
 
+    if (num_of_bits <= 64)
+    {
+        /* The combined integer fits in 64 bits, so we can use integer arithmetic */
+        uint64_t combined = nums[0];
+        for (i = 1; i < num_of_ints; i++)
+        {
+            if (nums[i] >= sizes[i])
+            {
+                fprintf(stderr,
+                        "major breakdown in sendints num %u doesn't "
+                        "match size %u\n",
+                        nums[i],
+                        sizes[i]);
+                std::exit(1);
+            }
+            combined = combined * sizes[i] + nums[i];
+        }
+        /* Send the bytes, least significant first, up to 4 bytes per call */
+        int numBitsRemaining = num_of_bits;
+        while (numBitsRemaining >= CHAR_BIT)
+        {
+            const int    numBytes    = std::min(numBitsRemaining / CHAR_BIT, 4);
+            unsigned int bytesToSend = 0;
+            for (int b = 0; b < numBytes; b++)
+            {
+                bytesToSend = (bytesToSend << CHAR_BIT) | static_cast<uint8_t>(combined);
+                combined >>= CHAR_BIT;
+            }
+            sendbits(buffer, numBytes * CHAR_BIT, bytesToSend);
+            numBitsRemaining -= numBytes * CHAR_BIT;
+        }
+        if (numBitsRemaining > 0)
+        {
+            sendbits(buffer, numBitsRemaining, static_cast<unsigned int>(combined));
+        }
+        return;
+    }
+
+    /* Use multi-byte arithmetic for combined integers with more than 64 bits */
     tmp          = nums[0];
     num_of_bytes = 0;
     do
@@ -281,7 +342,11 @@ static void sendints(struct DataBuffer* buffer,
         {
             sendbits(buffer, CHAR_BIT, bytes[i]);
         }
-        sendbits(buffer, num_of_bits - num_of_bytes * CHAR_BIT, 0);
+        for (int numZeroBits = num_of_bits - num_of_bytes * CHAR_BIT; numZeroBits > 0;
+             numZeroBits -= CHAR_BIT)
+        {
+            sendbits(buffer, std::min(numZeroBits, CHAR_BIT), 0);
+        }
     }
     else
     {
@@ -298,46 +363,48 @@ static void sendints(struct DataBuffer* buffer,
 }
 
 
+//! Makes sure that at least 32 bits are cached, bits beyond the end of the data are zero
+static inline void refillbits(struct DataBuffer* buffer)
+{
+    if (buffer->numCachedBits < 4 * CHAR_BIT)
+    {
+        uint32_t bits = 0;
+        if (buffer->index + 4 <= buffer->size)
+        {
+            const unsigned char* src = buffer->data + buffer->index;
+
+            bits = (uint32_t(src[0]) << (3 * CHAR_BIT)) | (uint32_t(src[1]) << (2 * CHAR_BIT))
+                   | (uint32_t(src[2]) << CHAR_BIT) | uint32_t(src[3]);
+        }
+        else
+        {
+            for (std::size_t b = buffer->index; b < buffer->index + 4; b++)
+            {
+                bits = (bits << CHAR_BIT) | (b < buffer->size ? buffer->data[b] : 0U);
+            }
+        }
+        buffer->index += 4;
+        buffer->bitCache = (buffer->bitCache << (4 * CHAR_BIT)) | bits;
+        buffer->numCachedBits += 4 * CHAR_BIT;
+    }
+}
+
 /*___________________________________________________________________________
  |
  | receivebits - decode number from buffer using specified number of bits
  |
  | extract the number of bits from the data array in buffer and construct an integer
- | from it. Return that value.
+ | from it. Return that value. At most 32 bits can be received per call.
  |
  */
 
-static int receivebits(struct DataBuffer* buffer, int num_of_bits)
+static inline unsigned int receivebits(struct DataBuffer* buffer, int num_of_bits)
 {
+    refillbits(buffer);
+    buffer->numCachedBits -= num_of_bits;
 
-    int          num, lastbits;
-    unsigned int lastbyte;
-    int          mask = (1 << num_of_bits) - 1;
-
-    lastbits = buffer->lastbits;
-    lastbyte = buffer->lastbyte;
-
-    num = 0;
-    while (num_of_bits >= CHAR_BIT)
-    {
-        lastbyte = (lastbyte << CHAR_BIT) | buffer->data[buffer->index++];
-        num |= (lastbyte >> lastbits) << (num_of_bits - CHAR_BIT);
-        num_of_bits -= CHAR_BIT;
-    }
-    if (num_of_bits > 0)
-    {
-        if (lastbits < num_of_bits)
-        {
-            lastbits += CHAR_BIT;
-            lastbyte = (lastbyte << CHAR_BIT) | buffer->data[buffer->index++];
-        }
-        lastbits -= num_of_bits;
-        num |= (lastbyte >> lastbits) & ((1 << num_of_bits) - 1);
-    }
-    num &= mask;
-    buffer->lastbits = lastbits;
-    buffer->lastbyte = lastbyte;
-    return num;
+    return static_cast<unsigned int>((buffer->bitCache >> buffer->numCachedBits)
+                                     & ((uint64_t(1) << num_of_bits) - 1));
 }
 
 /*____________________________________________________________________________
@@ -360,6 +427,52 @@ static void receiveints(struct DataBuffer* buffer,
     int bytes[32];
     int i, j, num_of_bytes, p, num;
 
+    if (num_of_bits <= 64)
+    {
+        /* The combined integer fits in 64 bits, so we can use integer arithmetic.
+         * Receive the bytes, least significant first, up to 4 bytes per call.
+         */
+        const bool fitsIn32Bits = (num_of_bits <= 32);
+        uint64_t   combined     = 0;
+        int        shift        = 0;
+        while (num_of_bits > CHAR_BIT)
+        {
+            const int          numBytes = std::min((num_of_bits - 1) / CHAR_BIT, 4);
+            const unsigned int received = receivebits(buffer, numBytes * CHAR_BIT);
+            for (int b = numBytes - 1; b >= 0; b--)
+            {
+                combined |= uint64_t((received >> (b * CHAR_BIT)) & 0xff) << shift;
+                shift += CHAR_BIT;
+            }
+            num_of_bits -= numBytes * CHAR_BIT;
+        }
+        combined |= uint64_t(receivebits(buffer, num_of_bits)) << shift;
+
+        for (i = num_of_ints - 1; i > 0; i--)
+        {
+            if (sizes[i] == 0)
+            {
+                fprintf(stderr, "Cannot read trajectory, file possibly corrupted.");
+                exit(1);
+            }
+            if (fitsIn32Bits)
+            {
+                /* 32-bit division is significantly faster */
+                const auto combined32 = static_cast<uint32_t>(combined);
+                nums[i]               = static_cast<int>(combined32 % sizes[i]);
+                combined              = combined32 / sizes[i];
+            }
+            else
+            {
+                nums[i] = static_cast<int>(combined % sizes[i]);
+                combined /= sizes[i];
+            }
+        }
+        nums[0] = static_cast<int>(static_cast<uint32_t>(combined));
+        return;
+    }
+
+    /* Use multi-byte arithmetic for combined integers with more than 64 bits */
     bytes[0] = bytes[1] = bytes[2] = bytes[3] = 0;
     num_of_bytes                              = 0;
     while (num_of_bits > CHAR_BIT)
@@ -527,9 +640,7 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
             }
         }
 
-        buffer.index    = 0;
-        buffer.lastbits = 0;
-        buffer.lastbyte = 0;
+        initDataBuffer(&buffer, 0);
         minint[0] = minint[1] = minint[2] = INT_MAX;
         maxint[0] = maxint[1] = maxint[2] = INT_MIN;
         prevrun                           = -1;
@@ -802,10 +913,7 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
                 sizesmall[0] = sizesmall[1] = sizesmall[2] = magicints[smallidx];
             }
         }
-        if (buffer.lastbits != 0)
-        {
-            buffer.index++;
-        }
+        flushbits(&buffer);
 
         // Store the size of the buffer as 64-bit for the new XTC format.
         // Since this only has advantages for gigantic (>300M atoms) systems,
@@ -910,10 +1018,6 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
             }
         }
 
-        buffer.index    = 0;
-        buffer.lastbits = 0;
-        buffer.lastbyte = 0;
-
         if ((xdr_int(xdrs, &(minint[0])) == 0) || (xdr_int(xdrs, &(minint[1])) == 0)
             || (xdr_int(xdrs, &(minint[2])) == 0) || (xdr_int(xdrs, &(maxint[0])) == 0)
             || (xdr_int(xdrs, &(maxint[1])) == 0) || (xdr_int(xdrs, &(maxint[2])) == 0))
@@ -1003,15 +1107,14 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
             return 0;
         }
 
-        buffer.index    = 0;
-        buffer.lastbits = 0;
-        buffer.lastbyte = 0;
+        initDataBuffer(&buffer, buffer.index);
 
-        lfp           = fp;
-        inv_precision = 1.0 / *precision;
-        run           = 0;
-        i             = 0;
-        lip           = ip;
+        /* First decode all integer coordinates in output order, the conversion
+         * to floating point is done in a separate loop below which vectorizes.
+         */
+        run = 0;
+        i   = 0;
+        lip = ip;
         while (i < lsize)
         {
             thiscoord = reinterpret_cast<int*>(lip) + static_cast<std::size_t>(i) * 3;
@@ -1070,9 +1173,10 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
                         tmp          = thiscoord[2];
                         thiscoord[2] = prevcoord[2];
                         prevcoord[2] = tmp;
-                        *lfp++       = prevcoord[0] * inv_precision;
-                        *lfp++       = prevcoord[1] * inv_precision;
-                        *lfp++       = prevcoord[2] * inv_precision;
+
+                        thiscoord[-3] = prevcoord[0];
+                        thiscoord[-2] = prevcoord[1];
+                        thiscoord[-1] = prevcoord[2];
                     }
                     else
                     {
@@ -1080,17 +1184,9 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
                         prevcoord[1] = thiscoord[1];
                         prevcoord[2] = thiscoord[2];
                     }
-                    *lfp++ = thiscoord[0] * inv_precision;
-                    *lfp++ = thiscoord[1] * inv_precision;
-                    *lfp++ = thiscoord[2] * inv_precision;
+                    thiscoord += 3;
                 }
             }
-            else
-            {
-                *lfp++ = thiscoord[0] * inv_precision;
-                *lfp++ = thiscoord[1] * inv_precision;
-                *lfp++ = thiscoord[2] * inv_precision;
-            }
             smallidx += is_smaller;
             if (is_smaller < 0)
             {
@@ -1111,6 +1207,12 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision, int magic_num
             }
             sizesmall[0] = sizesmall[1] = sizesmall[2] = magicints[smallidx];
         }
+
+        inv_precision = 1.0 / *precision;
+        for (std::size_t j = 0; j < size3; j++)
+        {
+            fp[j] = ip[j] * inv_precision;
+        }
     }
     if (we_should_free)
     {
@@ -0,0 +1,181 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for reading H5MD trajectories with read_first_frame() and read_next_frame().
+ *
+ * \ingroup module_fileio
+ */
+
+#include "gmxpre.h"
+
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/fileio/h5md/h5md.h"
+#include "gromacs/fileio/oenv.h"
+#include "gromacs/fileio/trxio.h"
+#include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/topology/topology.h"
+#include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/testfilemanager.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! The number of atoms in the test trajectory
+constexpr int c_numAtoms = 6;
+//! The number of frames in the test trajectory
+constexpr int c_numFrames = 3;
+
+//! Returns the coordinates of \p atom in \p frame in the test trajectory
+RVec testPosition(int frame, int atom)
+{
+    return { 0.1_real * atom, 0.01_real * frame, 1 };
+}
+
+//! Writes an H5MD trajectory with positions and velocities given by testPosition()
+void writeH5mdTrajectory(const std::filesystem::path& filename)
+{
+    gmx_mtop_t mtop;
+    mtop.natoms = c_numAtoms;
+    t_inputrec inputRecord;
+    inputRecord.nstxout = 1;
+    inputRecord.nstvout = 1;
+
+    H5md file(filename, H5mdFileMode::Write);
+    file.setupFileFromInput(mtop, inputRecord);
+
+    const matrix      box = { { 3, 0, 0 }, { 0, 3, 0 }, { 0, 0, 3 } };
+    std::vector<RVec> x(c_numAtoms);
+    std::vector<RVec> v(c_numAtoms);
+    for (int f = 0; f < c_numFrames; f++)
+    {
+        for (int a = 0; a < c_numAtoms; a++)
+        {
+            x[a] = testPosition(f, a);
+            v[a] = -x[a];
+        }
+        file.writeNextFrame(x, v, {}, box, f, f);
+    }
+}
+
+class H5mdTrxioTest : public ::testing::Test
+{
+public:
+    H5mdTrxioTest() : filename_(fileManager_.getTemporaryFilePath("traj.h5md"))
+    {
+        writeH5mdTrajectory(filename_);
+        output_env_init_default(&oenv_);
+    }
+    ~H5mdTrxioTest() override { output_env_done(oenv_); }
+
+    //! Checks that \p frame of the trajectory holds the atoms \p atomIndices
+    static void checkFrame(const t_trxframe& frame, int frameIndex, ArrayRef<const int> atomIndices)
+    {
+        ASSERT_EQ(frame.natoms, atomIndices.ssize());
+        EXPECT_EQ(frame.time, frameIndex);
+        for (int i = 0; i < frame.natoms; i++)
+        {
+            EXPECT_EQ(RVec(frame.x[i]), testPosition(frameIndex, atomIndices[i]));
+            EXPECT_EQ(RVec(frame.v[i]), -testPosition(frameIndex, atomIndices[i]));
+        }
+    }
+
+    TestFileManager       fileManager_;
+    std::filesystem::path filename_;
+    gmx_output_env_t*     oenv_ = nullptr;
+};
+
+TEST_F(H5mdTrxioTest, ReadsOnlySelectedAtomsInAllFrames)
+{
+    const std::vector<int> atomIndices = { 1, 2, 5 };
+
+    t_trxstatus* status;
+    t_trxframe   frame;
+    ASSERT_TRUE(read_first_frame(oenv_, &status, filename_, &frame, TRX_NEED_X | TRX_READ_V, atomIndices));
+    int frameIndex = 0;
+    do
+    {
+        checkFrame(frame, frameIndex, atomIndices);
+        frameIndex++;
+    } while (read_next_frame(oenv_, status, &frame));
+    EXPECT_EQ(frameIndex, c_numFrames);
+
+    // The selection should persist when rewinding
+    rewind_trj(status);
+    ASSERT_TRUE(read_next_frame(oenv_, status, &frame));
+    checkFrame(frame, 0, atomIndices);
+
+    done_frame(&frame);
+    close_trx(status);
+}
+
+TEST_F(H5mdTrxioTest, ReadsAllAtomsWithEmptySelection)
+{
+    const std::vector<int> allAtoms = { 0, 1, 2, 3, 4, 5 };
+
+    t_trxstatus* status;
+    t_trxframe   frame;
+    ASSERT_TRUE(read_first_frame(oenv_, &status, filename_, &frame, TRX_NEED_X | TRX_READ_V, {}));
+    checkFrame(frame, 0, allAtoms);
+
+    done_frame(&frame);
+    close_trx(status);
+}
+
+TEST_F(H5mdTrxioTest, ThrowsForInvalidSelection)
+{
+    const std::vector<int> atomIndices = { 2, c_numAtoms };
+
+    t_trxstatus* status;
+    t_trxframe   frame;
+    EXPECT_THROW(read_first_frame(oenv_, &status, filename_, &frame, TRX_NEED_X, atomIndices),
+                 FileIOError);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements helpers for the test trajectories.
+ *
+ * \ingroup module_fileio
+ */
+
+#include "gmxpre.h"
+
+#include "testtrajectory.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/fileio/filetypes.h"
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/fileio/oenv.h"
+#include "gromacs/fileio/trrio.h"
+#include "gromacs/fileio/trxio.h"
+#include "gromacs/fileio/xtcio.h"
+#include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/vectypes.h"
+
+namespace gmx
+{
+namespace test
+{
+
+void writeTrajectory(const std::filesystem::path& filename, int numFrames)
+{
+    const bool        isXtc = (fn2ftp(filename) == efXTC);
+    t_fileio*         fio   = isXtc ? open_xtc(filename, "w") : gmx_trr_open(filename, "w");
+    const matrix      box   = { { 3, 0, 0 }, { 0, 3, 0 }, { 0, 0, 3 } };
+    std::vector<RVec> x(c_numAtoms);
+    for (int f = 0; f < numFrames; f++)
+    {
+        for (int a = 0; a < c_numAtoms; a++)
+        {
+            x[a] = { 0.1_real * a, 0.01_real * f, 1 };
+        }
+        const int64_t step = 100 * f;
+        const real    time = c_frameTime * f;
+        if (isXtc)
+        {
+            write_xtc(fio, c_numAtoms, step, time, box, as_rvec_array(x.data()), 1000);
+        }
+        else
+        {
+            gmx_trr_write_frame(
+                    fio, step, time, 0, box, c_numAtoms, as_rvec_array(x.data()), nullptr, nullptr);
+        }
+    }
+    gmx_fio_close(fio);
+}
+
+std::vector<real> readFrameTimes(const std::filesystem::path& filename)
+{
+    gmx_output_env_t* oenv;
+    output_env_init_default(&oenv);
+    t_trxstatus*      status;
+    t_trxframe        frame;
+    std::vector<real> times;
+    if (read_first_frame(oenv, &status, filename, &frame, TRX_NEED_X))
+    {
+        do
+        {
+            times.push_back(frame.time);
+            // Check that the coordinates belong to the frame
+            EXPECT_NEAR(frame.x[1][YY], 0.01_real * frame.time / c_frameTime, 1e-6);
+        } while (read_next_frame(oenv, status, &frame));
+    }
+    done_frame(&frame);
+    close_trx(status);
+    output_env_done(oenv);
+
+    return times;
+}
+
+} // namespace test
+} // namespace gmx
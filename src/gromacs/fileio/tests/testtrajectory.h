@@ -0,0 +1,77 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Declares helpers for writing and reading the small XTC and TRR
+ * trajectories used in the frame index and frame prefetching tests.
+ *
+ * \ingroup module_fileio
+ */
+#ifndef GMX_FILEIO_TESTS_TESTTRAJECTORY_H
+#define GMX_FILEIO_TESTS_TESTTRAJECTORY_H
+
+#include <filesystem>
+#include <vector>
+
+#include "gromacs/utility/real.h"
+
+namespace gmx
+{
+namespace test
+{
+
+//! The number of atoms in the test trajectories, enough to use compression in XTC
+constexpr int c_numAtoms = 20;
+//! The number of frames in the test trajectories
+constexpr int c_numFrames = 10;
+//! The time between frames in the test trajectories
+constexpr real c_frameTime = 2;
+
+/*! \brief Writes an XTC or TRR trajectory, depending on the extension of \p filename
+ *
+ * The coordinates depend on the frame number, which allows checking
+ * that coordinates belong to the frame that is read.
+ */
+void writeTrajectory(const std::filesystem::path& filename, int numFrames = c_numFrames);
+
+/*! \brief Returns the times of all frames read with read_first_frame() and read_next_frame()
+ *
+ * Checks that the coordinates that are read belong to the frame.
+ */
+std::vector<real> readFrameTimes(const std::filesystem::path& filename);
+
+} // namespace test
+} // namespace gmx
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the index of the frames in XTC and TRR trajectory files.
+ *
+ * \ingroup module_fileio
+ */
+
+#include "gmxpre.h"
+
+#include "gromacs/fileio/trajectoryframeindex.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/fileio/filetypes.h"
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/fileio/oenv.h"
+#include "gromacs/fileio/timecontrol.h"
+#include "gromacs/fileio/trrio.h"
+#include "gromacs/fileio/trxio.h"
+#include "gromacs/fileio/xtcio.h"
+#include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/setenv.h"
+#include "testutils/testfilemanager.h"
+
+#include "testtrajectory.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Returns the step of the frame that starts at \p offset
+int64_t readStepAt(t_fileio* fio, gmx_off_t offset)
+{
+    gmx_fio_seek(fio, offset);
+    gmx_bool bOK;
+    if (fn2ftp(gmx_fio_getname(fio)) == efXTC)
+    {
+        int     natoms;
+        int64_t step;
+        real    time;
+        skip_xtc_frame(fio, &natoms, &step, &time, &bOK);
+        return step;
+    }
+    gmx_trr_header_t header;
+    gmx_trr_read_frame_header(fio, &header, &bOK);
+    return header.step;
+}
+
+class TrajectoryFrameIndexTest : public ::testing::TestWithParam<const char*>
+{
+public:
+    ~TrajectoryFrameIndexTest() override
+    {
+        unsetTimeValue(TimeControl::Begin);
+        unsetTimeValue(TimeControl::Delta);
+    }
+
+    TestFileManager       fileManager_;
+    std::filesystem::path filename_ = fileManager_.getTemporaryFilePath(GetParam());
+};
+
+TEST_P(TrajectoryFrameIndexTest, BuildFindsAllFrames)
+{
+    writeTrajectory(filename_);
+
+    t_fileio*  fio   = gmx_fio_open(filename_, "r");
+    const auto index = TrajectoryFrameIndex::build(fio);
+    EXPECT_EQ(gmx_fio_ftell(fio), 0);
+
+    ASSERT_EQ(index.frames().ssize(), c_numFrames);
+    for (int f = 0; f < c_numFrames; f++)
+    {
+        EXPECT_EQ(index.frames()[f].step, 100 * f);
+        EXPECT_EQ(index.frames()[f].time, c_frameTime * f);
+        EXPECT_EQ(readStepAt(fio, index.frames()[f].offset), 100 * f);
+    }
+    EXPECT_EQ(index.frames()[0].offset, 0);
+    EXPECT_EQ(index.endOffset(), static_cast<gmx_off_t>(std::filesystem::file_size(filename_)));
+    gmx_fio_close(fio);
+}
+
+TEST_P(TrajectoryFrameIndexTest, BuildSkipsIncompleteLastFrame)
+{
+    writeTrajectory(filename_);
+    std::filesystem::resize_file(filename_, std::filesystem::file_size(filename_) - 8);
+
+    t_fileio*  fio   = gmx_fio_open(filename_, "r");
+    const auto index = TrajectoryFrameIndex::build(fio);
+    gmx_fio_close(fio);
+
+    EXPECT_EQ(index.frames().ssize(), c_numFrames - 1);
+}
+
+TEST_P(TrajectoryFrameIndexTest, CanWriteAndRead)
+{
+    writeTrajectory(filename_);
+    t_fileio*  fio   = gmx_fio_open(filename_, "r");
+    const auto index = TrajectoryFrameIndex::build(fio);
+    gmx_fio_close(fio);
+
+    const auto indexFilename = trajectoryFrameIndexFilename(filename_);
+    fileManager_.manageGeneratedOutputFile(indexFilename);
+    index.write(indexFilename);
+    const auto indexRead = TrajectoryFrameIndex::read(indexFilename, filename_);
+
+    ASSERT_TRUE(indexRead.has_value());
+    ASSERT_EQ(indexRead->frames().size(), index.frames().size());
+    for (size_t f = 0; f < index.frames().size(); f++)
+    {
+        EXPECT_EQ(indexRead->frames()[f].step, index.frames()[f].step);
+        EXPECT_EQ(indexRead->frames()[f].time, index.frames()[f].time);
+        EXPECT_EQ(indexRead->frames()[f].offset, index.frames()[f].offset);
+    }
+    EXPECT_EQ(indexRead->endOffset(), index.endOffset());
+    EXPECT_EQ(indexRead->isDoublePrecision(), index.isDoublePrecision());
+}
+
+TEST_P(TrajectoryFrameIndexTest, ReadRejectsOutdatedIndex)
+{
+    writeTrajectory(filename_);
+    t_fileio* fio = gmx_fio_open(filename_, "r");
+    TrajectoryFrameIndex::build(fio).write(trajectoryFrameIndexFilename(filename_));
+    gmx_fio_close(fio);
+    fileManager_.manageGeneratedOutputFile(trajectoryFrameIndexFilename(filename_));
+
+    writeTrajectory(filename_, c_numFrames + 1);
+
+    const auto indexFilename = trajectoryFrameIndexFilename(filename_);
+    EXPECT_FALSE(TrajectoryFrameIndex::read(indexFilename, filename_).has_value());
+}
+
+TEST_P(TrajectoryFrameIndexTest, ReadRejectsMissingOrInvalidIndex)
+{
+    writeTrajectory(filename_);
+    const auto indexFilename = trajectoryFrameIndexFilename(filename_);
+    EXPECT_FALSE(TrajectoryFrameIndex::read(indexFilename, filename_).has_value());
+
+    // Use the trajectory itself as an invalid index
+    EXPECT_FALSE(TrajectoryFrameIndex::read(filename_, filename_).has_value());
+}
+
+TEST_P(TrajectoryFrameIndexTest, ReadingFramesWithIndexSkipsTheSameFrames)
+{
+    writeTrajectory(filename_);
+    setTimeValue(TimeControl::Begin, 5);
+    setTimeValue(TimeControl::Delta, 4);
+    const auto timesWithoutIndex = readFrameTimes(filename_);
+    EXPECT_EQ(timesWithoutIndex, (std::vector<real>{ 8, 12, 16 }));
+
+    // Let reading the trajectory build and write the index
+    const auto indexFilename = trajectoryFrameIndexFilename(filename_);
+    fileManager_.manageGeneratedOutputFile(indexFilename);
+    gmxSetenv("GMX_TRAJECTORY_INDEX", "1", true);
+    const auto timesWhenBuildingIndex = readFrameTimes(filename_);
+    gmxUnsetenv("GMX_TRAJECTORY_INDEX");
+    EXPECT_TRUE(std::filesystem::exists(indexFilename));
+    EXPECT_EQ(timesWhenBuildingIndex, timesWithoutIndex);
+
+    // Read again using the index file
+    EXPECT_EQ(readFrameTimes(filename_), timesWithoutIndex);
+}
+
+TEST_P(TrajectoryFrameIndexTest, ReadingAllFramesWithIndexWorks)
+{
+    writeTrajectory(filename_);
+    t_fileio* fio = gmx_fio_open(filename_, "r");
+    TrajectoryFrameIndex::build(fio).write(trajectoryFrameIndexFilename(filename_));
+    gmx_fio_close(fio);
+    fileManager_.manageGeneratedOutputFile(trajectoryFrameIndexFilename(filename_));
+
+    EXPECT_EQ(gmx::ssize(readFrameTimes(filename_)), c_numFrames);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorksWith,
+                         TrajectoryFrameIndexTest,
+                         ::testing::Values("traj.xtc", "traj.trr"));
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -0,0 +1,297 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for reading trajectory frames ahead in worker threads.
+ *
+ * \ingroup module_fileio
+ */
+
+#include "gmxpre.h"
+
+#include "gromacs/fileio/trajectoryframeprefetcher.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/fileio/filetypes.h"
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/fileio/oenv.h"
+#include "gromacs/fileio/timecontrol.h"
+#include "gromacs/fileio/trajectoryframeindex.h"
+#include "gromacs/fileio/trrio.h"
+#include "gromacs/fileio/trxio.h"
+#include "gromacs/fileio/xtcio.h"
+#include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/smalloc.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/setenv.h"
+#include "testutils/testfilemanager.h"
+
+#include "testtrajectory.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Reads the frame at the current position of \p fio into \p frame
+bool readFrame(t_fileio* fio, t_trxframe* frame)
+{
+    if (frame->x == nullptr)
+    {
+        snew(frame->x, c_numAtoms);
+    }
+    frame->natoms = c_numAtoms;
+    bool isRead;
+    if (fn2ftp(gmx_fio_getname(fio)) == efXTC)
+    {
+        gmx_bool bOK;
+        isRead = (read_next_xtc(fio,
+                                c_numAtoms,
+                                &frame->step,
+                                &frame->time,
+                                frame->box,
+                                frame->x,
+                                &frame->prec,
+                                &bOK)
+                  != 0);
+    }
+    else
+    {
+        int natoms;
+        isRead = gmx_trr_read_frame(fio,
+                                    &frame->step,
+                                    &frame->time,
+                                    &frame->lambda,
+                                    frame->box,
+                                    &natoms,
+                                    frame->x,
+                                    nullptr,
+                                    nullptr);
+    }
+    frame->bStep = isRead;
+    frame->bTime = isRead;
+    frame->bX    = isRead;
+
+    return isRead;
+}
+
+//! Returns the offsets of the frames at \p positions in the trajectory \p filename
+std::vector<gmx_off_t> frameOffsets(const std::filesystem::path& filename,
+                                    ArrayRef<const int>          positions)
+{
+    t_fileio*  fio   = gmx_fio_open(filename, "r");
+    const auto index = TrajectoryFrameIndex::build(fio);
+    gmx_fio_close(fio);
+
+    std::vector<gmx_off_t> offsets;
+    for (int position : positions)
+    {
+        offsets.push_back(index.frames()[position].offset);
+    }
+
+    return offsets;
+}
+
+class TrajectoryFramePrefetcherTest : public ::testing::TestWithParam<const char*>
+{
+public:
+    TrajectoryFramePrefetcherTest()
+    {
+        writeTrajectory(filename_);
+        clear_trxframe(&frame_, TRUE);
+    }
+    ~TrajectoryFramePrefetcherTest() override
+    {
+        done_frame(&frame_);
+        unsetTimeValue(TimeControl::Begin);
+        unsetTimeValue(TimeControl::Delta);
+        unsetTimeValue(TimeControl::End);
+    }
+
+    TestFileManager       fileManager_;
+    std::filesystem::path filename_ = fileManager_.getTemporaryFilePath(GetParam());
+    t_trxframe            frame_;
+};
+
+TEST_P(TrajectoryFramePrefetcherTest, ReturnsFramesInRequestedOrder)
+{
+    const std::vector<int> positions = { 9, 0, 5, 5, 2, 3, 8, 1 };
+    const auto             offsets   = frameOffsets(filename_, positions);
+
+    TrajectoryFramePrefetcher prefetcher(filename_, offsets, readFrame, 3, 4);
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        const auto prefetched = prefetcher.nextFrame(&frame_);
+        ASSERT_TRUE(prefetched.has_value());
+        EXPECT_EQ(prefetched->index, static_cast<int64_t>(i));
+        EXPECT_TRUE(prefetched->isValid);
+        EXPECT_EQ(frame_.step, 100 * positions[i]);
+        EXPECT_EQ(frame_.time, c_frameTime * positions[i]);
+        ASSERT_TRUE(frame_.bX);
+        EXPECT_NEAR(frame_.x[1][YY], 0.01_real * positions[i], 1e-6);
+    }
+    EXPECT_FALSE(prefetcher.nextFrame(&frame_).has_value());
+}
+
+TEST_P(TrajectoryFramePrefetcherTest, WorksWithFewerBuffersThanThreads)
+{
+    const std::vector<int> positions = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const auto             offsets   = frameOffsets(filename_, positions);
+
+    TrajectoryFramePrefetcher prefetcher(filename_, offsets, readFrame, 4, 1);
+    for (int position : positions)
+    {
+        ASSERT_TRUE(prefetcher.nextFrame(&frame_).has_value());
+        EXPECT_EQ(frame_.step, 100 * position);
+    }
+    EXPECT_FALSE(prefetcher.nextFrame(&frame_).has_value());
+}
+
+TEST_P(TrajectoryFramePrefetcherTest, CanBeDestroyedBeforeAllFramesAreReturned)
+{
+    const std::vector<int> positions = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const auto             offsets   = frameOffsets(filename_, positions);
+
+    TrajectoryFramePrefetcher prefetcher(filename_, offsets, readFrame, 2, 2);
+    ASSERT_TRUE(prefetcher.nextFrame(&frame_).has_value());
+    EXPECT_EQ(frame_.step, 0);
+}
+
+TEST_P(TrajectoryFramePrefetcherTest, RethrowsErrorsWhenTheFrameIsReturned)
+{
+    const std::vector<int> positions = { 0, 1, 2, 3 };
+    const auto             offsets   = frameOffsets(filename_, positions);
+
+    auto readFrameOrThrow = [](t_fileio* fio, t_trxframe* frame)
+    {
+        const bool isRead = readFrame(fio, frame);
+        if (frame->step == 200)
+        {
+            GMX_THROW(FileIOError("Frame can not be used"));
+        }
+        return isRead;
+    };
+    TrajectoryFramePrefetcher prefetcher(filename_, offsets, readFrameOrThrow, 2, 4);
+    ASSERT_TRUE(prefetcher.nextFrame(&frame_).has_value());
+    ASSERT_TRUE(prefetcher.nextFrame(&frame_).has_value());
+    EXPECT_THROW(prefetcher.nextFrame(&frame_), FileIOError);
+    ASSERT_TRUE(prefetcher.nextFrame(&frame_).has_value());
+    EXPECT_EQ(frame_.step, 300);
+}
+
+TEST_P(TrajectoryFramePrefetcherTest, ReadingFramesWithThreadsGivesTheSameFrames)
+{
+    const auto allTimes = readFrameTimes(filename_);
+    EXPECT_EQ(gmx::ssize(allTimes), c_numFrames);
+    setTimeValue(TimeControl::Begin, 5);
+    setTimeValue(TimeControl::Delta, 4);
+    setTimeValue(TimeControl::End, 14);
+    const auto selectedTimes = readFrameTimes(filename_);
+    EXPECT_EQ(selectedTimes, (std::vector<real>{ 8, 12 }));
+
+    gmxSetenv("GMX_TRAJECTORY_READ_THREADS", "2", true);
+    const auto selectedTimesWithThreads = readFrameTimes(filename_);
+    unsetTimeValue(TimeControl::Begin);
+    unsetTimeValue(TimeControl::Delta);
+    unsetTimeValue(TimeControl::End);
+    const auto allTimesWithThreads = readFrameTimes(filename_);
+    gmxUnsetenv("GMX_TRAJECTORY_READ_THREADS");
+
+    EXPECT_EQ(selectedTimesWithThreads, selectedTimes);
+    EXPECT_EQ(allTimesWithThreads, allTimes);
+}
+
+TEST_P(TrajectoryFramePrefetcherTest, ReadingIncompleteTrajectoryWithThreadsWorks)
+{
+    std::filesystem::resize_file(filename_, std::filesystem::file_size(filename_) - 8);
+    const auto times = readFrameTimes(filename_);
+
+    gmxSetenv("GMX_TRAJECTORY_READ_THREADS", "3", true);
+    const auto timesWithThreads = readFrameTimes(filename_);
+    gmxUnsetenv("GMX_TRAJECTORY_READ_THREADS");
+
+    EXPECT_EQ(timesWithThreads, times);
+}
+
+TEST_P(TrajectoryFramePrefetcherTest, RewindingWhileFramesArePrefetchedWorks)
+{
+    gmxSetenv("GMX_TRAJECTORY_READ_THREADS", "2", true);
+
+    gmx_output_env_t* oenv;
+    output_env_init_default(&oenv);
+    t_trxstatus* status;
+    ASSERT_TRUE(read_first_frame(oenv, &status, filename_, &frame_, TRX_NEED_X));
+    EXPECT_EQ(frame_.time, 0);
+    ASSERT_TRUE(read_next_frame(oenv, status, &frame_));
+    EXPECT_EQ(frame_.time, c_frameTime);
+
+    // The worker threads are now reading the next frames
+    rewind_trj(status);
+
+    std::vector<real> times;
+    while (read_next_frame(oenv, status, &frame_))
+    {
+        times.push_back(frame_.time);
+        EXPECT_NEAR(frame_.x[1][YY], 0.01_real * frame_.time / c_frameTime, 1e-6);
+    }
+    close_trx(status);
+    output_env_done(oenv);
+    gmxUnsetenv("GMX_TRAJECTORY_READ_THREADS");
+
+    std::vector<real> refTimes;
+    for (int f = 0; f < c_numFrames; f++)
+    {
+        refTimes.push_back(c_frameTime * f);
+    }
+    EXPECT_EQ(times, refTimes);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorksWith,
+                         TrajectoryFramePrefetcherTest,
+                         ::testing::Values("traj.xtc", "traj.trr"));
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -0,0 +1,295 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for reading and writing TRR files.
+ *
+ * \ingroup module_fileio
+ */
+
+#include "gmxpre.h"
+
+#include "gromacs/fileio/trrio.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/fileio/gmxfio_xdr.h"
+#include "gromacs/random/threefry.h"
+#include "gromacs/random/uniformrealdistribution.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/testfilemanager.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Returns \p numAtoms random vectors
+std::vector<RVec> makeRandomVectors(int numAtoms, uint64_t seed)
+{
+    ThreeFry2x64<64>              rng(seed, RandomDomain::Other);
+    UniformRealDistribution<real> dist(-10, 10);
+    std::vector<RVec>             vectors(numAtoms);
+    for (RVec& v : vectors)
+    {
+        v = { dist(rng), dist(rng), dist(rng) };
+    }
+    return vectors;
+}
+
+//! Box used in the test frames
+const matrix c_box = { { 3, 0, 0 }, { 0.5, 4, 0 }, { 0.25, 0.125, 5 } };
+
+//! The number of atoms, more than is converted in one block
+constexpr int c_numAtoms = 2500;
+
+TEST(TrrIOTest, ReadsWhatWasWritten)
+{
+    TestFileManager fileManager;
+    const auto      filename = fileManager.getTemporaryFilePath("frames.trr");
+    const auto      x        = makeRandomVectors(c_numAtoms, 1);
+    const auto      v        = makeRandomVectors(c_numAtoms, 2);
+    const auto      f        = makeRandomVectors(c_numAtoms, 3);
+
+    t_fileio* fio = gmx_trr_open(filename, "w");
+    gmx_trr_write_frame(fio, 0, 0, 0, c_box, c_numAtoms, as_rvec_array(x.data()), nullptr, nullptr);
+    gmx_trr_write_frame(fio,
+                        1,
+                        0.5,
+                        0,
+                        c_box,
+                        c_numAtoms,
+                        as_rvec_array(x.data()),
+                        as_rvec_array(v.data()),
+                        as_rvec_array(f.data()));
+    gmx_trr_close(fio);
+
+    fio = gmx_trr_open(filename, "r");
+    std::vector<RVec> xRead(c_numAtoms), vRead(c_numAtoms), fRead(c_numAtoms);
+    matrix            box;
+    for (int frame = 0; frame < 2; frame++)
+    {
+        int64_t step;
+        real    time, lambda;
+        int     natoms;
+        ASSERT_TRUE(gmx_trr_read_frame(fio,
+                                       &step,
+                                       &time,
+                                       &lambda,
+                                       box,
+                                       &natoms,
+                                       as_rvec_array(xRead.data()),
+                                       as_rvec_array(vRead.data()),
+                                       as_rvec_array(fRead.data())));
+        EXPECT_EQ(step, frame);
+        EXPECT_EQ(natoms, c_numAtoms);
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int e = 0; e < DIM; e++)
+            {
+                EXPECT_EQ(box[d][e], c_box[d][e]);
+            }
+        }
+        for (int a = 0; a < c_numAtoms; a++)
+        {
+            EXPECT_EQ(xRead[a], x[a]);
+            if (frame == 1)
+            {
+                EXPECT_EQ(vRead[a], v[a]);
+                EXPECT_EQ(fRead[a], f[a]);
+            }
+        }
+    }
+    gmx_trr_close(fio);
+}
+
+TEST(TrrIOTest, CanSkipVectors)
+{
+    TestFileManager fileManager;
+    const auto      filename = fileManager.getTemporaryFilePath("frames.trr");
+    const auto      x        = makeRandomVectors(c_numAtoms, 1);
+    const auto      v        = makeRandomVectors(c_numAtoms, 2);
+
+    t_fileio* fio = gmx_trr_open(filename, "w");
+    for (int step = 0; step < 2; step++)
+    {
+        gmx_trr_write_frame(fio,
+                            step,
+                            step,
+                            0,
+                            c_box,
+                            c_numAtoms,
+                            as_rvec_array(x.data()),
+                            as_rvec_array(v.data()),
+                            nullptr);
+    }
+    gmx_trr_close(fio);
+
+    fio = gmx_trr_open(filename, "r");
+    std::vector<RVec> vRead(c_numAtoms);
+    for (int frame = 0; frame < 2; frame++)
+    {
+        int64_t step;
+        real    time, lambda;
+        int     natoms;
+        ASSERT_TRUE(gmx_trr_read_frame(fio,
+                                       &step,
+                                       &time,
+                                       &lambda,
+                                       nullptr,
+                                       &natoms,
+                                       nullptr,
+                                       as_rvec_array(vRead.data()),
+                                       nullptr));
+        EXPECT_EQ(step, frame);
+        EXPECT_EQ(vRead, v);
+    }
+    gmx_trr_close(fio);
+}
+
+TEST(TrrIOTest, ReadsTheSameValuesAsReadingSingleVectors)
+{
+    const auto filename = TestFileManager::getTestSimulationDatabaseDirectory() / "spc2-traj.trr";
+
+    t_fileio*        fio = gmx_trr_open(filename, "r");
+    gmx_trr_header_t header;
+    gmx_bool         bOK;
+    ASSERT_TRUE(gmx_trr_read_frame_header(fio, &header, &bOK));
+    const gmx_off_t dataOffset = gmx_fio_ftell(fio);
+    ASSERT_GT(header.x_size, 0);
+    ASSERT_GT(header.v_size, 0);
+
+    std::vector<RVec> x(header.natoms), v(header.natoms), f(header.natoms);
+    matrix            box;
+    ASSERT_TRUE(gmx_trr_read_frame_data(fio,
+                                        &header,
+                                        box,
+                                        as_rvec_array(x.data()),
+                                        as_rvec_array(v.data()),
+                                        as_rvec_array(f.data())));
+
+    // Read the same data again one vector at a time
+    gmx_fio_seek(fio, dataOffset);
+    const int numMatrices = (header.box_size > 0) + (header.vir_size > 0) + (header.pres_size > 0);
+    rvec      vector;
+    for (int i = 0; i < numMatrices * DIM; i++)
+    {
+        ASSERT_TRUE(gmx_fio_do_rvec(fio, vector));
+    }
+    for (int a = 0; a < header.natoms; a++)
+    {
+        ASSERT_TRUE(gmx_fio_do_rvec(fio, vector));
+        EXPECT_EQ(RVec(vector), x[a]);
+    }
+    for (int a = 0; a < header.natoms; a++)
+    {
+        ASSERT_TRUE(gmx_fio_do_rvec(fio, vector));
+        EXPECT_EQ(RVec(vector), v[a]);
+    }
+    gmx_trr_close(fio);
+}
+
+//! Reports the throughput of reading and writing coordinates, velocities and forces
+TEST(TrrIOBenchmark, DISABLED_WriteAndReadThroughput)
+{
+    const int numAtoms  = 300000;
+    const int numFrames = 50;
+
+    TestFileManager fileManager;
+    const auto      filename = fileManager.getTemporaryFilePath("benchmark.trr");
+    auto            x        = makeRandomVectors(numAtoms, 1);
+    auto            v        = makeRandomVectors(numAtoms, 2);
+    auto            f        = makeRandomVectors(numAtoms, 3);
+
+    const auto writeStart = std::chrono::steady_clock::now();
+    t_fileio*  fio        = gmx_trr_open(filename, "w");
+    for (int step = 0; step < numFrames; step++)
+    {
+        gmx_trr_write_frame(fio,
+                            step,
+                            step,
+                            0,
+                            c_box,
+                            numAtoms,
+                            as_rvec_array(x.data()),
+                            as_rvec_array(v.data()),
+                            as_rvec_array(f.data()));
+    }
+    gmx_trr_close(fio);
+    const auto writeEnd = std::chrono::steady_clock::now();
+    fio                 = gmx_trr_open(filename, "r");
+    int     numFramesRead = 0;
+    int64_t step;
+    real    time, lambda;
+    int     natoms;
+    matrix  box;
+    while (gmx_trr_read_frame(fio,
+                              &step,
+                              &time,
+                              &lambda,
+                              box,
+                              &natoms,
+                              as_rvec_array(x.data()),
+                              as_rvec_array(v.data()),
+                              as_rvec_array(f.data())))
+    {
+        numFramesRead++;
+    }
+    gmx_trr_close(fio);
+    const auto readEnd = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(numFramesRead, numFrames);
+
+    const double megaBytes = static_cast<double>(std::filesystem::file_size(filename)) / (1024 * 1024);
+
+    const double writeSeconds = std::chrono::duration<double>(writeEnd - writeStart).count();
+    const double readSeconds  = std::chrono::duration<double>(readEnd - writeEnd).count();
+    std::printf("TRR write: %8.1f MB/s\n", megaBytes / writeSeconds);
+    std::printf("TRR read:  %8.1f MB/s\n", megaBytes / readSeconds);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
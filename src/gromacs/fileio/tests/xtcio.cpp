@@ -0,0 +1,273 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the compressed coordinate codec used for XTC files.
+ *
+ * \ingroup module_fileio
+ */
+
+#include "gmxpre.h"
+
+#include "gromacs/fileio/xtcio.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/random/threefry.h"
+#include "gromacs/random/uniformrealdistribution.h"
+#include "gromacs/utility/real.h"
+#include "gromacs/utility/smalloc.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/testfilemanager.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! The frames of a trajectory, all with the same number of atoms
+using Frames = std::vector<std::vector<RVec>>;
+
+/*! \brief Returns frames with water-like coordinates in a cubic box
+ *
+ * Every third atom is placed randomly in the box, the two following atoms
+ * are placed within 0.1 nm of it, as for water. This exercises the run-length
+ * encoding of small differences as well as the large-coordinate paths.
+ */
+Frames makeWaterLikeFrames(int numAtoms, real boxSize, int numFrames)
+{
+    ThreeFry2x64<64>              rng(987654, RandomDomain::Other);
+    UniformRealDistribution<real> dist;
+
+    Frames frames(numFrames, std::vector<RVec>(numAtoms));
+    for (auto& x : frames)
+    {
+        for (int a = 0; a < numAtoms; a++)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                if (a % 3 == 0)
+                {
+                    x[a][d] = boxSize * dist(rng);
+                }
+                else
+                {
+                    x[a][d] = x[a - a % 3][d] + 0.2_real * (dist(rng) - 0.5_real);
+                }
+            }
+        }
+    }
+
+    return frames;
+}
+
+//! Writes \p frames to an XTC file with precision \p precision
+void writeFrames(const std::filesystem::path& filename,
+                 const Frames&                frames,
+                 real                         boxSize,
+                 real                         precision)
+{
+    const matrix box  = { { boxSize, 0, 0 }, { 0, boxSize, 0 }, { 0, 0, boxSize } };
+    t_fileio*    fio  = open_xtc(filename, "w");
+    int64_t      step = 0;
+    for (const auto& x : frames)
+    {
+        const int natoms = static_cast<int>(x.size());
+        ASSERT_TRUE(write_xtc(fio, natoms, step, step, box, as_rvec_array(x.data()), precision));
+        step++;
+    }
+    close_xtc(fio);
+}
+
+//! Returns all frames read from an XTC file
+Frames readFrames(const std::filesystem::path& filename)
+{
+    Frames    frames;
+    t_fileio* fio = open_xtc(filename, "r");
+    int       natoms;
+    int64_t   step;
+    real      time;
+    matrix    box;
+    rvec*     x = nullptr;
+    real      precision;
+    gmx_bool  bOK;
+    if (read_first_xtc(fio, &natoms, &step, &time, box, &x, &precision, &bOK))
+    {
+        do
+        {
+            frames.emplace_back(x, x + natoms);
+        } while (read_next_xtc(fio, natoms, &step, &time, box, x, &precision, &bOK));
+    }
+    EXPECT_TRUE(bOK);
+    sfree(x);
+    close_xtc(fio);
+
+    return frames;
+}
+
+//! Parameters for the codec tests
+struct XtcCodecTestParameters
+{
+    //! The number of atoms
+    int numAtoms;
+    //! The size of the box
+    real boxSize;
+    //! The XTC precision
+    real precision;
+};
+
+class XtcCodecTest : public ::testing::TestWithParam<XtcCodecTestParameters>
+{
+public:
+    TestFileManager fileManager_;
+};
+
+TEST_P(XtcCodecTest, RoundTripIsWithinPrecision)
+{
+    const auto& params   = GetParam();
+    const auto  filename = fileManager_.getTemporaryFilePath("traj.xtc");
+    const auto  frames   = makeWaterLikeFrames(params.numAtoms, params.boxSize, 3);
+
+    writeFrames(filename, frames, params.boxSize, params.precision);
+    const auto framesRead = readFrames(filename);
+
+    ASSERT_EQ(frames.size(), framesRead.size());
+    for (size_t f = 0; f < frames.size(); f++)
+    {
+        ASSERT_EQ(frames[f].size(), framesRead[f].size());
+        for (size_t a = 0; a < frames[f].size(); a++)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                // Rounding to precision, plus float rounding of the result
+                const real tolerance = 0.5_real / params.precision
+                                       + 4 * GMX_FLOAT_EPS * std::abs(frames[f][a][d]);
+                EXPECT_NEAR(frames[f][a][d], framesRead[f][a][d], tolerance)
+                        << "frame " << f << " atom " << a << " dim " << d;
+            }
+        }
+    }
+}
+
+TEST_P(XtcCodecTest, RecompressionIsLossless)
+{
+    const auto& params    = GetParam();
+    const auto  filename1 = fileManager_.getTemporaryFilePath("traj1.xtc");
+    const auto  filename2 = fileManager_.getTemporaryFilePath("traj2.xtc");
+    if (params.boxSize * params.precision >= (1 << 22))
+    {
+        GTEST_SKIP() << "Float coordinates cannot represent all multiples of the precision";
+    }
+
+    writeFrames(filename1,
+                makeWaterLikeFrames(params.numAtoms, params.boxSize, 3),
+                params.boxSize,
+                params.precision);
+    const auto framesRead1 = readFrames(filename1);
+    writeFrames(filename2, framesRead1, params.boxSize, params.precision);
+    const auto framesRead2 = readFrames(filename2);
+
+    ASSERT_EQ(framesRead1.size(), framesRead2.size());
+    for (size_t f = 0; f < framesRead1.size(); f++)
+    {
+        ASSERT_EQ(framesRead1[f].size(), framesRead2[f].size());
+        for (size_t a = 0; a < framesRead1[f].size(); a++)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                EXPECT_EQ(framesRead1[f][a][d], framesRead2[f][a][d]);
+            }
+        }
+    }
+}
+
+//! Covers uncompressed, 32-bit, 64-bit, multi-byte and large-size encoding paths
+const XtcCodecTestParameters c_xtcCodecTestParameters[] = {
+    { 6, 3, 1000 },     { 10, 3, 1000 },      { 11, 3, 1000 },     { 3000, 5, 1000 },
+    { 3000, 5, 10000 }, { 3000, 2000, 1000 }, { 300, 5000, 1000 }, { 999, 50000, 1000 },
+};
+
+INSTANTIATE_TEST_SUITE_P(WorksWith, XtcCodecTest, ::testing::ValuesIn(c_xtcCodecTestParameters));
+
+/*! \brief Measures the XTC encoding and decoding throughput
+ *
+ * Uses a water-like system as most simulation systems are dominated by water.
+ * Run with --gtest_also_run_disabled_tests to get the timings.
+ */
+TEST(XtcCodecBenchmark, DISABLED_EncodeAndDecodeThroughput)
+{
+    const int  numAtoms  = 300000;
+    const real boxSize   = 15;
+    const real precision = 1000;
+    const int  numFrames = 100;
+
+    TestFileManager fileManager;
+    const auto      filename = fileManager.getTemporaryFilePath("benchmark.xtc");
+    const auto      frames   = makeWaterLikeFrames(numAtoms, boxSize, numFrames);
+
+    const auto encodeStart = std::chrono::steady_clock::now();
+    writeFrames(filename, frames, boxSize, precision);
+    const auto   encodeEnd     = std::chrono::steady_clock::now();
+    const auto   framesRead    = readFrames(filename);
+    const auto   decodeEnd     = std::chrono::steady_clock::now();
+    const double encodeSeconds = std::chrono::duration<double>(encodeEnd - encodeStart).count();
+    const double decodeSeconds = std::chrono::duration<double>(decodeEnd - encodeEnd).count();
+
+    EXPECT_EQ(framesRead.size(), frames.size());
+
+    // Throughput is reported for the uncompressed single-precision coordinate data
+    const double megaBytes = double(numFrames) * numAtoms * DIM * sizeof(float) / (1024 * 1024);
+    std::printf("XTC encode: %8.1f MB/s %8.1f frames/s\n",
+                megaBytes / encodeSeconds,
+                numFrames / encodeSeconds);
+    std::printf("XTC decode: %8.1f MB/s %8.1f frames/s\n",
+                megaBytes / decodeSeconds,
+                numFrames / decodeSeconds);
+    std::printf("XTC file size: %.1f MB\n",
+                static_cast<double>(std::filesystem::file_size(filename)) / (1024 * 1024));
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -0,0 +1,253 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements the index of the frames in XTC and TRR trajectory files.
+ *
+ * \ingroup module_fileio
+ */
+#include "gmxpre.h"
+
+#include "trajectoryframeindex.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+#include "gromacs/fileio/filetypes.h"
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/fileio/trrio.h"
+#include "gromacs/fileio/xtcio.h"
+#include "gromacs/serialization/inmemoryserializer.h"
+#include "gromacs/serialization/iserializer.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/real.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! Identifies frame index files
+constexpr int32_t c_frameIndexMagic = 0x464d4958;
+//! The version of the frame index file format
+constexpr int32_t c_frameIndexVersion = 1;
+//! Frame index files are stored in little-endian byte order
+constexpr EndianSwapBehavior c_endianSwapBehavior = EndianSwapBehavior::SwapIfHostIsBigEndian;
+
+//! Returns the size and modification time of \p filename, or zeros when it can not be accessed
+std::pair<int64_t, int64_t> fileSizeAndModificationTime(const std::filesystem::path& filename)
+{
+    std::error_code errorCode;
+    const auto      size = std::filesystem::file_size(filename, errorCode);
+    if (errorCode)
+    {
+        return { 0, 0 };
+    }
+    const auto modificationTime = std::filesystem::last_write_time(filename, errorCode);
+    if (errorCode)
+    {
+        return { 0, 0 };
+    }
+
+    return { static_cast<int64_t>(size),
+             static_cast<int64_t>(modificationTime.time_since_epoch().count()) };
+}
+
+} // namespace
+
+TrajectoryFrameIndex TrajectoryFrameIndex::build(t_fileio* fio)
+{
+    const int fileType = gmx_fio_getftp(fio);
+    if (fileType != efXTC && fileType != efTRR)
+    {
+        GMX_THROW(InvalidInputError("Frame indices can only be built for XTC and TRR files"));
+    }
+
+    TrajectoryFrameIndex index;
+    std::tie(index.trajectorySize_, index.trajectoryModificationTime_) =
+            fileSizeAndModificationTime(gmx_fio_getname(fio));
+
+    const gmx_off_t startPosition = gmx_fio_ftell(fio);
+    gmx_fio_seek(fio, 0);
+
+    gmx_off_t offset = 0;
+    bool      bRead  = true;
+    while (bRead)
+    {
+        Frame    frame{ 0, 0, offset };
+        gmx_bool bOK = TRUE;
+        if (fileType == efXTC)
+        {
+            int  natoms;
+            real time;
+            bRead      = (skip_xtc_frame(fio, &natoms, &frame.step, &time, &bOK) != 0);
+            frame.time = time;
+        }
+        else
+        {
+            gmx_trr_header_t header;
+            bRead = (gmx_trr_read_frame_header(fio, &header, &bOK) != 0);
+            if (bRead)
+            {
+                const gmx_off_t dataSize = header.box_size + header.vir_size + header.pres_size
+                                           + gmx_off_t(header.x_size) + gmx_off_t(header.v_size)
+                                           + gmx_off_t(header.f_size);
+                bRead = (gmx_fio_seek(fio, gmx_fio_ftell(fio) + dataSize) == 0);
+
+                frame.step               = header.step;
+                frame.time               = header.t;
+                index.isDoublePrecision_ = header.bDouble;
+            }
+        }
+        offset = gmx_fio_ftell(fio);
+        // Seeking succeeds past the end of the file, so check for incomplete frames
+        bRead = bRead && bOK && offset <= index.trajectorySize_;
+        if (bRead)
+        {
+            index.frames_.push_back(frame);
+            index.endOffset_ = offset;
+        }
+    }
+
+    gmx_fio_seek(fio, startPosition);
+
+    return index;
+}
+
+std::optional<TrajectoryFrameIndex> TrajectoryFrameIndex::read(
+        const std::filesystem::path& indexFile, const std::filesystem::path& trajectoryFile)
+{
+    std::ifstream stream(indexFile, std::ios::binary);
+    if (!stream)
+    {
+        return std::nullopt;
+    }
+    const std::vector<char> buffer{ std::istreambuf_iterator<char>(stream),
+                                    std::istreambuf_iterator<char>() };
+
+    // Check the sizes while deserializing, as the deserializer does not check bounds
+    if (stream.bad() || buffer.size() < serializedSize(0))
+    {
+        return std::nullopt;
+    }
+    TrajectoryFrameIndex index;
+    InMemoryDeserializer serializer(buffer, false, c_endianSwapBehavior);
+    int64_t              numFrames = 0;
+    if (!index.serializeHeader(&serializer, &numFrames)
+        || buffer.size() != serializedSize(static_cast<size_t>(numFrames)))
+    {
+        return std::nullopt;
+    }
+    index.frames_.resize(numFrames);
+    index.serializeFrames(&serializer);
+
+    const auto [size, modificationTime] = fileSizeAndModificationTime(trajectoryFile);
+    if (size != index.trajectorySize_ || modificationTime != index.trajectoryModificationTime_)
+    {
+        return std::nullopt;
+    }
+
+    return index;
+}
+
+void TrajectoryFrameIndex::write(const std::filesystem::path& indexFile) const
+{
+    InMemorySerializer   serializer(c_endianSwapBehavior);
+    TrajectoryFrameIndex indexCopy = *this;
+    int64_t              numFrames = frames_.size();
+    indexCopy.serializeHeader(&serializer, &numFrames);
+    indexCopy.serializeFrames(&serializer);
+    const std::vector<char> buffer = serializer.finishAndGetBuffer();
+
+    std::ofstream stream(indexFile, std::ios::binary | std::ios::trunc);
+    stream.write(buffer.data(), buffer.size());
+    if (!stream)
+    {
+        GMX_THROW(FileIOError("Could not write frame index file " + indexFile.string()));
+    }
+}
+
+bool TrajectoryFrameIndex::serializeHeader(ISerializer* serializer, int64_t* numFrames)
+{
+    int32_t magic   = c_frameIndexMagic;
+    int32_t version = c_frameIndexVersion;
+    serializer->doInt32(&magic);
+    serializer->doInt32(&version);
+    serializer->doInt64(&trajectorySize_);
+    serializer->doInt64(&trajectoryModificationTime_);
+    serializer->doBool(&isDoublePrecision_);
+    serializer->doInt64(&endOffset_);
+    serializer->doInt64(numFrames);
+
+    // Every frame takes more than one byte in the trajectory
+    return magic == c_frameIndexMagic && version == c_frameIndexVersion && *numFrames >= 0
+           && *numFrames <= trajectorySize_;
+}
+
+void TrajectoryFrameIndex::serializeFrames(ISerializer* serializer)
+{
+    for (Frame& frame : frames_)
+    {
+        serializer->doInt64(&frame.step);
+        serializer->doDouble(&frame.time);
+        serializer->doInt64(&frame.offset);
+    }
+}
+
+size_t TrajectoryFrameIndex::serializedSize(size_t numFrames)
+{
+    InMemorySerializer   serializer(c_endianSwapBehavior);
+    TrajectoryFrameIndex index;
+    int64_t              numFramesInHeader = 0;
+    index.serializeHeader(&serializer, &numFramesInHeader);
+    const size_t frameSize = sizeof(Frame::step) + sizeof(Frame::time) + sizeof(Frame::offset);
+
+    return serializer.finishAndGetBuffer().size() + numFrames * frameSize;
+}
+
+std::filesystem::path trajectoryFrameIndexFilename(const std::filesystem::path& trajectoryFilename)
+{
+    std::filesystem::path indexFilename = trajectoryFilename;
+    indexFilename += ".idx";
+
+    return indexFilename;
+}
+
+} // namespace gmx
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares an index of the frames in XTC and TRR trajectory files.
+ *
+ * The index stores the step, time and file offset of each frame, so that
+ * readers can jump directly to any frame or time without scanning or
+ * bisecting the file. The index can be stored in a file next to the
+ * trajectory.
+ *
+ * \inlibraryapi
+ * \ingroup module_fileio
+ */
+#ifndef GMX_FILEIO_TRAJECTORYFRAMEINDEX_H
+#define GMX_FILEIO_TRAJECTORYFRAMEINDEX_H
+
+#include <cstdint>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/futil.h"
+
+struct t_fileio;
+
+namespace gmx
+{
+
+class ISerializer;
+
+/*! \libinternal \brief
+ * Index of the frames in an XTC or TRR trajectory file.
+ */
+class TrajectoryFrameIndex
+{
+public:
+    //! Location and identification of a single frame
+    struct Frame
+    {
+        //! The step of the frame
+        int64_t step;
+        //! The time of the frame
+        double time;
+        //! The offset of the start of the frame in the file
+        gmx_off_t offset;
+    };
+
+    /*! \brief Builds the index by reading only the frame headers of an open file
+     *
+     * The file position of \p fio is restored afterwards. A trailing
+     * incomplete frame is not included in the index.
+     *
+     * \throws InvalidInputError when \p fio is not an XTC or TRR file
+     */
+    static TrajectoryFrameIndex build(t_fileio* fio);
+
+    /*! \brief Reads an index from file
+     *
+     * Returns an empty optional when \p indexFile does not exist, can not
+     * be read, or does not match the current size and modification time of
+     * \p trajectoryFile.
+     */
+    static std::optional<TrajectoryFrameIndex> read(const std::filesystem::path& indexFile,
+                                                    const std::filesystem::path& trajectoryFile);
+
+    /*! \brief Writes the index to file, replacing any existing file
+     *
+     * \throws FileIOError when the file can not be written
+     */
+    void write(const std::filesystem::path& indexFilename) const;
+
+    //! Returns the frames in the order they occur in the file
+    ArrayRef<const Frame> frames() const { return frames_; }
+    //! Returns the offset just past the last complete frame
+    gmx_off_t endOffset() const { return endOffset_; }
+    //! Returns whether the frames are stored in double precision
+    bool isDoublePrecision() const { return isDoublePrecision_; }
+
+private:
+    /*! \brief Reads or writes the file and trajectory information and the number of frames
+     *
+     * Returns false when reading a file that is not a valid frame index file.
+     */
+    bool serializeHeader(ISerializer* serializer, int64_t* numFrames);
+    //! Reads or writes the frames
+    void serializeFrames(ISerializer* serializer);
+    //! Returns the size in bytes of a serialized index with \p numFrames frames
+    static size_t serializedSize(size_t numFrames);
+
+    //! The frames
+    std::vector<Frame> frames_;
+    //! The offset just past the last complete frame
+    gmx_off_t endOffset_ = 0;
+    //! Whether the trajectory is stored in double precision
+    bool isDoublePrecision_ = false;
+    //! The size of the trajectory file when the index was built
+    int64_t trajectorySize_ = 0;
+    //! The modification time of the trajectory file when the index was built
+    int64_t trajectoryModificationTime_ = 0;
+};
+
+//! Returns the name of the frame index file for \p trajectoryFilename
+std::filesystem::path trajectoryFrameIndexFilename(const std::filesystem::path& trajectoryFilename);
+
+} // namespace gmx
+
+#endif
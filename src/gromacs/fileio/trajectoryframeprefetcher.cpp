@@ -0,0 +1,315 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements the reader that decodes trajectory frames ahead of use in worker threads.
+ *
+ * \ingroup module_fileio
+ */
+#include "gmxpre.h"
+
+#include "trajectoryframeprefetcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/fileio/trxio.h"
+#include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/smalloc.h"
+#include "gromacs/utility/vec.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+/*! \brief Copies the buffer \p source with \p natoms entries into \p destination
+ *
+ * Allocates \p destination when it is not allocated yet.
+ */
+void copyVectors(const rvec* source, int natoms, rvec** destination)
+{
+    if (*destination == nullptr)
+    {
+        snew(*destination, natoms);
+    }
+    std::memcpy(*destination, source, natoms * sizeof(rvec));
+}
+
+//! Copies the data read from a trajectory file from \p source into \p destination
+void copyFrameData(const t_trxframe& source, t_trxframe* destination)
+{
+    destination->not_ok    = source.not_ok;
+    destination->bDouble   = source.bDouble;
+    destination->natoms    = source.natoms;
+    destination->bStep     = source.bStep;
+    destination->step      = source.step;
+    destination->bTime     = source.bTime;
+    destination->time      = source.time;
+    destination->bLambda   = source.bLambda;
+    destination->bFepState = source.bFepState;
+    destination->lambda    = source.lambda;
+    destination->fep_state = source.fep_state;
+    destination->bPrec     = source.bPrec;
+    destination->prec      = source.prec;
+    destination->bBox      = source.bBox;
+    copy_mat(source.box, destination->box);
+
+    destination->bX = source.bX;
+    if (source.bX)
+    {
+        copyVectors(source.x, source.natoms, &destination->x);
+    }
+    destination->bV = source.bV;
+    if (source.bV)
+    {
+        copyVectors(source.v, source.natoms, &destination->v);
+    }
+    destination->bF = source.bF;
+    if (source.bF)
+    {
+        copyVectors(source.f, source.natoms, &destination->f);
+    }
+}
+
+} // namespace
+
+class TrajectoryFramePrefetcher::Impl
+{
+public:
+    Impl(const std::filesystem::path& filename,
+         ArrayRef<const gmx_off_t>    frameOffsets,
+         FrameReader                  readFrame,
+         int                          numThreads,
+         int                          numBufferedFrames);
+    ~Impl();
+
+    //! See TrajectoryFramePrefetcher::nextFrame()
+    std::optional<PrefetchedFrame> nextFrame(t_trxframe* frame);
+
+private:
+    //! A frame in the ring buffer
+    struct Slot
+    {
+        //! The frame, which owns its buffers
+        t_trxframe frame;
+        //! The index of the frame that has been read into this slot, -1 when none
+        int64_t readFrameIndex = -1;
+        //! Whether reading the frame succeeded
+        bool isValid = false;
+        //! The error thrown while reading the frame, if any
+        std::exception_ptr exception;
+    };
+
+    //! Reads frames in a worker thread using \p fio
+    void runWorker(t_fileio* fio);
+
+    //! The offsets of the frames to read
+    std::vector<gmx_off_t> frameOffsets_;
+    //! Reads a frame
+    FrameReader readFrame_;
+    //! The ring buffer of frames, frame \c i is read into slot \c i modulo its size
+    std::vector<Slot> slots_;
+    //! The file handles used by the worker threads
+    std::vector<t_fileio*> fileHandles_;
+    //! The worker threads
+    std::vector<std::thread> workers_;
+    //! Protects the counters, the stop flag and the read frame indices of the slots
+    std::mutex mutex_;
+    //! Notifies workers that a slot was freed or that they should stop
+    std::condition_variable slotFreed_;
+    //! Notifies the consumer that a frame was read
+    std::condition_variable frameRead_;
+    //! The index of the next frame to be assigned to a worker
+    int64_t nextFrameToRead_ = 0;
+    //! The index of the next frame to be returned by nextFrame()
+    int64_t nextFrameToReturn_ = 0;
+    //! Whether the workers should stop
+    bool stop_ = false;
+};
+
+TrajectoryFramePrefetcher::Impl::Impl(const std::filesystem::path& filename,
+                                      ArrayRef<const gmx_off_t>    frameOffsets,
+                                      FrameReader                  readFrame,
+                                      int                          numThreads,
+                                      int                          numBufferedFrames) :
+    frameOffsets_(frameOffsets.begin(), frameOffsets.end()),
+    readFrame_(std::move(readFrame)),
+    slots_(std::max(numBufferedFrames, numThreads))
+{
+    GMX_RELEASE_ASSERT(numThreads > 0, "Need at least one thread to read frames");
+
+    for (Slot& slot : slots_)
+    {
+        clear_trxframe(&slot.frame, TRUE);
+    }
+    for (int thread = 0; thread < numThreads; thread++)
+    {
+        fileHandles_.push_back(gmx_fio_open(filename, "r"));
+    }
+    for (t_fileio* fio : fileHandles_)
+    {
+        workers_.emplace_back(&Impl::runWorker, this, fio);
+    }
+}
+
+TrajectoryFramePrefetcher::Impl::~Impl()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    slotFreed_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+    for (t_fileio* fio : fileHandles_)
+    {
+        gmx_fio_close(fio);
+    }
+    for (Slot& slot : slots_)
+    {
+        done_frame(&slot.frame);
+    }
+}
+
+void TrajectoryFramePrefetcher::Impl::runWorker(t_fileio* fio)
+{
+    const int64_t numFrames = gmx::ssize(frameOffsets_);
+    const int64_t numSlots  = gmx::ssize(slots_);
+    while (true)
+    {
+        int64_t frameIndex;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // Wait until the slot for the next frame has been consumed
+            slotFreed_.wait(lock, [this, numFrames, numSlots]() {
+                return stop_ || nextFrameToRead_ >= numFrames
+                       || nextFrameToRead_ < nextFrameToReturn_ + numSlots;
+            });
+            if (stop_ || nextFrameToRead_ >= numFrames)
+            {
+                return;
+            }
+            frameIndex = nextFrameToRead_++;
+        }
+
+        // Only this thread accesses the slot until the frame is marked as read
+        Slot& slot = slots_[frameIndex % numSlots];
+        try
+        {
+            clear_trxframe(&slot.frame, FALSE);
+            gmx_fio_seek(fio, frameOffsets_[frameIndex]);
+            slot.isValid = readFrame_(fio, &slot.frame);
+        }
+        catch (...)
+        {
+            slot.exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot.readFrameIndex = frameIndex;
+        }
+        frameRead_.notify_one();
+    }
+}
+
+std::optional<TrajectoryFramePrefetcher::PrefetchedFrame>
+TrajectoryFramePrefetcher::Impl::nextFrame(t_trxframe* frame)
+{
+    if (nextFrameToReturn_ >= gmx::ssize(frameOffsets_))
+    {
+        return std::nullopt;
+    }
+
+    const int64_t frameIndex = nextFrameToReturn_;
+    Slot&         slot       = slots_[frameIndex % gmx::ssize(slots_)];
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        frameRead_.wait(lock, [&slot, frameIndex]() { return slot.readFrameIndex == frameIndex; });
+    }
+
+    // The slot is not reused by the workers before nextFrameToReturn_ is increased
+    std::exception_ptr exception = std::move(slot.exception);
+    slot.exception               = nullptr;
+    if (!exception)
+    {
+        copyFrameData(slot.frame, frame);
+    }
+    const bool isValid = slot.isValid;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nextFrameToReturn_++;
+    }
+    slotFreed_.notify_all();
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    return PrefetchedFrame{ frameIndex, isValid };
+}
+
+TrajectoryFramePrefetcher::TrajectoryFramePrefetcher(const std::filesystem::path& filename,
+                                                     ArrayRef<const gmx_off_t>    frameOffsets,
+                                                     FrameReader                  readFrame,
+                                                     int                          numThreads,
+                                                     int                          numBufferedFrames) :
+    impl_(new Impl(filename, frameOffsets, std::move(readFrame), numThreads, numBufferedFrames))
+{
+}
+
+TrajectoryFramePrefetcher::~TrajectoryFramePrefetcher() {}
+
+std::optional<TrajectoryFramePrefetcher::PrefetchedFrame>
+TrajectoryFramePrefetcher::nextFrame(t_trxframe* frame)
+{
+    return impl_->nextFrame(frame);
+}
+
+} // namespace gmx
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares a reader that decodes trajectory frames ahead of use in worker threads.
+ *
+ * \inlibraryapi
+ * \ingroup module_fileio
+ */
+#ifndef GMX_FILEIO_TRAJECTORYFRAMEPREFETCHER_H
+#define GMX_FILEIO_TRAJECTORYFRAMEPREFETCHER_H
+
+#include <cstdint>
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/futil.h"
+
+struct t_fileio;
+struct t_trxframe;
+
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * Reads frames at known file offsets in worker threads, ahead of their use.
+ *
+ * Each worker thread opens its own handle to the trajectory file and
+ * decodes frames into a ring buffer, while the calling thread consumes
+ * them in order with nextFrame(). At most \c numBufferedFrames frames are
+ * decoded ahead of the frame that is being consumed.
+ *
+ * Errors thrown while reading a frame are rethrown by nextFrame() when
+ * that frame is consumed.
+ */
+class TrajectoryFramePrefetcher
+{
+public:
+    /*! \brief Reads a single frame from the current position of a file into a frame
+     *
+     * Should return false when the frame could not be read. Is called
+     * concurrently from several threads, but never with the same file
+     * handle or frame.
+     */
+    using FrameReader = std::function<bool(t_fileio*, t_trxframe*)>;
+
+    //! Describes a frame that was returned by nextFrame()
+    struct PrefetchedFrame
+    {
+        //! The index of the frame in the list of frames to read
+        int64_t index;
+        //! Whether the frame was read successfully
+        bool isValid;
+    };
+
+    /*! \brief Opens the file and starts reading frames
+     *
+     * \param[in] filename           The trajectory file
+     * \param[in] frameOffsets       The file offsets of the frames to read, in the order
+     *                               they should be returned
+     * \param[in] readFrame          Reads a frame at the current position of a file
+     * \param[in] numThreads         The number of worker threads, at least one
+     * \param[in] numBufferedFrames  The maximum number of frames read ahead, no less
+     *                               than \p numThreads are used
+     */
+    TrajectoryFramePrefetcher(const std::filesystem::path& filename,
+                              ArrayRef<const gmx_off_t>    frameOffsets,
+                              FrameReader                  readFrame,
+                              int                          numThreads,
+                              int                          numBufferedFrames);
+    //! Stops the worker threads and closes the file handles
+    ~TrajectoryFramePrefetcher();
+
+    TrajectoryFramePrefetcher(const TrajectoryFramePrefetcher&)            = delete;
+    TrajectoryFramePrefetcher& operator=(const TrajectoryFramePrefetcher&) = delete;
+
+    /*! \brief Waits for the next frame and copies it into \p frame
+     *
+     * Copies the step, time, lambda, precision and box, and the
+     * coordinates, velocities and forces when present. The buffers for
+     * the coordinates, velocities and forces in \p frame are reused when
+     * they are already allocated.
+     *
+     * Returns an empty optional when all frames have been returned.
+     */
+    std::optional<PrefetchedFrame> nextFrame(t_trxframe* frame);
+
+private:
+    class Impl;
+
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace gmx
+
+#endif
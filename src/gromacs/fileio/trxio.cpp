@@ -37,15 +37,19 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "gromacs/fileio/checkpoint.h"
 #include "gromacs/fileio/confio.h"
@@ -60,6 +64,8 @@
 #include "gromacs/fileio/timecontrol.h"
 #include "gromacs/fileio/tngio.h"
 #include "gromacs/fileio/tpxio.h"
+#include "gromacs/fileio/trajectoryframeindex.h"
+#include "gromacs/fileio/trajectoryframeprefetcher.h"
 #include "gromacs/fileio/trrio.h"
 #include "gromacs/fileio/xdrf.h"
 #include "gromacs/fileio/xtcio.h"
@@ -92,6 +98,15 @@ struct gmx_output_env_t;
 #define SKIP2 100
 #define SKIP3 1000
 
+//! Frames of an XTC or TRR file that are read ahead in worker threads
+struct FramePrefetch
+{
+    //! The positions in the frame index of the frames that are read
+    std::vector<int64_t> positions;
+    //! Reads the frames
+    std::unique_ptr<gmx::TrajectoryFramePrefetcher> prefetcher;
+};
+
 struct t_trxstatus
 {
     int  flags; /* flags for read_first/next_frame  */
@@ -106,6 +121,10 @@ struct t_trxstatus
     int                  fileType;
     int                  natoms;
     char*                persistent_line; /* Persistent line for reading g96 trajectories */
+
+    gmx::TrajectoryFrameIndex* frameIndex;         /* Frame index for XTC and TRR, can be null */
+    int64_t                    frameIndexPosition; /* Index of the next frame in frameIndex */
+    FramePrefetch*             prefetch;           /* Frames read ahead, can be null */
 #if GMX_USE_PLUGINS
     gmx_vmdplugin_t* vmdplugin;
 #endif
@@ -181,16 +200,19 @@ static void initcount(t_trxstatus* status)
 
 static void status_init(t_trxstatus* status)
 {
-    status->flags           = 0;
-    status->xframe          = nullptr;
-    status->fio             = nullptr;
-    status->currentFrame    = -1;
-    status->t0              = 0;
-    status->tf              = 0;
-    status->persistent_line = nullptr;
-    status->tng             = nullptr;
-    status->h5md            = nullptr;
-    status->fileType        = efNR;
+    status->flags              = 0;
+    status->xframe             = nullptr;
+    status->fio                = nullptr;
+    status->currentFrame       = -1;
+    status->t0                 = 0;
+    status->tf                 = 0;
+    status->persistent_line    = nullptr;
+    status->tng                = nullptr;
+    status->h5md               = nullptr;
+    status->frameIndex         = nullptr;
+    status->frameIndexPosition = 0;
+    status->prefetch           = nullptr;
+    status->fileType           = efNR;
 }
 
 
@@ -648,6 +670,8 @@ void close_trx(t_trxstatus* status)
     }
     gmx_tng_close(&status->tng);
     delete status->h5md;
+    delete status->prefetch;
+    delete status->frameIndex;
     if (status->fio)
     {
         gmx_fio_close(status->fio);
@@ -686,14 +710,14 @@ t_trxstatus* open_trx(const std::filesystem::path& outfile, const char* filemode
     return stat;
 }
 
-static gmx_bool gmx_next_frame(t_trxstatus* status, t_trxframe* fr)
+static gmx_bool gmx_next_frame(t_fileio* fio, int flags, t_trxframe* fr)
 {
     gmx_trr_header_t sh;
     gmx_bool         bOK, bRet;
 
     bRet = FALSE;
 
-    if (gmx_trr_read_frame_header(status->fio, &sh, &bOK))
+    if (gmx_trr_read_frame_header(fio, &sh, &bOK))
     {
         fr->bDouble   = sh.bDouble;
         fr->natoms    = sh.natoms;
@@ -705,7 +729,7 @@ static gmx_bool gmx_next_frame(t_trxstatus* status, t_trxframe* fr)
         fr->bFepState = TRUE;
         fr->lambda    = sh.lambda;
         fr->bBox      = sh.box_size > 0;
-        if (status->flags & (TRX_READ_X | TRX_NEED_X))
+        if (flags & (TRX_READ_X | TRX_NEED_X))
         {
             if (fr->x == nullptr)
             {
@@ -713,7 +737,7 @@ static gmx_bool gmx_next_frame(t_trxstatus* status, t_trxframe* fr)
             }
             fr->bX = sh.x_size > 0;
         }
-        if (status->flags & (TRX_READ_V | TRX_NEED_V))
+        if (flags & (TRX_READ_V | TRX_NEED_V))
         {
             if (fr->v == nullptr)
             {
@@ -721,7 +745,7 @@ static gmx_bool gmx_next_frame(t_trxstatus* status, t_trxframe* fr)
             }
             fr->bV = sh.v_size > 0;
         }
-        if (status->flags & (TRX_READ_F | TRX_NEED_F))
+        if (flags & (TRX_READ_F | TRX_NEED_F))
         {
             if (fr->f == nullptr)
             {
@@ -729,7 +753,7 @@ static gmx_bool gmx_next_frame(t_trxstatus* status, t_trxframe* fr)
             }
             fr->bF = sh.f_size > 0;
         }
-        if (gmx_trr_read_frame_data(status->fio, &sh, fr->box, fr->x, fr->v, fr->f))
+        if (gmx_trr_read_frame_data(fio, &sh, fr->box, fr->x, fr->v, fr->f))
         {
             bRet = TRUE;
         }
@@ -746,6 +770,28 @@ static gmx_bool gmx_next_frame(t_trxstatus* status, t_trxframe* fr)
     return bRet;
 }
 
+static gmx_bool xtc_next_frame(t_fileio* fio, t_trxframe* fr)
+{
+    gmx_bool bOK, bRet;
+
+    bRet = (read_next_xtc(fio, fr->natoms, &fr->step, &fr->time, fr->box, fr->x, &fr->prec, &bOK)
+            != 0);
+
+    fr->bPrec = (bRet && fr->prec > 0);
+    fr->bStep = bRet;
+    fr->bTime = bRet;
+    fr->bX    = bRet;
+    fr->bBox  = bRet;
+    if (!bOK)
+    {
+        /* Actually the header could also be not ok,
+           but from bOK from read_next_xtc this can't be distinguished */
+        fr->not_ok = DATA_NOT_OK;
+    }
+
+    return bRet;
+}
+
 static gmx_bool pdb_next_x(t_trxstatus* status, FILE* fp, t_trxframe* fr)
 {
     t_atoms   atoms;
@@ -827,11 +873,195 @@ static int pdb_first_x(t_trxstatus* status, FILE* fp, t_trxframe* fr)
     return fr->natoms;
 }
 
+/*! \brief Returns the number of threads for reading XTC and TRR frames ahead, zero when disabled
+ *
+ * Set with the environment variable GMX_TRAJECTORY_READ_THREADS.
+ */
+static int numFramePrefetchThreads()
+{
+    const char* env = std::getenv("GMX_TRAJECTORY_READ_THREADS");
+    return (env != nullptr ? std::max(static_cast<int>(std::strtol(env, nullptr, 10)), 0) : 0);
+}
+
+/*! \brief Returns the frame index of an XTC or TRR file, or nullptr when there is none
+ *
+ * An up to date index file next to the trajectory is used when present.
+ * Otherwise, when the environment variable GMX_TRAJECTORY_INDEX is set,
+ * the index is built from the frame headers and written next to the
+ * trajectory for later use. When frames are read ahead in worker threads,
+ * the index is built without writing it.
+ */
+static gmx::TrajectoryFrameIndex* openFrameIndex(t_fileio* fio, const std::filesystem::path& fn)
+{
+    const auto indexFilename = gmx::trajectoryFrameIndexFilename(fn);
+    const bool bWriteIndex   = (std::getenv("GMX_TRAJECTORY_INDEX") != nullptr);
+    auto       index         = gmx::TrajectoryFrameIndex::read(indexFilename, fn);
+    if (!index.has_value() && (bWriteIndex || numFramePrefetchThreads() > 0))
+    {
+        index = gmx::TrajectoryFrameIndex::build(fio);
+        if (bWriteIndex)
+        {
+            try
+            {
+                index->write(indexFilename);
+            }
+            catch (const gmx::FileIOError&)
+            {
+                // The index can still be used, the directory is probably not writable
+                fprintf(stderr,
+                        "\nNote: Could not write the frame index file %s\n",
+                        indexFilename.string().c_str());
+            }
+        }
+    }
+
+    return index.has_value() ? new gmx::TrajectoryFrameIndex(std::move(index.value())) : nullptr;
+}
+
+/*! \brief Returns the position in the frame index of the first frame from \p position on
+ * that will not be skipped
+ *
+ * Frames before the start time and, unless all frames should be returned,
+ * frames that do not match the time interval are skipped.
+ */
+static int64_t nextFrameWithIndex(const t_trxstatus* status, int64_t position)
+{
+    const auto frames    = status->frameIndex->frames();
+    const auto startTime = timeValue(TimeControl::Begin);
+    while (position < gmx::ssize(frames))
+    {
+        const real time = frames[position].time;
+        if ((startTime.has_value() && time < startTime.value())
+            || (!(status->flags & TRX_DONT_SKIP)
+                && check_times2(time, status->t0, status->frameIndex->isDoublePrecision()) < 0))
+        {
+            position++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return position;
+}
+
+//! Uses the frame index to seek to the frame at \p position, or to the end of the frames
+static void seekToFrameWithIndex(t_trxstatus* status, int64_t position)
+{
+    const auto frames = status->frameIndex->frames();
+    gmx_fio_seek(status->fio,
+                 position < gmx::ssize(frames) ? frames[position].offset
+                                               : status->frameIndex->endOffset());
+    /* Keep the frame count consistent with reading all frames */
+    status->currentFrame += position - status->frameIndexPosition;
+    status->frameIndexPosition = position;
+}
+
+/*! \brief Uses the frame index to seek to the next frame that will not be skipped
+ *
+ * Skipped frames are not read at all.
+ */
+static void seekToNextFrameWithIndex(t_trxstatus* status)
+{
+    const int64_t next = nextFrameWithIndex(status, status->frameIndexPosition);
+    if (next != status->frameIndexPosition)
+    {
+        seekToFrameWithIndex(status, next);
+    }
+}
+
+/*! \brief Starts reading the frames that will not be skipped ahead in worker threads
+ *
+ * Only done for XTC and TRR files, using the frame index, when
+ * GMX_TRAJECTORY_READ_THREADS is set to a positive number of threads.
+ * Frames are read up to and including the first frame after the end time.
+ */
+static void startFramePrefetch(t_trxstatus* status, const std::filesystem::path& fn)
+{
+    const int numThreads = numFramePrefetchThreads();
+    if (numThreads == 0 || status->frameIndex == nullptr)
+    {
+        return;
+    }
+
+    const auto             frames  = status->frameIndex->frames();
+    const bool             bDouble = status->frameIndex->isDoublePrecision();
+    std::vector<int64_t>   positions;
+    std::vector<gmx_off_t> offsets;
+    for (int64_t position = nextFrameWithIndex(status, status->frameIndexPosition);
+         position < gmx::ssize(frames);
+         position = nextFrameWithIndex(status, position + 1))
+    {
+        positions.push_back(position);
+        offsets.push_back(frames[position].offset);
+        if (check_times2(frames[position].time, status->t0, bDouble) > 0)
+        {
+            break;
+        }
+    }
+    if (positions.empty())
+    {
+        return;
+    }
+
+    gmx::TrajectoryFramePrefetcher::FrameReader readFrame;
+    if (status->fileType == efXTC)
+    {
+        const int natoms = status->natoms;
+        readFrame        = [natoms](t_fileio* fio, t_trxframe* fr)
+        {
+            if (fr->x == nullptr)
+            {
+                snew(fr->x, natoms);
+            }
+            fr->natoms = natoms;
+            return xtc_next_frame(fio, fr) != 0;
+        };
+    }
+    else
+    {
+        const int flags = status->flags;
+        readFrame       = [flags](t_fileio* fio, t_trxframe* fr)
+        { return gmx_next_frame(fio, flags, fr) != 0; };
+    }
+    /* Buffer two frames per thread, so threads rarely wait for the analysis to free a buffer */
+    auto prefetcher = std::make_unique<gmx::TrajectoryFramePrefetcher>(
+            fn, offsets, std::move(readFrame), numThreads, 2 * numThreads);
+    status->prefetch = new FramePrefetch{ std::move(positions), std::move(prefetcher) };
+}
+
+/*! \brief Returns the next frame that was read ahead in \p fr, and whether it is valid in \p bRet
+ *
+ * Returns false when all frames that were read ahead have been returned.
+ * Reading then continues from the file, after the last frame that was read ahead.
+ */
+static bool readPrefetchedFrame(t_trxstatus* status, t_trxframe* fr, bool* bRet)
+{
+    const auto prefetched = status->prefetch->prefetcher->nextFrame(fr);
+    if (!prefetched.has_value())
+    {
+        const int64_t position = status->prefetch->positions.back() + 1;
+        delete status->prefetch;
+        status->prefetch = nullptr;
+        seekToFrameWithIndex(status, position);
+        return false;
+    }
+
+    const int64_t position = status->prefetch->positions[prefetched->index];
+    /* Keep the frame count consistent with reading all frames */
+    status->currentFrame += position - status->frameIndexPosition;
+    status->frameIndexPosition = position;
+    *bRet                      = prefetched->isValid;
+
+    return true;
+}
+
 bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxframe* fr)
 {
     real     pt;
     int      ct;
-    gmx_bool bOK, bMissingData = FALSE, bSkip = FALSE;
+    gmx_bool bMissingData = FALSE, bSkip = FALSE;
     bool     bRet = false;
 
     pt = status->tf;
@@ -840,62 +1070,74 @@ bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxfra
     {
         clear_trxframe(fr, FALSE);
 
-        auto startTime = timeValue(TimeControl::Begin);
-        switch (status->fileType)
+        /* Use the frames that were read ahead, until all of them have been returned */
+        const bool bPrefetched =
+                (status->prefetch != nullptr && readPrefetchedFrame(status, fr, &bRet));
+        if (!bPrefetched)
         {
-            case efTRR: bRet = gmx_next_frame(status, fr); break;
-            case efCPT:
-                /* Checkpoint files can not contain multiple frames */
-                break;
-            case efG96:
+            auto startTime = timeValue(TimeControl::Begin);
+            if (status->frameIndex != nullptr)
             {
-                t_symtab* symtab = nullptr;
-                read_g96_conf(gmx_fio_getfp(status->fio), {}, nullptr, fr, symtab, status->persistent_line);
-                bRet = (fr->natoms > 0);
-                break;
+                seekToNextFrameWithIndex(status);
             }
-            case efXTC:
-                if (startTime.has_value() && (status->tf < startTime.value()))
+            switch (status->fileType)
+            {
+                case efTRR: bRet = gmx_next_frame(status->fio, status->flags, fr); break;
+                case efCPT:
+                    /* Checkpoint files can not contain multiple frames */
+                    break;
+                case efG96:
                 {
-                    if (xtc_seek_time(status->fio, startTime.value(), fr->natoms, TRUE))
+                    t_symtab* symtab = nullptr;
+                    read_g96_conf(gmx_fio_getfp(status->fio),
+                                  {},
+                                  nullptr,
+                                  fr,
+                                  symtab,
+                                  status->persistent_line);
+                    bRet = (fr->natoms > 0);
+                    break;
+                }
+                case efXTC:
+                    if (startTime.has_value() && (status->tf < startTime.value())
+                        && status->frameIndex == nullptr)
                     {
-                        gmx_fatal(FARGS,
-                                  "Specified frame (time %f) doesn't exist or file "
-                                  "corrupt/inconsistent.",
-                                  startTime.value());
+                        if (xtc_seek_time(status->fio, startTime.value(), fr->natoms, TRUE))
+                        {
+                            gmx_fatal(FARGS,
+                                      "Specified frame (time %f) doesn't exist or file "
+                                      "corrupt/inconsistent.",
+                                      startTime.value());
+                        }
+                        initcount(status);
                     }
-                    initcount(status);
-                }
-                bRet      = (read_next_xtc(
-                                status->fio, fr->natoms, &fr->step, &fr->time, fr->box, fr->x, &fr->prec, &bOK)
-                        != 0);
-                fr->bPrec = (bRet && fr->prec > 0);
-                fr->bStep = bRet;
-                fr->bTime = bRet;
-                fr->bX    = bRet;
-                fr->bBox  = bRet;
-                if (!bOK)
-                {
-                    /* Actually the header could also be not ok,
-                       but from bOK from read_next_xtc this can't be distinguished */
-                    fr->not_ok = DATA_NOT_OK;
-                }
-                break;
-            case efTNG: bRet = gmx_read_next_tng_frame(status->tng, fr, nullptr, 0); break;
-            case efH5MD: bRet = status->h5md->readNextFrame(fr); break;
-            case efPDB: bRet = pdb_next_x(status, gmx_fio_getfp(status->fio), fr); break;
-            case efGRO: bRet = gro_next_x_or_v(gmx_fio_getfp(status->fio), fr); break;
-            default:
+                    bRet = xtc_next_frame(status->fio, fr);
+                    break;
+                case efTNG: bRet = gmx_read_next_tng_frame(status->tng, fr, nullptr, 0); break;
+                case efH5MD:
+                    /* Skip directly to the start time, using the stored frame times */
+                    if (startTime.has_value() && (status->tf < startTime.value())
+                        && status->h5md->seekToTime(startTime.value()))
+                    {
+                        initcount(status);
+                    }
+                    bRet = status->h5md->readNextFrame(fr);
+                    break;
+                case efPDB: bRet = pdb_next_x(status, gmx_fio_getfp(status->fio), fr); break;
+                case efGRO: bRet = gro_next_x_or_v(gmx_fio_getfp(status->fio), fr); break;
+                default:
 #if GMX_USE_PLUGINS
-                bRet = read_next_vmd_frame(status->vmdplugin, fr);
+                    bRet = read_next_vmd_frame(status->vmdplugin, fr);
 #else
-                gmx_fatal(FARGS,
-                          "DEATH HORROR in read_next_frame fileType=%s,status=%s",
-                          ftp2ext(status->fileType),
-                          gmx_fio_getname(status->fio).string().c_str());
+                    gmx_fatal(FARGS,
+                              "DEATH HORROR in read_next_frame fileType=%s,status=%s",
+                              ftp2ext(status->fileType),
+                              gmx_fio_getname(status->fio).string().c_str());
 #endif
+            }
         }
         status->tf = fr->time;
+        status->frameIndexPosition++;
 
         if (bRet)
         {
@@ -941,6 +1183,16 @@ bool read_first_frame(const gmx_output_env_t*      oenv,
                       const std::filesystem::path& fn,
                       t_trxframe*                  fr,
                       int                          flags)
+{
+    return read_first_frame(oenv, status, fn, fr, flags, {});
+}
+
+bool read_first_frame(const gmx_output_env_t*      oenv,
+                      t_trxstatus**                status,
+                      const std::filesystem::path& fn,
+                      t_trxframe*                  fr,
+                      int                          flags,
+                      gmx::ArrayRef<const int>     atomIndices)
 {
     t_fileio* fio = nullptr;
     gmx_bool  bFirst, bOK;
@@ -965,10 +1217,18 @@ bool read_first_frame(const gmx_output_env_t*      oenv,
     {
         (*status)->h5md = new gmx::H5md(fn, gmx::H5mdFileMode('r'));
         (*status)->h5md->setupFromExistingFile();
+        if (!atomIndices.empty())
+        {
+            (*status)->h5md->setParticlesToRead(atomIndices);
+        }
     }
     else if ((*status)->fileType != efCPT)
     {
         fio = (*status)->fio = gmx_fio_open(fn, "r");
+        if ((*status)->fileType == efXTC || (*status)->fileType == efTRR)
+        {
+            (*status)->frameIndex = openFrameIndex(fio, fn);
+        }
     }
     switch ((*status)->fileType)
     {
@@ -1024,6 +1284,7 @@ bool read_first_frame(const gmx_output_env_t*      oenv,
                 fr->bBox  = TRUE;
                 printcount(*status, oenv, fr->time, FALSE);
             }
+            (*status)->frameIndexPosition++;
             bFirst = FALSE;
             break;
         case efTNG:
@@ -1119,6 +1380,11 @@ bool read_first_frame(const gmx_output_env_t*      oenv,
      */
     (*status)->natoms = fr->natoms;
 
+    if (fr->natoms > 0 && ((*status)->fileType == efXTC || (*status)->fileType == efTRR))
+    {
+        startFramePrefetch(*status, fn);
+    }
+
     return (fr->natoms > 0);
 }
 
@@ -1160,8 +1426,18 @@ gmx_bool read_next_x(const gmx_output_env_t* oenv, t_trxstatus* status, real* t,
 void rewind_trj(t_trxstatus* status)
 {
     initcount(status);
+    delete status->prefetch;
+    status->prefetch           = nullptr;
+    status->frameIndexPosition = 0;
 
-    gmx_fio_rewind(status->fio);
+    if (status->fileType == efH5MD)
+    {
+        status->h5md->rewind();
+    }
+    else
+    {
+        gmx_fio_rewind(status->fio);
+    }
 }
 
 /***** T O P O L O G Y   S T U F F ******/
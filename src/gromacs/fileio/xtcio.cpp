@@ -284,3 +284,64 @@ int read_next_xtc(t_fileio* fio, int natoms, int64_t* step, real* time, matrix b
 
     return static_cast<int>(*bOK);
 }
+
+int skip_xtc_frame(t_fileio* fio, int* natoms, int64_t* step, real* time, gmx_bool* bOK)
+{
+    int   magic;
+    int   size;
+    float floatValue;
+    int   intValue;
+    XDR*  xd;
+
+    /* XDR stores all data in units of 4 bytes */
+    constexpr int64_t xdrUnitSize = 4;
+
+    *bOK = TRUE;
+    xd   = gmx_fio_getxdr(fio);
+
+    /* read header */
+    if (!xtc_header(xd, &magic, natoms, step, time, TRUE, bOK))
+    {
+        return 0;
+    }
+
+    /* Check magic number */
+    check_xtc_magic(magic);
+
+    /* The box and the number of coordinates, see xdr3dfcoord() for the layout of the rest */
+    for (int i = 0; i < DIM * DIM; i++)
+    {
+        *bOK = *bOK && (xdr_float(xd, &floatValue) != 0);
+    }
+    *bOK = *bOK && (xdr_int(xd, &size) != 0);
+
+    int64_t numBytes = 0;
+    if (*bOK && size <= 9)
+    {
+        /* Small systems are stored uncompressed */
+        numBytes = static_cast<int64_t>(size) * DIM * xdrUnitSize;
+    }
+    else if (*bOK)
+    {
+        /* Skip the precision, minint, maxint and smallidx */
+        *bOK = *bOK && (xdr_float(xd, &floatValue) != 0);
+        for (int i = 0; i < 2 * DIM + 1; i++)
+        {
+            *bOK = *bOK && (xdr_int(xd, &intValue) != 0);
+        }
+        if (magic == XTC_NEW_MAGIC)
+        {
+            *bOK = *bOK && (xdr_int64(xd, &numBytes) != 0);
+        }
+        else
+        {
+            *bOK     = *bOK && (xdr_int(xd, &intValue) != 0);
+            numBytes = intValue;
+        }
+        /* XDR opaque data is padded to a multiple of 4 bytes */
+        numBytes = (numBytes + xdrUnitSize - 1) / xdrUnitSize * xdrUnitSize;
+    }
+    *bOK = *bOK && (gmx_fio_seek(fio, gmx_fio_ftell(fio) + numBytes) == 0);
+
+    return static_cast<int>(*bOK);
+}
@@ -2243,20 +2243,21 @@ rbdihs(int              nbonds,
 
 
 template<BondedKernelFlavor flavor>
-real idihs(int             nbonds,
-           const t_iatom   forceatoms[],
-           const t_iparams forceparams[],
-           const rvec      x[],
-           rvec4           f[],
-           rvec            fshift[],
-           const t_pbc*    pbc,
-           real            lambda,
-           real*           dvdlambda,
-           gmx::ArrayRef<const real> /*charge*/,
-           t_fcdata gmx_unused*     fcd,
-           t_disresdata gmx_unused* disresdata,
-           t_oriresdata gmx_unused* oriresdata,
-           int gmx_unused*          global_atom_index)
+std::enable_if_t<flavor != BondedKernelFlavor::ForcesSimdWhenAvailable || !GMX_SIMD_HAVE_REAL, real>
+idihs(int             nbonds,
+      const t_iatom   forceatoms[],
+      const t_iparams forceparams[],
+      const rvec      x[],
+      rvec4           f[],
+      rvec            fshift[],
+      const t_pbc*    pbc,
+      real            lambda,
+      real*           dvdlambda,
+      gmx::ArrayRef<const real> /*charge*/,
+      t_fcdata gmx_unused*     fcd,
+      t_disresdata gmx_unused* disresdata,
+      t_oriresdata gmx_unused* oriresdata,
+      int gmx_unused*          global_atom_index)
 {
     int  i, type, ai, aj, ak, al;
     int  t1, t2, t3;
@@ -2310,6 +2311,120 @@ real idihs(int             nbonds,
     return vtot;
 }
 
+#if GMX_SIMD_HAVE_REAL
+
+/* As the SIMD flavor of pdihs above, but with a harmonic improper dihedral potential.
+ * This function can replace idihs() when no energy and virial are needed.
+ */
+template<BondedKernelFlavor flavor>
+std::enable_if_t<flavor == BondedKernelFlavor::ForcesSimdWhenAvailable, real>
+idihs(int              nbonds,
+      const t_iatom    forceatoms[],
+      const t_iparams  forceparams[],
+      const rvec       x[],
+      rvec4            f[],
+      rvec gmx_unused  fshift[],
+      const t_pbc*     pbc,
+      real gmx_unused  lambda,
+      real gmx_unused* dvdlambda,
+      gmx::ArrayRef<const real> /*charge*/,
+      t_fcdata gmx_unused*     fcd,
+      t_disresdata gmx_unused* disresdata,
+      t_oriresdata gmx_unused* oriresdata,
+      int gmx_unused*          global_atom_index)
+{
+    const int                                nfa1 = 5;
+    int                                      i, iu, s;
+    int                                      type;
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t al[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         buf[2 * GMX_SIMD_REAL_WIDTH];
+    real *                                   kk, *phi0;
+    SimdReal                                 deg2rad_S(gmx::c_deg2Rad);
+    SimdReal                                 twopi_S(2 * M_PI);
+    SimdReal                                 inv_twopi_S(1 / (2 * M_PI));
+    SimdReal                                 p_S, q_S;
+    SimdReal                                 phi0_S, phi_S, dp_S;
+    SimdReal                                 mx_S, my_S, mz_S;
+    SimdReal                                 nx_S, ny_S, nz_S;
+    SimdReal                                 nrkj_m2_S, nrkj_n2_S;
+    SimdReal                                 mddphi_S;
+    SimdReal                                 sf_i_S, msf_l_S;
+    alignas(GMX_SIMD_ALIGNMENT) real         pbc_simd[9 * GMX_SIMD_REAL_WIDTH];
+
+    /* Extract aligned pointer for parameters and variables */
+    kk   = buf + 0 * GMX_SIMD_REAL_WIDTH;
+    phi0 = buf + 1 * GMX_SIMD_REAL_WIDTH;
+
+    set_pbc_simd(pbc, pbc_simd);
+
+    /* nbonds is the number of dihedrals times nfa1, here we step GMX_SIMD_REAL_WIDTH dihs */
+    for (i = 0; (i < nbonds); i += GMX_SIMD_REAL_WIDTH * nfa1)
+    {
+        /* Collect atoms quadruplets for GMX_SIMD_REAL_WIDTH dihedrals.
+         * iu indexes into forceatoms, we should not let iu go beyond nbonds.
+         */
+        iu = i;
+        for (s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            type  = forceatoms[iu];
+            ai[s] = forceatoms[iu + 1];
+            aj[s] = forceatoms[iu + 2];
+            ak[s] = forceatoms[iu + 3];
+            al[s] = forceatoms[iu + 4];
+
+            /* At the end fill the arrays with the last atoms and 0 params */
+            if (i + s * nfa1 < nbonds)
+            {
+                kk[s]   = forceparams[type].harmonic.krA;
+                phi0[s] = forceparams[type].harmonic.rA;
+
+                if (iu + nfa1 < nbonds)
+                {
+                    iu += nfa1;
+                }
+            }
+            else
+            {
+                kk[s]   = 0;
+                phi0[s] = 0;
+            }
+        }
+
+        /* Calculate GMX_SIMD_REAL_WIDTH dihedral angles at once */
+        dih_angle_simd(
+                x, ai, aj, ak, al, pbc_simd, &phi_S, &mx_S, &my_S, &mz_S, &nx_S, &ny_S, &nz_S, &nrkj_m2_S, &nrkj_n2_S, &p_S, &q_S);
+
+        phi0_S = load<SimdReal>(phi0) * deg2rad_S;
+
+        /* As in the plain-C code, we take phi-phi0 modulo (-Pi,Pi) */
+        dp_S = phi_S - phi0_S;
+        dp_S = dp_S - twopi_S * round(dp_S * inv_twopi_S);
+
+        mddphi_S = -load<SimdReal>(kk) * dp_S;
+        sf_i_S   = mddphi_S * nrkj_m2_S;
+        msf_l_S  = mddphi_S * nrkj_n2_S;
+
+        /* After this m?_S will contain f[i] */
+        mx_S = sf_i_S * mx_S;
+        my_S = sf_i_S * my_S;
+        mz_S = sf_i_S * mz_S;
+
+        /* After this m?_S will contain -f[l] */
+        nx_S = msf_l_S * nx_S;
+        ny_S = msf_l_S * ny_S;
+        nz_S = msf_l_S * nz_S;
+
+        do_dih_fup_noshiftf_simd(ai, aj, ak, al, p_S, q_S, mx_S, my_S, mz_S, nx_S, ny_S, nz_S, f);
+    }
+
+    return 0;
+}
+
+#endif // GMX_SIMD_HAVE_REAL
+
 /*! \brief Computes angle restraints of two different types */
 template<BondedKernelFlavor flavor>
 real low_angres(int             nbonds,
@@ -2560,20 +2675,21 @@ real unimplemented(int gmx_unused             nbonds,
 }
 
 template<BondedKernelFlavor flavor>
-real restrangles(int              nbonds,
-                 const t_iatom    forceatoms[],
-                 const t_iparams  forceparams[],
-                 const rvec       x[],
-                 rvec4            f[],
-                 rvec             fshift[],
-                 const t_pbc*     pbc,
-                 real gmx_unused  lambda,
-                 real gmx_unused* dvdlambda,
-                 gmx::ArrayRef<const real> /*charge*/,
-                 t_fcdata gmx_unused*     fcd,
-                 t_disresdata gmx_unused* disresdata,
-                 t_oriresdata gmx_unused* oriresdata,
-                 int gmx_unused*          global_atom_index)
+std::enable_if_t<flavor != BondedKernelFlavor::ForcesSimdWhenAvailable || !GMX_SIMD_HAVE_REAL, real>
+restrangles(int              nbonds,
+            const t_iatom    forceatoms[],
+            const t_iparams  forceparams[],
+            const rvec       x[],
+            rvec4            f[],
+            rvec             fshift[],
+            const t_pbc*     pbc,
+            real gmx_unused  lambda,
+            real gmx_unused* dvdlambda,
+            gmx::ArrayRef<const real> /*charge*/,
+            t_fcdata gmx_unused*     fcd,
+            t_disresdata gmx_unused* disresdata,
+            t_oriresdata gmx_unused* oriresdata,
+            int gmx_unused*          global_atom_index)
 {
     int    i, d, ai, aj, ak, type, m;
     int    t1, t2;
@@ -2662,6 +2778,139 @@ real restrangles(int              nbonds,
     return vtot;
 }
 
+#if GMX_SIMD_HAVE_REAL
+
+/* As restrangles above, but using SIMD to calculate many restricted angles at once.
+ * This routine does not calculate energies and shift forces. Note that, unlike
+ * the plain-C code, this computes the force factors in real precision.
+ */
+template<BondedKernelFlavor flavor>
+std::enable_if_t<flavor == BondedKernelFlavor::ForcesSimdWhenAvailable, real>
+restrangles(int              nbonds,
+            const t_iatom    forceatoms[],
+            const t_iparams  forceparams[],
+            const rvec       x[],
+            rvec4            f[],
+            rvec gmx_unused  fshift[],
+            const t_pbc*     pbc,
+            real gmx_unused  lambda,
+            real gmx_unused* dvdlambda,
+            gmx::ArrayRef<const real> /*charge*/,
+            t_fcdata gmx_unused*     fcd,
+            t_disresdata gmx_unused* disresdata,
+            t_oriresdata gmx_unused* oriresdata,
+            int gmx_unused*          global_atom_index)
+{
+    const int                                nfa1 = 4;
+    int                                      i, iu, s;
+    int                                      type;
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         coeff[2 * GMX_SIMD_REAL_WIDTH];
+    SimdReal                                 xi_S, yi_S, zi_S;
+    SimdReal                                 xj_S, yj_S, zj_S;
+    SimdReal                                 xk_S, yk_S, zk_S;
+    SimdReal                                 rijx_S, rijy_S, rijz_S;
+    SimdReal                                 rkjx_S, rkjy_S, rkjz_S;
+    SimdReal                                 k_S, cos_eq_S;
+    SimdReal                                 c_ante_S, c_cros_S, c_post_S;
+    SimdReal                                 norm_S, cos_S, sin2_S;
+    SimdReal                                 ratio_ante_S, ratio_post_S;
+    SimdReal                                 pref_S;
+    SimdReal                                 f_ix_S, f_iy_S, f_iz_S;
+    SimdReal                                 f_kx_S, f_ky_S, f_kz_S;
+    SimdReal                                 one_S(1.0);
+    alignas(GMX_SIMD_ALIGNMENT) real         pbc_simd[9 * GMX_SIMD_REAL_WIDTH];
+
+    set_pbc_simd(pbc, pbc_simd);
+
+    /* nbonds is the number of angles times nfa1, here we step GMX_SIMD_REAL_WIDTH angles */
+    for (i = 0; (i < nbonds); i += GMX_SIMD_REAL_WIDTH * nfa1)
+    {
+        /* Collect atoms for GMX_SIMD_REAL_WIDTH angles.
+         * iu indexes into forceatoms, we should not let iu go beyond nbonds.
+         */
+        iu = i;
+        for (s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            type  = forceatoms[iu];
+            ai[s] = forceatoms[iu + 1];
+            aj[s] = forceatoms[iu + 2];
+            ak[s] = forceatoms[iu + 3];
+
+            /* At the end fill the arrays with the last atoms and 0 params */
+            if (i + s * nfa1 < nbonds)
+            {
+                /* The potential uses the cosine of the supplement of the equilibrium angle */
+                coeff[s] = forceparams[type].harmonic.krA;
+                coeff[GMX_SIMD_REAL_WIDTH + s] =
+                        std::cos(M_PI - forceparams[type].harmonic.rA * gmx::c_deg2Rad);
+
+                if (iu + nfa1 < nbonds)
+                {
+                    iu += nfa1;
+                }
+            }
+            else
+            {
+                coeff[s]                       = 0;
+                coeff[GMX_SIMD_REAL_WIDTH + s] = 0;
+            }
+        }
+
+        /* Store the non PBC corrected distances packed and aligned */
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), ai, &xi_S, &yi_S, &zi_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), aj, &xj_S, &yj_S, &zj_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), ak, &xk_S, &yk_S, &zk_S);
+        rijx_S = xi_S - xj_S;
+        rijy_S = yi_S - yj_S;
+        rijz_S = zi_S - zj_S;
+        rkjx_S = xk_S - xj_S;
+        rkjy_S = yk_S - yj_S;
+        rkjz_S = zk_S - zj_S;
+
+        k_S      = load<SimdReal>(coeff);
+        cos_eq_S = load<SimdReal>(coeff + GMX_SIMD_REAL_WIDTH);
+
+        pbc_correct_dx_simd(&rijx_S, &rijy_S, &rijz_S, pbc_simd);
+        pbc_correct_dx_simd(&rkjx_S, &rkjy_S, &rkjz_S, pbc_simd);
+
+        /* The plain-C code uses delta_ante = -r_ij and delta_post = r_kj */
+        c_ante_S = norm2(rijx_S, rijy_S, rijz_S);
+        c_cros_S = -iprod(rijx_S, rijy_S, rijz_S, rkjx_S, rkjy_S, rkjz_S);
+        c_post_S = norm2(rkjx_S, rkjy_S, rkjz_S);
+
+        norm_S = invsqrt(c_ante_S * c_post_S);
+        cos_S  = c_cros_S * norm_S;
+        sin2_S = one_S - cos_S * cos_S;
+
+        ratio_ante_S = c_cros_S * inv(c_ante_S);
+        ratio_post_S = c_cros_S * inv(c_post_S);
+
+        pref_S = -k_S * (cos_S - cos_eq_S) * norm_S * (one_S - cos_S * cos_eq_S)
+                 * inv(sin2_S * sin2_S);
+
+        /* f_i = pref * (ratio_ante * delta_ante - delta_post) */
+        f_ix_S = -pref_S * fma(ratio_ante_S, rijx_S, rkjx_S);
+        f_iy_S = -pref_S * fma(ratio_ante_S, rijy_S, rkjy_S);
+        f_iz_S = -pref_S * fma(ratio_ante_S, rijz_S, rkjz_S);
+        /* f_k = pref * (delta_ante - ratio_post * delta_post) */
+        f_kx_S = -pref_S * fma(ratio_post_S, rkjx_S, rijx_S);
+        f_ky_S = -pref_S * fma(ratio_post_S, rkjy_S, rijy_S);
+        f_kz_S = -pref_S * fma(ratio_post_S, rkjz_S, rijz_S);
+
+        transposeScatterIncrU<4>(reinterpret_cast<real*>(f), ai, f_ix_S, f_iy_S, f_iz_S);
+        transposeScatterDecrU<4>(
+                reinterpret_cast<real*>(f), aj, f_ix_S + f_kx_S, f_iy_S + f_ky_S, f_iz_S + f_kz_S);
+        transposeScatterIncrU<4>(reinterpret_cast<real*>(f), ak, f_kx_S, f_ky_S, f_kz_S);
+    }
+
+    return 0;
+}
+
+#endif // GMX_SIMD_HAVE_REAL
+
 
 template<BondedKernelFlavor flavor>
 real restrdihs(int              nbonds,
@@ -3138,6 +3387,210 @@ void accumulateCmapForces(const rvec      x[],
     }
 }
 
+#if GMX_SIMD_HAVE_REAL
+
+/*! \brief As cmap_dihs, but using SIMD to calculate many CMAP interactions at once
+ *
+ * The grid lookups are done per interaction, the dihedral angles, the bicubic
+ * interpolation and the force distribution use SIMD.
+ * This routine does not calculate energies and shift forces.
+ */
+real cmapDihedralsSimd(int               nbonds,
+                       const t_iatom     forceatoms[],
+                       const t_iparams   forceparams[],
+                       const gmx_cmap_t* cmap_grid,
+                       const rvec        x[],
+                       rvec4             f[],
+                       const t_pbc*      pbc)
+{
+    constexpr int                            nfa1 = 6;
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t al[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t am[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         phi1[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         phi2[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         tt[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         tu[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         tx[16 * GMX_SIMD_REAL_WIDTH];
+    int                                      cmapType[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         pbc_simd[9 * GMX_SIMD_REAL_WIDTH];
+
+    SimdReal phi1_S, m1x_S, m1y_S, m1z_S, n1x_S, n1y_S, n1z_S, nrkj_m2_1_S, nrkj_n2_1_S, p1_S, q1_S;
+    SimdReal phi2_S, m2x_S, m2y_S, m2z_S, n2x_S, n2y_S, n2z_S, nrkj_m2_2_S, nrkj_n2_2_S, p2_S, q2_S;
+    SimdReal tc_S[16];
+    SimdReal two_S(2.0);
+    SimdReal three_S(3.0);
+
+    const int gridSpacing = cmap_grid->grid_spacing;
+    /* The grid spacing in radians and degrees */
+    const real dxRadians = 2 * M_PI / gridSpacing;
+    const real dx        = 360.0 / gridSpacing;
+    const real fac       = gmx::c_rad2Deg / dx;
+
+    set_pbc_simd(pbc, pbc_simd);
+
+    /* nbonds is the number of CMAPs times nfa1, here we step GMX_SIMD_REAL_WIDTH CMAPs */
+    for (int i = 0; i < nbonds; i += GMX_SIMD_REAL_WIDTH * nfa1)
+    {
+        /* Collect atoms for GMX_SIMD_REAL_WIDTH CMAPs.
+         * iu indexes into forceatoms, we should not let iu go beyond nbonds.
+         */
+        int iu = i;
+        for (int s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            ai[s] = forceatoms[iu + 1];
+            aj[s] = forceatoms[iu + 2];
+            ak[s] = forceatoms[iu + 3];
+            al[s] = forceatoms[iu + 4];
+            am[s] = forceatoms[iu + 5];
+
+            /* At the end fill the arrays with the last atoms and no CMAP type */
+            if (i + s * nfa1 < nbonds)
+            {
+                cmapType[s] = forceparams[forceatoms[iu]].cmap.cmapA;
+
+                if (iu + nfa1 < nbonds)
+                {
+                    iu += nfa1;
+                }
+            }
+            else
+            {
+                cmapType[s] = -1;
+            }
+        }
+
+        /* Calculate GMX_SIMD_REAL_WIDTH pairs of dihedral angles at once */
+        dih_angle_simd(
+                x, ai, aj, ak, al, pbc_simd, &phi1_S, &m1x_S, &m1y_S, &m1z_S, &n1x_S, &n1y_S, &n1z_S, &nrkj_m2_1_S, &nrkj_n2_1_S, &p1_S, &q1_S);
+        dih_angle_simd(
+                x, aj, ak, al, am, pbc_simd, &phi2_S, &m2x_S, &m2y_S, &m2z_S, &n2x_S, &n2y_S, &n2z_S, &nrkj_m2_2_S, &nrkj_n2_2_S, &p2_S, &q2_S);
+        store(phi1, phi1_S);
+        store(phi2, phi2_S);
+
+        /* Look up the grid values around the two angles, as in cmap_dihs() */
+        for (int s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            if (cmapType[s] < 0)
+            {
+                for (int k = 0; k < 16; k++)
+                {
+                    tx[k * GMX_SIMD_REAL_WIDTH + s] = 0;
+                }
+                tt[s] = 0;
+                tu[s] = 0;
+                continue;
+            }
+
+            /* Range mangling */
+            std::array<real, 2> xphi = { phi1[s] + static_cast<real>(M_PI),
+                                         phi2[s] + static_cast<real>(M_PI) };
+            for (real& xp : xphi)
+            {
+                if (xp < 0)
+                {
+                    xp = xp + 2 * M_PI;
+                }
+                else if (xp >= 2 * M_PI)
+                {
+                    xp = xp - 2 * M_PI;
+                }
+            }
+            const real xphi1 = xphi[0];
+            const real xphi2 = xphi[1];
+
+            int ip1m1, ip1p1, ip1p2;
+            int ip2m1, ip2p1, ip2p2;
+            const int iphi1 = cmap_setup_grid_index(
+                    static_cast<int>(xphi1 / dxRadians), gridSpacing, &ip1m1, &ip1p1, &ip1p2);
+            const int iphi2 = cmap_setup_grid_index(
+                    static_cast<int>(xphi2 / dxRadians), gridSpacing, &ip2m1, &ip2p1, &ip2p2);
+
+            const std::array<int, 4> pos = { iphi1 * gridSpacing + iphi2,
+                                             ip1p1 * gridSpacing + iphi2,
+                                             ip1p1 * gridSpacing + ip2p1,
+                                             iphi1 * gridSpacing + ip2p1 };
+
+            gmx::ArrayRef<const real> cmapd = cmap_grid->cmapdata[cmapType[s]].cmap;
+            for (int c = 0; c < 4; c++)
+            {
+                tx[c * GMX_SIMD_REAL_WIDTH + s]        = cmapd[pos[c] * 4];
+                tx[(c + 4) * GMX_SIMD_REAL_WIDTH + s]  = cmapd[pos[c] * 4 + 1] * dx;
+                tx[(c + 8) * GMX_SIMD_REAL_WIDTH + s]  = cmapd[pos[c] * 4 + 2] * dx;
+                tx[(c + 12) * GMX_SIMD_REAL_WIDTH + s] = cmapd[pos[c] * 4 + 3] * dx * dx;
+            }
+
+            tt[s] = (xphi1 * gmx::c_rad2Deg - iphi1 * dx) / dx;
+            tu[s] = (xphi2 * gmx::c_rad2Deg - iphi2 * dx) / dx;
+        }
+
+        /* The bicubic coefficients, the matrix is sparse and contains only small integers */
+        for (int idx = 0; idx < 16; idx++)
+        {
+            tc_S[idx] = setZero();
+        }
+        for (int k = 0; k < 16; k++)
+        {
+            const SimdReal tx_S = load<SimdReal>(tx + k * GMX_SIMD_REAL_WIDTH);
+            for (int idx = 0; idx < 16; idx++)
+            {
+                const int coeff = cmap_coeff_matrix[k * 16 + idx];
+                if (coeff != 0)
+                {
+                    tc_S[idx] = fma(SimdReal(coeff), tx_S, tc_S[idx]);
+                }
+            }
+        }
+
+        const SimdReal tt_S = load<SimdReal>(tt);
+        const SimdReal tu_S = load<SimdReal>(tu);
+
+        SimdReal df1_S = setZero();
+        SimdReal df2_S = setZero();
+        for (int c = 3; c >= 0; c--)
+        {
+            df1_S = fma(tu_S,
+                        df1_S,
+                        fma(fma(three_S * tc_S[12 + c], tt_S, two_S * tc_S[8 + c]), tt_S, tc_S[4 + c]));
+            df2_S = fma(tt_S,
+                        df2_S,
+                        fma(fma(three_S * tc_S[c * 4 + 3], tu_S, two_S * tc_S[c * 4 + 2]),
+                            tu_S,
+                            tc_S[c * 4 + 1]));
+        }
+
+        /* Convert to -dV/dphi in radians, as for the dihedral force update */
+        const SimdReal mddphi1_S = df1_S * SimdReal(-fac);
+        const SimdReal mddphi2_S = df2_S * SimdReal(-fac);
+
+        /* After this m?_S will contain f[i] and n?_S -f[l] */
+        const SimdReal sf_i1_S  = mddphi1_S * nrkj_m2_1_S;
+        const SimdReal msf_l1_S = mddphi1_S * nrkj_n2_1_S;
+        m1x_S                   = sf_i1_S * m1x_S;
+        m1y_S                   = sf_i1_S * m1y_S;
+        m1z_S                   = sf_i1_S * m1z_S;
+        n1x_S                   = msf_l1_S * n1x_S;
+        n1y_S                   = msf_l1_S * n1y_S;
+        n1z_S                   = msf_l1_S * n1z_S;
+        do_dih_fup_noshiftf_simd(ai, aj, ak, al, p1_S, q1_S, m1x_S, m1y_S, m1z_S, n1x_S, n1y_S, n1z_S, f);
+
+        const SimdReal sf_i2_S  = mddphi2_S * nrkj_m2_2_S;
+        const SimdReal msf_l2_S = mddphi2_S * nrkj_n2_2_S;
+        m2x_S                   = sf_i2_S * m2x_S;
+        m2y_S                   = sf_i2_S * m2y_S;
+        m2z_S                   = sf_i2_S * m2z_S;
+        n2x_S                   = msf_l2_S * n2x_S;
+        n2y_S                   = msf_l2_S * n2y_S;
+        n2z_S                   = msf_l2_S * n2z_S;
+        do_dih_fup_noshiftf_simd(aj, ak, al, am, p2_S, q2_S, m2x_S, m2y_S, m2z_S, n2x_S, n2y_S, n2z_S, f);
+    }
+
+    return 0;
+}
+
+#endif // GMX_SIMD_HAVE_REAL
 
 } // namespace
 
@@ -3155,8 +3608,18 @@ real cmap_dihs(int                 nbonds,
                t_fcdata gmx_unused*     fcd,
                t_disresdata gmx_unused* disresdata,
                t_oriresdata gmx_unused* oriresdata,
-               int gmx_unused*          global_atom_index)
+               int gmx_unused*          global_atom_index,
+               BondedKernelFlavor       bondedKernelFlavor)
 {
+#if GMX_SIMD_HAVE_REAL
+    if (bondedKernelFlavor == BondedKernelFlavor::ForcesSimdWhenAvailable)
+    {
+        return cmapDihedralsSimd(nbonds, forceatoms, forceparams, cmap_grid, x, f, pbc);
+    }
+#else
+    GMX_UNUSED_VALUE(bondedKernelFlavor);
+#endif
+
     int t11, t21, t31, t12, t22, t32;
     int ip1m1, ip1p1, ip1p2;
     int ip2m1, ip2p1, ip2p2;
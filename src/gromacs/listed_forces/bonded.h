@@ -114,23 +114,6 @@ void do_dih_fup(int                 i,
                 int                 t3);
 
 
-/*! \brief Compute CMAP dihedral energies and forces */
-real cmap_dihs(int                 nbonds,
-               const t_iatom       forceatoms[],
-               const t_iparams     forceparams[],
-               const gmx_cmap_t*   cmap_grid,
-               const rvec          x[],
-               rvec4               f[],
-               rvec                fshift[],
-               const struct t_pbc* pbc,
-               real gmx_unused     lambda,
-               real gmx_unused*    dvdlambda,
-               gmx::ArrayRef<const real> /*charge*/,
-               t_fcdata gmx_unused*     fcd,
-               t_disresdata gmx_unused* disresdata,
-               t_oriresdata gmx_unused* oriresdata,
-               int gmx_unused*          global_atom_index);
-
 /*! \brief For selecting which flavor of bonded kernel is used for simple bonded types */
 enum class BondedKernelFlavor
 {
@@ -164,6 +147,28 @@ static constexpr bool computeEnergyOrVirial(const BondedKernelFlavor flavor)
             || flavor == BondedKernelFlavor::ForcesAndEnergy);
 }
 
+/*! \brief Compute CMAP dihedral energies and forces
+ *
+ * With \p bondedKernelFlavor ForcesSimdWhenAvailable only forces are computed,
+ * using SIMD when available.
+ */
+real cmap_dihs(int                 nbonds,
+               const t_iatom       forceatoms[],
+               const t_iparams     forceparams[],
+               const gmx_cmap_t*   cmap_grid,
+               const rvec          x[],
+               rvec4               f[],
+               rvec                fshift[],
+               const struct t_pbc* pbc,
+               real gmx_unused     lambda,
+               real gmx_unused*    dvdlambda,
+               gmx::ArrayRef<const real> /*charge*/,
+               t_fcdata gmx_unused*     fcd,
+               t_disresdata gmx_unused* disresdata,
+               t_oriresdata gmx_unused* oriresdata,
+               int gmx_unused*          global_atom_index,
+               BondedKernelFlavor       bondedKernelFlavor);
+
 /*! \brief Calculates bonded interactions for simple bonded types
  *
  * Exits with an error when the bonded type is not simple
@@ -323,7 +323,8 @@ real calc_one_bond(int                                 thread,
                           fcd,
                           nullptr,
                           nullptr,
-                          global_atom_index);
+                          global_atom_index,
+                          flavor);
         }
         else
         {
@@ -108,6 +108,60 @@ static void divide_bondeds_by_locality(bonded_threading_t* bt,
         at_ind[f] = ild[f].il->iatoms[1];
     }
 
+    /* Returns the type index of the unassigned interaction with the lowest
+     * first atom index, at_ind of that type is INT_MAX when all are assigned.
+     *
+     * To divide bonds based on atom order, we compare
+     * the index of the first atom in the bonded interaction.
+     * This works well, since the domain decomposition generates
+     * bondeds in order of the atoms by looking up interactions
+     * which are linked to the first atom in each interaction.
+     * It usually also works well without DD, since than the atoms
+     * in bonded interactions are usually in increasing order.
+     * If they are not assigned in increasing order, the balancing
+     * is still good, but the memory access and reduction cost will
+     * be higher.
+     */
+    auto typeWithLowestAtomIndex = [&at_ind, numType]()
+    {
+        int f_min = 0;
+        for (int fi = 1; fi < numType; fi++)
+        {
+            if (at_ind[fi] < at_ind[f_min])
+            {
+                f_min = fi;
+            }
+        }
+        assert(f_min >= 0 && f_min < numType);
+
+        return f_min;
+    };
+
+    /* Assigns the interaction with the lowest atom index (of type index f_min)
+     * to the current thread by increasing ind.
+     */
+    auto assignInteraction = [&](int f_min)
+    {
+        ind[f_min] += ild[f_min].nat + 1;
+        nat_sum += ild[f_min].nat;
+
+        /* Update the first unassigned atom index for this type */
+        if (ind[f_min] < ild[f_min].il->size())
+        {
+            at_ind[f_min] = ild[f_min].il->iatoms[ind[f_min] + 1];
+        }
+        else
+        {
+            /* We have assigned all interactions of this type.
+             * Setting at_ind to INT_MAX ensures this type will not be
+             * chosen during next iterations.
+             */
+            at_ind[f_min] = INT_MAX;
+        }
+    };
+
+    constexpr int c_numBlockBits = gmx::ThreadForceBuffer<rvec4>::s_numReductionBlockBits;
+
     nat_sum = 0;
     /* Loop over the end bounds of the nthreads threads to determine
      * which interactions threads 0 to nthreads shall calculate.
@@ -133,50 +187,31 @@ static void divide_bondeds_by_locality(bonded_threading_t* bt,
          */
         nat_thread = (nat_tot * t) / bt->nthreads;
 
+        int lastFirstAtom = -1;
         while (nat_sum < nat_thread)
         {
-            /* To divide bonds based on atom order, we compare
-             * the index of the first atom in the bonded interaction.
-             * This works well, since the domain decomposition generates
-             * bondeds in order of the atoms by looking up interactions
-             * which are linked to the first atom in each interaction.
-             * It usually also works well without DD, since than the atoms
-             * in bonded interactions are usually in increasing order.
-             * If they are not assigned in increasing order, the balancing
-             * is still good, but the memory access and reduction cost will
-             * be higher.
-             */
-            int f_min;
-
-            /* Find out which of the types has the lowest atom index */
-            f_min = 0;
-            for (f = 1; f < numType; f++)
-            {
-                if (at_ind[f] < at_ind[f_min])
-                {
-                    f_min = f;
-                }
-            }
-            assert(f_min >= 0 && f_min < numType);
-
-            /* Assign the interaction with the lowest atom index (of type
-             * index f_min) to thread t-1 by increasing ind.
-             */
-            ind[f_min] += ild[f_min].nat + 1;
-            nat_sum += ild[f_min].nat;
+            const int f_min = typeWithLowestAtomIndex();
+            lastFirstAtom   = at_ind[f_min];
+            assignInteraction(f_min);
+        }
 
-            /* Update the first unassigned atom index for this type */
-            if (ind[f_min] < ild[f_min].il->size())
-            {
-                at_ind[f_min] = ild[f_min].il->iatoms[ind[f_min] + 1];
-            }
-            else
+        /* Move the bound between this thread and the next up to the end
+         * of the force reduction block of the last assigned first atom.
+         * This way each block of first atoms is owned by a single thread,
+         * which means that only interactions that cross block boundaries
+         * cause force buffer blocks to be shared between threads.
+         * Shared blocks need to be reduced over multiple buffers,
+         * whereas blocks owned by a single thread are reduced by that thread.
+         * This adds an imbalance of at most one block of atoms per thread.
+         */
+        if (t < bt->nthreads && lastFirstAtom >= 0)
+        {
+            int f_min = typeWithLowestAtomIndex();
+            while (at_ind[f_min] != INT_MAX
+                   && (at_ind[f_min] >> c_numBlockBits) == (lastFirstAtom >> c_numBlockBits))
             {
-                /* We have assigned all interactions of this type.
-                 * Setting at_ind to INT_MAX ensures this type will not be
-                 * chosen in the for loop above during next iterations.
-                 */
-                at_ind[f_min] = INT_MAX;
+                assignInteraction(f_min);
+                f_min = typeWithLowestAtomIndex();
             }
         }
 
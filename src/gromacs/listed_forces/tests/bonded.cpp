@@ -54,6 +54,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <ostream>
 #include <string>
 #include <tuple>
@@ -838,6 +839,118 @@ INSTANTIATE_TEST_SUITE_P(AngleZero,
                                             ::testing::ValuesIn(c_coordinatesForTestsZeroAngle),
                                             ::testing::ValuesIn(c_pbcForTests)));
 
+/*! \brief Tests that the force-only CMAP kernel, which uses SIMD when available,
+ * gives the same forces as the kernel that also computes energies and the virial
+ */
+TEST(CmapTest, ForceOnlyFlavorMatchesReferenceFlavor)
+{
+    // Two CMAP types with smooth, but otherwise arbitrary values on the grid
+    constexpr int c_gridSpacing = 24;
+    gmx_cmap_t    cmapGrid;
+    cmapGrid.grid_spacing = c_gridSpacing;
+    cmapGrid.cmapdata.resize(2);
+    for (int type = 0; type < 2; type++)
+    {
+        std::vector<real>& cmap = cmapGrid.cmapdata[type].cmap;
+        cmap.resize(4 * c_gridSpacing * c_gridSpacing);
+        const real amplitude = 1.0 + type;
+        for (int i = 0; i < c_gridSpacing; i++)
+        {
+            for (int j = 0; j < c_gridSpacing; j++)
+            {
+                const real phi  = -M_PI + 2 * M_PI * i / c_gridSpacing;
+                const real psi  = -M_PI + 2 * M_PI * j / c_gridSpacing;
+                real*      grid = cmap.data() + (i * c_gridSpacing + j) * 4;
+                // The value and derivatives per degree
+                grid[0] = amplitude * std::sin(phi) * std::cos(2 * psi);
+                grid[1] = amplitude * std::cos(phi) * std::cos(2 * psi) * c_deg2Rad;
+                grid[2] = -2 * amplitude * std::sin(phi) * std::sin(2 * psi) * c_deg2Rad;
+                grid[3] = -2 * amplitude * std::cos(phi) * std::sin(2 * psi) * c_deg2Rad * c_deg2Rad;
+            }
+        }
+    }
+    t_iparams iparams[2];
+    for (int type = 0; type < 2; type++)
+    {
+        iparams[type].cmap.cmapA = type;
+        iparams[type].cmap.cmapB = type;
+    }
+
+    // An irregular chain with CMAPs over each five consecutive atoms,
+    // the number of CMAPs is not a multiple of common SIMD widths
+    constexpr int      c_numChainAtoms = 16;
+    PaddedVector<RVec> x(c_numChainAtoms);
+    for (int a = 0; a < c_numChainAtoms; a++)
+    {
+        x[a] = { 0.12_real * a + 0.03_real * std::sin(1.3_real * a),
+                 0.1_real * std::cos(1.9_real * a),
+                 0.1_real * std::sin(2.3_real * a) };
+    }
+    std::vector<t_iatom> iatoms;
+    for (int a = 0; a + 4 < c_numChainAtoms; a++)
+    {
+        iatoms.insert(iatoms.end(), { a % 2, a, a + 1, a + 2, a + 3, a + 4 });
+    }
+
+    std::vector<int> ddgatindex(c_numChainAtoms);
+    std::iota(ddgatindex.begin(), ddgatindex.end(), 0);
+
+    alignas(GMX_REAL_MAX_SIMD_WIDTH * sizeof(real)) rvec4 fReference[c_numChainAtoms] = { { 0 } };
+    alignas(GMX_REAL_MAX_SIMD_WIDTH * sizeof(real)) rvec4 fForceOnly[c_numChainAtoms] = { { 0 } };
+    rvec fshift[c_numShiftVectors] = { { 0 } };
+    real dvdlambda                 = 0;
+
+    cmap_dihs(iatoms.size(),
+              iatoms.data(),
+              iparams,
+              &cmapGrid,
+              as_rvec_array(x.data()),
+              fReference,
+              fshift,
+              nullptr,
+              0,
+              &dvdlambda,
+              {},
+              nullptr,
+              nullptr,
+              nullptr,
+              ddgatindex.data(),
+              BondedKernelFlavor::ForcesAndVirialAndEnergy);
+    cmap_dihs(iatoms.size(),
+              iatoms.data(),
+              iparams,
+              &cmapGrid,
+              as_rvec_array(x.data()),
+              fForceOnly,
+              nullptr,
+              nullptr,
+              0,
+              &dvdlambda,
+              {},
+              nullptr,
+              nullptr,
+              nullptr,
+              ddgatindex.data(),
+              BondedKernelFlavor::ForcesSimdWhenAvailable);
+
+    real maxForce = 0;
+    for (int a = 0; a < c_numChainAtoms; a++)
+    {
+        maxForce = std::max(maxForce, std::sqrt(norm2(fReference[a])));
+    }
+    EXPECT_GT(maxForce, 0);
+    // The SIMD kernel computes the dihedral angles with atan2() instead of asin()/acos()
+    const FloatingPointTolerance tolerance = relativeToleranceAsFloatingPoint(maxForce, 1e-4);
+    for (int a = 0; a < c_numChainAtoms; a++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_REAL_EQ_TOL(fReference[a][d], fForceOnly[a][d], tolerance)
+                    << "atom " << a << " dimension " << d;
+        }
+    }
+}
+
 } // namespace
 
 } // namespace test
@@ -1206,7 +1206,8 @@ Constraints::Impl::Impl(const gmx_mtop_t&          mtop_p,
                 please_cite(log, "Barth95a");
             }
 
-            shaked = std::make_unique<shakedata>();
+            shaked             = std::make_unique<shakedata>();
+            shaked->numThreads = gmx_omp_nthreads_get(ModuleMultiThread::Shake);
         }
     }
 
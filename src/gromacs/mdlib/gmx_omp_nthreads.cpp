@@ -80,7 +80,8 @@ static const char* enumValueToEnvVariableString(ModuleMultiThread enumValue)
         "GMX_UPDATE_NUM_THREADS",
         "GMX_VSITE_NUM_THREADS",
         "GMX_LINCS_NUM_THREADS",
-        "GMX_SETTLE_NUM_THREADS"
+        "GMX_SETTLE_NUM_THREADS",
+        "GMX_SHAKE_NUM_THREADS"
     };
     return moduleMultiThreadEnvVariableNames[enumValue];
 }
@@ -90,7 +91,7 @@ static const char* enumValueToString(ModuleMultiThread enumValue)
 {
     constexpr gmx::EnumerationArray<ModuleMultiThread, const char*> moduleMultiThreadNames = {
         "default", "domain decomposition", "pair search", "non-bonded", "bonded", "PME",
-        "update",  "virtual sites",        "LINCS",       "SETTLE"
+        "update",  "virtual sites",        "LINCS",       "SETTLE",     "SHAKE"
     };
     return moduleMultiThreadNames[enumValue];
 }
@@ -104,7 +105,7 @@ static const char* enumValueToString(ModuleMultiThread enumValue)
  *  the init call is omitted.
  * */
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-static omp_module_nthreads_t modth = { 0, 0, { 0, 0, 0, 0, 0, 0, 0, 0, 0 } };
+static omp_module_nthreads_t modth = { 0, 0, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 } };
 
 
 /** Determine the number of threads for module \p mod.
@@ -364,6 +365,7 @@ static void manage_number_of_openmp_threads(const gmx::MDLogger& mdlog,
     pick_module_nthreads(mdlog, ModuleMultiThread::VirtualSite, haveSeparatePmeRanks);
     pick_module_nthreads(mdlog, ModuleMultiThread::Lincs, haveSeparatePmeRanks);
     pick_module_nthreads(mdlog, ModuleMultiThread::Settle, haveSeparatePmeRanks);
+    pick_module_nthreads(mdlog, ModuleMultiThread::Shake, haveSeparatePmeRanks);
 
     /* set the number of threads globally */
     if (haveOpenMP)
@@ -58,6 +58,7 @@ enum class ModuleMultiThread : int
     VirtualSite,
     Lincs,
     Settle,
+    Shake,
     Count
 };
 
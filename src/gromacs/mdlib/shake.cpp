@@ -44,6 +44,7 @@
 #include "shake.h"
 
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 
 #include <algorithm>
@@ -63,6 +64,7 @@
 #include "gromacs/topology/invblock.h"
 #include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/gmxassert.h"
 #include "gromacs/utility/listoflists.h"
@@ -202,6 +204,8 @@ void make_shake_sblock_serial(shakedata* shaked, InteractionDefinitions* idef, c
     }
     /* Last block... */
     shaked->sblock.push_back(3 * ncons);
+    /* The blocks are connected sets of constraints, so they have no atoms in common */
+    shaked->blocksAreIndependent = true;
 
     resizeLagrangianData(shaked, ncons);
 }
@@ -227,6 +231,10 @@ void make_shake_sblock_dd(shakedata* shaked, const InteractionList& ilcon)
         iatom += 3;
     }
     shaked->sblock.push_back(3 * ncons);
+    /* The blocks are split at each new first atom, so constraints
+     * in different blocks can share atoms.
+     */
+    shaked->blocksAreIndependent = false;
     resizeLagrangianData(shaked, ncons);
 }
 
@@ -428,9 +436,14 @@ static void crattle(const int            iatom[],
     *nerror = error;
 }
 
-//! Applies SHAKE
+/*! \brief Applies SHAKE to a block of \p ncon constraints
+ *
+ * The working data for the block is stored in \p shaked starting
+ * at constraint index \p constraintOffset.
+ */
 static int vec_shakef(FILE*                     fplog,
                       shakedata*                shaked,
+                      int                       constraintOffset,
                       ArrayRef<const real>      invmass,
                       int                       ncon,
                       ArrayRef<const t_iparams> ip,
@@ -455,15 +468,13 @@ static int vec_shakef(FILE*                     fplog,
     int  error = 0;
     real constraint_distance;
 
-    shaked->rij.resize(ncon);
-    shaked->half_of_reduced_mass.resize(ncon);
-    shaked->distance_squared_tolerance.resize(ncon);
-    shaked->constraint_distance_squared.resize(ncon);
-
-    ArrayRef<RVec> rij                         = shaked->rij;
-    ArrayRef<real> half_of_reduced_mass        = shaked->half_of_reduced_mass;
-    ArrayRef<real> distance_squared_tolerance  = shaked->distance_squared_tolerance;
-    ArrayRef<real> constraint_distance_squared = shaked->constraint_distance_squared;
+    ArrayRef<RVec> rij = makeArrayRef(shaked->rij).subArray(constraintOffset, ncon);
+    ArrayRef<real> half_of_reduced_mass =
+            makeArrayRef(shaked->half_of_reduced_mass).subArray(constraintOffset, ncon);
+    ArrayRef<real> distance_squared_tolerance =
+            makeArrayRef(shaked->distance_squared_tolerance).subArray(constraintOffset, ncon);
+    ArrayRef<real> constraint_distance_squared =
+            makeArrayRef(shaked->constraint_distance_squared).subArray(constraintOffset, ncon);
 
     L1            = 1.0_real - lambda;
     const int* ia = iatom;
@@ -707,7 +718,7 @@ static bool bshakef(FILE*                         log,
                     ConstraintVariable            econq)
 {
     real dt_2, dvdl;
-    int  i, n0, ncon, blen, type, ll;
+    int  ncon, type, ll;
     int  tnit = 0, trij = 0;
 
     ncon = idef.il[InteractionFunction::Constraints].size() / 3;
@@ -717,21 +728,65 @@ static bool bshakef(FILE*                         log,
         shaked->scaled_lagrange_multiplier[ll] = 0;
     }
 
-    // TODO Rewrite this block so that it is obvious that i, iatoms
-    // and lam are all iteration variables. Is this easier if the
-    // sblock data structure is organized differently?
-    const int*     iatoms = &(idef.il[InteractionFunction::Constraints].iatoms[shaked->sblock[0]]);
-    ArrayRef<real> lam    = shaked->scaled_lagrange_multiplier;
-    for (i = 0; (i < shaked->numShakeBlocks());)
+    shaked->rij.resize(ncon);
+    shaked->half_of_reduced_mass.resize(ncon);
+    shaked->distance_squared_tolerance.resize(ncon);
+    shaked->constraint_distance_squared.resize(ncon);
+
+    /* Blocks without shared atoms are independent, so we can distribute
+     * them over threads. Each thread gets a contiguous range of blocks
+     * with about the same number of constraints. Only the summation order
+     * of the virial depends on the number of threads.
+     */
+    const int numBlocks = shaked->numShakeBlocks();
+    const int numThreads =
+            (shaked->blocksAreIndependent ? std::min(shaked->numThreads, numBlocks) : 1);
+    shaked->taskData.resize(numThreads);
+
+    const int* iatomsAll = idef.il[InteractionFunction::Constraints].iatoms.data();
+
+    /* Returns the first block that starts at or after constraint index c */
+    auto blockForConstraint = [shaked, numBlocks](int c)
+    {
+        return static_cast<int>(
+                std::lower_bound(shaked->sblock.begin(), shaked->sblock.begin() + numBlocks, 3 * c)
+                - shaked->sblock.begin());
+    };
+
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (int th = 0; th < numThreads; th++)
     {
-        blen = (shaked->sblock[i + 1] - shaked->sblock[i]);
-        blen /= 3;
-        n0 = vec_shakef(log,
+        try
+        {
+            ShakeTaskData& task = shaked->taskData[th];
+            clear_mat(task.vir_r_m_dr);
+            task.numIterations  = 0;
+            task.numConstraints = 0;
+            task.failedBlock    = -1;
+
+            const int blockBegin =
+                    (th == 0 ? 0 : blockForConstraint((ncon * int64_t(th)) / numThreads));
+            const int blockEnd =
+                    (th == numThreads - 1
+                             ? numBlocks
+                             : blockForConstraint((ncon * int64_t(th + 1)) / numThreads));
+
+            for (int b = blockBegin; b < blockEnd; b++)
+            {
+                const int firstConstraint = shaked->sblock[b] / 3;
+                const int blen            = shaked->sblock[b + 1] / 3 - firstConstraint;
+
+                ArrayRef<real> lam =
+                        makeArrayRef(shaked->scaled_lagrange_multiplier).subArray(firstConstraint, blen);
+
+                const int n0 = vec_shakef(
+                        log,
                         shaked,
+                        firstConstraint,
                         invmass,
                         blen,
                         idef.iparams,
-                        iatoms,
+                        iatomsAll + shaked->sblock[b],
                         ir.shake_tol,
                         x_s,
                         prime,
@@ -743,24 +798,40 @@ static bool bshakef(FILE*                         log,
                         invdt,
                         v,
                         bCalcVir,
-                        vir_r_m_dr,
+                        task.vir_r_m_dr,
                         econq);
 
-        if (n0 == 0)
+                if (n0 == 0)
+                {
+                    task.failedBlock = b;
+                    break;
+                }
+                task.numIterations += n0 * blen;
+                task.numConstraints += blen;
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
+
+    for (const ShakeTaskData& task : shaked->taskData)
+    {
+        if (task.failedBlock >= 0)
         {
             if (bDumpOnError && log)
             {
-                {
-                    check_cons(log, blen, x_s, prime, v, pbc, idef.iparams, iatoms, invmass, econq);
-                }
+                const int  b      = task.failedBlock;
+                const int  blen   = (shaked->sblock[b + 1] - shaked->sblock[b]) / 3;
+                const int* iatoms = iatomsAll + shaked->sblock[b];
+                check_cons(log, blen, x_s, prime, v, pbc, idef.iparams, iatoms, invmass, econq);
             }
             return FALSE;
         }
-        tnit += n0 * blen;
-        trij += blen;
-        iatoms += 3 * blen; /* Increment pointer! */
-        lam = lam.subArray(blen, lam.ssize() - blen);
-        i++;
+        tnit += task.numIterations;
+        trij += task.numConstraints;
+        if (bCalcVir)
+        {
+            m_add(vir_r_m_dr, task.vir_r_m_dr, vir_r_m_dr);
+        }
     }
     /* only for position part? */
     if (econq == ConstraintVariable::Positions)
@@ -66,6 +66,21 @@ class ArrayRef;
 
 enum class ConstraintVariable : int;
 
+/*! \libinternal
+ * \brief Output of a thread task of SHAKE
+ */
+struct ShakeTaskData
+{
+    //! The constraint virial contribution, sum r x m delta_r
+    tensor vir_r_m_dr;
+    //! The number of iterations times constraints
+    int numIterations;
+    //! The number of constraints
+    int numConstraints;
+    //! The first block that failed, -1 when all blocks converged
+    int failedBlock;
+};
+
 /*! \libinternal
  * \brief Working data for the SHAKE algorithm
  */
@@ -74,6 +89,13 @@ struct shakedata
     //! Returns the number of SHAKE blocks */
     int numShakeBlocks() const { return sblock.size() - 1; }
 
+    //! The maximum number of threads to distribute the SHAKE blocks over
+    int numThreads = 1;
+    //! Whether the blocks have no atoms in common, so they can be constrained in parallel
+    bool blocksAreIndependent = false;
+    //! Thread task output
+    std::vector<ShakeTaskData> taskData;
+
     //! The reference constraint vectors
     std::vector<RVec> rij;
     //! The reduced mass of the two atoms in each constraint times 0.5
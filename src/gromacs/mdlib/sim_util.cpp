@@ -1833,6 +1833,18 @@ void do_force(FILE*                         fplog,
                                  stepWork);
     }
 
+    /* With CPU non-bonded work and the CPU halo exchange, we only post
+     * the coordinate halo communication here and complete it after
+     * the local non-bonded work has been computed, so the communication
+     * overlaps with the local non-bonded computation. This requires that
+     * no work before that point uses non-local coordinates.
+     */
+    const bool overlapHaloXWithLocalNonbonded =
+            (simulationWork.havePpDomainDecomposition && cr->dd->haloExchange
+             && !stepWork.doNeighborSearch && !stepWork.useGpuXHalo && !stepWork.useGpuXBufferOps
+             && !simulationWork.useGpuUpdate && !simulationWork.useGpuNonbonded
+             && !fr->nbv->emulateGpu() && !fr->wholeMoleculeTransform);
+
     /* Communicate coordinates and sum dipole if necessary */
     if (simulationWork.havePpDomainDecomposition)
     {
@@ -1866,7 +1878,14 @@ void do_force(FILE*                         fplog,
                     }
                 }
 
-                if (cr->dd->haloExchange)
+                if (overlapHaloXWithLocalNonbonded)
+                {
+                    wallcycle_start(wcycle, WallCycleCounter::MoveX);
+                    cr->dd->haloExchange->initiateReceiveX(x.unpaddedArrayRef());
+                    cr->dd->haloExchange->initiateSendX(box, x.unpaddedArrayRef());
+                    wallcycle_stop(wcycle, WallCycleCounter::MoveX);
+                }
+                else if (cr->dd->haloExchange)
                 {
                     wallcycle_start(wcycle, WallCycleCounter::MoveX);
                     cr->dd->haloExchange->moveX(box, x.unpaddedArrayRef());
@@ -1896,7 +1915,7 @@ void do_force(FILE*                         fplog,
             nbv->convertCoordinatesGpu(
                     AtomLocality::NonLocal, stateGpu->getCoordinates(), xReadyOnDeviceEvent);
         }
-        else if (!stepWork.doNeighborSearch)
+        else if (!stepWork.doNeighborSearch && !overlapHaloXWithLocalNonbonded)
         {
             nbv->convertCoordinates(AtomLocality::NonLocal, x.unpaddedArrayRef());
         }
@@ -2090,6 +2109,17 @@ void do_force(FILE*                         fplog,
         wallcycle_stop(wcycle, WallCycleCounter::Force);
     }
 
+    if (overlapHaloXWithLocalNonbonded)
+    {
+        /* Complete the coordinate halo exchange started before the local work */
+        wallcycle_start(wcycle, WallCycleCounter::MoveX);
+        cr->dd->haloExchange->completeReceiveX();
+        cr->dd->haloExchange->completeSendX();
+        wallcycle_stop(wcycle, WallCycleCounter::MoveX);
+
+        nbv->convertCoordinates(AtomLocality::NonLocal, x.unpaddedArrayRef());
+    }
+
     if (stepWork.useGpuXHalo && domainWork.haveCpuNonLocalForceWork)
     {
         /* Wait for non-local coordinate data to be copied from device */
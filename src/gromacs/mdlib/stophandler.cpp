@@ -56,7 +56,7 @@ namespace gmx
 StopHandler::StopHandler(compat::not_null<SimulationSignal*>      signal,
                          bool                                     simulationShareState,
                          std::vector<std::function<StopSignal()>> stopConditions,
-                         int                                      nstList) :
+                         const int&                               nstList) :
     signal_(*signal), stopConditions_(std::move(stopConditions)), nstList_(nstList)
 {
     if (simulationShareState)
@@ -65,7 +65,7 @@ StopHandler::StopHandler(compat::not_null<SimulationSignal*>      signal,
     }
 }
 
-StopConditionSignal::StopConditionSignal(int nstList, bool makeBinaryReproducibleSimulation, int nstSignalComm) :
+StopConditionSignal::StopConditionSignal(const int& nstList, bool makeBinaryReproducibleSimulation, int nstSignalComm) :
     handledStopCondition_(StopCondition::None),
     makeBinaryReproducibleSimulation_(makeBinaryReproducibleSimulation),
     nstSignalComm_(nstSignalComm),
@@ -122,7 +122,7 @@ StopSignal StopConditionSignal::getSignal(FILE* fplog)
     return signal;
 }
 
-StopConditionTime::StopConditionTime(int nstList, real maximumHoursToRun, int nstSignalComm) :
+StopConditionTime::StopConditionTime(const int& nstList, real maximumHoursToRun, int nstSignalComm) :
     signalSent_(false), maximumHoursToRun_(maximumHoursToRun), nstList_(nstList), nstSignalComm_(nstSignalComm)
 {
 }
@@ -168,9 +168,9 @@ void StopHandlerBuilder::registerStopCondition(std::function<StopSignal()> stopC
 };
 
 std::unique_ptr<StopHandler> StopHandlerBuilder::getStopHandlerMD(compat::not_null<SimulationSignal*> signal,
-                                                                  bool simulationShareState,
-                                                                  bool isMain,
-                                                                  int  nstList,
+                                                                  bool       simulationShareState,
+                                                                  bool       isMain,
+                                                                  const int& nstList,
                                                                   bool makeBinaryReproducibleSimulation,
                                                                   int            nstSignalComm,
                                                                   real           maximumHoursToRun,
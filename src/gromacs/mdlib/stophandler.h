@@ -138,12 +138,13 @@ public:
      * @param nstList        The pairlist update interval in steps, 0 is never update
      *
      * Note: As the StopHandler does not work without this signal, it keeps a non-const reference
-     * to it as a member variable.
+     * to it as a member variable. The pairlist update interval can change during the run,
+     * so a reference to it is kept as well.
      */
     StopHandler(compat::not_null<SimulationSignal*>      signal,
                 bool                                     simulationShareState,
                 std::vector<std::function<StopSignal()>> stopConditions,
-                int                                      nstList);
+                const int&                               nstList);
 
     /*! \brief Decides whether a stop signal shall be sent
      *
@@ -193,7 +194,7 @@ public:
 private:
     SimulationSignal&                              signal_;
     const std::vector<std::function<StopSignal()>> stopConditions_;
-    const int                                      nstList_;
+    const int&                                     nstList_;
 };
 
 /*! \libinternal
@@ -206,7 +207,7 @@ class StopConditionSignal final
 public:
     /*! \brief StopConditionSignal constructor
      */
-    StopConditionSignal(int nstList, bool makeBinaryReproducibleSimulation, int nstSignalComm);
+    StopConditionSignal(const int& nstList, bool makeBinaryReproducibleSimulation, int nstSignalComm);
 
     /*! \brief Decides whether a stopping signal needs to be set
      *
@@ -220,7 +221,7 @@ private:
     StopCondition handledStopCondition_;
     const bool    makeBinaryReproducibleSimulation_;
     const int     nstSignalComm_;
-    const int     nstList_;
+    const int&    nstList_;
 };
 
 /*! \libinternal
@@ -233,7 +234,7 @@ class StopConditionTime final
 public:
     /*! \brief StopConditionTime constructor
      */
-    StopConditionTime(int nstList, real maximumHoursToRun, int nstSignalComm);
+    StopConditionTime(const int& nstList, real maximumHoursToRun, int nstSignalComm);
 
     /*! \brief Decides whether a stopping signal needs to be set
      *
@@ -246,7 +247,7 @@ private:
     bool signalSent_;
 
     const real maximumHoursToRun_;
-    const int  nstList_;
+    const int& nstList_;
     const int  nstSignalComm_;
 };
 
@@ -293,11 +294,13 @@ public:
      * stop conditions. Initializes a new StopHandler with this extended vector of
      * stop conditions. It is the caller's responsibility to make sure arguments passed by
      * pointer or reference remain valid for the lifetime of the returned StopHandler.
+     * \p nstList is passed by reference, so that the stop conditions and the StopHandler
+     * follow changes of the pairlist update interval during the run.
      */
     std::unique_ptr<StopHandler> getStopHandlerMD(compat::not_null<SimulationSignal*> signal,
                                                   bool           simulationShareState,
                                                   bool           isMain,
-                                                  int            nstList,
+                                                  const int&     nstList,
                                                   bool           makeBinaryReproducibleSimulation,
                                                   int            nstSignalComm,
                                                   real           maximumHoursToRun,
@@ -94,8 +94,11 @@ public:
 class ShakeConstraintsRunner : public IConstraintsTestRunner
 {
 public:
-    //! Default constructor.
-    ShakeConstraintsRunner() {}
+    /*! \brief Constructor.
+     *
+     * \param[in] numThreads  The maximum number of threads to distribute SHAKE blocks over.
+     */
+    ShakeConstraintsRunner(int numThreads = 1) : numThreads_(numThreads) {}
     /*! \brief Apply SHAKE constraints to the test data.
      *
      * \param[in] testData             Test data structure.
@@ -108,7 +111,15 @@ public:
      *
      * \return "SHAKE" string;
      */
-    std::string name() override { return "SHAKE on CPU"; }
+    std::string name() override
+    {
+        return numThreads_ == 1 ? "SHAKE on CPU"
+                                : "SHAKE on CPU with " + std::to_string(numThreads_) + " threads";
+    }
+
+private:
+    //! The maximum number of threads to distribute SHAKE blocks over
+    int numThreads_;
 };
 
 // Runner for the CPU implementation of LINCS constraints algorithm.
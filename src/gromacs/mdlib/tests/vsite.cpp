@@ -0,0 +1,356 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief Tests for virtual site construction and force spreading.
+ *
+ * Checks constructVirtualSites against plain reference implementations
+ * of the construction formulas for enough virtual sites per type to
+ * exercise both the SIMD batches and the scalar remainder. Checks that
+ * force spreading with the SIMD kernels matches the scalar code.
+ *
+ * \ingroup module_mdlib
+ */
+#include "gmxpre.h"
+
+#include "gromacs/mdlib/vsite.h"
+
+#include <cmath>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/gmxlib/nrnb.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
+#include "gromacs/pbcutil/ishift.h"
+#include "gromacs/pbcutil/pbc.h"
+#include "gromacs/topology/idef.h"
+#include "gromacs/topology/ifunc.h"
+#include "gromacs/topology/topology.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/vec.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/setenv.h"
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! The number of virtual sites per type, not a multiple of any SIMD width
+constexpr int c_numVsitesPerType = 37;
+
+//! Returns a deterministic, irregular position for atom \p atom
+RVec atomPosition(int atom)
+{
+    return { static_cast<real>(0.3 * atom + 0.11 * std::sin(1.3 * atom)),
+             static_cast<real>(0.7 + 0.23 * std::cos(0.7 * atom)),
+             static_cast<real>(-0.4 + 0.19 * std::sin(2.1 * atom + 0.5)) };
+}
+
+/*! \brief Double precision reference for the position of one virtual site
+ *
+ * \p atoms points to the vsite index followed by the constructing atoms.
+ */
+std::array<double, DIM> referencePosition(InteractionFunction  ftype,
+                                          const t_iparams&     ip,
+                                          ArrayRef<const RVec> x,
+                                          const int*           atoms)
+{
+    auto diff = [&x](int a, int b)
+    {
+        return std::array<double, DIM>{ double(x[a][XX]) - x[b][XX],
+                                        double(x[a][YY]) - x[b][YY],
+                                        double(x[a][ZZ]) - x[b][ZZ] };
+    };
+    auto cross = [](const std::array<double, DIM>& u, const std::array<double, DIM>& v)
+    {
+        return std::array<double, DIM>{ u[YY] * v[ZZ] - u[ZZ] * v[YY],
+                                        u[ZZ] * v[XX] - u[XX] * v[ZZ],
+                                        u[XX] * v[YY] - u[YY] * v[XX] };
+    };
+    auto norm = [](const std::array<double, DIM>& u)
+    { return std::sqrt(u[XX] * u[XX] + u[YY] * u[YY] + u[ZZ] * u[ZZ]); };
+
+    const double a = ip.vsite.a;
+    const double b = ip.vsite.b;
+    const double c = ip.vsite.c;
+
+    const int               ai  = atoms[1];
+    const auto              xij = diff(atoms[2], ai);
+    const auto              xik = diff(atoms[3], ai);
+    std::array<double, DIM> dx  = {};
+    switch (ftype)
+    {
+        case InteractionFunction::VirtualSite3:
+            for (int d = 0; d < DIM; d++)
+            {
+                dx[d] = a * xij[d] + b * xik[d];
+            }
+            break;
+        case InteractionFunction::VirtualSite3FlexibleDistance:
+        {
+            std::array<double, DIM> temp;
+            for (int d = 0; d < DIM; d++)
+            {
+                temp[d] = xij[d] + a * (xik[d] - xij[d]);
+            }
+            const double scale = b / norm(temp);
+            for (int d = 0; d < DIM; d++)
+            {
+                dx[d] = scale * temp[d];
+            }
+            break;
+        }
+        case InteractionFunction::VirtualSite3Outside:
+        {
+            const auto temp = cross(xij, xik);
+            for (int d = 0; d < DIM; d++)
+            {
+                dx[d] = a * xij[d] + b * xik[d] + c * temp[d];
+            }
+            break;
+        }
+        case InteractionFunction::VirtualSite4FlexibleDistanceNormalization:
+        {
+            const auto              xil = diff(atoms[4], ai);
+            std::array<double, DIM> rja;
+            std::array<double, DIM> rjb;
+            for (int d = 0; d < DIM; d++)
+            {
+                rja[d] = a * xik[d] - xij[d];
+                rjb[d] = b * xil[d] - xij[d];
+            }
+            const auto   rm    = cross(rja, rjb);
+            const double scale = c / norm(rm);
+            for (int d = 0; d < DIM; d++)
+            {
+                dx[d] = scale * rm[d];
+            }
+            break;
+        }
+        default: GMX_RELEASE_ASSERT(false, "Unhandled virtual site type");
+    }
+
+    return { x[ai][XX] + dx[XX], x[ai][YY] + dx[YY], x[ai][ZZ] + dx[ZZ] };
+}
+
+//! The virtual site types that have SIMD kernels
+const std::array<InteractionFunction, 4> c_simdVsiteTypes = {
+    InteractionFunction::VirtualSite3,
+    InteractionFunction::VirtualSite3FlexibleDistance,
+    InteractionFunction::VirtualSite3Outside,
+    InteractionFunction::VirtualSite4FlexibleDistanceNormalization
+};
+
+//! Returns two parameter sets for virtual sites, used alternatingly
+std::vector<t_iparams> vsiteParameters()
+{
+    std::vector<t_iparams> iparams(2);
+    iparams[0].vsite.a = 0.3;
+    iparams[0].vsite.b = 0.4;
+    iparams[0].vsite.c = 1.5;
+    iparams[1].vsite.a = 0.6;
+    iparams[1].vsite.b = 0.2;
+    iparams[1].vsite.c = -2.5;
+
+    return iparams;
+}
+
+TEST(VirtualSiteTest, ConstructsManyVirtualSitesOfEachType)
+{
+    const std::array<InteractionFunction, 4>& vsiteTypes = c_simdVsiteTypes;
+
+    const std::vector<t_iparams> iparams = vsiteParameters();
+
+    gmx::EnumerationArray<InteractionFunction, InteractionList> ilists;
+    int                                                         numAtoms = 0;
+    for (InteractionFunction ftype : vsiteTypes)
+    {
+        const int numConstructingAtoms = NRAL(ftype) - 1;
+        for (int v = 0; v < c_numVsitesPerType; v++)
+        {
+            /* The constructing atoms come first, the vsite last */
+            std::array<int, 5> atoms = {};
+            atoms[0]                 = numAtoms + numConstructingAtoms;
+            for (int j = 0; j < numConstructingAtoms; j++)
+            {
+                atoms[1 + j] = numAtoms + j;
+            }
+            ilists[ftype].push_back(v % 2, NRAL(ftype), atoms.data());
+            numAtoms += NRAL(ftype);
+        }
+    }
+
+    std::vector<RVec> x(numAtoms);
+    for (int a = 0; a < numAtoms; a++)
+    {
+        x[a] = atomPosition(a);
+    }
+    const std::vector<RVec> xInitial = x;
+
+    constructVirtualSites(x, iparams, &ilists);
+
+    const FloatingPointTolerance tolerance = relativeToleranceAsFloatingPoint(1.0, 1e-5);
+    for (InteractionFunction ftype : vsiteTypes)
+    {
+        SCOPED_TRACE(interaction_function[ftype].longname);
+
+        ArrayRef<const int> iatoms = ilists[ftype].iatoms;
+        for (int i = 0; i < iatoms.ssize(); i += 1 + NRAL(ftype))
+        {
+            const std::array<double, DIM> ref =
+                    referencePosition(ftype, iparams[iatoms[i]], xInitial, iatoms.data() + i + 1);
+            const int vsite = iatoms[i + 1];
+            for (int d = 0; d < DIM; d++)
+            {
+                EXPECT_REAL_EQ_TOL(ref[d], x[vsite][d], tolerance);
+            }
+        }
+    }
+}
+
+/*! \brief Spreads the forces \p f with a single thread and sets the non-linear virial
+ *
+ * The SIMD kernels are used unless \p disableSimd is true.
+ */
+void spreadForces(const gmx_mtop_t&                                                  mtop,
+                  const gmx::EnumerationArray<InteractionFunction, InteractionList>& ilists,
+                  ArrayRef<const RVec>                                               x,
+                  ArrayRef<RVec>                                                     f,
+                  const bool                                                         disableSimd,
+                  matrix*                                                            virial)
+{
+    if (disableSimd)
+    {
+        gmxSetenv("GMX_DISABLE_SIMD_KERNELS", "1", true);
+    }
+    VirtualSitesHandler vsiteHandler(mtop, nullptr, PbcType::No, {});
+    if (disableSimd)
+    {
+        gmxUnsetenv("GMX_DISABLE_SIMD_KERNELS");
+    }
+
+    vsiteHandler.setVirtualSites(&ilists, x.ssize(), x.ssize(), {});
+
+    std::vector<RVec> fshift(c_numShiftVectors, { 0.0_real, 0.0_real, 0.0_real });
+    matrix            box = { { 0 } };
+    t_nrnb            nrnb;
+    clear_mat(*virial);
+    vsiteHandler.spreadForces(
+            x, f, VirtualSitesHandler::VirialHandling::NonLinear, fshift, *virial, &nrnb, box, nullptr);
+}
+
+/* Checks that the SIMD force spreading kernels give the same result as the
+ * scalar code. Batches of virtual sites share constructing atoms, so the
+ * SIMD kernels need to accumulate forces to the same atom multiple times.
+ */
+TEST(VirtualSiteTest, SpreadsForcesOfManyVirtualSitesOfEachType)
+{
+    gmx_omp_nthreads_set(ModuleMultiThread::VirtualSite, 1);
+
+    gmx_mtop_t mtop;
+    mtop.ffparams.iparams = vsiteParameters();
+
+    /* The constructing atoms are taken from a small pool per type, so atoms
+     * are used by several virtual sites in a SIMD batch. Atoms of the same
+     * virtual site are distinct.
+     */
+    constexpr int c_poolSize = 7;
+
+    gmx::EnumerationArray<InteractionFunction, InteractionList> ilists;
+    int                                                         numAtoms = 0;
+    for (InteractionFunction ftype : c_simdVsiteTypes)
+    {
+        const int numConstructingAtoms = NRAL(ftype) - 1;
+        const int poolStart            = numAtoms;
+        numAtoms += c_poolSize;
+        for (int v = 0; v < c_numVsitesPerType; v++)
+        {
+            std::array<int, 5> atoms = {};
+            atoms[0]                 = numAtoms + v;
+            for (int j = 0; j < numConstructingAtoms; j++)
+            {
+                atoms[1 + j] = poolStart + (v + 2 * j) % c_poolSize;
+            }
+            ilists[ftype].push_back(v % 2, NRAL(ftype), atoms.data());
+        }
+        numAtoms += c_numVsitesPerType;
+    }
+
+    std::vector<RVec> x(numAtoms);
+    std::vector<RVec> fInitial(numAtoms);
+    for (int a = 0; a < numAtoms; a++)
+    {
+        x[a]        = atomPosition(a);
+        fInitial[a] = atomPosition(3 * a + 1);
+    }
+    constructVirtualSites(x, mtop.ffparams.iparams, &ilists);
+
+    std::vector<RVec> fSimd = fInitial;
+    matrix            virialSimd;
+    spreadForces(mtop, ilists, x, fSimd, false, &virialSimd);
+
+    std::vector<RVec> fScalar = fInitial;
+    matrix            virialScalar;
+    spreadForces(mtop, ilists, x, fScalar, true, &virialScalar);
+
+    const FloatingPointTolerance tolerance = relativeToleranceAsFloatingPoint(10.0, 1e-5);
+    for (int a = 0; a < numAtoms; a++)
+    {
+        SCOPED_TRACE("Atom " + std::to_string(a));
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_REAL_EQ_TOL(fScalar[a][d], fSimd[a][d], tolerance);
+        }
+    }
+    for (int d1 = 0; d1 < DIM; d1++)
+    {
+        for (int d2 = 0; d2 < DIM; d2++)
+        {
+            EXPECT_REAL_EQ_TOL(virialScalar[d1][d2], virialSimd[d1][d2], tolerance);
+        }
+    }
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
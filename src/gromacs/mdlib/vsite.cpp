@@ -43,6 +43,7 @@
 #include "vsite.h"
 
 #include <cstdio>
+#include <cstdlib>
 
 #include <algorithm>
 #include <filesystem>
@@ -58,6 +59,9 @@
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/pbcutil/ishift.h"
 #include "gromacs/pbcutil/pbc.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/simd/simd_math.h"
+#include "gromacs/simd/vector_operations.h"
 #include "gromacs/timing/wallcycle.h"
 #include "gromacs/topology/block.h"
 #include "gromacs/topology/forcefieldparameters.h"
@@ -78,6 +82,8 @@
  *
  * We divide the atom range that vsites operate on (natoms_local with DD,
  * 0 - last atom involved in vsites without DD) equally over all threads.
+ * The boundaries between the thread ranges are then shifted locally
+ * to where they split the least vsites.
  *
  * Vsites in the local range constructed from atoms in the local range
  * and/or other vsites that are fully local are assigned to a simple,
@@ -95,6 +101,10 @@
 namespace gmx
 {
 
+// The SIMD versions of iprod and cprod in namespace gmx hide the versions for rvec
+using ::cprod;
+using ::iprod;
+
 //! VirialHandling is often used outside VirtualSitesHandler class members
 using VirialHandling = VirtualSitesHandler::VirialHandling;
 
@@ -227,6 +237,8 @@ private:
     std::vector<std::unique_ptr<VsiteThread>> tData_;
     //! Work array for dividing vsites over threads
     std::vector<int> taskIndex_;
+    //! The start of the atom range of each thread, the last entry is the end of the thread ranges
+    std::vector<int> threadAtomBoundaries_;
 };
 
 /*! \brief Impl class for VirtualSitesHandler
@@ -288,6 +300,12 @@ private:
     const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilists_;
     //! Information for handling vsite threading
     ThreadingInfo threadingInfo_;
+    //! Whether SIMD kernels are allowed, they can be disabled with an environment variable
+    const bool allowSimd_;
+    //! Whether we use SIMD kernels for the current set of vsites
+    bool useSimd_ = false;
+    //! Buffer for marking vsite atoms when checking SIMD compatibility, all entries are false
+    std::vector<bool> isVsiteBuffer_;
 };
 
 VirtualSitesHandler::~VirtualSitesHandler() = default;
@@ -876,6 +894,269 @@ static int constr_vsiten(const t_iatom*            ia,
 
 #endif // DOXYGEN
 
+/*! \brief Returns whether vsite type \p ftype has a SIMD kernel
+ *
+ * These are the linear and simple non-linear types that are commonly
+ * used for hydrogens with -vsite h and for 4-site water models.
+ */
+static bool haveSimdVsiteKernel(const InteractionFunction ftype)
+{
+    return (ftype == InteractionFunction::VirtualSite3
+            || ftype == InteractionFunction::VirtualSite3FlexibleDistance
+            || ftype == InteractionFunction::VirtualSite3Outside
+            || ftype == InteractionFunction::VirtualSite4FlexibleDistanceNormalization);
+}
+
+/*! \brief Returns whether the SIMD kernels can process the vsites in \p ilist
+ *
+ * The SIMD kernels process multiple vsites of the same type at once.
+ * This is only correct when no vsite of a type with a SIMD kernel is
+ * constructed from another vsite of the same type.
+ *
+ * \param[in]     ilist     The interaction lists, only vsites are used
+ * \param[in]     numAtoms  The number of atoms the vsite indices refer to
+ * \param[in,out] isVsite   Buffer with only false values, resized when shorter than \p numAtoms
+ */
+static bool vsitesAreSimdCompatible(const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
+                                    const int          numAtoms,
+                                    std::vector<bool>* isVsite)
+{
+    if (gmx::ssize(*isVsite) < numAtoms)
+    {
+        isVsite->resize(numAtoms, false);
+    }
+
+    bool isCompatible = true;
+    for (InteractionFunction ftype : vSiteFunctionTypes)
+    {
+        const InteractionList& il = (*ilist)[ftype];
+        if (!haveSimdVsiteKernel(ftype) || il.empty())
+        {
+            continue;
+        }
+
+        const int nral1 = 1 + NRAL(ftype);
+        for (int i = 0; i < il.size(); i += nral1)
+        {
+            (*isVsite)[il.iatoms[i + 1]] = true;
+        }
+        for (int i = 0; i < il.size() && isCompatible; i += nral1)
+        {
+            for (int j = i + 2; j < i + nral1; j++)
+            {
+                if ((*isVsite)[il.iatoms[j]])
+                {
+                    isCompatible = false;
+                }
+            }
+        }
+        // Only reset the entries we set, so the buffer does not need to be cleared
+        for (int i = 0; i < il.size(); i += nral1)
+        {
+            (*isVsite)[il.iatoms[i + 1]] = false;
+        }
+
+        if (!isCompatible)
+        {
+            break;
+        }
+    }
+
+    return isCompatible;
+}
+
+#if GMX_SIMD_HAVE_REAL
+
+/*! \brief Atom indices and parameters for a batch of GMX_SIMD_REAL_WIDTH vsites of the same type
+ */
+struct VsiteSimdBatch
+{
+    //! The vsite atom indices
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t av[GMX_SIMD_REAL_WIDTH];
+    //! The first constructing atom indices
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    //! The second constructing atom indices
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    //! The third constructing atom indices
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    //! The fourth constructing atom indices, only used for 4-atom constructions
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t al[GMX_SIMD_REAL_WIDTH];
+    //! The first vsite parameter
+    alignas(GMX_SIMD_ALIGNMENT) real a[GMX_SIMD_REAL_WIDTH];
+    //! The second vsite parameter
+    alignas(GMX_SIMD_ALIGNMENT) real b[GMX_SIMD_REAL_WIDTH];
+    //! The third vsite parameter, not used by all types
+    alignas(GMX_SIMD_ALIGNMENT) real c[GMX_SIMD_REAL_WIDTH];
+};
+
+//! Returns the number of atoms, including the vsite, for types with SIMD kernels
+template<InteractionFunction ftype>
+static constexpr int simdVsiteNumAtoms()
+{
+    return (ftype == InteractionFunction::VirtualSite4FlexibleDistanceNormalization ? 5 : 4);
+}
+
+/*! \brief Fills \p batch with the GMX_SIMD_REAL_WIDTH vsites of type \p ftype starting at \p ia
+ *
+ * Returns false when one of the atom indices is \p numAtomsSafe or larger.
+ * Such vsites should be handled by the scalar code, since the SIMD gather
+ * operations load one element beyond the last atom.
+ */
+template<InteractionFunction ftype>
+static bool fillVsiteSimdBatch(const t_iatom*            ia,
+                               ArrayRef<const t_iparams> ip,
+                               const int                 numAtomsSafe,
+                               VsiteSimdBatch*           batch)
+{
+    constexpr int c_numAtoms = simdVsiteNumAtoms<ftype>();
+
+    int maxAtomIndex = 0;
+    for (int s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+    {
+        const t_iatom*   iaS   = ia + s * (1 + c_numAtoms);
+        const t_iparams& param = ip[iaS[0]];
+
+        batch->av[s] = iaS[1];
+        batch->ai[s] = iaS[2];
+        batch->aj[s] = iaS[3];
+        batch->ak[s] = iaS[4];
+        batch->al[s] = (c_numAtoms == 5 ? iaS[5] : iaS[4]);
+        batch->a[s]  = param.vsite.a;
+        batch->b[s]  = param.vsite.b;
+        batch->c[s]  = param.vsite.c;
+
+        maxAtomIndex = std::max(
+                { maxAtomIndex, batch->av[s], batch->ai[s], batch->aj[s], batch->ak[s], batch->al[s] });
+    }
+
+    return maxAtomIndex < numAtomsSafe;
+}
+
+/*! \brief Constructs the positions of vsites of type \p ftype using SIMD, without PBC
+ *
+ * Only processes full batches of GMX_SIMD_REAL_WIDTH vsites and stops at the first
+ * batch that can not be processed with SIMD.
+ *
+ * \returns the number of entries in \p iatoms that have been processed.
+ */
+template<InteractionFunction ftype>
+static int constructVsitesSimd(ArrayRef<RVec> x, ArrayRef<const t_iparams> ip, ArrayRef<const int> iatoms)
+{
+    constexpr int c_numAtoms = simdVsiteNumAtoms<ftype>();
+    GMX_ASSERT(c_numAtoms == NRAL(ftype), "The number of atoms should match");
+
+    constexpr int c_batchSize  = GMX_SIMD_REAL_WIDTH * (1 + c_numAtoms);
+    const int     numAtomsSafe = x.ssize() - 1;
+    real*         xPtr         = as_rvec_array(x.data())[0];
+
+    VsiteSimdBatch batch;
+
+    int i = 0;
+    for (; i + c_batchSize <= iatoms.ssize(); i += c_batchSize)
+    {
+        if (!fillVsiteSimdBatch<ftype>(iatoms.data() + i, ip, numAtomsSafe, &batch))
+        {
+            break;
+        }
+
+        SimdReal xi[DIM], xj[DIM], xk[DIM], xv[DIM];
+        gatherLoadUTranspose<3>(xPtr, batch.ai, &xi[XX], &xi[YY], &xi[ZZ]);
+        gatherLoadUTranspose<3>(xPtr, batch.aj, &xj[XX], &xj[YY], &xj[ZZ]);
+        gatherLoadUTranspose<3>(xPtr, batch.ak, &xk[XX], &xk[YY], &xk[ZZ]);
+
+        const SimdReal a = load<SimdReal>(batch.a);
+        const SimdReal b = load<SimdReal>(batch.b);
+
+        if (ftype == InteractionFunction::VirtualSite3)
+        {
+            const SimdReal c = SimdReal(1.0_real) - a - b;
+            for (int d = 0; d < DIM; d++)
+            {
+                xv[d] = fma(b, xk[d], fma(a, xj[d], c * xi[d]));
+            }
+        }
+        else if (ftype == InteractionFunction::VirtualSite3FlexibleDistance)
+        {
+            SimdReal temp[DIM];
+            for (int d = 0; d < DIM; d++)
+            {
+                /* temp goes from i to a point on the line jk */
+                temp[d] = fma(a, xk[d] - xj[d], xj[d] - xi[d]);
+            }
+            const SimdReal c = b * invsqrt(norm2(temp[XX], temp[YY], temp[ZZ]));
+            for (int d = 0; d < DIM; d++)
+            {
+                xv[d] = fma(c, temp[d], xi[d]);
+            }
+        }
+        else if (ftype == InteractionFunction::VirtualSite3Outside)
+        {
+            const SimdReal c = load<SimdReal>(batch.c);
+            SimdReal       xij[DIM], xik[DIM], temp[DIM];
+            for (int d = 0; d < DIM; d++)
+            {
+                xij[d] = xj[d] - xi[d];
+                xik[d] = xk[d] - xi[d];
+            }
+            cprod(xij[XX], xij[YY], xij[ZZ], xik[XX], xik[YY], xik[ZZ], &temp[XX], &temp[YY], &temp[ZZ]);
+            for (int d = 0; d < DIM; d++)
+            {
+                xv[d] = fma(c, temp[d], fma(b, xik[d], fma(a, xij[d], xi[d])));
+            }
+        }
+        else if (ftype == InteractionFunction::VirtualSite4FlexibleDistanceNormalization)
+        {
+            const SimdReal c = load<SimdReal>(batch.c);
+            SimdReal       xl[DIM];
+            gatherLoadUTranspose<3>(xPtr, batch.al, &xl[XX], &xl[YY], &xl[ZZ]);
+
+            SimdReal rja[DIM], rjb[DIM], rm[DIM];
+            for (int d = 0; d < DIM; d++)
+            {
+                const SimdReal xij = xj[d] - xi[d];
+                rja[d]             = fms(a, xk[d] - xi[d], xij);
+                rjb[d]             = fms(b, xl[d] - xi[d], xij);
+            }
+            cprod(rja[XX], rja[YY], rja[ZZ], rjb[XX], rjb[YY], rjb[ZZ], &rm[XX], &rm[YY], &rm[ZZ]);
+            const SimdReal d = c * invsqrt(norm2(rm[XX], rm[YY], rm[ZZ]));
+            for (int dim = 0; dim < DIM; dim++)
+            {
+                xv[dim] = fma(d, rm[dim], xi[dim]);
+            }
+        }
+
+        transposeScatterStoreU<3>(xPtr, batch.av, xv[XX], xv[YY], xv[ZZ]);
+    }
+
+    return i;
+}
+
+/*! \brief Constructs the positions of vsites of type \p ftype using SIMD, when available
+ *
+ * \returns the number of entries in \p iatoms that have been processed.
+ */
+static int constructVsitesSimd(const InteractionFunction ftype,
+                               ArrayRef<RVec>            x,
+                               ArrayRef<const t_iparams> ip,
+                               ArrayRef<const int>       iatoms)
+{
+    switch (ftype)
+    {
+        case InteractionFunction::VirtualSite3:
+            return constructVsitesSimd<InteractionFunction::VirtualSite3>(x, ip, iatoms);
+        case InteractionFunction::VirtualSite3FlexibleDistance:
+            return constructVsitesSimd<InteractionFunction::VirtualSite3FlexibleDistance>(x, ip, iatoms);
+        case InteractionFunction::VirtualSite3Outside:
+            return constructVsitesSimd<InteractionFunction::VirtualSite3Outside>(x, ip, iatoms);
+        case InteractionFunction::VirtualSite4FlexibleDistanceNormalization:
+            return constructVsitesSimd<InteractionFunction::VirtualSite4FlexibleDistanceNormalization>(
+                    x, ip, iatoms);
+        default: return 0;
+    }
+}
+
+#endif // GMX_SIMD_HAVE_REAL
+
 //! PBC modes for vsite construction and spreading
 enum class PbcMode
 {
@@ -908,13 +1189,15 @@ static PbcMode getPbcMode(const t_pbc* pbcPtr)
  * \param[in]     ip  Interaction parameters for all interaction, only vsite parameters are used
  * \param[in]     ilist  The interaction lists, only vsites are usesd
  * \param[in]     pbc_null  PBC struct, used for PBC distance calculations when !=nullptr
+ * \param[in]     useSimd   Whether to use SIMD kernels, when available, for positions without PBC
  */
 template<VSiteCalculatePosition calculatePosition, VSiteCalculateVelocity calculateVelocity>
 static void construct_vsites_thread(ArrayRef<RVec>            x,
                                     ArrayRef<RVec>            v,
                                     ArrayRef<const t_iparams> ip,
                                     const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
-                                    const t_pbc* pbc_null)
+                                    const t_pbc* pbc_null,
+                                    const bool   useSimd)
 {
     if (calculateVelocity == VSiteCalculateVelocity::Yes)
     {
@@ -951,9 +1234,24 @@ static void construct_vsites_thread(ArrayRef<RVec>            x,
             int inc = 1 + nra;
             int nr  = (*ilist)[ftype].size();
 
-            const t_iatom* ia = (*ilist)[ftype].iatoms.data();
+            int i = 0;
+#if GMX_SIMD_HAVE_REAL
+            if (useSimd && haveSimdVsiteKernel(ftype) && pbc_null == nullptr
+                && calculatePosition == VSiteCalculatePosition::Yes
+                && calculateVelocity == VSiteCalculateVelocity::No)
+            {
+                /* Construct as many vsites as possible with SIMD,
+                 * the remainder is constructed by the scalar loop below.
+                 */
+                i = constructVsitesSimd(ftype, x, ip, (*ilist)[ftype].iatoms);
+            }
+#else
+            GMX_UNUSED_VALUE(useSimd);
+#endif
 
-            for (int i = 0; i < nr;)
+            const t_iatom* ia = (*ilist)[ftype].iatoms.data() + i;
+
+            while (i < nr)
             {
                 int tp = ia[0];
                 /* The vsite and constructing atoms */
@@ -1131,6 +1429,7 @@ static void construct_vsites_thread(ArrayRef<RVec>            x,
  * \param[in]     ilist  The interaction lists, only vsites are usesd
  * \param[in]     domainInfo  Information about PBC and DD
  * \param[in]     box  Used for PBC when PBC is set in domainInfo
+ * \param[in]     useSimd  Whether we can use SIMD kernels, when available
  */
 template<VSiteCalculatePosition calculatePosition, VSiteCalculateVelocity calculateVelocity>
 static void construct_vsites(const ThreadingInfo*      threadingInfo,
@@ -1139,7 +1438,8 @@ static void construct_vsites(const ThreadingInfo*      threadingInfo,
                              ArrayRef<const t_iparams> ip,
                              const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
                              const DomainInfo& domainInfo,
-                             const matrix      box)
+                             const matrix      box,
+                             const bool        useSimd)
 {
     const bool useDomdec = domainInfo.useDomdec();
 
@@ -1177,7 +1477,7 @@ static void construct_vsites(const ThreadingInfo*      threadingInfo,
 
     if (threadingInfo == nullptr || threadingInfo->numThreads() == 1)
     {
-        construct_vsites_thread<calculatePosition, calculateVelocity>(x, v, ip, ilist, pbc_null);
+        construct_vsites_thread<calculatePosition, calculateVelocity>(x, v, ip, ilist, pbc_null, useSimd);
     }
     else
     {
@@ -1191,7 +1491,7 @@ static void construct_vsites(const ThreadingInfo*      threadingInfo,
                            "The thread data should be initialized before calling construct_vsites");
 
                 construct_vsites_thread<calculatePosition, calculateVelocity>(
-                        x, v, ip, &tData.ilist, pbc_null);
+                        x, v, ip, &tData.ilist, pbc_null, useSimd);
                 if (tData.useInterdependentTask)
                 {
                     /* Here we don't need a barrier (unlike the spreading),
@@ -1199,14 +1499,14 @@ static void construct_vsites(const ThreadingInfo*      threadingInfo,
                      * or local vsites, not from non-local vsites.
                      */
                     construct_vsites_thread<calculatePosition, calculateVelocity>(
-                            x, v, ip, &tData.idTask.ilist, pbc_null);
+                            x, v, ip, &tData.idTask.ilist, pbc_null, useSimd);
                 }
             }
             GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
         }
         /* Now we can construct the vsites that might depend on other vsites */
         construct_vsites_thread<calculatePosition, calculateVelocity>(
-                x, v, ip, &threadingInfo->threadDataNonLocalDependent().ilist, pbc_null);
+                x, v, ip, &threadingInfo->threadDataNonLocalDependent().ilist, pbc_null, useSimd);
     }
 }
 
@@ -1219,15 +1519,15 @@ void VirtualSitesHandler::Impl::construct(ArrayRef<RVec> x,
     {
         case VSiteOperation::Positions:
             construct_vsites<VSiteCalculatePosition::Yes, VSiteCalculateVelocity::No>(
-                    &threadingInfo_, x, v, iparams_, ilists_, domainInfo_, box);
+                    &threadingInfo_, x, v, iparams_, ilists_, domainInfo_, box, useSimd_);
             break;
         case VSiteOperation::Velocities:
             construct_vsites<VSiteCalculatePosition::No, VSiteCalculateVelocity::Yes>(
-                    &threadingInfo_, x, v, iparams_, ilists_, domainInfo_, box);
+                    &threadingInfo_, x, v, iparams_, ilists_, domainInfo_, box, useSimd_);
             break;
         case VSiteOperation::PositionsAndVelocities:
             construct_vsites<VSiteCalculatePosition::Yes, VSiteCalculateVelocity::Yes>(
-                    &threadingInfo_, x, v, iparams_, ilists_, domainInfo_, box);
+                    &threadingInfo_, x, v, iparams_, ilists_, domainInfo_, box, useSimd_);
             break;
         default: gmx_fatal(FARGS, "Unknown virtual site operation");
     }
@@ -1245,8 +1545,11 @@ void constructVirtualSites(ArrayRef<RVec>
 {
     // No PBC, no DD
     const DomainInfo domainInfo;
+    std::vector<bool> isVsite;
+    const bool        useSimd = (std::getenv("GMX_DISABLE_SIMD_KERNELS") == nullptr
+                                 && vsitesAreSimdCompatible(ilist, x.ssize(), &isVsite));
     construct_vsites<VSiteCalculatePosition::Yes, VSiteCalculateVelocity::No>(
-            nullptr, x, {}, ip, ilist, domainInfo, nullptr);
+            nullptr, x, {}, ip, ilist, domainInfo, nullptr, useSimd);
 }
 
 #ifndef DOXYGEN
@@ -2107,6 +2410,285 @@ static int spread_vsiten(const t_iatom             ia[],
 
 #endif // DOXYGEN
 
+#if GMX_SIMD_HAVE_REAL
+
+/*! \brief Spreads the forces of vsites of type \p ftype using SIMD, without PBC
+ *
+ * Only processes full batches of GMX_SIMD_REAL_WIDTH vsites and stops at the first
+ * batch that can not be processed with SIMD. The forces on the vsites are cleared.
+ *
+ * \returns the number of entries in \p iatoms that have been processed.
+ */
+template<InteractionFunction ftype, VirialHandling virialHandling>
+static int spreadVsitesSimd(ArrayRef<const RVec>      x,
+                            ArrayRef<RVec>            f,
+                            matrix                    dxdf,
+                            ArrayRef<const t_iparams> ip,
+                            ArrayRef<const int>       iatoms)
+{
+    constexpr int c_numAtoms = simdVsiteNumAtoms<ftype>();
+    GMX_ASSERT(c_numAtoms == NRAL(ftype), "The number of atoms should match");
+
+    constexpr int c_batchSize  = GMX_SIMD_REAL_WIDTH * (1 + c_numAtoms);
+    const int     numAtomsSafe = std::min(x.ssize(), f.ssize()) - 1;
+    const real*   xPtr         = as_rvec_array(x.data())[0];
+    real*         fPtr         = as_rvec_array(f.data())[0];
+
+    SimdReal dxdfSimd[DIM][DIM];
+    if (virialHandling == VirialHandling::NonLinear)
+    {
+        for (int d1 = 0; d1 < DIM; d1++)
+        {
+            for (int d2 = 0; d2 < DIM; d2++)
+            {
+                dxdfSimd[d1][d2] = setZero();
+            }
+        }
+    }
+
+    VsiteSimdBatch batch;
+
+    int i = 0;
+    for (; i + c_batchSize <= iatoms.ssize(); i += c_batchSize)
+    {
+        if (!fillVsiteSimdBatch<ftype>(iatoms.data() + i, ip, numAtomsSafe, &batch))
+        {
+            break;
+        }
+
+        SimdReal fv[DIM];
+        gatherLoadUTranspose<3>(fPtr, batch.av, &fv[XX], &fv[YY], &fv[ZZ]);
+
+        const SimdReal a = load<SimdReal>(batch.a);
+        const SimdReal b = load<SimdReal>(batch.b);
+
+        /* The forces on the constructing atoms, fi is computed as fv - sum of the others */
+        SimdReal fi[DIM], fj[DIM], fk[DIM], fl[DIM];
+
+        if (ftype == InteractionFunction::VirtualSite3)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                fj[d] = a * fv[d];
+                fk[d] = b * fv[d];
+                fi[d] = fv[d] - fj[d] - fk[d];
+            }
+        }
+        else
+        {
+            SimdReal xi[DIM], xj[DIM], xk[DIM], xv[DIM];
+            gatherLoadUTranspose<3>(xPtr, batch.ai, &xi[XX], &xi[YY], &xi[ZZ]);
+            gatherLoadUTranspose<3>(xPtr, batch.aj, &xj[XX], &xj[YY], &xj[ZZ]);
+            gatherLoadUTranspose<3>(xPtr, batch.ak, &xk[XX], &xk[YY], &xk[ZZ]);
+
+            SimdReal xij[DIM];
+            for (int d = 0; d < DIM; d++)
+            {
+                xij[d] = xj[d] - xi[d];
+            }
+
+            if (ftype == InteractionFunction::VirtualSite3FlexibleDistance)
+            {
+                /* xix goes from i to point x on the line jk */
+                SimdReal xix[DIM];
+                for (int d = 0; d < DIM; d++)
+                {
+                    xix[d] = fma(a, xk[d] - xj[d], xij[d]);
+                }
+                const SimdReal invDistance = invsqrt(norm2(xix[XX], xix[YY], xix[ZZ]));
+                const SimdReal c            = b * invDistance;
+                const SimdReal fproj        = iprod(xix[XX], xix[YY], xix[ZZ], fv[XX], fv[YY], fv[ZZ])
+                                       * invDistance * invDistance;
+
+                SimdReal temp[DIM];
+                for (int d = 0; d < DIM; d++)
+                {
+                    temp[d] = c * fnma(fproj, xix[d], fv[d]);
+                    fi[d]   = fv[d] - temp[d];
+                    fj[d]   = fnma(a, temp[d], temp[d]);
+                    fk[d]   = a * temp[d];
+                }
+
+                if (virialHandling == VirialHandling::NonLinear)
+                {
+                    /* As xix is a linear combination of j and k, use that here */
+                    gatherLoadUTranspose<3>(xPtr, batch.av, &xv[XX], &xv[YY], &xv[ZZ]);
+                    for (int d1 = 0; d1 < DIM; d1++)
+                    {
+                        const SimdReal xiv = xv[d1] - xi[d1];
+                        for (int d2 = 0; d2 < DIM; d2++)
+                        {
+                            dxdfSimd[d1][d2] = fma(xix[d1], temp[d2], fnma(xiv, fv[d2], dxdfSimd[d1][d2]));
+                        }
+                    }
+                }
+            }
+            else
+            {
+                const SimdReal c = load<SimdReal>(batch.c);
+
+                SimdReal xik[DIM];
+                for (int d = 0; d < DIM; d++)
+                {
+                    xik[d] = xk[d] - xi[d];
+                }
+
+                SimdReal xil[DIM];
+                if (ftype == InteractionFunction::VirtualSite3Outside)
+                {
+                    SimdReal cf[DIM], temp[DIM];
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        cf[d] = c * fv[d];
+                    }
+                    /* fj = a fv + xik x c fv, fk = b fv + c fv x xij */
+                    cprod(xik[XX], xik[YY], xik[ZZ], cf[XX], cf[YY], cf[ZZ], &temp[XX], &temp[YY], &temp[ZZ]);
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        fj[d] = fma(a, fv[d], temp[d]);
+                    }
+                    cprod(cf[XX], cf[YY], cf[ZZ], xij[XX], xij[YY], xij[ZZ], &temp[XX], &temp[YY], &temp[ZZ]);
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        fk[d] = fma(b, fv[d], temp[d]);
+                        fi[d] = fv[d] - fj[d] - fk[d];
+                    }
+                }
+                else
+                {
+                    SimdReal xl[DIM];
+                    gatherLoadUTranspose<3>(xPtr, batch.al, &xl[XX], &xl[YY], &xl[ZZ]);
+
+                    SimdReal rja[DIM], rjb[DIM], rab[DIM], rm[DIM];
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        xil[d]            = xl[d] - xi[d];
+                        const SimdReal ra = a * xik[d];
+                        const SimdReal rb = b * xil[d];
+                        rja[d]            = ra - xij[d];
+                        rjb[d]            = rb - xij[d];
+                        rab[d]            = rb - ra;
+                    }
+                    cprod(rja[XX], rja[YY], rja[ZZ], rjb[XX], rjb[YY], rjb[ZZ], &rm[XX], &rm[YY], &rm[ZZ]);
+
+                    const SimdReal invrm = invsqrt(norm2(rm[XX], rm[YY], rm[ZZ]));
+                    const SimdReal denom = invrm * invrm;
+
+                    SimdReal cf[DIM];
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        cf[d] = c * invrm * fv[d];
+                    }
+                    const SimdReal rmDotCf = iprod(rm[XX], rm[YY], rm[ZZ], cf[XX], cf[YY], cf[ZZ]);
+
+                    /* fj = -(rm x rab) (rm.cf)/rm^2 + cf x rab */
+                    SimdReal rt[DIM], temp[DIM];
+                    cprod(rm[XX], rm[YY], rm[ZZ], rab[XX], rab[YY], rab[ZZ], &rt[XX], &rt[YY], &rt[ZZ]);
+                    cprod(cf[XX], cf[YY], cf[ZZ], rab[XX], rab[YY], rab[ZZ], &temp[XX], &temp[YY], &temp[ZZ]);
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        fj[d] = fnma(rt[d] * denom, rmDotCf, temp[d]);
+                    }
+
+                    /* fk = a (-(rjb x rm) (rm.cf)/rm^2 + rjb x cf) */
+                    cprod(rjb[XX], rjb[YY], rjb[ZZ], rm[XX], rm[YY], rm[ZZ], &rt[XX], &rt[YY], &rt[ZZ]);
+                    cprod(rjb[XX], rjb[YY], rjb[ZZ], cf[XX], cf[YY], cf[ZZ], &temp[XX], &temp[YY], &temp[ZZ]);
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        fk[d] = a * fnma(rt[d] * denom, rmDotCf, temp[d]);
+                    }
+
+                    /* fl = b (-(rm x rja) (rm.cf)/rm^2 + cf x rja) */
+                    cprod(rm[XX], rm[YY], rm[ZZ], rja[XX], rja[YY], rja[ZZ], &rt[XX], &rt[YY], &rt[ZZ]);
+                    cprod(cf[XX], cf[YY], cf[ZZ], rja[XX], rja[YY], rja[ZZ], &temp[XX], &temp[YY], &temp[ZZ]);
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        fl[d] = b * fnma(rt[d] * denom, rmDotCf, temp[d]);
+                        fi[d] = fv[d] - fj[d] - fk[d] - fl[d];
+                    }
+                }
+
+                if (virialHandling == VirialHandling::NonLinear)
+                {
+                    gatherLoadUTranspose<3>(xPtr, batch.av, &xv[XX], &xv[YY], &xv[ZZ]);
+                    for (int d1 = 0; d1 < DIM; d1++)
+                    {
+                        const SimdReal xiv = xv[d1] - xi[d1];
+                        for (int d2 = 0; d2 < DIM; d2++)
+                        {
+                            SimdReal sum = fnma(xiv, fv[d2], dxdfSimd[d1][d2]);
+                            sum          = fma(xij[d1], fj[d2], sum);
+                            sum          = fma(xik[d1], fk[d2], sum);
+                            if (ftype == InteractionFunction::VirtualSite4FlexibleDistanceNormalization)
+                            {
+                                sum = fma(xil[d1], fl[d2], sum);
+                            }
+                            dxdfSimd[d1][d2] = sum;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* Note that the scatter operations handle repeated indices correctly */
+        transposeScatterIncrU<3>(fPtr, batch.ai, fi[XX], fi[YY], fi[ZZ]);
+        transposeScatterIncrU<3>(fPtr, batch.aj, fj[XX], fj[YY], fj[ZZ]);
+        transposeScatterIncrU<3>(fPtr, batch.ak, fk[XX], fk[YY], fk[ZZ]);
+        if (ftype == InteractionFunction::VirtualSite4FlexibleDistanceNormalization)
+        {
+            transposeScatterIncrU<3>(fPtr, batch.al, fl[XX], fl[YY], fl[ZZ]);
+        }
+
+        const SimdReal zero = setZero();
+        transposeScatterStoreU<3>(fPtr, batch.av, zero, zero, zero);
+    }
+
+    if (virialHandling == VirialHandling::NonLinear)
+    {
+        for (int d1 = 0; d1 < DIM; d1++)
+        {
+            for (int d2 = 0; d2 < DIM; d2++)
+            {
+                dxdf[d1][d2] += reduce(dxdfSimd[d1][d2]);
+            }
+        }
+    }
+
+    return i;
+}
+
+/*! \brief Spreads the forces of vsites of type \p ftype using SIMD, when available
+ *
+ * \returns the number of entries in \p iatoms that have been processed.
+ */
+template<VirialHandling virialHandling>
+static int spreadVsitesSimd(const InteractionFunction ftype,
+                            ArrayRef<const RVec>      x,
+                            ArrayRef<RVec>            f,
+                            matrix                    dxdf,
+                            ArrayRef<const t_iparams> ip,
+                            ArrayRef<const int>       iatoms)
+{
+    switch (ftype)
+    {
+        case InteractionFunction::VirtualSite3:
+            return spreadVsitesSimd<InteractionFunction::VirtualSite3, virialHandling>(
+                    x, f, dxdf, ip, iatoms);
+        case InteractionFunction::VirtualSite3FlexibleDistance:
+            return spreadVsitesSimd<InteractionFunction::VirtualSite3FlexibleDistance, virialHandling>(
+                    x, f, dxdf, ip, iatoms);
+        case InteractionFunction::VirtualSite3Outside:
+            return spreadVsitesSimd<InteractionFunction::VirtualSite3Outside, virialHandling>(
+                    x, f, dxdf, ip, iatoms);
+        case InteractionFunction::VirtualSite4FlexibleDistanceNormalization:
+            return spreadVsitesSimd<InteractionFunction::VirtualSite4FlexibleDistanceNormalization, virialHandling>(
+                    x, f, dxdf, ip, iatoms);
+        default: return 0;
+    }
+}
+
+#endif // GMX_SIMD_HAVE_REAL
+
 //! Returns the number of virtual sites in the interaction list, for VSITEN the number of atoms
 static int vsite_count(const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
                        InteractionFunction                                                ftype)
@@ -2129,7 +2711,8 @@ static void spreadForceForThread(ArrayRef<const RVec>      x,
                                  matrix                    dxdf,
                                  ArrayRef<const t_iparams> ip,
                                  const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
-                                 const t_pbc* pbc_null)
+                                 const t_pbc* pbc_null,
+                                 const bool   useSimd)
 {
     /* this loop goes backwards to be able to build *
      * higher type vsites from lower types         */
@@ -2145,9 +2728,30 @@ static void spreadForceForThread(ArrayRef<const RVec>      x,
             int inc = 1 + nra;
             int nr  = (*ilist)[ftype].size();
 
-            const t_iatom* ia = (*ilist)[ftype].iatoms.data();
+            int i = 0;
+#if GMX_SIMD_HAVE_REAL
+            if (useSimd && haveSimdVsiteKernel(ftype) && pbc_null == nullptr)
+            {
+                /* Without PBC there are no shift force contributions,
+                 * so we only need to distinguish the non-linear virial.
+                 */
+                if (virialHandling == VirialHandling::NonLinear)
+                {
+                    i = spreadVsitesSimd<VirialHandling::NonLinear>(
+                            ftype, x, f, dxdf, ip, (*ilist)[ftype].iatoms);
+                }
+                else
+                {
+                    i = spreadVsitesSimd<VirialHandling::None>(ftype, x, f, dxdf, ip, (*ilist)[ftype].iatoms);
+                }
+            }
+#else
+            GMX_UNUSED_VALUE(useSimd);
+#endif
+
+            const t_iatom* ia = (*ilist)[ftype].iatoms.data() + i;
 
-            for (int i = 0; i < nr;)
+            while (i < nr)
             {
                 int tp = ia[0];
 
@@ -2220,7 +2824,8 @@ static void spreadForceWrapper(ArrayRef<const RVec>      x,
                                const bool                clearDxdf,
                                ArrayRef<const t_iparams> ip,
                                const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
-                               const t_pbc* pbc_null)
+                               const t_pbc* pbc_null,
+                               const bool   useSimd)
 {
     if (virialHandling == VirialHandling::NonLinear && clearDxdf)
     {
@@ -2230,13 +2835,13 @@ static void spreadForceWrapper(ArrayRef<const RVec>      x,
     switch (virialHandling)
     {
         case VirialHandling::None:
-            spreadForceForThread<VirialHandling::None>(x, f, fshift, dxdf, ip, ilist, pbc_null);
+            spreadForceForThread<VirialHandling::None>(x, f, fshift, dxdf, ip, ilist, pbc_null, useSimd);
             break;
         case VirialHandling::Pbc:
-            spreadForceForThread<VirialHandling::Pbc>(x, f, fshift, dxdf, ip, ilist, pbc_null);
+            spreadForceForThread<VirialHandling::Pbc>(x, f, fshift, dxdf, ip, ilist, pbc_null, useSimd);
             break;
         case VirialHandling::NonLinear:
-            spreadForceForThread<VirialHandling::NonLinear>(x, f, fshift, dxdf, ip, ilist, pbc_null);
+            spreadForceForThread<VirialHandling::NonLinear>(x, f, fshift, dxdf, ip, ilist, pbc_null, useSimd);
             break;
     }
 }
@@ -2295,7 +2900,7 @@ void VirtualSitesHandler::Impl::spreadForces(ArrayRef<const RVec> x,
     if (numThreads == 1)
     {
         matrix dxdf;
-        spreadForceWrapper(x, f, virialHandling, fshift, dxdf, true, iparams_, ilists_, pbc_null);
+        spreadForceWrapper(x, f, virialHandling, fshift, dxdf, true, iparams_, ilists_, pbc_null, useSimd_);
 
         if (virialHandling == VirialHandling::NonLinear)
         {
@@ -2320,7 +2925,8 @@ void VirtualSitesHandler::Impl::spreadForces(ArrayRef<const RVec> x,
                            true,
                            iparams_,
                            &nlDependentVSites.ilist,
-                           pbc_null);
+                           pbc_null,
+                           useSimd_);
 
 #pragma omp parallel num_threads(numThreads)
         {
@@ -2373,7 +2979,8 @@ void VirtualSitesHandler::Impl::spreadForces(ArrayRef<const RVec> x,
                                        true,
                                        iparams_,
                                        &tData.idTask.ilist,
-                                       pbc_null);
+                                       pbc_null,
+                                       useSimd_);
 
                     /* We need a barrier before reducing forces below
                      * that have been produced by a different thread above.
@@ -2409,8 +3016,16 @@ void VirtualSitesHandler::Impl::spreadForces(ArrayRef<const RVec> x,
                 }
 
                 /* Spread the vsites that spread locally only */
-                spreadForceWrapper(
-                        x, f, virialHandling, fshift_t, tData.dxdf, false, iparams_, &tData.ilist, pbc_null);
+                spreadForceWrapper(x,
+                                   f,
+                                   virialHandling,
+                                   fshift_t,
+                                   tData.dxdf,
+                                   false,
+                                   iparams_,
+                                   &tData.ilist,
+                                   pbc_null,
+                                   useSimd_);
             }
             GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
         }
@@ -2621,7 +3236,8 @@ VirtualSitesHandler::Impl::Impl(const gmx_mtop_t& mtop,
                                 const ArrayRef<const RangePartitioning> updateGroupingPerMoleculeType) :
     numInterUpdategroupVirtualSites_(countInterUpdategroupVsites(mtop, updateGroupingPerMoleculeType)),
     domainInfo_({ pbcType, pbcType != PbcType::No && numInterUpdategroupVirtualSites_ > 0, domdec }),
-    iparams_(mtop.ffparams.iparams)
+    iparams_(mtop.ffparams.iparams),
+    allowSimd_(std::getenv("GMX_DISABLE_SIMD_KERNELS") == nullptr)
 {
 }
 
@@ -2634,12 +3250,15 @@ VirtualSitesHandler::VirtualSitesHandler(const gmx_mtop_t& mtop,
 }
 
 //! Flag that atom \p atom which is home in another task, if it has not already been added before
-static inline void flagAtom(InterdependentTask* idTask, const int atom, const int numThreads, const int numAtomsPerThread)
+static inline void flagAtom(InterdependentTask* idTask, const int atom, ArrayRef<const int> threadAtomBoundaries)
 {
     if (!idTask->use[atom])
     {
         idTask->use[atom] = true;
-        int thread        = atom / numAtomsPerThread;
+        const int numThreads = threadAtomBoundaries.ssize() - 1;
+        int       thread =
+                std::upper_bound(threadAtomBoundaries.begin(), threadAtomBoundaries.end(), atom)
+                - threadAtomBoundaries.begin() - 1;
         /* Assign all non-local atom force writes to thread 0 */
         if (thread >= numThreads)
         {
@@ -2658,11 +3277,11 @@ static inline void flagAtom(InterdependentTask* idTask, const int atom, const in
  * taskIndex[] is set for all vsites in our range, either to our local tasks
  * or to the single last task as taskIndex[]=2*nthreads.
  */
-static void assignVsitesToThread(VsiteThread*       tData,
-                                 int                thread,
-                                 int                nthread,
-                                 int                natperthread,
-                                 gmx::ArrayRef<int> taskIndex,
+static void assignVsitesToThread(VsiteThread*             tData,
+                                 int                      thread,
+                                 int                      nthread,
+                                 gmx::ArrayRef<const int> threadAtomBoundaries,
+                                 gmx::ArrayRef<int>       taskIndex,
                                  const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilist,
                                  ArrayRef<const t_iparams>    ip,
                                  ArrayRef<const ParticleType> ptype)
@@ -2778,14 +3397,14 @@ static void assignVsitesToThread(VsiteThread*       tData,
                     {
                         for (int j = i + 2; j < i + nral1; j++)
                         {
-                            flagAtom(&tData->idTask, iat[j], nthread, natperthread);
+                            flagAtom(&tData->idTask, iat[j], threadAtomBoundaries);
                         }
                     }
                     else
                     {
                         for (int j = i + 2; j < i + numIAtoms; j += 3)
                         {
-                            flagAtom(&tData->idTask, iat[j], nthread, natperthread);
+                            flagAtom(&tData->idTask, iat[j], threadAtomBoundaries);
                         }
                     }
                 }
@@ -2832,6 +3451,93 @@ static void assignVsitesToSingleTask(VsiteThread*             tData,
     }
 }
 
+/*! \brief Sets the atom range boundaries between threads
+ *
+ * The boundaries start out as multiples of \p natperthread. Each internal
+ * boundary is then shifted by at most half a thread range to the position
+ * with the least vsites that have atoms on both sides of the boundary.
+ * This moves vsites from the interdependent and serial tasks
+ * to the independent thread tasks.
+ */
+static void setThreadAtomBoundaries(std::vector<int>* threadAtomBoundaries,
+                                    const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilists,
+                                    ArrayRef<const t_iparams> iparams,
+                                    const int                 numThreads,
+                                    const int                 natperthread)
+{
+    const int rangeEnd = numThreads * natperthread;
+
+    threadAtomBoundaries->resize(numThreads + 1);
+    for (int t = 0; t <= numThreads; t++)
+    {
+        (*threadAtomBoundaries)[t] = t * natperthread;
+    }
+    if (natperthread < 2)
+    {
+        return;
+    }
+
+    /* Count for each atom index the number of vsites that span the boundary
+     * just below it, by accumulating +1 after the lowest and -1 after
+     * the highest atom index involved in a vsite.
+     */
+    std::vector<int> numSpanning(rangeEnd + 1, 0);
+    auto             addSpan = [&numSpanning, rangeEnd](int atomMin, int atomMax)
+    {
+        if (atomMin < rangeEnd)
+        {
+            numSpanning[atomMin + 1]++;
+            numSpanning[std::min(atomMax + 1, rangeEnd)]--;
+        }
+    };
+    for (InteractionFunction ftype : vSiteFunctionTypes)
+    {
+        const int           nral1 = 1 + NRAL(ftype);
+        ArrayRef<const int> iat   = (*ilists)[ftype].iatoms;
+        for (int i = 0; i < iat.ssize();)
+        {
+            /* The 3 below is from 1+NRAL(ftype)=3 */
+            const int numIAtoms =
+                    (ftype == InteractionFunction::VirtualSiteN ? iparams[iat[i]].vsiten.n * 3 : nral1);
+            const int step    = (ftype == InteractionFunction::VirtualSiteN ? 3 : 1);
+            int       atomMin = iat[i + 1];
+            int       atomMax = iat[i + 1];
+            for (int j = i + 2; j < i + numIAtoms; j += step)
+            {
+                atomMin = std::min(atomMin, iat[j]);
+                atomMax = std::max(atomMax, iat[j]);
+            }
+            addSpan(atomMin, atomMax);
+            i += numIAtoms;
+        }
+    }
+    for (int a = 1; a <= rangeEnd; a++)
+    {
+        numSpanning[a] += numSpanning[a - 1];
+    }
+
+    const int maxShift = natperthread / 2;
+    for (int t = 1; t < numThreads; t++)
+    {
+        const int target   = t * natperthread;
+        const int minIndex = std::max((*threadAtomBoundaries)[t - 1] + 1, target - maxShift);
+        const int maxIndex = std::min(rangeEnd - 1, target + maxShift);
+        int       best     = std::max(target, minIndex);
+        for (int shift = 0; shift <= maxShift && numSpanning[best] > 0; shift++)
+        {
+            /* Prefer the boundary closest to the uniform distribution */
+            for (int b : { target - shift, target + shift })
+            {
+                if (b >= minIndex && b <= maxIndex && numSpanning[b] < numSpanning[best])
+                {
+                    best = b;
+                }
+            }
+        }
+        (*threadAtomBoundaries)[t] = best;
+    }
+}
+
 void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunction, InteractionList>* ilists,
                                     ArrayRef<const t_iparams>    iparams,
                                     const int                    numAtoms,
@@ -2845,9 +3551,8 @@ void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunct
         return;
     }
 
-    /* The current way of distributing the vsites over threads in primitive.
-     * We divide the atom range 0 - natoms_in_vsite uniformly over threads,
-     * without taking into account how the vsites are distributed.
+    /* We divide the atom range 0 - natoms_in_vsite uniformly over threads
+     * and then move the boundaries to avoid splitting vsites over threads.
      * Without domain decomposition we at least tighten the upper bound
      * of the range (useful for common systems such as a vsite-protein
      * in 3-site water).
@@ -2922,6 +3627,8 @@ void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunct
                 natperthread);
     }
 
+    setThreadAtomBoundaries(&threadAtomBoundaries_, ilists, iparams, numThreads_, natperthread);
+
     /* To simplify the vsite assignment, we make an index which tells us
      * to which task particles, both non-vsites and vsites, are assigned.
      */
@@ -2930,11 +3637,17 @@ void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunct
     /* Initialize the task index array. Here we assign the non-vsite
      * particles to task=thread, so we easily figure out if vsites
      * depend on local and/or non-local particles in assignVsitesToThread.
+     * Particles beyond the last boundary get task numThreads_, which is
+     * not the thread task of any thread.
      */
     {
         int thread = 0;
         for (int i = 0; i < numAtoms; i++)
         {
+            while (thread < numThreads_ && i >= threadAtomBoundaries_[thread + 1])
+            {
+                thread++;
+            }
             if (ptype[i] == ParticleType::VSite)
             {
                 /* vsites are not assigned to a task yet */
@@ -2945,10 +3658,6 @@ void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunct
                 /* assign non-vsite particles to task thread */
                 taskIndex_[i] = thread;
             }
-            if (i == (thread + 1) * natperthread && thread < numThreads_)
-            {
-                thread++;
-            }
         }
     }
 
@@ -3007,10 +3716,10 @@ void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunct
             }
 
             /* Assign all vsites that can execute independently on threads */
-            tData.rangeStart = thread * natperthread;
+            tData.rangeStart = threadAtomBoundaries_[thread];
             if (thread < numThreads_ - 1)
             {
-                tData.rangeEnd = (thread + 1) * natperthread;
+                tData.rangeEnd = threadAtomBoundaries_[thread + 1];
             }
             else
             {
@@ -3018,7 +3727,7 @@ void ThreadingInfo::setVirtualSites(const gmx::EnumerationArray<InteractionFunct
                 tData.rangeEnd = numAtoms;
             }
             assignVsitesToThread(
-                    &tData, thread, numThreads_, natperthread, taskIndex_, ilists, iparams, ptype);
+                    &tData, thread, numThreads_, threadAtomBoundaries_, taskIndex_, ilists, iparams, ptype);
 
             if (tData.useInterdependentTask)
             {
@@ -3107,6 +3816,8 @@ void VirtualSitesHandler::Impl::setVirtualSites(
 {
     ilists_ = ilists;
 
+    useSimd_ = allowSimd_ && vsitesAreSimdCompatible(ilists, numAtoms, &isVsiteBuffer_);
+
     threadingInfo_.setVirtualSites(ilists, iparams_, numAtoms, homenr, ptype, domainInfo_.useDomdec());
 }
 
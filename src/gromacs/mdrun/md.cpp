@@ -148,6 +148,7 @@
 #include "gromacs/modularsimulator/energydata.h"
 #include "gromacs/nbnxm/gpu_data_mgmt.h"
 #include "gromacs/nbnxm/nbnxm.h"
+#include "gromacs/nbnxm/pairlist_tuning.h"
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/pulling/output.h"
 #include "gromacs/pulling/pull.h"
@@ -560,6 +561,16 @@ void gmx::LegacySimulator::do_md()
                 cr_->dd, mdLog_, *ir, state_->box, *fr_->ic, *fr_->nbv, fr_->pmedata, simulationWork);
     }
 
+    // Run-time tuning of nstlist and the pairlist buffers, only when requested
+    std::unique_ptr<PairlistTuning> pairlistTuning;
+    if (std::getenv("GMX_TUNE_NSTLIST") != nullptr && pairlistTuningIsSupported(*ir, simulationWork))
+    {
+        pairlistTuning = std::make_unique<PairlistTuning>(
+                mdLog_, *ir, topGlobal_, state_->box, state_->x, *fr_->ic, *fr_->nbv);
+    }
+    // The pairlist update interval, can be changed by pairlistTuning
+    int nstlist = ir->nstlist;
+
     if (!ir->bContinuation)
     {
         if (state_->hasEntry(StateEntry::V))
@@ -812,7 +823,7 @@ void gmx::LegacySimulator::do_md()
             compat::not_null<SimulationSignal*>(&signals[eglsSTOPCOND]),
             simulationsShareState,
             isMainRank,
-            ir->nstlist,
+            nstlist,
             mdrunOptions_.reproducible,
             nstSignalComm,
             mdrunOptions_.maximumHoursToRun,
@@ -868,7 +879,7 @@ void gmx::LegacySimulator::do_md()
     while (!bLastStep)
     {
         /* Determine if this is a neighbor search step */
-        const bool bNStList = (ir->nstlist > 0 && step % ir->nstlist == 0);
+        const bool bNStList = (nstlist > 0 && step % nstlist == 0);
 
         if (pmeLoadBal && bNStList)
         {
@@ -889,6 +900,16 @@ void gmx::LegacySimulator::do_md()
                                   step_rel);
         }
 
+        if (pairlistTuning && bNStList)
+        {
+            pairlistTuning->addCycles((mdrunOptions_.verbose && isMainRank) ? stderr : nullptr,
+                                      fr_,
+                                      wallCycleCounters_,
+                                      step,
+                                      step_rel);
+            nstlist = pairlistTuning->nstlist();
+        }
+
         wallcycle_start(wallCycleCounters_, WallCycleCounter::Step);
 
         bLastStep      = (step_rel == ir->nsteps);
@@ -1717,7 +1738,7 @@ void gmx::LegacySimulator::do_md()
                 // or with an odd nstlist, since the odd/even step
                 // pruning pattern will change
                 bool forceGraphReinstantiation =
-                        (pmeLoadBal && pmeLoadBal->isActive()) || ((ir->nstlist % 2) == 1);
+                        (pmeLoadBal && pmeLoadBal->isActive()) || ((nstlist % 2) == 1);
                 mdGraph->createExecutableGraph(forceGraphReinstantiation);
             }
             if (mdGraph->useGraphThisStep())
@@ -2210,6 +2231,12 @@ void gmx::LegacySimulator::do_md()
         pmeLoadBal.reset(nullptr);
     }
 
+    if (pairlistTuning)
+    {
+        pairlistTuning->printSettings();
+        pairlistTuning.reset(nullptr);
+    }
+
     done_shellfc(fpLog_, shellfc, step_rel);
 
     if (useReplicaExchange && isMainRank)
@@ -510,11 +510,13 @@ void gmx::LegacySimulator::do_rerun()
         calc_shifts(rerun_fr.box, fr_->shift_vec);
     }
 
-    auto stopHandler = stopHandlerBuilder_->getStopHandlerMD(
+    // Rerun constructs the pairlist for each frame
+    const int nstlistRerun = 1;
+    auto      stopHandler  = stopHandlerBuilder_->getStopHandlerMD(
             compat::not_null<SimulationSignal*>(&signals[eglsSTOPCOND]),
             false,
             isMainRank,
-            1, // rerun constructs the pairlist for each frame
+            nstlistRerun,
             mdrunOptions_.reproducible,
             nstglobalcomm,
             mdrunOptions_.maximumHoursToRun,
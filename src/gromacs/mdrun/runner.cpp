@@ -151,6 +151,7 @@
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/mdtypes/state_propagator_data_gpu.h"
 #include "gromacs/modularsimulator/modularsimulator.h"
+#include "gromacs/nbnxm/benchmark/bench_kernel_selection.h"
 #include "gromacs/nbnxm/gpu_data_mgmt.h"
 #include "gromacs/nbnxm/nbnxm.h"
 #include "gromacs/nbnxm/nbnxm_enums.h"
@@ -1909,6 +1910,13 @@ int Mdrunner::mdrunner()
                     runScheduleWork.simulationWork.useNvshmem);
         }
 
+        // Optionally replace the heuristic CPU kernel layout choice by a measured one
+        const std::optional<NbnxmKernelType> measuredCpuSimdKernelType =
+                (!runScheduleWork.simulationWork.useGpuNonbonded && fr->use_simd_kernels)
+                        ? measureFastestNbnxmKernelCpuSimdType(
+                                mdlog, *inputrec, *fr->ic, cr->commMyGroup)
+                        : std::nullopt;
+
         fr->nbv = init_nb_verlet(
                 mdlog,
                 *inputrec,
@@ -1916,6 +1924,7 @@ int Mdrunner::mdrunner()
                 cr->commMyGroup,
                 cr->dd,
                 *hwinfo_,
+                measuredCpuSimdKernelType,
                 runScheduleWork.simulationWork.useGpuNonbonded,
                 runScheduleWork.simulationWork.useGpuNonbondedFE,
                 deviceStreamManager.get(),
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the ThreadedForceBuffer class.
+ *
+ * \ingroup module_mdtypes
+ */
+#include "gmxpre.h"
+
+#include "gromacs/mdtypes/threaded_force_buffer.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/math/arrayrefwithpadding.h"
+#include "gromacs/math/paddedvector.h"
+#include "gromacs/mdtypes/forceoutput.h"
+#include "gromacs/mdtypes/simulation_workload.h"
+#include "gromacs/pbcutil/ishift.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/vectypes.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Returns a force that is unique for \p atom and \p thread
+RVec threadForce(int atom, int thread)
+{
+    return { real(atom), real(thread + 1), real(0.5 * atom * (thread + 1)) };
+}
+
+TEST(ThreadedForceBuffer, ReducesExclusiveAndSharedBlocks)
+{
+    constexpr int c_numThreads = 3;
+    constexpr int c_blockSize  = ThreadForceBuffer<RVec>::s_reductionBlockSize;
+    constexpr int c_numAtoms   = 5 * c_blockSize - 3;
+
+    /* Thread 0 writes to block 0 only, thread 1 to block 2 and 4
+     * and thread 2 to blocks 3 and 4. Block 1 is not used.
+     */
+    const std::vector<std::vector<int>> threadAtoms = {
+        { 0, 1, c_blockSize - 1 },
+        { 2 * c_blockSize, 2 * c_blockSize + 5, 4 * c_blockSize + 1 },
+        { 3 * c_blockSize + 2, 4 * c_blockSize + 1, c_numAtoms - 1 }
+    };
+
+    ThreadedForceBuffer<RVec> threadedForceBuffer(c_numThreads, false, 1);
+
+    for (int t = 0; t < c_numThreads; t++)
+    {
+        auto& threadBuffer = threadedForceBuffer.threadForceBuffer(t);
+        threadBuffer.resizeBufferAndClearMask(c_numAtoms);
+        for (int a : threadAtoms[t])
+        {
+            threadBuffer.addAtomToMask(a);
+        }
+        threadBuffer.processMask();
+    }
+    threadedForceBuffer.setupReduction();
+
+    std::vector<RVec> referenceForces(c_numAtoms, { 0.0_real, 0.0_real, 0.0_real });
+    for (int t = 0; t < c_numThreads; t++)
+    {
+        auto& threadBuffer = threadedForceBuffer.threadForceBuffer(t);
+        threadBuffer.clearForcesAndEnergies();
+        for (int a : threadAtoms[t])
+        {
+            threadBuffer.forceBuffer()[a] = threadForce(a, t);
+            referenceForces[a] += threadForce(a, t);
+        }
+    }
+
+    PaddedVector<RVec> forces(c_numAtoms, { 1.0_real, 2.0_real, 3.0_real });
+    std::vector<RVec>  shiftForces(c_numShiftVectors);
+    ForceWithShiftForces forceWithShiftForces(forces.arrayRefWithPadding(), false, shiftForces);
+
+    StepWorkload stepWork;
+    stepWork.computeForces = true;
+    threadedForceBuffer.reduce(&forceWithShiftForces, nullptr, nullptr, {}, stepWork, 1);
+
+    for (int a = 0; a < c_numAtoms; a++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_REAL_EQ_TOL(1.0_real + d + referenceForces[a][d],
+                               forces[a][d],
+                               defaultRealTolerance())
+                    << "for atom " << a << " dimension " << d;
+        }
+    }
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
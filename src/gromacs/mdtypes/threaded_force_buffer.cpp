@@ -151,73 +151,85 @@ template<typename ForceBufferElementType>
 void reduceThreadForceBuffers(ArrayRef<gmx::RVec> force,
                               ArrayRef<std::unique_ptr<ThreadForceBuffer<ForceBufferElementType>>> threadForceBuffers,
                               ArrayRef<const gmx_bitmask_t> masks,
-                              ArrayRef<const int>           usedBlockIndices)
+                              ArrayRef<const int>           usedBlockIndices,
+                              ArrayRef<const int>           reductionThreadBlockRanges)
 {
     const int numBuffers = threadForceBuffers.size();
     GMX_ASSERT(numBuffers <= s_maxNumThreadsForReduction,
                "There is a limit on the number of buffers we can use for reduction");
+    GMX_ASSERT(reductionThreadBlockRanges.ssize() == numBuffers + 1,
+               "We need a block range for each reduction thread");
 
     // In case force is only for local atoms, we need to limit the reduction range
     const int numAtoms = std::min(gmx::ssize(force), threadForceBuffers[0]->size());
 
     rvec* gmx_restrict f = as_rvec_array(force.data());
 
-    /* This reduction can run on any number of threads, independently of the number of buffers.
-     * But if the number of threads matches the number of buffers, which it currently does,
-     * the uniform distribution of the touched blocks over nthreads will
-     * match the distribution of bonded over threads well in most cases,
-     * which means that threads mostly reduce their own data which increases
-     * the number of cache hits.
+    /* This reduction runs on one thread per buffer. The used blocks have been
+     * ordered by setupReduction() such that each thread reduces the blocks
+     * only it has written to, as well as part of the shared blocks it has
+     * contributed to. Thus threads mostly reduce their own data, which is
+     * still in their cache and, with locality based bonded work division,
+     * cover a contiguous atom range.
      * Additionally, we should always use the same number of threads in parallel
      * regions in OpenMP, otherwise the performance will degrade significantly.
      */
-    const int gmx_unused numThreadsForReduction = threadForceBuffers.size();
+    const int gmx_unused numThreadsForReduction = numBuffers;
 // nvc++ 24.1+ version has bug due to which it generates incorrect OMP code for this region
 // so disable this until nvc++ gets fixed.
 #if !defined(__NVCOMPILER)
 #    pragma omp parallel for num_threads(numThreadsForReduction) schedule(static)
 #endif
-    for (int b = 0; b < usedBlockIndices.ssize(); b++)
+    for (int thread = 0; thread < numThreadsForReduction; thread++)
     {
         try
         {
-            // Reduce the buffers that contribute to this block
-            ForceBufferElementType* fp[s_maxNumThreadsForReduction];
+            const int blockRangeBegin = reductionThreadBlockRanges[thread];
+            const int blockRangeEnd   = reductionThreadBlockRanges[thread + 1];
+            for (int b = blockRangeBegin; b < blockRangeEnd; b++)
+            {
+                // Reduce the buffers that contribute to this block
+                ForceBufferElementType* fp[s_maxNumThreadsForReduction];
 
-            const int blockIndex = usedBlockIndices[b];
+                const int blockIndex = usedBlockIndices[b];
 
-            // Make a list of threads that have this block index set in the mask
-            int numContributingBuffers = 0;
-            for (int ft = 0; ft < numBuffers; ft++)
-            {
-                if (bitmask_is_set(masks[blockIndex], ft))
-                {
-                    fp[numContributingBuffers++] =
-                            threadForceBuffers[ft]->forceBufferWithPadding().paddedArrayRef().data();
-                }
-            }
-            if (numContributingBuffers > 0)
-            {
-                // Reduce the selected buffers
-                int a0 = blockIndex * ThreadForceBuffer<ForceBufferElementType>::s_reductionBlockSize;
-                int a1 = (blockIndex + 1) * ThreadForceBuffer<ForceBufferElementType>::s_reductionBlockSize;
-                // Note: It would be nice if we could pad f to avoid this min()
-                a1 = std::min(a1, numAtoms);
-                if (numContributingBuffers == 1)
+                // Make a list of threads that have this block index set in the mask
+                int numContributingBuffers = 0;
+                for (int ft = 0; ft < numBuffers; ft++)
                 {
-                    // Avoid double loop for the case of a single buffer
-                    for (int a = a0; a < a1; a++)
+                    if (bitmask_is_set(masks[blockIndex], ft))
                     {
-                        rvec_inc(f[a], fp[0][a]);
+                        fp[numContributingBuffers++] = threadForceBuffers[ft]
+                                                                       ->forceBufferWithPadding()
+                                                                       .paddedArrayRef()
+                                                                       .data();
                     }
                 }
-                else
+                if (numContributingBuffers > 0)
                 {
-                    for (int a = a0; a < a1; a++)
+                    // Reduce the selected buffers
+                    constexpr int c_blockSize =
+                            ThreadForceBuffer<ForceBufferElementType>::s_reductionBlockSize;
+                    int a0 = blockIndex * c_blockSize;
+                    int a1 = (blockIndex + 1) * c_blockSize;
+                    // Note: It would be nice if we could pad f to avoid this min()
+                    a1 = std::min(a1, numAtoms);
+                    if (numContributingBuffers == 1)
+                    {
+                        // Avoid double loop for the case of a single buffer
+                        for (int a = a0; a < a1; a++)
+                        {
+                            rvec_inc(f[a], fp[0][a]);
+                        }
+                    }
+                    else
                     {
-                        for (int fb = 0; fb < numContributingBuffers; fb++)
+                        for (int a = a0; a < a1; a++)
                         {
-                            rvec_inc(f[a], fp[fb][a]);
+                            for (int fb = 0; fb < numContributingBuffers; fb++)
+                            {
+                                rvec_inc(f[a], fp[fb][a]);
+                            }
                         }
                     }
                 }
@@ -272,51 +284,101 @@ void ThreadedForceBuffer<ForceBufferElementType>::setupReduction()
     }
 
     /* Reduce the masks over the threads and determine which blocks
-     * we need to reduce over.
+     * we need to reduce over. Each used block is assigned to a reduction
+     * thread. A block written by a single thread is reduced by that thread,
+     * so threads that own a disjoint atom range, as with the locality based
+     * bonded work division, reduce their own, cache-resident, data.
+     * Blocks shared by multiple threads are assigned to the contributing
+     * thread with the lowest reduction load so far.
      */
     reductionMask_.resize(totalNumBlocks);
 
-    usedBlockIndices_.clear();
-    int numBlocksUsed = 0;
+    std::vector<std::vector<int>> threadBlockIndices(numBuffers);
+    std::vector<int>              threadReductionLoad(numBuffers, 0);
+    std::vector<int>              sharedBlockIndices;
+    int                           numBlocksUsed = 0;
     for (int b = 0; b < totalNumBlocks; b++)
     {
         gmx_bitmask_t& mask = reductionMask_[b];
 
         /* Generate the union over the threads of the bitmask */
         bitmask_clear(&mask);
+        int numContributingBuffers = 0;
+        int lastContributingBuffer = -1;
         for (int t = 0; t < numBuffers; t++)
         {
-            bitmask_union(&mask, threadForceBuffers_[t]->reductionMask()[b]);
+            const gmx_bitmask_t& threadMask = threadForceBuffers_[t]->reductionMask()[b];
+            if (bitmask_is_set(threadMask, t))
+            {
+                numContributingBuffers++;
+                lastContributingBuffer = t;
+            }
+            bitmask_union(&mask, threadMask);
+        }
+        if (numContributingBuffers == 1)
+        {
+            threadBlockIndices[lastContributingBuffer].push_back(b);
+            threadReductionLoad[lastContributingBuffer] += 1;
         }
-        if (!bitmask_is_zero(mask))
+        else if (numContributingBuffers > 1)
         {
-            usedBlockIndices_.push_back(b);
+            sharedBlockIndices.push_back(b);
         }
+        numBlocksUsed += numContributingBuffers;
 
-        if (debug)
+        if (debug && gmx_debug_at)
         {
-            int c = 0;
-            for (int t = 0; t < numBuffers; t++)
+            fprintf(debug,
+                    "block %d flags %s count %d\n",
+                    b,
+                    to_hex_string(mask).c_str(),
+                    numContributingBuffers);
+        }
+    }
+
+    for (const int b : sharedBlockIndices)
+    {
+        int reductionThread        = -1;
+        int numContributingBuffers = 0;
+        for (int t = 0; t < numBuffers; t++)
+        {
+            if (bitmask_is_set(reductionMask_[b], t))
             {
-                if (bitmask_is_set(mask, t))
+                numContributingBuffers++;
+                if (reductionThread < 0
+                    || threadReductionLoad[t] < threadReductionLoad[reductionThread])
                 {
-                    c++;
+                    reductionThread = t;
                 }
             }
-            numBlocksUsed += c;
-
-            if (gmx_debug_at)
-            {
-                fprintf(debug, "block %d flags %s count %d\n", b, to_hex_string(mask).c_str(), c);
-            }
         }
+        threadBlockIndices[reductionThread].push_back(b);
+        threadReductionLoad[reductionThread] += numContributingBuffers;
     }
+
+    /* Store the block indices ordered by reduction thread, with increasing
+     * block index per thread to have a linear memory access pattern.
+     */
+    usedBlockIndices_.clear();
+    reductionThreadBlockRanges_.resize(numBuffers + 1);
+    reductionThreadBlockRanges_[0] = 0;
+    for (int t = 0; t < numBuffers; t++)
+    {
+        std::sort(threadBlockIndices[t].begin(), threadBlockIndices[t].end());
+        usedBlockIndices_.insert(usedBlockIndices_.end(),
+                                 threadBlockIndices[t].begin(),
+                                 threadBlockIndices[t].end());
+        reductionThreadBlockRanges_[t + 1] = gmx::ssize(usedBlockIndices_);
+    }
+
     if (debug)
     {
+        const int numSharedBlocks = gmx::ssize(sharedBlockIndices);
         fprintf(debug,
-                "Number of %d atom blocks to reduce: %d\n",
+                "Number of %d atom blocks to reduce: %d, of which shared between threads: %d\n",
                 ThreadForceBuffer<ForceBufferElementType>::s_reductionBlockSize,
-                int(gmx::ssize(usedBlockIndices_)));
+                int(gmx::ssize(usedBlockIndices_)),
+                numSharedBlocks);
         fprintf(debug,
                 "Reduction density %.2f for touched blocks only %.2f\n",
                 numBlocksUsed * ThreadForceBuffer<ForceBufferElementType>::s_reductionBlockSize
@@ -373,7 +435,11 @@ void ThreadedForceBuffer<ForceBufferElementType>::reduceTemplated(
         GMX_ASSERT(forceBuffer, "Need a valid force buffer for reduction");
 
         reduceThreadForceBuffers<ForceBufferElementType>(
-                forceBuffer->force(), threadForceBuffers_, reductionMask_, usedBlockIndices_);
+                forceBuffer->force(),
+                threadForceBuffers_,
+                reductionMask_,
+                usedBlockIndices_,
+                reductionThreadBlockRanges_);
     }
 
     const int numBuffers = numThreadBuffers();
@@ -215,7 +215,12 @@ public:
         return *threadForceBuffers_[bufferIndex];
     }
 
-    //! Sets up the reduction, should be called after generating the masks on each thread
+    /*! \brief Sets up the reduction, should be called after generating the masks on each thread
+     *
+     * Blocks that are written to by a single thread will be reduced by that thread.
+     * Blocks that are written to by multiple threads are distributed over
+     * the contributing threads.
+     */
     void setupReduction();
 
     /*! \brief Reduces forces with shift forces and energies and dV/dlambda,
@@ -277,8 +282,10 @@ private:
     bool useEnergyTerms_;
     //! Force/energy data per thread, size nthreads, stored in unique_ptr to allow thread local allocation
     std::vector<std::unique_ptr<ThreadForceBuffer<ForceBufferElementType>>> threadForceBuffers_;
-    //! Indices of blocks that are used, i.e. have force contributions.
+    //! Indices of blocks that are used, i.e. have force contributions, ordered by reduction thread
     std::vector<int> usedBlockIndices_;
+    //! Range of \p usedBlockIndices_ reduced by each thread, size number of threads + 1
+    std::vector<int> reductionThreadBlockRanges_;
     //! Mask array, one element corresponds to a block of reduction_block_size atoms of the force array, bit corresponding to thread indices set if a thread writes to that block
     std::vector<gmx_bitmask_t> reductionMask_;
 
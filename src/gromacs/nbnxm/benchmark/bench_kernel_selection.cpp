@@ -0,0 +1,138 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+
+/*! \internal \file
+ * \brief
+ * This file defines the choice of the CPU SIMD non-bonded kernel layout by timing
+ *
+ * \ingroup module_nbnxm
+ */
+
+#include "gmxpre.h"
+
+#include "bench_kernel_selection.h"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
+#include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/mdtypes/interaction_const.h"
+#include "gromacs/mdtypes/md_enums.h"
+#include "gromacs/nbnxm/nbnxm_enums.h"
+#include "gromacs/nbnxm/nbnxm_simd.h"
+#include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/logger.h"
+#include "gromacs/utility/mpicomm.h"
+#include "gromacs/utility/real.h"
+
+#include "bench_setup.h"
+
+namespace gmx
+{
+
+std::optional<NbnxmKernelType> measureFastestNbnxmKernelCpuSimdType(const MDLogger&   mdlog,
+                                                                    const t_inputrec& inputrec,
+                                                                    const interaction_const_t& ic,
+                                                                    const MpiComm& mpiComm)
+{
+    if (std::getenv("GMX_NBNXN_SIMD_TUNE") == nullptr || !sc_haveNbnxmSimd4xmKernels
+        || !sc_haveNbnxmSimd2xmmKernels || std::getenv("GMX_NBNXN_SIMD_4XN") != nullptr
+        || std::getenv("GMX_NBNXN_SIMD_2XNN") != nullptr)
+    {
+        return std::nullopt;
+    }
+
+    NbnxmKernelBenchOptions options;
+    options.nbnxmSimd    = NbnxmBenchMarkKernels::SimdAuto;
+    options.numThreads   = gmx_omp_nthreads_get(ModuleMultiThread::Nonbonded);
+    options.coulombType  = usingPmeOrEwald(inputrec.coulombtype)
+                                   ? NbnxmBenchMarkCoulomb::Pme
+                                   : NbnxmBenchMarkCoulomb::ReactionField;
+    options.ewaldcoeff_q = ic.coulomb.ewaldCoeff;
+    switch (ic.vdw.modifier)
+    {
+        case InteractionModifiers::PotSwitch:
+            options.interactionModifier = NbnxmBenchMarkInteractionModifiers::PotSwitch;
+            break;
+        case InteractionModifiers::ForceSwitch:
+            options.interactionModifier = NbnxmBenchMarkInteractionModifiers::ForceSwitch;
+            break;
+        default: options.interactionModifier = NbnxmBenchMarkInteractionModifiers::PotShift;
+    }
+    // The benchmark system of 1000 water molecules has a box of 3.1 nm
+    options.pairlistCutoff      = std::min(inputrec.rlist, 1.5_real);
+    options.numIterations       = 100;
+    options.numWarmupIterations = 20;
+    options.printReport         = false;
+
+    // The benchmark sets the thread counts of both modules, restore them afterwards
+    const int numPairsearchThreads = gmx_omp_nthreads_get(ModuleMultiThread::Pairsearch);
+
+    const std::vector<NbnxmKernelBenchResult> results = bench(1, options);
+
+    gmx_omp_nthreads_set(ModuleMultiThread::Pairsearch, numPairsearchThreads);
+    gmx_omp_nthreads_set(ModuleMultiThread::Nonbonded, options.numThreads);
+
+    GMX_RELEASE_ASSERT(results.size() == 2
+                               && results[0].options.nbnxmSimd == NbnxmBenchMarkKernels::Simd4XM
+                               && results[1].options.nbnxmSimd == NbnxmBenchMarkKernels::Simd2XMM,
+                       "Expect benchmark results for the 4xM and 2xMM kernels");
+
+    // Compare the time per iteration, the useful work is identical for both layouts
+    std::array<double, 2> microSeconds = { results[0].microSeconds, results[1].microSeconds };
+    mpiComm.sumReduce(microSeconds);
+
+    const NbnxmKernelType fastestKernelType = (microSeconds[1] < microSeconds[0])
+                                                      ? NbnxmKernelType::Cpu4xN_Simd_2xNN
+                                                      : NbnxmKernelType::Cpu4xN_Simd_4xN;
+
+    GMX_LOG(mdlog.info)
+            .asParagraph()
+            .appendTextFormatted(
+                    "Measured nonbonded kernel performance: SIMD4xM %.1f, SIMD2xMM %.1f "
+                    "useful pairs/ns, choosing %s",
+                    1e-3 * results[0].numUsefulPairs * results[0].numIterations * mpiComm.size()
+                            / microSeconds[0],
+                    1e-3 * results[1].numUsefulPairs * results[1].numIterations * mpiComm.size()
+                            / microSeconds[1],
+                    nbnxmKernelTypeToName(fastestKernelType));
+
+    return fastestKernelType;
+}
+
+} // namespace gmx
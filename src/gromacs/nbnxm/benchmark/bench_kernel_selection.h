@@ -0,0 +1,79 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+
+/*! \libinternal \file
+ * \brief
+ * This file declares the choice of the CPU SIMD non-bonded kernel layout by timing
+ *
+ * \inlibraryapi
+ * \ingroup module_nbnxm
+ */
+
+#ifndef GMX_NBNXM_BENCH_KERNEL_SELECTION_H
+#define GMX_NBNXM_BENCH_KERNEL_SELECTION_H
+
+#include <optional>
+
+struct interaction_const_t;
+struct t_inputrec;
+
+namespace gmx
+{
+
+class MDLogger;
+class MpiComm;
+enum class NbnxmKernelType : int;
+
+/*! \brief Returns the CPU SIMD kernel type with the highest measured pair throughput
+ *
+ * Times the 4xM and 2x(M+M) kernels with the nonbonded kernel benchmark
+ * on a box of water, using the interaction type, cut-off and thread count
+ * of this run. The relative performance of the two layouts depends on
+ * the SIMD width, FMA throughput and cache sizes of the CPU, which the
+ * heuristics in the Nbnxm setup can only approximate.
+ * The timings are summed over all ranks in \p mpiComm, so that all ranks
+ * make the same choice. This should be called by all these ranks.
+ *
+ * Returns std::nullopt, without timing, when environment variable
+ * GMX_NBNXN_SIMD_TUNE is not set, when only one of the two layouts is
+ * compiled in or when one is forced with GMX_NBNXN_SIMD_4XN or GMX_NBNXN_SIMD_2XNN.
+ */
+std::optional<NbnxmKernelType> measureFastestNbnxmKernelCpuSimdType(const MDLogger&   mdlog,
+                                                                    const t_inputrec& inputrec,
+                                                                    const interaction_const_t& ic,
+                                                                    const MpiComm& mpiComm);
+
+} // namespace gmx
+
+#endif
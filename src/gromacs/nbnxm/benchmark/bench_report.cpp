@@ -0,0 +1,265 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * This file defines functions for reporting kernel benchmark results
+ * in JSON format and for comparing them against a stored baseline
+ *
+ * \ingroup module_nbnxm
+ */
+
+#include "gmxpre.h"
+
+#include "bench_report.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+
+#include <string>
+#include <vector>
+
+#include "gromacs/simd/simd.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/baseversion.h"
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/stringutil.h"
+#include "gromacs/utility/textreader.h"
+#include "gromacs/utility/textwriter.h"
+
+#include "bench_setup.h"
+
+namespace gmx
+{
+
+//! Returns the Ewald exclusion correction used by the instance, empty with reaction-field
+static const char* ewaldCorrectionName(const NbnxmKernelBenchOptions& options)
+{
+    if (options.coulombType == NbnxmBenchMarkCoulomb::ReactionField)
+    {
+        return "";
+    }
+    return (options.nbnxmSimd == NbnxmBenchMarkKernels::SimdNo || options.useTabulatedEwaldCorr)
+                   ? "table"
+                   : "analytical";
+}
+
+//! Returns the number of useful pair interactions per microsecond
+static double usefulPairsPerMicroSecond(const NbnxmKernelBenchResult& result)
+{
+    return result.numIterations * result.numUsefulPairs / result.microSeconds;
+}
+
+std::string nbnxmKernelBenchResultKey(const NbnxmKernelBenchResult& result)
+{
+    const NbnxmKernelBenchOptions& options = result.options;
+
+    return formatString(
+            "kernel=%s coulomb=%s ewaldcorr=%s lj=%s comb=%s intmod=%s energy=%s atoms=%d "
+            "cutoff=%g threads=%d",
+            c_nbnxmBenchKernelNames[options.nbnxmSimd],
+            options.coulombType == NbnxmBenchMarkCoulomb::Pme ? "Ewald" : "RF",
+            ewaldCorrectionName(options),
+            options.useHalfLJOptimization ? "half" : "all",
+            c_nbnxmBenchCombRuleNames[options.ljCombinationRule],
+            c_nbnxmBenchInteractionModifierNames[options.interactionModifier],
+            options.computeVirialAndEnergy ? "yes" : "no",
+            result.numAtoms,
+            options.pairlistCutoff,
+            options.numThreads);
+}
+
+void writeNbnxmKernelBenchJson(const std::string& fileName, ArrayRef<const NbnxmKernelBenchResult> results)
+{
+    // A 2 fs time step expressed in ns, for the ns/day equivalent
+    constexpr double c_timeStepInNs       = 2e-6;
+    constexpr double c_microSecondsPerDay = 86400e6;
+
+    TextWriter writer(fileName);
+
+    writer.writeLine("{");
+    writer.writeLineFormatted("  \"gromacs_version\": \"%s\",", gmx_version());
+#if GMX_SIMD
+    writer.writeLineFormatted("  \"simd_real_width\": %d,", GMX_SIMD_REAL_WIDTH);
+#else
+    writer.writeLineFormatted("  \"simd_real_width\": %d,", 0);
+#endif
+    writer.writeLine("  \"results\": [");
+    for (Index i = 0; i < results.ssize(); i++)
+    {
+        const NbnxmKernelBenchResult&  result  = results[i];
+        const NbnxmKernelBenchOptions& options = result.options;
+
+        const double microSecondsPerIteration = result.microSeconds / result.numIterations;
+
+        // Each result goes on a single line, this is relied upon by the baseline reader
+        writer.writeLineFormatted(
+                "    { \"key\": \"%s\", \"kernel\": \"%s\", \"coulomb\": \"%s\", "
+                "\"ewald_correction\": \"%s\", \"lj\": \"%s\", \"comb_rule\": \"%s\", "
+                "\"interaction_modifier\": \"%s\", \"energy\": %s, \"atoms\": %d, "
+                "\"cutoff\": %g, \"threads\": %d, \"iterations\": %d, \"pairs\": %td, "
+                "\"useful_pairs\": %.0f, \"mcycles\": %.4f, \"usec\": %.3f, "
+                "\"usec_per_iteration\": %.4f, \"pairs_per_usec\": %.4f, "
+                "\"useful_pairs_per_usec\": %.4f, \"ns_per_day\": %.2f }%s",
+                nbnxmKernelBenchResultKey(result).c_str(),
+                c_nbnxmBenchKernelNames[options.nbnxmSimd],
+                options.coulombType == NbnxmBenchMarkCoulomb::Pme ? "Ewald" : "RF",
+                ewaldCorrectionName(options),
+                options.useHalfLJOptimization ? "half" : "all",
+                c_nbnxmBenchCombRuleNames[options.ljCombinationRule],
+                c_nbnxmBenchInteractionModifierNames[options.interactionModifier],
+                options.computeVirialAndEnergy ? "true" : "false",
+                result.numAtoms,
+                options.pairlistCutoff,
+                options.numThreads,
+                result.numIterations,
+                result.numPairs,
+                result.numUsefulPairs,
+                result.cycles * 1e-6,
+                result.microSeconds,
+                microSecondsPerIteration,
+                result.numIterations * result.numPairs / result.microSeconds,
+                usefulPairsPerMicroSecond(result),
+                c_microSecondsPerDay / microSecondsPerIteration * c_timeStepInNs,
+                i + 1 < results.ssize() ? "," : "");
+    }
+    writer.writeLine("  ]");
+    writer.writeLine("}");
+    writer.close();
+}
+
+/*! \brief Returns the position just after \p name as a JSON member name with colon in \p line
+ *
+ * Returns std::string::npos when \p name is not present.
+ */
+static size_t findJsonMemberValue(const std::string& line, const char* name)
+{
+    const std::string member = formatString("\"%s\":", name);
+    const size_t      pos    = line.find(member);
+    if (pos == std::string::npos)
+    {
+        return pos;
+    }
+    return line.find_first_not_of(' ', pos + member.size());
+}
+
+std::vector<NbnxmKernelBenchBaselineEntry> readNbnxmKernelBenchBaseline(const std::string& fileName)
+{
+    std::vector<NbnxmKernelBenchBaselineEntry> baseline;
+
+    TextReader  reader(fileName);
+    std::string line;
+    int         lineNumber = 0;
+    while (reader.readLine(&line))
+    {
+        lineNumber++;
+
+        const size_t keyPos = findJsonMemberValue(line, "key");
+        if (keyPos == std::string::npos)
+        {
+            // Not a result line
+            continue;
+        }
+        const size_t keyEnd = line.find('"', keyPos + 1);
+        if (line[keyPos] != '"' || keyEnd == std::string::npos)
+        {
+            GMX_THROW(InvalidInputError(formatString(
+                    "Invalid key on line %d of benchmark baseline file %s", lineNumber, fileName.c_str())));
+        }
+
+        const size_t valuePos = findJsonMemberValue(line, "useful_pairs_per_usec");
+        if (valuePos == std::string::npos)
+        {
+            GMX_THROW(InvalidInputError(
+                    formatString("Missing useful_pairs_per_usec on line %d of benchmark baseline file %s",
+                                 lineNumber,
+                                 fileName.c_str())));
+        }
+
+        NbnxmKernelBenchBaselineEntry entry;
+        entry.key                       = line.substr(keyPos + 1, keyEnd - keyPos - 1);
+        entry.usefulPairsPerMicroSecond = std::strtod(line.c_str() + valuePos, nullptr);
+        baseline.push_back(entry);
+    }
+
+    return baseline;
+}
+
+int compareNbnxmKernelBenchToBaseline(ArrayRef<const NbnxmKernelBenchResult>        results,
+                                      ArrayRef<const NbnxmKernelBenchBaselineEntry> baseline,
+                                      const real                                    tolerance,
+                                      FILE*                                         fp)
+{
+    fprintf(fp, "\nComparison with baseline, allowed kernel time increase %g%%\n", tolerance * 100);
+    fprintf(fp, "%12s %12s %9s  %s\n", "baseline", "current", "change", "setup");
+    fprintf(fp, "%12s %12s %9s\n", "pairs/usec", "pairs/usec", "in time");
+
+    int numRegressions = 0;
+    for (const NbnxmKernelBenchResult& result : results)
+    {
+        const std::string key     = nbnxmKernelBenchResultKey(result);
+        const double      current = usefulPairsPerMicroSecond(result);
+
+        const auto entry = std::find_if(baseline.begin(),
+                                        baseline.end(),
+                                        [&key](const NbnxmKernelBenchBaselineEntry& e)
+                                        { return e.key == key; });
+        if (entry == baseline.end())
+        {
+            fprintf(fp, "%12s %12.2f %9s  %s\n", "-", current, "-", key.c_str());
+            continue;
+        }
+
+        // The relative change in kernel time, positive is slower
+        const double timeChange   = entry->usefulPairsPerMicroSecond / current - 1;
+        const bool   isRegression = (timeChange > tolerance);
+        if (isRegression)
+        {
+            numRegressions++;
+        }
+        fprintf(fp,
+                "%12.2f %12.2f %8.1f%%  %s%s\n",
+                entry->usefulPairsPerMicroSecond,
+                current,
+                timeChange * 100,
+                key.c_str(),
+                isRegression ? "  REGRESSION" : "");
+    }
+    fprintf(fp, "\nNumber of regressions: %d\n", numRegressions);
+
+    return numRegressions;
+}
+
+} // namespace gmx
@@ -0,0 +1,123 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * This file declares functions for reporting kernel benchmark results
+ * in JSON format and for comparing them against a stored baseline
+ *
+ * \inlibraryapi
+ * \ingroup module_nbnxm
+ */
+
+#ifndef GMX_NBNXN_BENCH_REPORT_H
+#define GMX_NBNXN_BENCH_REPORT_H
+
+#include <cstdio>
+
+#include <string>
+#include <vector>
+
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/real.h"
+
+namespace gmx
+{
+
+struct NbnxmKernelBenchResult;
+
+/*! \internal \brief
+ * A single baseline measurement read back from a benchmark JSON file
+ */
+struct NbnxmKernelBenchBaselineEntry
+{
+    //! The key identifying the benchmark setup, see nbnxmKernelBenchResultKey()
+    std::string key;
+    //! The number of useful pair interactions per microsecond
+    double usefulPairsPerMicroSecond;
+};
+
+/*! \brief
+ * Returns a string that uniquely identifies the setup of a benchmark instance
+ *
+ * The key contains all settings that affect the performance, i.e. the kernel
+ * and interaction setup, the system size, the cut-off and the thread count.
+ */
+std::string nbnxmKernelBenchResultKey(const NbnxmKernelBenchResult& result);
+
+/*! \brief
+ * Writes benchmark results to a JSON file
+ *
+ * Each result is written as a single-line JSON object, which allows
+ * the file to be read back with readNbnxmKernelBenchBaseline().
+ * Apart from timings and pair throughput, an ns/day equivalent is reported
+ * which is the simulation rate of a 2 fs time step that would consist only
+ * of this kernel call.
+ *
+ * \param[in] fileName  The name of the file to write
+ * \param[in] results   The results to write
+ * \throws FileIOError when the file can not be written
+ */
+void writeNbnxmKernelBenchJson(const std::string& fileName, ArrayRef<const NbnxmKernelBenchResult> results);
+
+/*! \brief
+ * Reads the baseline entries from a JSON file written by writeNbnxmKernelBenchJson()
+ *
+ * \throws FileIOError when the file can not be read
+ * \throws InvalidInputError when a result entry lacks the key or throughput
+ */
+std::vector<NbnxmKernelBenchBaselineEntry> readNbnxmKernelBenchBaseline(const std::string& fileName);
+
+/*! \brief
+ * Compares benchmark results to a baseline and prints the comparison to \p fp
+ *
+ * A result is considered a regression when its useful pair throughput
+ * is lower than that of the baseline by more than a fraction \p tolerance
+ * of the result throughput, i.e. when the kernel time increased by more than
+ * \p tolerance. Results without a matching baseline entry are listed,
+ * but are not considered regressions.
+ *
+ * \param[in] results    The results of the current run
+ * \param[in] baseline   The baseline entries
+ * \param[in] tolerance  The allowed relative increase of the kernel time
+ * \param[in] fp         The file to print the comparison to
+ * \returns The number of results that are regressions
+ */
+int compareNbnxmKernelBenchToBaseline(ArrayRef<const NbnxmKernelBenchResult>        results,
+                                      ArrayRef<const NbnxmKernelBenchBaselineEntry> baseline,
+                                      real                                          tolerance,
+                                      FILE*                                         fp);
+
+} // namespace gmx
+
+#endif
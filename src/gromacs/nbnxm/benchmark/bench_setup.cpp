@@ -49,6 +49,7 @@
 #include <cstdio>
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -103,7 +104,8 @@ namespace gmx
 static std::optional<std::string> checkKernelSetup(const NbnxmKernelBenchOptions& options)
 {
     GMX_RELEASE_ASSERT(options.nbnxmSimd < NbnxmBenchMarkKernels::Count
-                               && options.nbnxmSimd != NbnxmBenchMarkKernels::SimdAuto,
+                               && options.nbnxmSimd != NbnxmBenchMarkKernels::SimdAuto
+                               && options.nbnxmSimd != NbnxmBenchMarkKernels::SimdAll,
                        "Need a valid kernel SIMD type");
 
     // Check SIMD support
@@ -316,19 +318,30 @@ static void expandSimdOptionAndPushBack(const NbnxmKernelBenchOptions&        op
             optionsList->back().nbnxmSimd = NbnxmBenchMarkKernels::SimdNo;
         }
     }
+    else if (options.nbnxmSimd == NbnxmBenchMarkKernels::SimdAll)
+    {
+        // Plain-C first, then all SIMD kernels that were set up at configuration time
+        optionsList->push_back(options);
+        optionsList->back().nbnxmSimd = NbnxmBenchMarkKernels::SimdNo;
+#if GMX_HAVE_NBNXM_SIMD_4XM || GMX_HAVE_NBNXM_SIMD_2XMM
+        NbnxmKernelBenchOptions simdOptions = options;
+        simdOptions.nbnxmSimd               = NbnxmBenchMarkKernels::SimdAuto;
+        expandSimdOptionAndPushBack(simdOptions, optionsList);
+#endif
+    }
     else
     {
         optionsList->push_back(options);
     }
 }
 
-//! Sets up and runs the requested benchmark instance and prints the results
+//! Sets up and runs the requested benchmark instance, prints and returns the results
 //
 // When \p doWarmup is true runs the warmup iterations instead
 // of the normal ones and does not print any results
-static void setupAndRunInstance(const BenchmarkSystem&         system,
-                                const NbnxmKernelBenchOptions& options,
-                                const bool                     doWarmup)
+static NbnxmKernelBenchResult setupAndRunInstance(const BenchmarkSystem&         system,
+                                                  const NbnxmKernelBenchOptions& options,
+                                                  const bool                     doWarmup)
 {
     // Generate an, accurate, estimate of the number of non-zero pair interactions
     const real atomDensity = system.coordinates.size() / det(system.box);
@@ -353,28 +366,19 @@ static void setupAndRunInstance(const BenchmarkSystem&         system,
         stepWork.computeEnergy = true;
     }
 
-    const EnumerationArray<NbnxmBenchMarkKernels, std::string> kernelNames = {
-        "auto", "no", "4xM", "2xMM"
-    };
-
-    const EnumerationArray<NbnxmBenchMarkCombRule, std::string> combruleNames = { "geom.",
-                                                                                  "LB",
-                                                                                  "none" };
+    const auto& kernelNames              = c_nbnxmBenchKernelNames;
+    const auto& combruleNames            = c_nbnxmBenchCombRuleNames;
+    const auto& interactionModifierNames = c_nbnxmBenchInteractionModifierNames;
 
-    const EnumerationArray<NbnxmBenchMarkInteractionModifiers, std::string> interactionModifierNames = {
-        "PotShift", "PotSwitch", "ForceSwitch"
-    };
-
-
-    if (!doWarmup)
+    if (!doWarmup && options.printReport)
     {
         fprintf(stdout,
                 "%-7s %-4s %-5s %-4s %-12s",
                 options.coulombType == NbnxmBenchMarkCoulomb::Pme ? "Ewald" : "RF",
                 options.useHalfLJOptimization ? "half" : "all",
-                combruleNames[options.ljCombinationRule].c_str(),
-                kernelNames[options.nbnxmSimd].c_str(),
-                interactionModifierNames[options.interactionModifier].c_str());
+                combruleNames[options.ljCombinationRule],
+                kernelNames[options.nbnxmSimd],
+                interactionModifierNames[options.interactionModifier]);
         if (!options.outputFile.empty())
         {
             fprintf(system.csv,
@@ -398,9 +402,9 @@ static void setupAndRunInstance(const BenchmarkSystem&         system,
                             : "",
                     options.coulombType == NbnxmBenchMarkCoulomb::Pme ? "Ewald" : "RF",
                     options.useHalfLJOptimization ? "half" : "all",
-                    combruleNames[options.ljCombinationRule].c_str(),
-                    kernelNames[options.nbnxmSimd].c_str(),
-                    interactionModifierNames[options.interactionModifier].c_str());
+                    combruleNames[options.ljCombinationRule],
+                    kernelNames[options.nbnxmSimd],
+                    interactionModifierNames[options.interactionModifier]);
         }
     }
 
@@ -422,7 +426,8 @@ static void setupAndRunInstance(const BenchmarkSystem&         system,
     const int numIterations = (doWarmup ? options.numWarmupIterations : options.numIterations);
     const PairlistSet& pairlistSet = nbv->pairlistSets().pairlistSet(InteractionLocality::Local);
     const Index numPairs = pairlistSet.natpair_ljq_ + pairlistSet.natpair_lj_ + pairlistSet.natpair_q_;
-    gmx_cycles_t cycles = gmx_cycles_read();
+    const auto   startTime = std::chrono::steady_clock::now();
+    gmx_cycles_t cycles    = gmx_cycles_read();
     for (int iter = 0; iter < numIterations; iter++)
     {
         // Run the kernel without force clearing
@@ -438,7 +443,18 @@ static void setupAndRunInstance(const BenchmarkSystem&         system,
                 &nrnb);
     }
     cycles = gmx_cycles_read() - cycles;
-    if (!doWarmup)
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    NbnxmKernelBenchResult result;
+    result.options        = options;
+    result.numAtoms       = system.coordinates.size();
+    result.numIterations  = numIterations;
+    result.numPairs       = numPairs;
+    result.numUsefulPairs = numUsefulPairs;
+    result.cycles         = static_cast<double>(cycles);
+    result.microSeconds   = elapsed.count();
+
+    if (!doWarmup && options.printReport)
     {
         if (options.reportTime)
         {
@@ -503,15 +519,17 @@ static void setupAndRunInstance(const BenchmarkSystem&         system,
             }
         }
     }
+
+    return result;
 }
 
-void bench(const int sizeFactor, const NbnxmKernelBenchOptions& options)
+std::vector<NbnxmKernelBenchResult> bench(const int sizeFactor, const NbnxmKernelBenchOptions& options)
 {
     // We don't want to call gmx_omp_nthreads_init(), so we init what we need
     gmx_omp_nthreads_set(ModuleMultiThread::Pairsearch, options.numThreads);
     gmx_omp_nthreads_set(ModuleMultiThread::Nonbonded, options.numThreads);
 
-    const BenchmarkSystem system(sizeFactor, options.outputFile);
+    const BenchmarkSystem system(sizeFactor, options.outputFile, options.appendToOutputFile);
 
     real minBoxSize = norm(system.box[XX]);
     for (int dim = YY; dim < DIM; dim++)
@@ -556,78 +574,88 @@ void bench(const int sizeFactor, const NbnxmKernelBenchOptions& options)
     }
     GMX_RELEASE_ASSERT(!optionsList.empty(), "Expect at least on benchmark setup");
 
-#if GMX_SIMD
-    if (options.nbnxmSimd != NbnxmBenchMarkKernels::SimdNo)
+    if (options.printReport)
     {
-        fprintf(stdout, "SIMD width:           %d\n", GMX_SIMD_REAL_WIDTH);
-    }
+#if GMX_SIMD
+        if (options.nbnxmSimd != NbnxmBenchMarkKernels::SimdNo)
+        {
+            fprintf(stdout, "SIMD width:           %d\n", GMX_SIMD_REAL_WIDTH);
+        }
 #endif
-    fprintf(stdout, "System size:          %zu atoms\n", system.coordinates.size());
-    fprintf(stdout, "Cut-off radius:       %g nm\n", options.pairlistCutoff);
-    fprintf(stdout, "Number of threads:    %d\n", options.numThreads);
-    fprintf(stdout, "Number of iterations: %d\n", options.numIterations);
-    fprintf(stdout, "Compute energies:     %s\n", options.computeVirialAndEnergy ? "yes" : "no");
-    if (options.coulombType != NbnxmBenchMarkCoulomb::ReactionField)
-    {
-        fprintf(stdout,
-                "Ewald excl. corr.:    %s\n",
-                options.nbnxmSimd == NbnxmBenchMarkKernels::SimdNo || options.useTabulatedEwaldCorr
-                        ? "table"
-                        : "analytical");
+        fprintf(stdout, "System size:          %zu atoms\n", system.coordinates.size());
+        fprintf(stdout, "Cut-off radius:       %g nm\n", options.pairlistCutoff);
+        fprintf(stdout, "Number of threads:    %d\n", options.numThreads);
+        fprintf(stdout, "Number of iterations: %d\n", options.numIterations);
+        fprintf(stdout, "Compute energies:     %s\n", options.computeVirialAndEnergy ? "yes" : "no");
+        if (options.coulombType != NbnxmBenchMarkCoulomb::ReactionField)
+        {
+            fprintf(stdout,
+                    "Ewald excl. corr.:    %s\n",
+                    options.nbnxmSimd == NbnxmBenchMarkKernels::SimdNo || options.useTabulatedEwaldCorr
+                            ? "table"
+                            : "analytical");
+        }
+        printf("\n");
     }
-    printf("\n");
 
     if (options.numWarmupIterations > 0)
     {
         setupAndRunInstance(system, optionsList[0], true);
     }
 
-    if (options.reportTime)
+    if (options.printReport)
     {
-        fprintf(stdout,
-                "Coulomb LJ   comb. SIMD intmod.           usec         usec/it.        %s\n",
-                options.cyclesPerPair ? "usec/pair" : "pairs/usec");
-        if (!options.outputFile.empty())
+        if (options.reportTime)
         {
-            fprintf(system.csv,
-                    "\"width\",\"atoms\",\"cut-off radius\",\"threads\",\"iter\",\"compute "
-                    "energy\",\"Ewald excl. "
-                    "corr.\",\"Coulomb\",\"LJ\",\"comb\",\"SIMD\",\"intmod\",\"usec\",\"usec/"
-                    "it\",\"total "
-                    "pairs/usec\",\"useful pairs/usec\"\n");
+            fprintf(stdout,
+                    "Coulomb LJ   comb. SIMD intmod.           usec         usec/it.        %s\n",
+                    options.cyclesPerPair ? "usec/pair" : "pairs/usec");
+            if (!options.outputFile.empty() && !options.appendToOutputFile)
+            {
+                fprintf(system.csv,
+                        "\"width\",\"atoms\",\"cut-off radius\",\"threads\",\"iter\",\"compute "
+                        "energy\",\"Ewald excl. "
+                        "corr.\",\"Coulomb\",\"LJ\",\"comb\",\"SIMD\",\"intmod\",\"usec\",\"usec/"
+                        "it\",\"total "
+                        "pairs/usec\",\"useful pairs/usec\"\n");
+            }
+            fprintf(stdout,
+                    "                                                                    total      "
+                    "useful\n");
         }
-        fprintf(stdout,
-                "                                                                    total      "
-                "useful\n");
-    }
-    else
-    {
-        fprintf(stdout,
-                "Coulomb LJ   comb. SIMD intmod.        Mcycles  Mcycles/it.   %s\n",
-                options.cyclesPerPair ? "cycles/pair" : "pairs/cycle");
-        if (!options.outputFile.empty())
+        else
         {
-            fprintf(system.csv,
-                    "\"width\",\"atoms\",\"cut-off radius\",\"threads\",\"iter\",\"compute "
-                    "energy\",\"Ewald excl. "
-                    "corr.\",\"Coulomb\",\"LJ\",\"comb\",\"SIMD\",\"intmod\",\"Mcycles\",\"Mcycles/"
-                    "it\",\"total "
-                    "total cycles/pair\",\"total cycles per useful pair\"\n");
+            fprintf(stdout,
+                    "Coulomb LJ   comb. SIMD intmod.        Mcycles  Mcycles/it.   %s\n",
+                    options.cyclesPerPair ? "cycles/pair" : "pairs/cycle");
+            if (!options.outputFile.empty() && !options.appendToOutputFile)
+            {
+                fprintf(system.csv,
+                        "\"width\",\"atoms\",\"cut-off radius\",\"threads\",\"iter\",\"compute "
+                        "energy\",\"Ewald excl. "
+                        "corr.\",\"Coulomb\",\"LJ\",\"comb\",\"SIMD\",\"intmod\",\"Mcycles\",\"Mcycles/"
+                        "it\",\"total "
+                        "total cycles/pair\",\"total cycles per useful pair\"\n");
+            }
+            fprintf(stdout,
+                    "                                                            total    "
+                    "useful\n");
         }
-        fprintf(stdout,
-                "                                                            total    "
-                "useful\n");
     }
 
+    std::vector<NbnxmKernelBenchResult> results;
+    results.reserve(optionsList.size());
     for (const auto& optionsInstance : optionsList)
     {
-        setupAndRunInstance(system, optionsInstance, false);
+        results.push_back(setupAndRunInstance(system, optionsInstance, false));
     }
 
     if (!options.outputFile.empty())
     {
         std::fclose(system.csv);
     }
+
+    return results;
 }
 
 } // namespace gmx
@@ -46,7 +46,10 @@
 #define GMX_NBNXN_BENCH_SETUP_H
 
 #include <string>
+#include <vector>
 
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/enumerationhelpers.h"
 #include "gromacs/utility/real.h"
 
 namespace gmx
@@ -59,9 +62,15 @@ enum class NbnxmBenchMarkKernels : int
     SimdNo,
     Simd4XM,
     Simd2XMM,
+    SimdAll,
     Count
 };
 
+//! Names of the kernel SIMD types as used in benchmark reports
+static constexpr EnumerationArray<NbnxmBenchMarkKernels, const char*> c_nbnxmBenchKernelNames = {
+    { "auto", "no", "4xM", "2xMM", "all" }
+};
+
 //! Enum for selecting the combination rule for kernel benchmarks
 enum class NbnxmBenchMarkCombRule : int
 {
@@ -71,6 +80,11 @@ enum class NbnxmBenchMarkCombRule : int
     Count
 };
 
+//! Names of the combination rules as used in benchmark reports
+static constexpr EnumerationArray<NbnxmBenchMarkCombRule, const char*> c_nbnxmBenchCombRuleNames = {
+    { "geom.", "LB", "none" }
+};
+
 //! Enum for selecting coulomb type for kernel benchmarks
 enum class NbnxmBenchMarkCoulomb : int
 {
@@ -79,6 +93,7 @@ enum class NbnxmBenchMarkCoulomb : int
     Count
 };
 
+//! Enum for selecting the interaction modifier for kernel benchmarks
 enum class NbnxmBenchMarkInteractionModifiers : int
 {
     PotShift,
@@ -87,6 +102,11 @@ enum class NbnxmBenchMarkInteractionModifiers : int
     Count
 };
 
+//! Names of the interaction modifiers as used in benchmark reports
+static constexpr EnumerationArray<NbnxmBenchMarkInteractionModifiers, const char*> c_nbnxmBenchInteractionModifierNames = {
+    { "PotShift", "PotSwitch", "ForceSwitch" }
+};
+
 /*! \internal \brief
  * The options for the kernel benchmarks
  */
@@ -128,6 +148,31 @@ struct NbnxmKernelBenchOptions
     bool reportTime = false;
     //! Also report into a csv file
     std::string outputFile;
+    //! Append to the csv file without writing a header, used when sweeping over system setups
+    bool appendToOutputFile = false;
+    //! Print the settings and timings to stdout and the csv file, disabled for internal measurements
+    bool printReport = true;
+};
+
+/*! \internal \brief
+ * The measured performance of a single kernel benchmark instance
+ */
+struct NbnxmKernelBenchResult
+{
+    //! The options this instance was run with, with a concrete SIMD kernel type
+    NbnxmKernelBenchOptions options;
+    //! The number of atoms in the benchmark system
+    int numAtoms = 0;
+    //! The number of timed iterations
+    int numIterations = 0;
+    //! The number of atom pairs in the cluster pair list, i.e. computed per iteration
+    Index numPairs = 0;
+    //! The estimated number of atom pairs within the cut-off distance
+    double numUsefulPairs = 0;
+    //! The number of cycles for all timed iterations
+    double cycles = 0;
+    //! The wall-clock time in microseconds for all timed iterations
+    double microSeconds = 0;
 };
 
 /*! \brief
@@ -136,12 +181,14 @@ struct NbnxmKernelBenchOptions
  * The simulated system is a box of 1000 SPC/E water molecules scaled
  * by the factor \p sizeFactor, which has to be a power of 2.
  * One or more benchmarks are run, as specified by \p options.
- * Benchmark settings and timings are printed to stdout.
+ * Benchmark settings and timings are printed to stdout, unless
+ * \p options.printReport is false.
  *
  * \param[in] sizeFactor How much should the system size be increased.
  * \param[in] options How the benchmark will be run.
+ * \returns The measured performance of each benchmark instance that was run.
  */
-void bench(int sizeFactor, const NbnxmKernelBenchOptions& options);
+std::vector<NbnxmKernelBenchResult> bench(int sizeFactor, const NbnxmKernelBenchOptions& options);
 
 } // namespace gmx
 
@@ -158,7 +158,9 @@ static void generateCoordinates(int multiplicationFactor, std::vector<gmx::RVec>
     }
 }
 
-BenchmarkSystem::BenchmarkSystem(const int multiplicationFactor, const std::string& outputFile)
+BenchmarkSystem::BenchmarkSystem(const int          multiplicationFactor,
+                                 const std::string& outputFile,
+                                 const bool         appendToOutputFile)
 {
     numAtomTypes = 2;
     nonbondedParameters.resize(numAtomTypes * numAtomTypes * 2, 0);
@@ -209,7 +211,7 @@ BenchmarkSystem::BenchmarkSystem(const int multiplicationFactor, const std::stri
     calc_shifts(box, forceRec.shift_vec);
     if (!outputFile.empty())
     {
-        csv = std::fopen(outputFile.c_str(), "w+");
+        csv = std::fopen(outputFile.c_str(), appendToOutputFile ? "a+" : "w+");
     }
 }
 
@@ -68,8 +68,9 @@ struct BenchmarkSystem
      *
      * \param[in] multiplicationFactor  Should be a power of 2, is checked
      * \param[in] outputFile            The name of the csv file to write benchmark results
+     * \param[in] appendToOutputFile    Whether to append to instead of overwrite \p outputFile
      */
-    BenchmarkSystem(int multiplicationFactor, const std::string& outputFile);
+    BenchmarkSystem(int multiplicationFactor, const std::string& outputFile, bool appendToOutputFile);
 
     //! Number of different atom types in test system.
     int numAtomTypes;
@@ -495,6 +495,30 @@ static void sort_atoms(int                  dim,
     }
 }
 
+/*! \brief Sorts particle index \p a on coordinates \p x along \p dim using insertion sort
+ *
+ * Produces the same, increasing, order as sort_atoms(), including the atom index
+ * tie-break for identical coordinates. This is much cheaper than sort_atoms()
+ * when the input is already nearly sorted, as is the case when starting from
+ * the order of the previous search step.
+ */
+static void sortAtomsNearlySorted(int dim, int* a, int n, ArrayRef<const RVec> x)
+{
+    for (int i = 1; i < n; i++)
+    {
+        const int  atom  = a[i];
+        const real coord = x[atom][dim];
+
+        int j = i;
+        while (j > 0 && (x[a[j - 1]][dim] > coord || (x[a[j - 1]][dim] == coord && a[j - 1] > atom)))
+        {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = atom;
+    }
+}
+
 #if GMX_DOUBLE
 //! Returns double up to one least significant float bit smaller than x
 static double R2F_D(const float x)
@@ -1065,12 +1089,37 @@ void Grid::fillCell(GridSetData*            gridSetData,
     }
 }
 
+bool Grid::columnAtomsAreUnchanged(const int cxy, const Range<int> atomRange, ArrayRef<const int> cells) const
+{
+    const int numAtoms = numAtomsInColumn(cxy);
+    if (numAtoms != previousNumAtomsInColumn_[cxy])
+    {
+        return false;
+    }
+
+    /* As the previous atom indices are unique, the sets of atoms are
+     * identical when all previous atoms are now in this column.
+     */
+    const int* previousAtoms =
+            previousAtomIndices_.data() + previousColumnStart_[cxy] * geometry_.numAtomsPerCell_;
+    for (int i = 0; i < numAtoms; i++)
+    {
+        if (!atomRange.isInRange(previousAtoms[i]) || cells[previousAtoms[i]] != cxy)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Grid::sortColumnsCpuGeometry(GridSetData*            gridSetData,
                                   int                     dd_zone,
                                   ArrayRef<const int32_t> atomInfo,
                                   ArrayRef<const RVec>    x,
                                   nbnxn_atomdata_t*       nbat,
                                   const Range<int>        columnRange,
+                                  const bool              reuseColumnOrder,
                                   ArrayRef<int>           sort_work)
 {
     if (debug)
@@ -1094,17 +1143,31 @@ void Grid::sortColumnsCpuGeometry(GridSetData*            gridSetData,
         const int atomOffset = firstAtomInColumn(cxy);
 
         /* Sort the atoms within each x,y column on z coordinate */
-        sort_atoms(ZZ,
-                   FALSE,
-                   dd_zone,
-                   relevantAtomsAreWithinGridBounds,
-                   gridSetData->atomIndices.data() + atomOffset,
-                   numAtoms,
-                   x,
-                   dimensions_.lowerCorner[ZZ],
-                   1.0 / dimensions_.gridSize[ZZ],
-                   numCellsZ * numAtomsPerCell,
-                   sort_work);
+        if (reuseColumnOrder && columnOrderIsReusable_[cxy])
+        {
+            /* The column contains the same atoms as at the previous search.
+             * Their previous order is nearly sorted, which insertion sort
+             * exploits, and gives the same order as sort_atoms().
+             */
+            std::copy_n(previousAtomIndices_.data() + previousColumnStart_[cxy] * numAtomsPerCell,
+                        numAtoms,
+                        gridSetData->atomIndices.data() + atomOffset);
+            sortAtomsNearlySorted(ZZ, gridSetData->atomIndices.data() + atomOffset, numAtoms, x);
+        }
+        else
+        {
+            sort_atoms(ZZ,
+                       FALSE,
+                       dd_zone,
+                       relevantAtomsAreWithinGridBounds,
+                       gridSetData->atomIndices.data() + atomOffset,
+                       numAtoms,
+                       x,
+                       dimensions_.lowerCorner[ZZ],
+                       1.0 / dimensions_.gridSize[ZZ],
+                       numCellsZ * numAtomsPerCell,
+                       sort_work);
+        }
 
         /* Fill the ncz cells in this column */
         const int firstCell  = firstCellInColumn(cxy);
@@ -1417,12 +1480,19 @@ void Grid::setCellIndices(int                  ddZone,
                           ArrayRef<const RVec> x,
                           nbnxn_atomdata_t*    nbat)
 {
-    cellOffset_ = cellOffset;
-
     const int nthread = gmx_omp_nthreads_get(ModuleMultiThread::Pairsearch);
 
     const int numAtomsPerCell = geometry_.numAtomsPerCell_;
 
+    /* Most atoms stay in the same grid column between search steps.
+     * For the home zone with CPU geometry we store the atom order of the previous
+     * search, so we can reuse it for sorting columns with unchanged atom content.
+     * Note that the bounding boxes always need to be recomputed, as atoms moved.
+     */
+    const bool reuseColumnOrder = (previousNumColumns_ == numColumns());
+
+    cellOffset_ = cellOffset;
+
     /* Make the cell index as a function of x and y */
     int ncz_max = 0;
     int ncz     = 0;
@@ -1516,6 +1586,19 @@ void Grid::setCellIndices(int                  ddZone,
         atomIndices[firstAtomInColumn(cxy) + cxy_na_[cxy]++] = i;
     }
 
+    if (reuseColumnOrder)
+    {
+        /* This needs to be done before we set the cell indices of the moved atoms
+         * below and before the sorting, which stores the final cell indices.
+         */
+        columnOrderIsReusable_.resize(numColumns());
+#pragma omp parallel for num_threads(nthread) schedule(static)
+        for (int cxy = 0; cxy < numColumns(); cxy++)
+        {
+            columnOrderIsReusable_[cxy] = static_cast<char>(columnAtomsAreUnchanged(cxy, atomRange, cells));
+        }
+    }
+
     if (isHomeZone(ddZone))
     {
         /* Set the cell indices for the moved particles */
@@ -1537,8 +1620,14 @@ void Grid::setCellIndices(int                  ddZone,
                                    ((thread + 1) * numColumns()) / nthread);
             if (geometry_.isSimple_)
             {
-                sortColumnsCpuGeometry(
-                        gridSetData, ddZone, atomInfo, x, nbat, columnRange, gridWork[thread].sortBuffer);
+                sortColumnsCpuGeometry(gridSetData,
+                                       ddZone,
+                                       atomInfo,
+                                       x,
+                                       nbat,
+                                       columnRange,
+                                       reuseColumnOrder,
+                                       gridWork[thread].sortBuffer);
             }
             else
             {
@@ -1554,6 +1643,25 @@ void Grid::setCellIndices(int                  ddZone,
         combine_bounding_box_pairs(*this, bb_, bbj_);
     }
 
+    /* Store the sorted atom order for the next search. We copy it here, as the column
+     * arrays are not guaranteed to still match the atom indices at the next search.
+     * Only the home zone grid has a fixed location in the atom index list.
+     */
+    if (geometry_.isSimple_ && ddZone == 0)
+    {
+        const int firstAtom = cellOffset_ * numAtomsPerCell;
+        const int lastAtom  = firstAtom + cxy_ind_[numColumns()] * numAtomsPerCell;
+        previousColumnStart_.assign(cxy_ind_.begin(), cxy_ind_.begin() + numColumns());
+        previousNumAtomsInColumn_.assign(cxy_na_.begin(), cxy_na_.begin() + numColumns());
+        previousAtomIndices_.assign(gridSetData->atomIndices.begin() + firstAtom,
+                                    gridSetData->atomIndices.begin() + lastAtom);
+        previousNumColumns_ = numColumns();
+    }
+    else
+    {
+        previousNumColumns_ = -1;
+    }
+
     if (!geometry_.isSimple_)
     {
         numClustersTotal_ = 0;
@@ -1567,6 +1675,14 @@ void Grid::setCellIndices(int                  ddZone,
     {
         if (geometry_.isSimple_)
         {
+            if (reuseColumnOrder)
+            {
+                fprintf(debug,
+                        "ns reused the previous atom order for %d out of %d columns\n",
+                        static_cast<int>(std::count(
+                                columnOrderIsReusable_.begin(), columnOrderIsReusable_.end(), 1)),
+                        numColumns());
+            }
             print_bbsizes_simple(debug, *this);
         }
         else
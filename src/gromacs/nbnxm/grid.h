@@ -363,15 +363,27 @@ private:
                   ArrayRef<const int32_t> atomInfo,
                   ArrayRef<const RVec>    x);
 
-    //! Spatially sort the atoms within the given column range, for CPU geometry
+    /*! \brief Spatially sort the atoms within the given column range, for CPU geometry
+     *
+     * When \p reuseColumnOrder is true, columns marked in \p columnOrderIsReusable_
+     * are sorted starting from the atom order of the previous search.
+     */
     void sortColumnsCpuGeometry(GridSetData*            gridSetData,
                                 int                     dd_zone,
                                 ArrayRef<const int32_t> atomInfo,
                                 ArrayRef<const RVec>    x,
                                 nbnxn_atomdata_t*       nbat,
                                 Range<int>              columnRange,
+                                bool                    reuseColumnOrder,
                                 ArrayRef<int>           sort_work);
 
+    /*! \brief Returns whether column \p cxy contains the same atoms as at the previous search
+     *
+     * Should be called after the unsorted fill of the columns, when \p cells contains
+     * the column indices of the atoms.
+     */
+    bool columnAtomsAreUnchanged(int cxy, Range<int> atomRange, ArrayRef<const int> cells) const;
+
     //! Spatially sort the atoms within the given column range, for GPU geometry
     void sortColumnsGpuGeometry(GridSetData*            gridSetData,
                                 int                     dd_zone,
@@ -433,6 +445,18 @@ private:
     //! Signal bits for atoms in each cell that tell whether an atom is perturbed
     std::vector<unsigned int> fep_;
 
+    /* Atom order of the previous search, used for incremental column sorting */
+    //! The number of columns at the previous search, -1 when the order can not be reused
+    int previousNumColumns_ = -1;
+    //! The grid-local cell index for each grid column at the previous search
+    std::vector<int> previousColumnStart_;
+    //! The number of atoms in each column at the previous search
+    std::vector<int> previousNumAtomsInColumn_;
+    //! The sorted atom indices of the previous search
+    std::vector<int> previousAtomIndices_;
+    //! Tells for each column whether the previous atom order can be reused
+    std::vector<char> columnOrderIsReusable_;
+
     /* Statistics */
     //! Total number of clusters, used for printing
     int numClustersTotal_;
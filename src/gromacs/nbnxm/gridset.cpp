@@ -60,6 +60,8 @@
 #include "gromacs/utility/basedefinitions.h"
 #include "gromacs/utility/fatalerror.h"
 
+#include "hilbertcurve.h"
+
 namespace gmx
 {
 
@@ -110,11 +112,13 @@ GridSet::GridSet(const PbcType      pbcType,
                  const bool         haveFep,
                  const bool         localAtomOrderMatchesNbnxmOrder,
                  const int          numThreads,
-                 PinningPolicy      pinningPolicy) :
+                 PinningPolicy      pinningPolicy,
+                 const bool         useHilbertColumnOrder) :
     domainSetup_(pbcType, doTestParticleInsertion, numDDCells, ddZones),
     pairlistType_(pairlistType),
     haveFep_(haveFep),
     localAtomOrderMatchesNbnxmOrder_(localAtomOrderMatchesNbnxmOrder),
+    useHilbertColumnOrder_(useHilbertColumnOrder && !localAtomOrderMatchesNbnxmOrder),
     pinningPolicy_(pinningPolicy),
     gridWork_(numThreads)
 {
@@ -153,8 +157,9 @@ void GridSet::setLocalAtomOrder()
     else
     {
         int atomIndex = 0;
-        for (int cxy = 0; cxy < grid.numColumns(); cxy++)
+        for (int columnIndex = 0; columnIndex < grid.numColumns(); columnIndex++)
         {
+            const int cxy = (useHilbertColumnOrder_ ? localColumnOrder_[columnIndex] : columnIndex);
             const int numAtoms  = grid.numAtomsInColumn(cxy);
             int       cellIndex = grid.firstCellInColumn(cxy) * grid.geometry().numAtomsPerCell_;
             for (int i = 0; i < numAtoms; i++)
@@ -290,6 +295,12 @@ void GridSet::putOnGrid(const matrix            box,
     /* Copy the already computed cell indices to the grid and sort, when needed */
     grid.setCellIndices(ddZone, cellOffset, &gridSetData_, gridWork_, atomRange, atomInfo, x, nbat);
 
+    if (gridIndex == 0 && useHilbertColumnOrder_)
+    {
+        localColumnOrder_ = hilbertColumnOrder(grid.dimensions().numCells[XX],
+                                               grid.dimensions().numCells[YY]);
+    }
+
     if (gridIndex == numGridsInUse_ - 1)
     {
         /* We are done setting up all grids, we can resize the force buffers */
@@ -304,6 +315,31 @@ void GridSet::putOnGrid(const matrix            box,
     setNumColumnsMax(maxNumColumns);
 }
 
+ArrayRef<const int> GridSet::getLocalAtomorder() const
+{
+    /* Return the atom order for the home cell (index 0) */
+    const Grid& grid = grids_[0];
+
+    if (useHilbertColumnOrder_)
+    {
+        localAtomOrder_.clear();
+        for (const int cxy : localColumnOrder_)
+        {
+            const int firstAtom = grid.firstAtomInColumn(cxy);
+            localAtomOrder_.insert(localAtomOrder_.end(),
+                                   gridSetData_.atomIndices.begin() + firstAtom,
+                                   gridSetData_.atomIndices.begin() + firstAtom
+                                           + grid.numAtomsInColumn(cxy));
+        }
+
+        return localAtomOrder_;
+    }
+
+    const int numIndices = grid.atomIndexEnd() - grid.firstAtomInColumn(0);
+
+    return constArrayRefFromArray(atomIndices().data(), numIndices);
+}
+
 ArrayRef<const int> GridSet::getLocalGridNumAtomsPerColumn() const
 {
     const Grid& grid = grids_[0];
@@ -319,6 +355,17 @@ ArrayRef<const int> GridSet::getLocalGridNumAtomsPerColumn() const
 
         return localGridNumAtomsPerColumn_;
     }
+    else if (useHilbertColumnOrder_)
+    {
+        localGridNumAtomsPerColumn_.resize(grid.numColumns());
+
+        for (int column = 0; column < grid.numColumns(); column++)
+        {
+            localGridNumAtomsPerColumn_[column] = grid.numAtomsInColumn(localColumnOrder_[column]);
+        }
+
+        return localGridNumAtomsPerColumn_;
+    }
     else
     {
         return grid.cxy_na();
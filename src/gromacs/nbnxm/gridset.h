@@ -109,7 +109,11 @@ public:
         const gmx::DomdecZones* zones;
     };
 
-    //! Constructs a grid set for 1 or multiple DD zones, when numDDCells!=nullptr
+    /*! \brief Constructs a grid set for 1 or multiple DD zones, when numDDCells!=nullptr
+     *
+     * With \p useHilbertColumnOrder, and when the local atom order does not need to match
+     * the NBNxM order, the local atoms are ordered with the grid columns along a Hilbert curve.
+     */
     GridSet(PbcType            pbcType,
             bool               doTestParticleInsertion,
             const IVec*        numDDCells,
@@ -118,7 +122,8 @@ public:
             bool               haveFep,
             bool               localAtomOrderMatchesNbnxmOrder,
             int                numThreads,
-            PinningPolicy      pinningPolicy);
+            PinningPolicy      pinningPolicy,
+            bool               useHilbertColumnOrder = false);
 
     //! Puts the atoms on the grid with index \p gridIndex and copies the coordinates to \p nbat
     void putOnGrid(const matrix            box,
@@ -190,14 +195,15 @@ public:
         return numRealAtomsTotal_;
     }
 
-    //! Returns the atom order on the grid for the local atoms
-    ArrayRef<const int> getLocalAtomorder() const
-    {
-        /* Return the atom order for the home cell (index 0) */
-        const int numIndices = grids_[0].atomIndexEnd() - grids_[0].firstAtomInColumn(0);
+    //! Returns whether the local atoms are ordered with the grid columns along a Hilbert curve
+    bool useHilbertColumnOrder() const { return useHilbertColumnOrder_; }
 
-        return constArrayRefFromArray(atomIndices().data(), numIndices);
-    }
+    /*! \brief Returns the atom order on the grid for the local atoms
+     *
+     * With Hilbert column order this only contains the real atoms, otherwise
+     * this is the grid order with -1 for padding and, without NBNxM order, fillers.
+     */
+    ArrayRef<const int> getLocalAtomorder() const;
 
     //! Sets the order of the local atoms to the order grid atom ordering
     void setLocalAtomOrder();
@@ -248,6 +254,10 @@ private:
     bool haveFep_;
     //! Tells whether the local atom order matches the NBNxM atom order
     bool localAtomOrderMatchesNbnxmOrder_;
+    //! Tells whether the local atoms are ordered with the grid columns along a Hilbert curve
+    bool useHilbertColumnOrder_;
+    //! The order of the columns of the local grid for the local atom order
+    std::vector<int> localColumnOrder_;
     //! The pinning policy for Grid data that might be accessed on GPUs
     PinningPolicy pinningPolicy_;
     //! The periodic unit-cell
@@ -263,6 +273,8 @@ private:
 
     //! Buffer for returning the number of grid atoms per column
     mutable std::vector<int> localGridNumAtomsPerColumn_;
+    //! Buffer for returning the local atom order with Hilbert column order
+    mutable std::vector<int> localAtomOrder_;
 };
 
 } // namespace gmx
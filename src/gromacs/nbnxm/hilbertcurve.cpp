@@ -0,0 +1,108 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+
+/*! \internal \file
+ *
+ * \brief
+ * Defines functions for ordering 2D grid columns along a Hilbert curve.
+ *
+ * \ingroup module_nbnxm
+ */
+
+#include "gmxpre.h"
+
+#include "hilbertcurve.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace gmx
+{
+
+int64_t hilbertCurveIndex(const int order, int x, int y)
+{
+    const int n = 1 << order;
+
+    int64_t index = 0;
+    for (int s = n / 2; s > 0; s /= 2)
+    {
+        const int rx = (x & s) > 0 ? 1 : 0;
+        const int ry = (y & s) > 0 ? 1 : 0;
+        index += int64_t(s) * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant such that the curve in it starts and ends at the right corners
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+
+    return index;
+}
+
+std::vector<int> hilbertColumnOrder(const int numColumnsX, const int numColumnsY)
+{
+    int order = 1;
+    while ((1 << order) < std::max(numColumnsX, numColumnsY))
+    {
+        order++;
+    }
+
+    std::vector<std::pair<int64_t, int>> keys;
+    keys.reserve(numColumnsX * numColumnsY);
+    for (int cx = 0; cx < numColumnsX; cx++)
+    {
+        for (int cy = 0; cy < numColumnsY; cy++)
+        {
+            keys.emplace_back(hilbertCurveIndex(order, cx, cy), cx * numColumnsY + cy);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<int> columnOrder;
+    columnOrder.reserve(keys.size());
+    for (const auto& key : keys)
+    {
+        columnOrder.push_back(key.second);
+    }
+
+    return columnOrder;
+}
+
+} // namespace gmx
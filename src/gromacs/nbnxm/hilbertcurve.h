@@ -0,0 +1,70 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+
+/*! \internal \file
+ *
+ * \brief
+ * Declares functions for ordering 2D grid columns along a Hilbert curve.
+ *
+ * \ingroup module_nbnxm
+ */
+
+#ifndef GMX_NBNXM_HILBERTCURVE_H
+#define GMX_NBNXM_HILBERTCURVE_H
+
+#include <cstdint>
+
+#include <vector>
+
+namespace gmx
+{
+
+/*! \brief Returns the index along a Hilbert curve of point (\p x, \p y)
+ *
+ * The curve covers a square grid of 2^\p order by 2^\p order points.
+ */
+int64_t hilbertCurveIndex(int order, int x, int y);
+
+/*! \brief Returns the column indices of a grid ordered along a Hilbert curve
+ *
+ * The column index of column (cx, cy) is cx * \p numColumnsY + cy, as in the
+ * NBNxM grid. For grid sizes that are not an equal power of 2 along both
+ * dimensions, the curve of the enclosing power-of-2 square is used and
+ * the columns outside the grid are skipped.
+ */
+std::vector<int> hilbertColumnOrder(int numColumnsX, int numColumnsY);
+
+} // namespace gmx
+
+#endif
@@ -123,12 +123,7 @@ bool nonbonded_verlet_t::isDynamicPruningStepGpu(int64_t step) const
 
 ArrayRef<const int> nonbonded_verlet_t::getLocalAtomOrder() const
 {
-    /* Return the atom order for the home cell (index 0) */
-    const Grid& grid = pairSearch_->gridSet().grid(0);
-
-    const int numIndices = grid.atomIndexEnd() - grid.firstAtomInColumn(0);
-
-    return constArrayRefFromArray(pairSearch_->gridSet().atomIndices().data(), numIndices);
+    return pairSearch_->gridSet().getLocalAtomorder();
 }
 
 void nonbonded_verlet_t::setLocalAtomOrder() const
@@ -259,6 +254,11 @@ void nonbonded_verlet_t::changePairlistRadii(real rlistOuter, real rlistInner) c
     pairlistSets_->changePairlistRadii(rlistOuter, rlistInner);
 }
 
+void nonbonded_verlet_t::changePairlistParams(const PairlistParams& params) const
+{
+    pairlistSets_->changePairlistParams(params);
+}
+
 void nonbonded_verlet_t::setupGpuShortRangeWork(const ListedForcesGpu*    listedForcesGpu,
                                                 const InteractionLocality iLocality) const
 {
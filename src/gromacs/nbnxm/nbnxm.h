@@ -146,6 +146,7 @@ struct GridDimensions;
 struct NbnxmGpu;
 struct nbnxn_atomdata_t;
 class PairSearch;
+struct PairlistParams;
 class PairlistSets;
 template<typename>
 class ArrayRefWithPadding;
@@ -441,6 +442,9 @@ public:
     //! Changes the pair-list outer and inner radius
     void changePairlistRadii(real rlistOuter, real rlistInner) const;
 
+    //! Changes the pair-list buffer and pruning parameters, should only be called before search steps
+    void changePairlistParams(const PairlistParams& params) const;
+
     //! Set up internal flags that indicate what type of short-range work there is.
     void setupGpuShortRangeWork(const ListedForcesGpu* listedForcesGpu, InteractionLocality iLocality) const;
 
@@ -504,13 +508,18 @@ private:
     bool useGpuNonbondedFE_;
 };
 
-/*! \brief Creates an Nbnxm object */
+/*! \brief Creates an Nbnxm object
+ *
+ * When \p measuredCpuSimdKernelType is set and the CPU SIMD kernels are used,
+ * it replaces the heuristic choice between the 4xM and 2xMM kernel layouts.
+ */
 std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const MDLogger&            mdlog,
                                                    const t_inputrec&          inputrec,
                                                    const t_forcerec&          forcerec,
                                                    const MpiComm&             mpiComm,
                                                    const gmx_domdec_t*        dd,
                                                    const gmx_hw_info_t&       hardwareInfo,
+                                                   std::optional<NbnxmKernelType> measuredCpuSimdKernelType,
                                                    bool                       useGpuForNonbonded,
                                                    bool                       useGpuForNonbondedFE,
                                                    const DeviceStreamManager* deviceStreamManager,
@@ -146,9 +146,11 @@ static bool nbnxmSimdSupported(const MDLogger& mdlog, const t_inputrec& inputrec
  * use of HT, use 4x8 to avoid a potential performance hit.
  * On Intel Haswell 4x8 is always faster.
  *
+ * When \p measuredType is set, this is used instead of the heuristics.
  */
 static NbnxmKernelType pickNbnxmKernelCpuSimdType(const t_inputrec&               inputrec,
-                                                  const gmx_hw_info_t gmx_unused& hardwareInfo)
+                                                  const gmx_hw_info_t gmx_unused& hardwareInfo,
+                                                  std::optional<NbnxmKernelType>  measuredType)
 {
     GMX_RELEASE_ASSERT(sc_haveNbnxmSimd4xmKernels || sc_haveNbnxmSimd2xmmKernels,
                        "Here at least on of SIMD kernels should be supported");
@@ -193,6 +195,11 @@ static NbnxmKernelType pickNbnxmKernelCpuSimdType(const t_inputrec&
     GMX_RELEASE_ASSERT(sc_haveNbnxmSimd4xmKernels && sc_haveNbnxmSimd2xmmKernels,
                        "Here both 4xM and 2xMM SIMD kernels should be supported");
 
+    if (measuredType)
+    {
+        return *measuredType;
+    }
+
     if (hardwareInfo.haveAmdZen1Cpu)
     {
         /* One 256-bit FMA per cycle makes 2xNN faster */
@@ -256,10 +263,11 @@ static EwaldExclusionType pickNbnxmKernelCpuSimdExclusion(const gmx_hw_info_t gm
 }
 
 /*! \brief Returns the most suitable CPU kernel type and Ewald handling */
-static NbnxmKernelSetup pickNbnxnKernelCpu(const t_inputrec&    inputrec,
-                                           const gmx_hw_info_t& hardwareInfo,
-                                           bool                 useSimd,
-                                           const MDLogger&      mdlog)
+static NbnxmKernelSetup pickNbnxnKernelCpu(const t_inputrec&              inputrec,
+                                           const gmx_hw_info_t&           hardwareInfo,
+                                           std::optional<NbnxmKernelType> measuredCpuSimdKernelType,
+                                           bool                           useSimd,
+                                           const MDLogger&                mdlog)
 {
     // Analytical Ewald exclusion correction is only an option in the SIMD kernel.
     if (std::getenv("GMX_NBNXN_PLAINC_1X1") != nullptr)
@@ -268,8 +276,10 @@ static NbnxmKernelSetup pickNbnxnKernelCpu(const t_inputrec&    inputrec,
     }
     if (GMX_SIMD && useSimd && nbnxmSimdSupported(mdlog, inputrec))
     {
-        return NbnxmKernelSetup{ pickNbnxmKernelCpuSimdType(inputrec, hardwareInfo),
-                                 pickNbnxmKernelCpuSimdExclusion(hardwareInfo) };
+        return NbnxmKernelSetup{
+            pickNbnxmKernelCpuSimdType(inputrec, hardwareInfo, measuredCpuSimdKernelType),
+            pickNbnxmKernelCpuSimdExclusion(hardwareInfo)
+        };
     }
     return NbnxmKernelSetup{ NbnxmKernelType::Cpu4x4_PlainC, EwaldExclusionType::Table };
 }
@@ -291,12 +301,13 @@ const char* nbnxmKernelTypeToName(const NbnxmKernelType kernelType)
 };
 
 /*! \brief Returns the most suitable kernel type and Ewald handling */
-static NbnxmKernelSetup pick_nbnxn_kernel(const gmx::MDLogger&     mdlog,
-                                          gmx_bool                 use_simd_kernels,
-                                          const gmx_hw_info_t&     hardwareInfo,
-                                          const PairlistType       gpuPairlistType,
-                                          const NonbondedResource& nonbondedResource,
-                                          const t_inputrec&        inputrec)
+static NbnxmKernelSetup pick_nbnxn_kernel(const gmx::MDLogger&           mdlog,
+                                          gmx_bool                       use_simd_kernels,
+                                          const gmx_hw_info_t&           hardwareInfo,
+                                          std::optional<NbnxmKernelType> measuredCpuSimdKernelType,
+                                          const PairlistType             gpuPairlistType,
+                                          const NonbondedResource&       nonbondedResource,
+                                          const t_inputrec&              inputrec)
 {
     NbnxmKernelSetup kernelSetup;
 
@@ -314,7 +325,8 @@ static NbnxmKernelSetup pick_nbnxn_kernel(const gmx::MDLogger&     mdlog,
     }
     else
     {
-        kernelSetup = pickNbnxnKernelCpu(inputrec, hardwareInfo, use_simd_kernels, mdlog);
+        kernelSetup = pickNbnxnKernelCpu(
+                inputrec, hardwareInfo, measuredCpuSimdKernelType, use_simd_kernels, mdlog);
     }
 
     const int iClusterSize = (nonbondedResource == NonbondedResource::Cpu)
@@ -457,6 +469,7 @@ std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const gmx::MDLogger& mdlog,
                                                    const MpiComm&       mpiComm,
                                                    const gmx_domdec_t*  dd,
                                                    const gmx_hw_info_t& hardwareInfo,
+                                                   std::optional<NbnxmKernelType> measuredCpuSimdKernelType,
                                                    const bool           useGpuForNonbonded,
                                                    const bool           useGpuForNonbondedFE,
                                                    const gmx::DeviceStreamManager* deviceStreamManager,
@@ -490,8 +503,13 @@ std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const gmx::MDLogger& mdlog,
     // device. For now we just use the one layout we have.
     const auto gpuPairlistLayout = sc_layoutType;
 
-    NbnxmKernelSetup kernelSetup = pick_nbnxn_kernel(
-            mdlog, forcerec.use_simd_kernels, hardwareInfo, gpuPairlistLayout, nonbondedResource, inputrec);
+    NbnxmKernelSetup kernelSetup = pick_nbnxn_kernel(mdlog,
+                                                     forcerec.use_simd_kernels,
+                                                     hardwareInfo,
+                                                     measuredCpuSimdKernelType,
+                                                     gpuPairlistLayout,
+                                                     nonbondedResource,
+                                                     inputrec);
 
     const bool haveMultipleDomains = havePPDomainDecomposition(dd);
 
@@ -607,6 +625,19 @@ std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const gmx::MDLogger& mdlog,
     auto pairlistSets = std::make_unique<PairlistSets>(
             pairlistParams, haveMultipleDomains, minimumIlistCountForGpuBalancing, pinPolicy);
 
+    // Hilbert ordering of the local atoms requires decoupling of the local and NBNxM atom orders
+    const bool useHilbertColumnOrder =
+            (dd != nullptr && ddUsesHilbertOrder(*dd) && !localAtomOrderMatchesNbnxmOrder);
+    if (dd != nullptr && ddUsesHilbertOrder(*dd))
+    {
+        GMX_LOG(mdlog.info)
+                .appendText(useHilbertColumnOrder
+                                    ? "Ordering the home atoms with the search grid columns along "
+                                      "a Hilbert curve"
+                                    : "Hilbert ordering of the home atoms is not supported with "
+                                      "filler particles in the local state, using grid order");
+    }
+
     auto pairSearch = std::make_unique<PairSearch>(inputrec.pbcType,
                                                    EI_TPI(inputrec.eI),
                                                    (dd != nullptr) ? &dd->numCells : nullptr,
@@ -615,7 +646,8 @@ std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const gmx::MDLogger& mdlog,
                                                    bFEP_NonBonded,
                                                    localAtomOrderMatchesNbnxmOrder,
                                                    gmx_omp_nthreads_get(ModuleMultiThread::Pairsearch),
-                                                   pinPolicy);
+                                                   pinPolicy,
+                                                   useHilbertColumnOrder);
 
     std::unique_ptr<ExclusionChecker> exclusionChecker;
     if (inputrec.efep != FreeEnergyPerturbationType::No
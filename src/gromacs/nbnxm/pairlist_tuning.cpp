@@ -45,24 +45,32 @@
 #include "pairlist_tuning.h"
 
 #include <cassert>
+#include <cinttypes>
 #include <cmath>
 #include <cstdlib>
 
 #include <algorithm>
 #include <filesystem>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include "gromacs/domdec/domdec.h"
 #include "gromacs/math/functions.h"
 #include "gromacs/mdlib/calc_verletbuf.h"
+#include "gromacs/mdlib/forcerec.h"
+#include "gromacs/mdtypes/forcerec.h"
 #include "gromacs/mdtypes/inputrec.h"
 #include "gromacs/mdtypes/interaction_const.h"
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/multipletimestepping.h"
+#include "gromacs/mdtypes/simulation_workload.h"
 #include "gromacs/mdtypes/state.h"
+#include "gromacs/nbnxm/nbnxm.h"
 #include "gromacs/nbnxm/nbnxm_enums.h"
 #include "gromacs/nbnxm/pairlistparams.h"
 #include "gromacs/pbcutil/pbc.h"
+#include "gromacs/timing/wallcycle.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/cstringutil.h"
@@ -445,9 +453,37 @@ static real calcPruneVerletBufferSize(const CalcVerletBufferParameters& params,
                                 params.listSetup);
 }
 
+/*! \brief Returns the pressure tolerance left for the inner list given the outer list setup
+ *
+ * \param[in] inputrec              The input parameter record
+ * \param[in] mtop                  The global topology
+ * \param[in] effectiveAtomDensity  The effective atom density of the system
+ * \param[in] nstlist               The outer list update interval
+ * \param[in] rlistOuter            The outer list cut-off
+ * \param[in] listSetup             The nbnxn pair list setup
+ */
+static real innerListPressureTolerance(const t_inputrec&         inputrec,
+                                       const gmx_mtop_t&         mtop,
+                                       const real                effectiveAtomDensity,
+                                       const int                 nstlist,
+                                       const real                rlistOuter,
+                                       const VerletbufListSetup& listSetup)
+{
+    real pressureTolerance = getPressureTolerance(inputrec.verletBufferPressureTolerance);
+    if (pressureTolerance > 0)
+    {
+        // The tolerance for the inner list is the total minus the contribution from the outer list
+        pressureTolerance -= verletBufferPressureError(
+                mtop, effectiveAtomDensity, inputrec, nstlist, false, rlistOuter, listSetup);
+    }
+
+    return pressureTolerance;
+}
+
 /*! \brief Set the dynamic pairlist pruning parameters in \p ic
  *
  * \param[in]     inputrec          The input parameter record
+ * \param[in]     nstlist     The outer list update interval, can differ from inputrec.nstlist
  * \param[in]     mtop        The global topology
  * \param[in]     effectiveAtomDensity  The effective atom density of the system
  * \param[in]     useGpuList  Tells if we are using a GPU type pairlist
@@ -457,6 +493,7 @@ static real calcPruneVerletBufferSize(const CalcVerletBufferParameters& params,
  * \param[in,out] listParams  The list setup parameters
  */
 static void setDynamicPairlistPruningParameters(const t_inputrec&          inputrec,
+                                                const int                  nstlist,
                                                 const gmx_mtop_t&          mtop,
                                                 const real                 effectiveAtomDensity,
                                                 const bool                 useGpuList,
@@ -476,13 +513,8 @@ static void setDynamicPairlistPruningParameters(const t_inputrec&          input
      * do add up in practice, although not completely.
      */
 
-    real pressureTolerance = getPressureTolerance(inputrec.verletBufferPressureTolerance);
-    if (pressureTolerance > 0)
-    {
-        // The tolerance for the inner list is the total minus the contribution from the outer list
-        pressureTolerance -= verletBufferPressureError(
-                mtop, effectiveAtomDensity, inputrec, inputrec.nstlist, false, listParams->rlistOuter, listSetup);
-    }
+    const real pressureTolerance = innerListPressureTolerance(
+            inputrec, mtop, effectiveAtomDensity, nstlist, listParams->rlistOuter, listSetup);
 
     /* When applying multiple time stepping to the non-bonded forces,
      * we only compute them every mtsFactor steps, so all parameters here
@@ -492,10 +524,9 @@ static void setDynamicPairlistPruningParameters(const t_inputrec&          input
 
     const int mtsFactor = listParams->mtsFactor;
 
-    GMX_RELEASE_ASSERT(inputrec.nstlist % mtsFactor == 0,
-                       "nstlist should be a multiple of mtsFactor");
+    GMX_RELEASE_ASSERT(nstlist % mtsFactor == 0, "nstlist should be a multiple of mtsFactor");
 
-    listParams->lifetime = inputrec.nstlist - mtsFactor;
+    listParams->lifetime = nstlist - mtsFactor;
 
     /* We are now left with determining the following parameters of listParams:
      * - useDynamicPruning
@@ -536,7 +567,7 @@ static void setDynamicPairlistPruningParameters(const t_inputrec&          input
          * so keep nstlistPrune a multiple of the interval.
          */
         tunedNstlistPrune += (useGpuList ? c_nbnxnGpuRollingListPruningInterval : 1) * mtsFactor;
-    } while (tunedNstlistPrune < inputrec.nstlist && rlistInner == interactionCutoff);
+    } while (tunedNstlistPrune < nstlist && rlistInner == interactionCutoff);
 
     /* The current nstlistPrune in listParams is in most cases sub-optimal,
      * as it often just increases the buffer from zero to a (small) non-zero value.
@@ -548,9 +579,9 @@ static void setDynamicPairlistPruningParameters(const t_inputrec&          input
          * Thus here we decrease nstlistPrune to the lowest value that has the same number
          * of pruning events and therefore the same pruning cost.
          */
-        const int numPrunings = (inputrec.nstlist + nstlistPrune - 1) / nstlistPrune;
+        const int numPrunings = (nstlist + nstlistPrune - 1) / nstlistPrune;
         // Compute the lowest nstlistPrune that has numPrunings pruning steps
-        const int lowerNstlistPrune = (inputrec.nstlist + numPrunings - 1) / numPrunings;
+        const int lowerNstlistPrune = (nstlist + numPrunings - 1) / numPrunings;
         if (lowerNstlistPrune < nstlistPrune)
         {
             nstlistPrune = lowerNstlistPrune;
@@ -668,8 +699,15 @@ void setupDynamicPairlistPruning(const MDLogger&            mdlog,
                                                    : c_nbnxnCpuDynamicListPruningMinLifetime);
         }
 
-        setDynamicPairlistPruningParameters(
-                inputrec, mtop, effectiveAtomDensity, useGpuList, ls, userSetNstlistPrune, interactionConst, listParams);
+        setDynamicPairlistPruningParameters(inputrec,
+                                            inputrec.nstlist,
+                                            mtop,
+                                            effectiveAtomDensity,
+                                            useGpuList,
+                                            ls,
+                                            userSetNstlistPrune,
+                                            interactionConst,
+                                            listParams);
 
         if (listParams->useDynamicPruning && useGpuList)
         {
@@ -808,4 +846,438 @@ void printNbnxmPressureError(const MDLogger&       mdlog,
                                      pressureError));
 }
 
+bool pairlistTuningIsSupported(const t_inputrec& ir, const SimulationWorkload& simulationWork)
+{
+    return supportsDynamicPairlistGenerationInterval(ir) && simulationWork.useCpuNonbonded
+           && !simulationWork.useGpuNonbonded && !simulationWork.havePpDomainDecomposition
+           && !simulationWork.haveSeparatePmeRank
+           && std::getenv("GMX_NSTLIST_DYNAMICPRUNING") == nullptr;
+}
+
+std::vector<PairlistTuningCandidate> makePairlistTuningCandidates(const t_inputrec&          ir,
+                                                                  const gmx_mtop_t&          mtop,
+                                                                  const real effectiveAtomDensity,
+                                                                  const real maxCutoff2,
+                                                                  const interaction_const_t& ic,
+                                                                  const PairlistParams& initialParams,
+                                                                  const bool tunePruning)
+{
+    std::vector<PairlistTuningCandidate> candidates = { { ir.nstlist, initialParams } };
+
+    const int  mtsFactor         = nonbondedMtsFactor(ir);
+    const real rlistInc          = nbnxmPairlistVolumeRadiusIncrease(false, effectiveAtomDensity);
+    const real pressureTolerance = getPressureTolerance(ir.verletBufferPressureTolerance);
+
+    // The same list setups as used by increaseNstlist() and setupDynamicPairlistPruning()
+    const VerletbufListSetup outerListSetup =
+            verletbufGetSafeListSetup(ListSetupType::CpuSimdWhenSupported);
+    const VerletbufListSetup innerListSetup = { IClusterSizePerListType[initialParams.pairlistType],
+                                                JClusterSizePerListType[initialParams.pairlistType] };
+
+    std::vector<int> nstlistValues = { nbnxnReferenceNstlist };
+    nstlistValues.insert(nstlistValues.end(), std::begin(nstlist_try), std::end(nstlist_try));
+    for (const int nstlistValue : nstlistValues)
+    {
+        const int nstlist = nstlistValue * mtsFactor;
+        if (nstlist == ir.nstlist)
+        {
+            continue;
+        }
+
+        PairlistTuningCandidate candidate = { nstlist, initialParams };
+
+        /* We use half the pressure tolerance to have margin for the inner pair list,
+         * as increaseNstlist() does.
+         */
+        candidate.params.rlistOuter = calcVerletBufferSize(
+                mtop, effectiveAtomDensity, ir, 0.5 * pressureTolerance, nstlist, nstlist - mtsFactor, -1, outerListSetup);
+        if (square(candidate.params.rlistOuter) >= maxCutoff2)
+        {
+            // The list buffer only increases with nstlist
+            break;
+        }
+
+        candidate.params.lifetime          = nstlist - mtsFactor;
+        candidate.params.useDynamicPruning = false;
+        candidate.params.nstlistPrune      = -1;
+        candidate.params.rlistInner        = candidate.params.rlistOuter;
+        if (!tunePruning)
+        {
+            candidates.push_back(candidate);
+            continue;
+        }
+
+        candidate.params.nstlistPrune = c_nbnxnCpuDynamicListPruningMinLifetime;
+        setDynamicPairlistPruningParameters(
+                ir, nstlist, mtop, effectiveAtomDensity, false, innerListSetup, false, ic, &candidate.params);
+        candidates.push_back(candidate);
+
+        if (candidate.params.useDynamicPruning)
+        {
+            /* The heuristic pruning interval minimizes the inner list size.
+             * Also try pruning once less per outer list lifetime, which trades
+             * a larger inner list for less pruning work.
+             */
+            const int numPrunings = divideRoundUp(nstlist, candidate.params.nstlistPrune);
+            if (numPrunings > 1)
+            {
+                const int nstlistPrune =
+                        divideRoundUp(divideRoundUp(nstlist, numPrunings - 1), mtsFactor) * mtsFactor;
+                CalcVerletBufferParameters calcBufferParams(
+                        { mtop,
+                          effectiveAtomDensity,
+                          ir,
+                          innerListPressureTolerance(
+                                  ir, mtop, effectiveAtomDensity, nstlist, candidate.params.rlistOuter, innerListSetup),
+                          innerListSetup,
+                          false,
+                          mtsFactor });
+                const real rlistInner = calcPruneVerletBufferSize(calcBufferParams, nstlistPrune);
+                if (rlistInner + rlistInc < 0.99 * (candidate.params.rlistOuter + rlistInc)
+                    && nstlistPrune < candidate.params.lifetime)
+                {
+                    candidate.params.nstlistPrune = nstlistPrune;
+                    candidate.params.rlistInner   = rlistInner;
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+    }
+
+    return candidates;
+}
+
+PairlistTuningSelector::PairlistTuningSelector(const int numCandidates, const int initialNstlist) :
+    initialNstlist_(initialNstlist), isActive_(numCandidates > 1), measurements_(numCandidates)
+{
+    GMX_RELEASE_ASSERT(numCandidates > 0, "We need at least the initial setup");
+}
+
+void PairlistTuningSelector::switchCandidate(const int index)
+{
+    currentCandidate_ = index;
+
+    // The first interval after a switch is irregular and includes allocation overhead
+    skipNextInterval_ = true;
+}
+
+bool PairlistTuningSelector::addCycles(const double cycles, const int64_t step, const int64_t step_rel)
+{
+    if (!isActive_)
+    {
+        return false;
+    }
+
+    const double  intervalCycles = cycles - cyclesPrevious_;
+    const int64_t intervalSteps  = step - stepPrevious_;
+    // The cycle counters can be reset during the run, in which case we skip the interval
+    const bool haveValidInterval = (stepPrevious_ >= 0 && intervalCycles >= 0 && intervalSteps > 0);
+
+    cyclesPrevious_ = cycles;
+    stepPrevious_   = step;
+
+    if (!haveValidInterval || step_rel < sc_numWarmupIntervals * initialNstlist_)
+    {
+        measurementCycles_ = 0;
+        measurementSteps_  = 0;
+
+        return false;
+    }
+    if (skipNextInterval_)
+    {
+        skipNextInterval_ = false;
+
+        return false;
+    }
+
+    measurementCycles_ += intervalCycles;
+    measurementSteps_ += intervalSteps;
+    if (measurementSteps_ < sc_minNumStepsPerMeasurement)
+    {
+        return false;
+    }
+
+    Measurements& current       = measurements_[currentCandidate_];
+    const double  cyclesPerStep = measurementCycles_ / measurementSteps_;
+    current.cyclesPerStep =
+            (current.numMeasurements == 0 ? cyclesPerStep : std::min(current.cyclesPerStep, cyclesPerStep));
+    current.numMeasurements++;
+    measurementCycles_ = 0;
+    measurementSteps_  = 0;
+
+    if (current.numMeasurements < sc_numMeasurementsPerCandidate)
+    {
+        return false;
+    }
+
+    if (currentCandidate_ + 1 < gmx::ssize(measurements_))
+    {
+        switchCandidate(currentCandidate_ + 1);
+
+        return true;
+    }
+
+    // All candidates have been measured, lock in the fastest
+    int fastest = 0;
+    for (int i = 1; i < gmx::ssize(measurements_); i++)
+    {
+        if (measurements_[i].cyclesPerStep < measurements_[fastest].cyclesPerStep)
+        {
+            fastest = i;
+        }
+    }
+    if (measurements_[fastest].cyclesPerStep
+        > (1 - sc_minRelativeImprovement) * measurements_[0].cyclesPerStep)
+    {
+        fastest = 0;
+    }
+    switchCandidate(fastest);
+    isActive_ = false;
+
+    return true;
+}
+
+/*! \brief Implementation of PairlistTuning */
+class PairlistTuning::Impl
+{
+public:
+    //! Constructor, see PairlistTuning
+    Impl(const MDLogger&            mdlog,
+         const t_inputrec&          ir,
+         const gmx_mtop_t&          mtop,
+         const matrix               box,
+         ArrayRef<const RVec>       x,
+         const interaction_const_t& ic,
+         const nonbonded_verlet_t&  nbv);
+
+    //! Returns whether the tuning is still in progress
+    bool isActive() const { return selector_.isActive(); }
+
+    //! Returns the pairlist update interval to use
+    int nstlist() const { return candidates_[selector_.currentCandidate()].nstlist; }
+
+    //! Process the cycles, see PairlistTuning
+    void addCycles(FILE* fp_err, t_forcerec* fr, const gmx_wallcycle* wcycle, int64_t step, int64_t step_rel);
+
+    //! Print the tuning results to the mdlogger
+    void printSettings() const;
+
+private:
+    //! Switches the simulation to the current candidate of the selector
+    void applyCurrentCandidate(t_forcerec* fr);
+
+    //! The MD logger
+    const MDLogger& mdlog_;
+    //! The input parameter record
+    const t_inputrec& ir_;
+    //! The candidate setups, the first is the initial setup
+    std::vector<PairlistTuningCandidate> candidates_;
+    //! Selects the candidate to use from the timings
+    PairlistTuningSelector selector_;
+};
+
+//! Returns the candidate setups for \p nbv, only the initial setup without cycle counters
+static std::vector<PairlistTuningCandidate> makeCandidates(const MDLogger&            mdlog,
+                                                           const t_inputrec&          ir,
+                                                           const gmx_mtop_t&          mtop,
+                                                           const matrix               box,
+                                                           ArrayRef<const RVec>       x,
+                                                           const interaction_const_t& ic,
+                                                           const nonbonded_verlet_t&  nbv)
+{
+    const PairlistParams& initialParams = nbv.pairlistSets().params();
+
+    if (!wallcycle_have_counter())
+    {
+        GMX_LOG(mdlog.warning)
+                .asParagraph()
+                .appendText(
+                        "NOTE: Cycle counters unsupported or not enabled in kernel. Cannot tune "
+                        "the pair-list setup.");
+
+        return { { ir.nstlist, initialParams } };
+    }
+
+    const real interactionCutoff = std::max(ic.coulomb.cutoff, ic.vdw.cutoff);
+    const real effectiveAtomDensity =
+            computeEffectiveAtomDensity(x, box, interactionCutoff, MPI_COMM_NULL);
+    const bool tunePruning = (nbv.kernelSetup().kernelType != NbnxmKernelType::Cpu1x1_PlainC
+                              && std::getenv("GMX_DISABLE_DYNAMICPRUNING") == nullptr);
+
+    return makePairlistTuningCandidates(
+            ir, mtop, effectiveAtomDensity, max_cutoff2(ir.pbcType, box), ic, initialParams, tunePruning);
+}
+
+PairlistTuning::Impl::Impl(const MDLogger&            mdlog,
+                           const t_inputrec&          ir,
+                           const gmx_mtop_t&          mtop,
+                           const matrix               box,
+                           ArrayRef<const RVec>       x,
+                           const interaction_const_t& ic,
+                           const nonbonded_verlet_t&  nbv) :
+    mdlog_(mdlog),
+    ir_(ir),
+    candidates_(makeCandidates(mdlog, ir, mtop, box, x, ic, nbv)),
+    selector_(gmx::ssize(candidates_), ir.nstlist)
+{
+    if (selector_.isActive())
+    {
+        GMX_LOG(mdlog.info)
+                .asParagraph()
+                .appendTextFormatted(
+                        "Will tune the pair-list setup using %zu candidate setups with nstlist "
+                        "between %d and %d",
+                        candidates_.size(),
+                        std::min_element(candidates_.begin(),
+                                         candidates_.end(),
+                                         [](const auto& a, const auto& b) { return a.nstlist < b.nstlist; })
+                                ->nstlist,
+                        std::max_element(candidates_.begin(),
+                                         candidates_.end(),
+                                         [](const auto& a, const auto& b) { return a.nstlist < b.nstlist; })
+                                ->nstlist);
+    }
+}
+
+void PairlistTuning::Impl::applyCurrentCandidate(t_forcerec* fr)
+{
+    const PairlistParams& params = candidates_[selector_.currentCandidate()].params;
+
+    fr->nbv->changePairlistParams(params);
+    /* Update deprecated rlist in forcerec to stay in sync with fr->nbv */
+    fr->rlist = params.rlistOuter;
+    /* We always re-initialize the tables whether they are used or not */
+    init_interaction_const_tables(nullptr, fr->ic.get(), params.rlistOuter, ir_.tabext);
+}
+
+void PairlistTuning::Impl::addCycles(FILE*                fp_err,
+                                     t_forcerec*          fr,
+                                     const gmx_wallcycle* wcycle,
+                                     const int64_t        step,
+                                     const int64_t        step_rel)
+{
+    if (!selector_.isActive())
+    {
+        return;
+    }
+
+    /* Only the search and the force computation depend on the pairlist setup,
+     * so we ignore the cost of all other parts of the step.
+     */
+    double cycles = 0;
+    for (const WallCycleCounter counter : { WallCycleCounter::NS, WallCycleCounter::Force })
+    {
+        int    numCalls      = 0;
+        double counterCycles = 0;
+        wallcycle_get(wcycle, counter, &numCalls, &counterCycles);
+        cycles += counterCycles;
+    }
+
+    const int  previousCandidate  = selector_.currentCandidate();
+    const int  numMeasurementsOld = selector_.numMeasurements(previousCandidate);
+    const bool candidateChanged   = selector_.addCycles(cycles, step, step_rel);
+
+    if (debug && selector_.numMeasurements(previousCandidate) > numMeasurementsOld)
+    {
+        const PairlistTuningCandidate& candidate = candidates_[previousCandidate];
+        fprintf(debug,
+                "step %" PRId64 ": pairlist tuning nstlist %d rlist %.3f %.3f nstlistPrune %d: %.3f Mcycles/step\n",
+                step,
+                candidate.nstlist,
+                candidate.params.rlistOuter,
+                candidate.params.rlistInner,
+                candidate.params.nstlistPrune,
+                selector_.cyclesPerStep(previousCandidate) * 1e-6);
+    }
+
+    if (!candidateChanged)
+    {
+        return;
+    }
+
+    applyCurrentCandidate(fr);
+
+    if (!selector_.isActive() && fp_err != nullptr)
+    {
+        const PairlistTuningCandidate& selected = candidates_[selector_.currentCandidate()];
+        fprintf(fp_err,
+                "\rstep %" PRId64 ": pair-list tuning selected nstlist %d, rlist %.3f nm\n",
+                step,
+                selected.nstlist,
+                selected.params.rlistOuter);
+    }
+}
+
+void PairlistTuning::Impl::printSettings() const
+{
+    if (candidates_.size() <= 1)
+    {
+        return;
+    }
+
+    std::string mesg = "Pair-list setup tuning results:\n";
+    mesg += "  nstlist  rlist outer  rlist inner  nstlistPrune  relative cost\n";
+    for (int i = 0; i < gmx::ssize(candidates_); i++)
+    {
+        const PairlistTuningCandidate& candidate = candidates_[i];
+        mesg += formatString("  %7d  %11.3f  %11.3f  %12d",
+                             candidate.nstlist,
+                             candidate.params.rlistOuter,
+                             candidate.params.rlistInner,
+                             candidate.params.useDynamicPruning ? candidate.params.nstlistPrune : 0);
+        if (selector_.numMeasurements(i) > 0 && selector_.numMeasurements(0) > 0)
+        {
+            mesg += formatString("  %13.3f", selector_.cyclesPerStep(i) / selector_.cyclesPerStep(0));
+        }
+        else
+        {
+            mesg += "      not timed";
+        }
+        mesg += (i == selector_.currentCandidate() ? "  <- used\n" : "\n");
+    }
+    if (selector_.isActive())
+    {
+        mesg += "NOTE: The run ended before the pair-list tuning completed";
+    }
+
+    GMX_LOG(mdlog_.info).asParagraph().appendText(mesg);
+}
+
+PairlistTuning::PairlistTuning(const MDLogger&            mdlog,
+                               const t_inputrec&          ir,
+                               const gmx_mtop_t&          mtop,
+                               const matrix               box,
+                               ArrayRef<const RVec>       x,
+                               const interaction_const_t& ic,
+                               const nonbonded_verlet_t&  nbv) :
+    impl_(std::make_unique<Impl>(mdlog, ir, mtop, box, x, ic, nbv))
+{
+}
+
+PairlistTuning::~PairlistTuning() = default;
+
+bool PairlistTuning::isActive() const
+{
+    return impl_->isActive();
+}
+
+int PairlistTuning::nstlist() const
+{
+    return impl_->nstlist();
+}
+
+void PairlistTuning::addCycles(FILE*                fp_err,
+                               t_forcerec*          fr,
+                               const gmx_wallcycle* wcycle,
+                               const int64_t        step,
+                               const int64_t        step_rel)
+{
+    impl_->addCycles(fp_err, fr, wcycle, step, step_rel);
+}
+
+void PairlistTuning::printSettings() const
+{
+    impl_->printSettings();
+}
+
 } // namespace gmx
@@ -45,20 +45,30 @@
 #ifndef NBNXM_PAIRLIST_TUNING_H
 #define NBNXM_PAIRLIST_TUNING_H
 
+#include <cstdint>
 #include <cstdio>
 
+#include <memory>
+#include <vector>
+
+#include "gromacs/nbnxm/pairlistparams.h"
 #include "gromacs/utility/real.h"
 #include "gromacs/utility/vectypes.h"
 
 struct gmx_mtop_t;
+struct gmx_wallcycle;
 struct interaction_const_t;
+struct t_forcerec;
 struct t_inputrec;
 
 namespace gmx
 {
-struct PairlistParams;
+struct nonbonded_verlet_t;
+template<typename T>
+class ArrayRef;
 class MDLogger;
 class MpiComm;
+class SimulationWorkload;
 
 /*! \brief Try to increase nstlist when using the Verlet cut-off scheme
  *
@@ -115,6 +125,200 @@ void printNbnxmPressureError(const MDLogger&       mdlog,
                              real                  effectiveAtomDensity,
                              const PairlistParams& listParams);
 
+/*! \brief Returns whether run-time tuning of the pairlist setup is supported
+ *
+ * Tuning is only supported with CPU non-bonded kernels on a single PP rank
+ * without separate PME ranks, so the cost of the search and the non-bonded
+ * kernels can be measured directly and PME load balancing never changes
+ * the pairlist setup. Tuning is also not supported when the user fixed
+ * the dynamic pruning interval.
+ *
+ * \param[in] ir              The input parameter record
+ * \param[in] simulationWork  The simulation workload
+ */
+bool pairlistTuningIsSupported(const t_inputrec& ir, const SimulationWorkload& simulationWork);
+
+//! A pairlist setup that is a candidate for run-time tuning
+struct PairlistTuningCandidate
+{
+    //! The outer list update interval
+    int nstlist;
+    //! The pairlist buffer and pruning parameters
+    PairlistParams params;
+};
+
+/*! \brief Returns the pairlist setups to try during run-time tuning
+ *
+ * The first candidate is the initial setup. The other candidates use
+ * increasing values of nstlist, with buffers set by the Verlet buffer
+ * tolerance. Candidates with an outer list cut-off that does not fit
+ * in the unit cell are not returned.
+ *
+ * \param[in] ir                    The input parameter record
+ * \param[in] mtop                  The global topology
+ * \param[in] effectiveAtomDensity  The effective atom density of the system
+ * \param[in] maxCutoff2            The square of the maximum cut-off allowed by the unit cell
+ * \param[in] ic                    The nonbonded interactions constants
+ * \param[in] initialParams         The initial pairlist setup
+ * \param[in] tunePruning           Whether to also tune the dynamic pruning setup
+ */
+std::vector<PairlistTuningCandidate> makePairlistTuningCandidates(const t_inputrec&          ir,
+                                                                  const gmx_mtop_t&          mtop,
+                                                                  real effectiveAtomDensity,
+                                                                  real maxCutoff2,
+                                                                  const interaction_const_t& ic,
+                                                                  const PairlistParams& initialParams,
+                                                                  bool tunePruning);
+
+/*! \brief Selects the fastest pairlist setup from timings
+ *
+ * Skips a few initial list lifetimes to let the run settle, then
+ * measures the cost per step of each candidate in turn and finally
+ * picks the fastest. The initial setup, candidate 0, is kept unless
+ * another candidate is faster by a relative margin, to avoid switching
+ * based on timing noise. This class only does the bookkeeping, so it
+ * can be used without a running simulation.
+ */
+class PairlistTuningSelector
+{
+public:
+    /*! \brief Constructor
+     *
+     * \param[in] numCandidates   The number of candidate setups, including the initial one
+     * \param[in] initialNstlist  The pairlist update interval of the initial setup
+     */
+    PairlistTuningSelector(int numCandidates, int initialNstlist);
+
+    //! Returns whether the selection is still in progress
+    bool isActive() const { return isActive_; }
+
+    //! Returns the index of the candidate currently in use
+    int currentCandidate() const { return currentCandidate_; }
+
+    //! Returns the number of cost measurements of candidate \p index
+    int numMeasurements(int index) const { return measurements_[index].numMeasurements; }
+
+    //! Returns the lowest measured cost, in cycles per step, of candidate \p index
+    double cyclesPerStep(int index) const { return measurements_[index].cyclesPerStep; }
+
+    /*! \brief Adds the cycle count at a search step
+     *
+     * \param[in] cycles    The total cycles spent in the setup dependent parts of the step
+     * \param[in] step      The current step
+     * \param[in] step_rel  The number of steps since the start of the run
+     * \returns whether the current candidate changed
+     */
+    bool addCycles(double cycles, int64_t step, int64_t step_rel);
+
+    //! The number of initial list intervals to skip before we start measuring
+    static constexpr int sc_numWarmupIntervals = 5;
+    //! The minimum number of steps that make up a single cost measurement
+    static constexpr int sc_minNumStepsPerMeasurement = 100;
+    //! The number of measurements per candidate, we use the minimum cost
+    static constexpr int sc_numMeasurementsPerCandidate = 2;
+    //! The relative cost reduction required to move away from the initial setup
+    static constexpr double sc_minRelativeImprovement = 0.02;
+
+private:
+    //! The timing results for a candidate
+    struct Measurements
+    {
+        //! The number of cost measurements
+        int numMeasurements = 0;
+        //! The lowest measured cost, in cycles per step
+        double cyclesPerStep = 0;
+    };
+
+    //! Switches to candidate \p index
+    void switchCandidate(int index);
+
+    //! The pairlist update interval of the initial setup, sets the warmup period
+    int initialNstlist_;
+    //! Whether we are still selecting
+    bool isActive_;
+    //! The measurement results for each candidate
+    std::vector<Measurements> measurements_;
+    //! The index of the candidate currently in use
+    int currentCandidate_ = 0;
+    //! Whether to skip the next interval, because we just changed setup
+    bool skipNextInterval_ = false;
+    //! The cycle count at the previous call
+    double cyclesPrevious_ = 0;
+    //! The step of the previous call, -1 when not set
+    int64_t stepPrevious_ = -1;
+    //! The cycles accumulated for the current measurement
+    double measurementCycles_ = 0;
+    //! The number of steps accumulated for the current measurement
+    int64_t measurementSteps_ = 0;
+};
+
+/*! \brief Object to manage run-time tuning of the pairlist setup
+ *
+ * The pairlist update interval nstlist, and with it the outer list buffer,
+ * together with the inner list buffer and dynamic pruning interval, set
+ * the balance between the cost of the pair search and the cost of
+ * the non-bonded and pruning kernels. The heuristics in increaseNstlist()
+ * and setupDynamicPairlistPruning() are a good default, but the optimum
+ * depends on the hardware. This object tries a set of candidate setups
+ * during the first few thousand steps, measures the cost of the search
+ * and the force computation for each and then locks in the fastest.
+ * All candidate buffers are determined from the Verlet buffer tolerance,
+ * so every candidate obeys the energy drift and pressure error tolerances.
+ */
+class PairlistTuning
+{
+public:
+    /*! \brief Constructor, sets up the candidate pairlist setups
+     *
+     * \note This constructor should only be called when \c pairlistTuningIsSupported() returns true.
+     *
+     * \param[in] mdlog  MD logger
+     * \param[in] ir     The input parameter record
+     * \param[in] mtop   The global topology
+     * \param[in] box    The unit cell
+     * \param[in] x      The coordinates of all atoms
+     * \param[in] ic     The nonbonded interactions constants
+     * \param[in] nbv    The nonbonded setup, provides the initial pairlist setup
+     */
+    PairlistTuning(const MDLogger&            mdlog,
+                   const t_inputrec&          ir,
+                   const gmx_mtop_t&          mtop,
+                   const matrix               box,
+                   ArrayRef<const RVec>       x,
+                   const interaction_const_t& ic,
+                   const nonbonded_verlet_t&  nbv);
+
+    ~PairlistTuning();
+
+    PairlistTuning(const PairlistTuning&)            = delete;
+    PairlistTuning& operator=(const PairlistTuning&) = delete;
+    PairlistTuning(PairlistTuning&&)                 = delete;
+    PairlistTuning& operator=(PairlistTuning&&)      = delete;
+
+    //! Returns whether the tuning is still in progress
+    bool isActive() const;
+
+    //! Returns the pairlist update interval to use
+    int nstlist() const;
+
+    /*! \brief Process the cycles of the last list lifetime and switch setup when needed
+     *
+     * Should be called at search steps, before the WallCycleCounter::Step counter
+     * is started. The pair-list update interval can change, so the caller
+     * should query nstlist() after this call.
+     */
+    void addCycles(FILE* fp_err, t_forcerec* fr, const gmx_wallcycle* wcycle, int64_t step, int64_t step_rel);
+
+    //! Print the tuning results to the mdlogger
+    void printSettings() const;
+
+private:
+    //! Implementation type
+    class Impl;
+    //! Implementation object
+    std::unique_ptr<Impl> impl_;
+};
+
 } // namespace gmx
 
 #endif /* NBNXM_PAIRLIST_TUNING_H */
@@ -123,6 +123,20 @@ public:
         params_.rlistInner = rlistInner;
     }
 
+    /*! \brief Changes the pair-list buffer and pruning parameters
+     *
+     * Should only be called right before a search step.
+     */
+    void changePairlistParams(const PairlistParams& params)
+    {
+        GMX_RELEASE_ASSERT(params.pairlistType == params_.pairlistType,
+                           "The pairlist type can not be changed");
+        GMX_RELEASE_ASSERT(params.mtsFactor == params_.mtsFactor,
+                           "The MTS factor can not be changed");
+
+        params_ = params;
+    }
+
     //! Returns the pair-list set for the given locality
     const PairlistSet& pairlistSet(InteractionLocality iLocality) const
     {
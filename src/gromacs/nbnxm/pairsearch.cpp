@@ -98,7 +98,8 @@ PairSearch::PairSearch(const PbcType      pbcType,
                        const bool         haveFep,
                        const bool         localAtomOrderMatchesNbnxmOrder,
                        const int          maxNumThreads,
-                       PinningPolicy      pinningPolicy) :
+                       PinningPolicy      pinningPolicy,
+                       const bool         useHilbertColumnOrder) :
     gridSet_(pbcType,
              doTestParticleInsertion,
              numDDCells,
@@ -107,7 +108,8 @@ PairSearch::PairSearch(const PbcType      pbcType,
              haveFep,
              localAtomOrderMatchesNbnxmOrder,
              maxNumThreads,
-             pinningPolicy),
+             pinningPolicy,
+             useHilbertColumnOrder),
     work_(maxNumThreads)
 {
     cycleCounting_.recordCycles_ = (std::getenv("GMX_NBNXN_CYCLE") != nullptr);
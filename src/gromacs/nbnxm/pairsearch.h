@@ -233,6 +233,7 @@ public:
      * \param[in] localAtomOrderMatchesNbnxmOrder  Whether the local atom order should match the NBNxM order
      * \param[in] maxNumThreads            The maximum number of threads used in the search
      * \param[in] pinningPolicy            Sets the pinning policy for all buffers used on the GPU
+     * \param[in] useHilbertColumnOrder    Whether to order the local atoms with the grid columns along a Hilbert curve
      */
     PairSearch(PbcType            pbcType,
                bool               doTestParticleInsertion,
@@ -242,7 +243,8 @@ public:
                bool               haveFep,
                bool               localAtomOrderMatchesNbnxmOrder,
                int                maxNumThreads,
-               PinningPolicy      pinningPolicy);
+               PinningPolicy      pinningPolicy,
+               bool               useHilbertColumnOrder = false);
 
     //! Sets the order of the local atoms to the order grid atom ordering
     void setLocalAtomOrder() { gridSet_.setLocalAtomOrder(); }
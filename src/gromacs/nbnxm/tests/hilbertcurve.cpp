@@ -0,0 +1,137 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the Hilbert curve ordering of grid columns
+ *
+ * \ingroup module_nbnxm
+ */
+#include "gmxpre.h"
+
+#include "gromacs/nbnxm/hilbertcurve.h"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Returns the position of each column in \p columnOrder
+std::vector<int> columnPositions(const std::vector<int>& columnOrder)
+{
+    std::vector<int> positions(columnOrder.size(), -1);
+    for (size_t i = 0; i < columnOrder.size(); i++)
+    {
+        positions[columnOrder[i]] = i;
+    }
+    return positions;
+}
+
+TEST(HilbertCurve, VisitsAllColumnsOnce)
+{
+    const int numColumnsX = 5;
+    const int numColumnsY = 3;
+
+    std::vector<int> columnOrder = hilbertColumnOrder(numColumnsX, numColumnsY);
+
+    ASSERT_EQ(columnOrder.size(), size_t(numColumnsX * numColumnsY));
+    std::sort(columnOrder.begin(), columnOrder.end());
+    for (int c = 0; c < numColumnsX * numColumnsY; c++)
+    {
+        EXPECT_EQ(columnOrder[c], c);
+    }
+}
+
+TEST(HilbertCurve, StepsBetweenNeighborsOnPowerOf2Grid)
+{
+    const int numColumns = 8;
+
+    const std::vector<int> columnOrder = hilbertColumnOrder(numColumns, numColumns);
+
+    for (size_t i = 1; i < columnOrder.size(); i++)
+    {
+        const int c0 = columnOrder[i - 1];
+        const int c1 = columnOrder[i];
+        const int distance =
+                std::abs(c0 / numColumns - c1 / numColumns) + std::abs(c0 % numColumns - c1 % numColumns);
+        EXPECT_EQ(distance, 1) << "Columns " << c0 << " and " << c1 << " are not neighbors";
+    }
+}
+
+TEST(HilbertCurve, KeepsMoreNeighborColumnsCloseThanRowMajorOrder)
+{
+    const int numColumns = 20;
+    // The number of consecutive columns that we consider close in memory
+    const int window = 8;
+
+    const std::vector<int> positions = columnPositions(hilbertColumnOrder(numColumns, numColumns));
+
+    int numPairs         = 0;
+    int numCloseHilbert  = 0;
+    int numCloseRowMajor = 0;
+    for (int cx = 0; cx < numColumns; cx++)
+    {
+        for (int cy = 0; cy < numColumns; cy++)
+        {
+            const int c = cx * numColumns + cy;
+            for (const int neighbor : { c + numColumns, c + 1 })
+            {
+                if ((neighbor == c + numColumns && cx + 1 == numColumns)
+                    || (neighbor == c + 1 && cy + 1 == numColumns))
+                {
+                    continue;
+                }
+                numPairs++;
+                numCloseHilbert += (std::abs(positions[c] - positions[neighbor]) < window);
+                numCloseRowMajor += (neighbor - c < window);
+            }
+        }
+    }
+
+    // Row-major order only keeps the neighbors along y close, the Hilbert curve about 80%
+    EXPECT_EQ(2 * numCloseRowMajor, numPairs);
+    EXPECT_GT(numCloseHilbert, 0.7 * numPairs);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -0,0 +1,366 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright 2026- The GROMACS Authors
+ * and the project initiators Erik Lindahl, Berk Hess and David van der Spoel.
+ * Consult the AUTHORS/COPYING files and https://www.gromacs.org for details.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * https://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at https://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out https://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the run-time tuning of the pairlist setup.
+ *
+ * \ingroup module_nbnxm
+ */
+#include "gmxpre.h"
+
+#include "gromacs/nbnxm/pairlist_tuning.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/math/functions.h"
+#include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/mdtypes/interaction_const.h"
+#include "gromacs/mdtypes/md_enums.h"
+#include "gromacs/nbnxm/nbnxm_enums.h"
+#include "gromacs/nbnxm/pairlistparams.h"
+#include "gromacs/topology/atoms.h"
+#include "gromacs/topology/forcefieldparameters.h"
+#include "gromacs/topology/ifunc.h"
+#include "gromacs/topology/topology.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/smalloc.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+
+namespace test
+{
+
+namespace
+{
+
+/*! \brief Feeds \p selector with cycle counts until it is done, returns the number of calls
+ *
+ * Search steps are \p nstlist steps apart and each step of candidate \p i
+ * costs \p costPerStep[i] cycles.
+ */
+int runSelector(PairlistTuningSelector* selector, const int nstlist, ArrayRef<const double> costPerStep)
+{
+    double  cycles   = 0;
+    int64_t step     = 0;
+    int     numCalls = 0;
+    while (selector->isActive())
+    {
+        selector->addCycles(cycles, step, step);
+        numCalls++;
+        cycles += costPerStep[selector->currentCandidate()] * nstlist;
+        step += nstlist;
+        GMX_RELEASE_ASSERT(numCalls < 10000, "The selection should end");
+    }
+
+    return numCalls;
+}
+
+TEST(PairlistTuningSelectorTest, SingleCandidateIsNotActive)
+{
+    PairlistTuningSelector selector(1, 10);
+
+    EXPECT_FALSE(selector.isActive());
+    EXPECT_FALSE(selector.addCycles(1000, 100, 100));
+    EXPECT_EQ(selector.currentCandidate(), 0);
+}
+
+TEST(PairlistTuningSelectorTest, NoMeasurementsDuringWarmup)
+{
+    const int              nstlist = 10;
+    PairlistTuningSelector selector(2, nstlist);
+
+    for (int64_t step = 0; step < PairlistTuningSelector::sc_numWarmupIntervals * nstlist; step += nstlist)
+    {
+        EXPECT_FALSE(selector.addCycles(step * 1000.0, step, step));
+    }
+    EXPECT_TRUE(selector.isActive());
+    EXPECT_EQ(selector.currentCandidate(), 0);
+    EXPECT_EQ(selector.numMeasurements(0), 0);
+}
+
+TEST(PairlistTuningSelectorTest, MeasuresEachCandidateInTurn)
+{
+    const int              nstlist = 10;
+    PairlistTuningSelector selector(3, nstlist);
+
+    double  cycles           = 0;
+    int     highestCandidate = 0;
+    int64_t step             = 0;
+    while (selector.isActive())
+    {
+        const int  previousCandidate = selector.currentCandidate();
+        const bool changed           = selector.addCycles(cycles, step, step);
+        // Candidates are tried in order, the final switch picks one of them
+        if (changed && selector.isActive())
+        {
+            EXPECT_EQ(selector.currentCandidate(), previousCandidate + 1);
+            EXPECT_EQ(selector.numMeasurements(previousCandidate),
+                      PairlistTuningSelector::sc_numMeasurementsPerCandidate);
+        }
+        highestCandidate = std::max(highestCandidate, selector.currentCandidate());
+        cycles += 1000.0 * nstlist;
+        step += nstlist;
+    }
+    EXPECT_EQ(highestCandidate, 2);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(selector.numMeasurements(i), PairlistTuningSelector::sc_numMeasurementsPerCandidate);
+        EXPECT_DOUBLE_EQ(selector.cyclesPerStep(i), 1000.0);
+    }
+}
+
+TEST(PairlistTuningSelectorTest, SelectsFastestCandidate)
+{
+    PairlistTuningSelector    selector(4, 10);
+    const std::vector<double> costPerStep = { 1000, 900, 700, 800 };
+
+    runSelector(&selector, 10, costPerStep);
+
+    EXPECT_EQ(selector.currentCandidate(), 2);
+    EXPECT_DOUBLE_EQ(selector.cyclesPerStep(2), 700);
+}
+
+TEST(PairlistTuningSelectorTest, KeepsInitialSetupWhenGainIsSmall)
+{
+    PairlistTuningSelector    selector(3, 10);
+    const double              gain        = 0.5 * PairlistTuningSelector::sc_minRelativeImprovement;
+    const std::vector<double> costPerStep = { 1000, 1000 * (1 - gain), 1100 };
+
+    runSelector(&selector, 10, costPerStep);
+
+    EXPECT_EQ(selector.currentCandidate(), 0);
+}
+
+TEST(PairlistTuningSelectorTest, SwitchesWhenGainIsLargeEnough)
+{
+    PairlistTuningSelector    selector(3, 10);
+    const double              gain        = 2 * PairlistTuningSelector::sc_minRelativeImprovement;
+    const std::vector<double> costPerStep = { 1000, 1000 * (1 - gain), 1100 };
+
+    runSelector(&selector, 10, costPerStep);
+
+    EXPECT_EQ(selector.currentCandidate(), 1);
+}
+
+TEST(PairlistTuningSelectorTest, SkipsIntervalAfterCounterReset)
+{
+    const int              nstlist = 10;
+    PairlistTuningSelector selector(2, nstlist);
+
+    double  cycles      = 0;
+    int64_t step        = 0;
+    auto    addInterval = [&]()
+    {
+        selector.addCycles(cycles, step, step);
+        cycles += 1000.0 * nstlist;
+        step += nstlist;
+    };
+    const int numIntervalsPerMeasurement = PairlistTuningSelector::sc_minNumStepsPerMeasurement / nstlist;
+
+    while (step < PairlistTuningSelector::sc_numWarmupIntervals * nstlist)
+    {
+        addInterval();
+    }
+    // Accumulate almost a full measurement, then reset the cycle counters
+    for (int i = 0; i < numIntervalsPerMeasurement - 1; i++)
+    {
+        addInterval();
+    }
+    cycles = 0;
+    addInterval();
+    EXPECT_EQ(selector.numMeasurements(0), 0);
+
+    // The reset also discarded the partial measurement
+    for (int i = 0; i < numIntervalsPerMeasurement - 1; i++)
+    {
+        addInterval();
+    }
+    EXPECT_EQ(selector.numMeasurements(0), 0);
+    addInterval();
+    EXPECT_EQ(selector.numMeasurements(0), 1);
+    EXPECT_DOUBLE_EQ(selector.cyclesPerStep(0), 1000.0);
+}
+
+//! Test fixture for the generation of the tuning candidates
+class PairlistTuningCandidatesTest : public ::testing::Test
+{
+public:
+    PairlistTuningCandidatesTest()
+    {
+        // A Lennard-Jones fluid with argon parameters
+        mtop_.moltype.emplace_back();
+        t_atoms& atoms = mtop_.moltype.back().atoms;
+        init_t_atoms(&atoms, 1, false);
+        atoms.atom[0].m    = 39.948;
+        atoms.atom[0].type = 0;
+        mtop_.molblock.emplace_back();
+        mtop_.molblock.back().type = 0;
+        mtop_.molblock.back().nmol = 1000;
+        mtop_.natoms               = 1000;
+        t_iparams ljParameters;
+        ljParameters.lj.c6  = 6.2e-3;
+        ljParameters.lj.c12 = 9.7e-6;
+        mtop_.ffparams.atnr = 1;
+        mtop_.ffparams.functype.push_back(InteractionFunction::LennardJonesShortRange);
+        mtop_.ffparams.iparams.push_back(ljParameters);
+        mtop_.finalize();
+
+        ir_.eI                            = IntegrationAlgorithm::MD;
+        ir_.delta_t                       = 0.002;
+        ir_.nstlist                       = 10;
+        ir_.verletbuf_tol                 = 0.005;
+        ir_.verletBufferPressureTolerance = 0.5;
+        ir_.coulombtype                   = CoulombInteractionType::Pme;
+        ir_.rcoulomb                      = 1.0;
+        ir_.ewald_rtol                    = 1e-5;
+        ir_.epsilon_r                     = 1;
+        ir_.vdwtype                       = VanDerWaalsType::Cut;
+        ir_.vdw_modifier                  = InteractionModifiers::PotShift;
+        ir_.rvdw                          = 1.0;
+        ir_.etc                           = TemperatureCoupling::VRescale;
+        ir_.ensembleTemperatureSetting    = EnsembleTemperatureSetting::Constant;
+        ir_.ensembleTemperature           = 300;
+        ir_.opts.ngtc                     = 1;
+        snew(ir_.opts.ref_t, ir_.opts.ngtc);
+        snew(ir_.opts.tau_t, ir_.opts.ngtc);
+        snew(ir_.opts.anneal_time, ir_.opts.ngtc);
+        snew(ir_.opts.anneal_temp, ir_.opts.ngtc);
+        ir_.opts.ref_t[0] = 300;
+        ir_.opts.tau_t[0] = 0.1;
+    }
+
+    //! Returns the candidates with an initial setup with buffer \p rlist
+    std::vector<PairlistTuningCandidate> makeCandidates(const real rlist,
+                                                        const real maxCutoff2,
+                                                        const bool tunePruning)
+    {
+        PairlistParams initialParams(NbnxmKernelType::Cpu4x4_PlainC, std::nullopt, false, rlist, false);
+        initialParams.lifetime = ir_.nstlist - 1;
+
+        return makePairlistTuningCandidates(
+                ir_, mtop_, c_atomDensity, maxCutoff2, ic_, initialParams, tunePruning);
+    }
+
+    //! The atom density of liquid argon
+    static constexpr real c_atomDensity = 21;
+    //! The global topology
+    gmx_mtop_t mtop_;
+    //! The input record
+    t_inputrec ir_;
+    //! The interaction constants, cut-offs of 1 nm
+    interaction_const_t ic_;
+};
+
+TEST_F(PairlistTuningCandidatesTest, FirstCandidateIsInitialSetup)
+{
+    const auto candidates = makeCandidates(1.1, square(3.0), true);
+
+    ASSERT_GT(candidates.size(), 1);
+    EXPECT_EQ(candidates[0].nstlist, ir_.nstlist);
+    EXPECT_EQ(candidates[0].params.rlistOuter, 1.1_real);
+    EXPECT_FALSE(candidates[0].params.useDynamicPruning);
+}
+
+TEST_F(PairlistTuningCandidatesTest, CandidatesObeyBounds)
+{
+    const real maxCutoff2 = square(3.0);
+
+    for (const bool tunePruning : { false, true })
+    {
+        SCOPED_TRACE(tunePruning ? "with pruning tuning" : "without pruning tuning");
+
+        const auto candidates = makeCandidates(1.1, maxCutoff2, tunePruning);
+
+        ASSERT_GT(candidates.size(), 1);
+        for (size_t i = 1; i < candidates.size(); i++)
+        {
+            const PairlistTuningCandidate& candidate = candidates[i];
+            EXPECT_NE(candidate.nstlist, ir_.nstlist);
+            EXPECT_GE(candidate.nstlist, candidates[i - 1].nstlist);
+            EXPECT_EQ(candidate.params.lifetime, candidate.nstlist - 1);
+            EXPECT_GE(candidate.params.rlistOuter, ic_.coulomb.cutoff);
+            EXPECT_LT(square(candidate.params.rlistOuter), maxCutoff2);
+            EXPECT_LE(candidate.params.rlistInner, candidate.params.rlistOuter);
+            if (candidate.params.useDynamicPruning)
+            {
+                EXPECT_TRUE(tunePruning);
+                EXPECT_GT(candidate.params.nstlistPrune, 0);
+                EXPECT_LT(candidate.params.nstlistPrune, candidate.params.lifetime);
+            }
+            else
+            {
+                EXPECT_EQ(candidate.params.rlistInner, candidate.params.rlistOuter);
+            }
+            // The buffer increases with the list lifetime
+            if (candidate.nstlist > candidates[i - 1].nstlist && i > 1)
+            {
+                EXPECT_GT(candidate.params.rlistOuter, candidates[i - 1].params.rlistOuter);
+            }
+        }
+    }
+}
+
+TEST_F(PairlistTuningCandidatesTest, UnitCellLimitsCandidates)
+{
+    const auto allCandidates = makeCandidates(1.1, square(3.0), false);
+    ASSERT_GT(allCandidates.size(), 2);
+
+    // Only allow the setups up to the second candidate
+    const real rlistLimit =
+            0.5 * (allCandidates[1].params.rlistOuter + allCandidates[2].params.rlistOuter);
+    const auto candidates = makeCandidates(1.1, square(rlistLimit), false);
+
+    ASSERT_EQ(candidates.size(), 2);
+    EXPECT_EQ(candidates[1].nstlist, allCandidates[1].nstlist);
+
+    // With a unit cell that is too small for any larger buffer, only the initial setup remains
+    const auto initialOnly = makeCandidates(1.1, square(allCandidates[1].params.rlistOuter), false);
+
+    EXPECT_EQ(initialOnly.size(), 1);
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace gmx
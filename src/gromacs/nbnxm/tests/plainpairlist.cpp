@@ -41,6 +41,8 @@
 
 #include "gmxpre.h"
 
+#include <cmath>
+
 #include <algorithm>
 #include <numeric>
 #include <vector>
@@ -269,6 +271,73 @@ TEST_P(PlainPairlistTest, ContainsAllPairs)
     EXPECT_EQ(numExcludedPairs, c_numExcludedPairsRef);
 };
 
+//! Test case that checks that a repeated search, which can reuse the previous atom order, matches a fresh search
+TEST_P(PlainPairlistTest, RepeatedSearchMatchesFreshSearch)
+{
+    const NbnxmKernelType kernelType = GetParam();
+    const KernelOptions   options(kernelType);
+
+    if (!sc_haveNbnxmSimd4xmKernels && kernelType == NbnxmKernelType::Cpu4xN_Simd_4xN)
+    {
+        GTEST_SKIP()
+                << "Cannot test or generate data for 4xN kernels without suitable SIMD support";
+    }
+
+    if (!sc_haveNbnxmSimd2xmmKernels && kernelType == NbnxmKernelType::Cpu4xN_Simd_2xNN)
+    {
+        GTEST_SKIP()
+                << "Cannot test or generate data for 2xNN kernels without suitable SIMD support";
+    }
+
+    const TestSystem system(LJCombinationRule::Geometric, true);
+
+    std::unique_ptr<nonbonded_verlet_t> nbv = setupNbnxmForBenchInstance(options, system);
+
+    // Displace the atoms a bit, as happens between search steps, and put them back in the box
+    TestSystem displacedSystem = system;
+    for (Index i = 0; i < gmx::ssize(displacedSystem.coordinates); i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            real& coordinate = displacedSystem.coordinates[i][d];
+            coordinate += 0.05_real * std::sin(static_cast<real>(DIM * i + d));
+            coordinate -= std::floor(coordinate / system.box[d][d]) * system.box[d][d];
+        }
+    }
+
+    const rvec lowerCorner = { 0, 0, 0 };
+    const rvec upperCorner = { system.box[XX][XX], system.box[YY][YY], system.box[ZZ][ZZ] };
+    const int  numAtoms    = displacedSystem.coordinates.size();
+
+    nbv->putAtomsOnGrid(displacedSystem.box,
+                        0,
+                        lowerCorner,
+                        upperCorner,
+                        nullptr,
+                        { 0, numAtoms },
+                        numAtoms,
+                        numAtoms / det(displacedSystem.box),
+                        displacedSystem.atomInfo,
+                        displacedSystem.coordinates,
+                        nullptr);
+    nbv->constructPairlist(InteractionLocality::Local, displacedSystem.excls, true, 0, nullptr);
+
+    std::unique_ptr<nonbonded_verlet_t> nbvFresh = setupNbnxmForBenchInstance(options, displacedSystem);
+
+    const ArrayRef<const int> atomOrder      = nbv->getLocalAtomOrder();
+    const ArrayRef<const int> atomOrderFresh = nbvFresh->getLocalAtomOrder();
+    EXPECT_EQ(std::vector<int>(atomOrder.begin(), atomOrder.end()),
+              std::vector<int>(atomOrderFresh.begin(), atomOrderFresh.end()));
+
+    std::vector<RVec> shiftVecs(c_numShiftVectors);
+    calc_shifts(displacedSystem.box, shiftVecs);
+
+    const auto& plainPairlist      = nbv->plainPairlist(options.plainPairlistRange, shiftVecs);
+    const auto& plainPairlistFresh = nbvFresh->plainPairlist(options.plainPairlistRange, shiftVecs);
+    EXPECT_EQ(plainPairlist.pairs, plainPairlistFresh.pairs);
+    EXPECT_EQ(plainPairlist.excludedPairs, plainPairlistFresh.excludedPairs);
+}
+
 INSTANTIATE_TEST_SUITE_P(WithParameters,
                          PlainPairlistTest,
                          ::testing::Values(NbnxmKernelType::Cpu4x4_PlainC,
@@ -90,6 +90,7 @@ enum class WallCycleCounter : int
     PmeGather,
     PmeFft,
     PmeFftComm,
+    PmeFftCommOverlap, /* Hidden communication time of chunked FFT transposes, reported as a note */
     LJPme,
     PmeSolve,
     WaitGpuPmeGridD2hCopy, /* Time for PME grid D2H transfer. Used in mixed mode. */
@@ -157,6 +158,9 @@ enum class WallCycleSubCounter : int
     LaunchGpuBonded,
     LaunchStatePropagatorData,
     EwaldCorrection,
+    PmeSplines,
+    PmeSpreadGrid,
+    PmeSpreadReduce,
     NBXBufOps,
     NBFBufOps,
     ClearForceBuffer,
@@ -224,6 +228,7 @@ static const char* enumValuetoString(WallCycleCounter enumValue)
         "PME gather",
         "PME 3D-FFT",
         "PME 3D-FFT Comm.",
+        "PME FFT Comm. hidden",
         "PME solve LJ",
         "PME solve Elec",
         "Wait PME GPU D2H",
@@ -294,6 +299,9 @@ static const char* enumValuetoString(WallCycleSubCounter enumValue)
         "Launch GPU Bonded",
         "Launch state copy",
         "Ewald F correction",
+        "PME splines",
+        "PME spread grid",
+        "PME spread reduce",
         "NB X buffer ops.",
         "NB F buffer ops.",
         "Clear force buffer",
@@ -42,11 +42,15 @@
 
 #include "nonbonded_bench.h"
 
+#include <cstdio>
+
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "gromacs/commandline/cmdlineoptionsmodule.h"
 #include "gromacs/ewald/ewald_utils.h"
+#include "gromacs/nbnxm/benchmark/bench_report.h"
 #include "gromacs/nbnxm/benchmark/bench_setup.h"
 #include "gromacs/options/basicoptions.h"
 #include "gromacs/options/filenameoption.h"
@@ -56,6 +60,7 @@
 #include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/arraysize.h"
 #include "gromacs/utility/enumerationhelpers.h"
+#include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/real.h"
 
 namespace gmx
@@ -78,7 +83,18 @@ public:
     int  run() override;
 
 private:
-    int                     sizeFactor_ = 1;
+    //! The system size factors to sweep over
+    std::vector<int> sizeFactors_ = { 1 };
+    //! The cut-off distances to sweep over
+    std::vector<real> cutoffs_ = { 1.0 };
+    //! The OpenMP thread counts to sweep over
+    std::vector<int> threadCounts_ = { 1 };
+    //! Output file for the results in JSON format
+    std::string jsonOutputFile_;
+    //! Input file with baseline results in JSON format
+    std::string baselineFile_;
+    //! The allowed relative increase in kernel time compared to the baseline
+    real                    regressionTolerance_ = 0.05;
     NbnxmKernelBenchOptions benchmarkOptions_;
 };
 
@@ -157,13 +173,26 @@ void NonbondedBenchmark::initOptions(IOptionsContainer* options, ICommandLineOpt
         "In the MD engine, any clusters where at most half of the atoms",
         "have LJ interactions will automatically use this kernel.",
         "And finally, the [TT]-energy[tt] option selects the computation",
-        "of energies, which are usually only needed infrequently."
+        "of energies, which are usually only needed infrequently.[PAR]",
+        "The options [TT]-size[tt], [TT]-cutoff[tt] and [TT]-nt[tt] accept",
+        "multiple values. All combinations of these values are benchmarked.",
+        "With [TT]-simd all[tt] the plain-C kernel is run in addition to all",
+        "supported SIMD kernels.",
+        "With [TT]-json[tt] the results are also written in JSON format.",
+        "Apart from cycles, timings and pair throughput, this reports",
+        "an ns/day equivalent, which is the simulation rate for a 2 fs",
+        "time step consisting only of the kernel call. Such a file can later",
+        "be passed to [TT]-baseline[tt] to compare a run with the stored",
+        "results, for instance after changing compiler or hardware.",
+        "Setups for which the kernel time increased by more than the fraction",
+        "set with [TT]-tolerance[tt] are reported as regressions and",
+        "result in a non-zero exit code."
     };
 
     settings->setHelpText(desc);
 
     static const EnumerationArray<NbnxmBenchMarkKernels, const char*> c_nbnxmSimdStrings = {
-        { "auto", "no", "4xm", "2xmm" }
+        { "auto", "no", "4xm", "2xmm", "all" }
     };
     static const EnumerationArray<NbnxmBenchMarkCombRule, const char*> c_combRuleStrings = {
         { "geometric", "lb", "none" }
@@ -175,15 +204,20 @@ void NonbondedBenchmark::initOptions(IOptionsContainer* options, ICommandLineOpt
     static const EnumerationArray<NbnxmBenchMarkInteractionModifiers, const char*> c_interactionModifierStrings = {
         { "PotShift", "PotSwitch", "ForceSwitch" }
     };
-    options->addOption(
-            IntegerOption("size").store(&sizeFactor_).description("The system size is 3000 atoms times this value"));
-    options->addOption(
-            IntegerOption("nt").store(&benchmarkOptions_.numThreads).description("The number of OpenMP threads to use"));
+    options->addOption(IntegerOption("size")
+                               .storeVector(&sizeFactors_)
+                               .multiValue()
+                               .description("The system size is 3000 atoms times this value"));
+    options->addOption(IntegerOption("nt")
+                               .storeVector(&threadCounts_)
+                               .multiValue()
+                               .description("The number of OpenMP threads to use"));
     options->addOption(EnumOption<NbnxmBenchMarkKernels>("simd")
                                .store(&benchmarkOptions_.nbnxmSimd)
                                .enumValue(c_nbnxmSimdStrings)
                                .description("SIMD type, auto runs all supported SIMD setups or no "
-                                            "SIMD when SIMD is not supported"));
+                                            "SIMD when SIMD is not supported, all also runs "
+                                            "the plain-C kernel"));
     options->addOption(EnumOption<NbnxmBenchMarkCoulomb>("coulomb")
                                .store(&benchmarkOptions_.coulombType)
                                .enumValue(c_coulombTypeStrings)
@@ -212,7 +246,8 @@ void NonbondedBenchmark::initOptions(IOptionsContainer* options, ICommandLineOpt
     options->addOption(
             BooleanOption("all").store(&benchmarkOptions_.doAll).description("Run all 36 combinations of options for coulomb, halflj, combrule, interactmodifier"));
     options->addOption(RealOption("cutoff")
-                               .store(&benchmarkOptions_.pairlistCutoff)
+                               .storeVector(&cutoffs_)
+                               .multiValue()
                                .description("Pair-list and interaction cut-off distance"));
     options->addOption(IntegerOption("iter")
                                .store(&benchmarkOptions_.numIterations)
@@ -231,18 +266,76 @@ void NonbondedBenchmark::initOptions(IOptionsContainer* options, ICommandLineOpt
                                .store(&benchmarkOptions_.outputFile)
                                .defaultBasename("nonbonded-benchmark")
                                .description("Also output results in csv format"));
+    options->addOption(FileNameOption("json")
+                               .filetype(OptionFileType::Json)
+                               .outputFile()
+                               .store(&jsonOutputFile_)
+                               .defaultBasename("nonbonded-benchmark")
+                               .description("Also output results in JSON format"));
+    options->addOption(FileNameOption("baseline")
+                               .filetype(OptionFileType::Json)
+                               .inputFile()
+                               .store(&baselineFile_)
+                               .defaultBasename("nonbonded-baseline")
+                               .description("JSON output of an earlier run to compare with"));
+    options->addOption(RealOption("tolerance")
+                               .store(&regressionTolerance_)
+                               .description("Relative kernel time increase with respect to the "
+                                            "baseline that is reported as a regression"));
 }
 
 void NonbondedBenchmark::optionsFinished()
 {
-    // We compute the Ewald coefficient here to avoid a dependency of the Nbnxm on the Ewald module
-    const real ewald_rtol = 1e-5;
-    benchmarkOptions_.ewaldcoeff_q = calc_ewaldcoeff_q(benchmarkOptions_.pairlistCutoff, ewald_rtol);
+    if (regressionTolerance_ < 0)
+    {
+        GMX_THROW(InconsistentInputError("The regression tolerance should not be negative"));
+    }
 }
 
 int NonbondedBenchmark::run()
 {
-    bench(sizeFactor_, benchmarkOptions_);
+    std::vector<NbnxmKernelBenchResult> results;
+
+    bool isFirstSetup = true;
+    for (const int numThreads : threadCounts_)
+    {
+        for (const real cutoff : cutoffs_)
+        {
+            for (const int sizeFactor : sizeFactors_)
+            {
+                NbnxmKernelBenchOptions options = benchmarkOptions_;
+                options.numThreads              = numThreads;
+                options.pairlistCutoff          = cutoff;
+                // We compute the Ewald coefficient here to avoid a dependency of the Nbnxm on the Ewald module
+                const real ewald_rtol      = 1e-5;
+                options.ewaldcoeff_q       = calc_ewaldcoeff_q(cutoff, ewald_rtol);
+                options.appendToOutputFile = !isFirstSetup;
+
+                if (!isFirstSetup)
+                {
+                    fprintf(stdout, "\n");
+                }
+                const auto setupResults = bench(sizeFactor, options);
+                results.insert(results.end(), setupResults.begin(), setupResults.end());
+
+                isFirstSetup = false;
+            }
+        }
+    }
+
+    if (!jsonOutputFile_.empty())
+    {
+        writeNbnxmKernelBenchJson(jsonOutputFile_, results);
+    }
+
+    if (!baselineFile_.empty())
+    {
+        const auto baseline = readNbnxmKernelBenchBaseline(baselineFile_);
+        const int  numRegressions =
+                compareNbnxmKernelBenchToBaseline(results, baseline, regressionTolerance_, stdout);
+
+        return numRegressions > 0 ? 1 : 0;
+    }
 
     return 0;
 }
@@ -49,12 +49,14 @@
 #include <gtest/gtest.h>
 
 #include "gromacs/commandline/cmdlineoptionsmodule.h"
+#include "gromacs/nbnxm/benchmark/bench_report.h"
 #include "gromacs/utility/stringutil.h"
 #include "gromacs/utility/textreader.h"
 
 #include "testutils/cmdlinetest.h"
 #include "testutils/refdata.h"
 #include "testutils/testasserts.h"
+#include "testutils/testfilemanager.h"
 
 #include "moduletest.h"
 
@@ -75,6 +77,38 @@ TEST(NonbondedBenchTest, BasicEndToEndTest)
                       &gmx::NonbondedBenchmarkInfo::create, &cmdline));
 }
 
+TEST(NonbondedBenchTest, SweepWritesJsonAndComparesToBaseline)
+{
+    TestFileManager   fileManager;
+    const auto        jsonFile  = fileManager.getTemporaryFilePath("bench.json");
+    const char* const command[] = { "nonbonded-benchmark" };
+    CommandLine       cmdline(command);
+    cmdline.addOption("-iter", 1);
+    cmdline.append("-cutoff");
+    cmdline.append("0.9");
+    cmdline.append("1.1");
+
+    CommandLine writeCmdline(cmdline);
+    writeCmdline.addOption("-json", jsonFile);
+    EXPECT_EQ(0,
+              gmx::test::CommandLineTestHelper::runModuleFactory(
+                      &gmx::NonbondedBenchmarkInfo::create, &writeCmdline));
+
+    const auto baseline = readNbnxmKernelBenchBaseline(jsonFile.string());
+    ASSERT_FALSE(baseline.empty());
+    EXPECT_EQ(baseline.size() % 2, 0U) << "Expect the same kernels to be run for both cut-offs";
+    EXPECT_NE(baseline.front().key.find("cutoff=0.9"), std::string::npos);
+    EXPECT_NE(baseline.back().key.find("cutoff=1.1"), std::string::npos);
+
+    // Use a tolerance that timing noise can not exceed
+    CommandLine compareCmdline(cmdline);
+    compareCmdline.addOption("-baseline", jsonFile);
+    compareCmdline.addOption("-tolerance", 1000.0);
+    EXPECT_EQ(0,
+              gmx::test::CommandLineTestHelper::runModuleFactory(
+                      &gmx::NonbondedBenchmarkInfo::create, &compareCmdline));
+}
+
 } // namespace
 } // namespace test
 } // namespace gmx